@@ -0,0 +1,71 @@
+/*
+ * AAC decoder sample and coefficient types
+ *
+ * This file is part of Libav.
+ *
+ * Libav is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * Libav is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Libav; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file
+ * Types shared by the floating-point and the fixed-point AAC decoders.
+ *
+ * The fixed-point decoder defines CONFIG_AACDEC_FIXED to 1 before including
+ * the AAC headers. Samples and QMF values are then integers, SBR energies
+ * and gains SoftFloat, and the SBR and PS entry points get a _fixed suffix
+ * so that both decoders can be linked together.
+ */
+
+#ifndef AVCODEC_AAC_DEFINES_H
+#define AVCODEC_AAC_DEFINES_H
+
+#include <stdint.h>
+
+#ifndef CONFIG_AACDEC_FIXED
+#define CONFIG_AACDEC_FIXED 0
+#endif
+
+#if CONFIG_AACDEC_FIXED
+
+#include "softfloat.h"
+
+#define INTFLOAT   int
+#define INT64FLOAT int64_t
+#define AAC_FLOAT  SoftFloat
+#define AAC_RENAME(x) x ## _fixed
+
+/* rounded to the nearest Q31 value, for constants of magnitude below 1 */
+#define Q31(x) ((int)((x) * 2147483648.0 + ((x) < 0 ? -0.5 : 0.5)))
+#define Q30(x) ((int)((x) * 1073741824.0 + ((x) < 0 ? -0.5 : 0.5)))
+
+#define AAC_MUL30(x, y) ((int)(((int64_t)(x) * (y) + 0x20000000) >> 30))
+#define AAC_MUL31(x, y) ((int)(((int64_t)(x) * (y) + 0x40000000) >> 31))
+
+#else
+
+#define INTFLOAT   float
+#define INT64FLOAT float
+#define AAC_FLOAT  float
+#define AAC_RENAME(x) x
+
+#define Q31(x) x
+#define Q30(x) x
+
+#define AAC_MUL30(x, y) ((x) * (y))
+#define AAC_MUL31(x, y) ((x) * (y))
+
+#endif /* CONFIG_AACDEC_FIXED */
+
+#endif /* AVCODEC_AAC_DEFINES_H */
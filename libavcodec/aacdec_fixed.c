@@ -0,0 +1,488 @@
+/*
+ * AAC decoder, fixed-point
+ *
+ * This file is part of Libav.
+ *
+ * Libav is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * Libav is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Libav; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file
+ * AAC decoder, fixed-point
+ *
+ * AAC-LC and ER AAC-LC are decoded, with SBR and PS (HE-AAC v1 and v2).
+ * The other object types are rejected, their tools have no integer
+ * implementation.
+ */
+
+#define FFT_FLOAT 0
+#define FFT_FIXED_32 1
+#define CONFIG_AACDEC_FIXED 1
+
+#include "libavutil/common.h"
+#include "aac.h"
+#include "aacdectab.h"
+#include "aacsbr.h"
+#include "aactab.h"
+#include "kbdwin.h"
+#include "mathops.h"
+#include "sinewin.h"
+
+#define VQTYPE int8_t
+#define CODEBOOK_VECTOR_VALS codebook_vector_ivals
+
+#define KBD_LONG_1024 kbd_long_1024
+#define KBD_SHORT_128 kbd_short_128
+#define SINE_1024     sine_1024
+#define SINE_128      sine_128
+
+/* windows and TNS coefficients in Q31 */
+DECLARE_ALIGNED(32, static int, kbd_long_1024)[1024];
+DECLARE_ALIGNED(32, static int, kbd_short_128)[128];
+DECLARE_ALIGNED(32, static int, sine_1024)[1024];
+DECLARE_ALIGNED(32, static int, sine_128)[128];
+static int tns_tmp2_map_fixed[4][16];
+
+/* i^(4/3) in Q13, with room for the largest escape value plus a pulse */
+static int pow43_tab[(1 << 13) + 16];
+
+/* 2^(i/4) in Q30 */
+static const int pow2_quarter[4] = {
+    1073741824, 1276901417, 1518500250, 1805811301,
+};
+
+static const int8_t codebook_vector0_ivals[]  = { -1, 0, 1 };
+static const int8_t codebook_vector4_ivals[]  = { -4, -3, -2, -1, 0, 1, 2, 3, 4 };
+static const int8_t codebook_vector10_ivals[] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+};
+
+static const int8_t *const codebook_vector_ivals[] = {
+    codebook_vector0_ivals,  codebook_vector0_ivals,
+    codebook_vector10_ivals, codebook_vector10_ivals,
+    codebook_vector4_ivals,  codebook_vector4_ivals,
+    codebook_vector10_ivals, codebook_vector10_ivals,
+    codebook_vector10_ivals, codebook_vector10_ivals,
+    codebook_vector10_ivals,
+};
+
+/**
+ * Scale by a power of 2^(1/4).
+ *
+ * @return  v * 2^(e/4), rounded and saturated to 32 bits
+ */
+static av_always_inline int aac_scale(int v, int e)
+{
+    int64_t r = (int64_t)v * pow2_quarter[e & 3];
+    int shift = 30 - (e >> 2);
+
+    if (shift <= 0)
+        return av_clipl_int32(r * (1 << FFMIN(-shift, 1)));
+    if (shift > 62)
+        return 0;
+    return av_clipl_int32((r + (1LL << (shift - 1))) >> shift);
+}
+
+static av_cold void init_dsp(AACContext *ac)
+{
+    int i, j;
+
+    ac->avctx->sample_fmt = AV_SAMPLE_FMT_S16P;
+
+    ff_aac_sbr_init_fixed();
+
+    /* both transforms output 1.0 as 1 << 22 */
+    ff_mdct_init(&ac->mdct,       11, 1, 1.0 / 8);
+    ff_mdct_init(&ac->mdct_small,  8, 1, 1.0);
+
+    for (i = 0; i < 1024; i++) {
+        kbd_long_1024[i] = av_clipl_int32(llrint(ff_aac_kbd_long_1024[i] * 2147483648.0));
+        sine_1024[i]     = av_clipl_int32(llrint(ff_sine_1024[i]         * 2147483648.0));
+    }
+    for (i = 0; i < 128; i++) {
+        kbd_short_128[i] = av_clipl_int32(llrint(ff_aac_kbd_short_128[i] * 2147483648.0));
+        sine_128[i]      = av_clipl_int32(llrint(ff_sine_128[i]          * 2147483648.0));
+    }
+    for (i = 0; i < 4; i++)
+        for (j = 0; j < 8 << (i & 1) >> (i >> 1); j++)
+            tns_tmp2_map_fixed[i][j] = llrint(tns_tmp2_map[i][j] * 2147483648.0);
+    for (i = 0; i < FF_ARRAY_ELEMS(pow43_tab); i++)
+        pow43_tab[i] = llrint(pow(i, 4.0 / 3.0) * 8192.0);
+}
+
+static av_cold void sbr_ctx_init(AACContext *ac, ChannelElement *che)
+{
+    ff_aac_sbr_ctx_init_fixed(ac, &che->sbr);
+}
+
+static av_cold void sbr_ctx_close(ChannelElement *che)
+{
+    ff_aac_sbr_ctx_close_fixed(&che->sbr);
+}
+
+/* The output is converted from the internal buffers. */
+static void map_output_buffers(AACContext *ac)
+{
+}
+
+/**
+ * Convert the decoded channels from 1.0 = 1 << 22 to S16P.
+ */
+static void convert_output(AACContext *ac, int samples)
+{
+    int ch, i;
+
+    for (ch = 0; ch < ac->avctx->channels; ch++) {
+        const int *src;
+        int16_t *dst = (int16_t *)ac->frame->extended_data[ch];
+
+        if (!ac->output_element[ch])
+            continue;
+        src = ac->output_element[ch]->ret;
+        for (i = 0; i < samples; i++)
+            dst[i] = av_clip_int16((src[i] + 64) >> 7);
+    }
+}
+
+/**
+ * Only AAC-LC, possibly with SBR and PS, is decoded in fixed point, the
+ * other object types need tools that have no integer implementation.
+ */
+static int check_object_type(AVCodecContext *avctx,
+                             const MPEG4AudioConfig *m4ac)
+{
+    if (m4ac->object_type != AOT_AAC_LC && m4ac->object_type != AOT_ER_AAC_LC) {
+        avpriv_report_missing_feature(avctx, "Audio object type %d "
+                                      "in the fixed-point decoder",
+                                      m4ac->object_type);
+        return AVERROR_PATCHWELCOME;
+    }
+    return 0;
+}
+
+/* Scalefactors are kept as exponents of 2^(1/4). */
+static av_always_inline int intensity_sf(int offset)
+{
+    return -offset;
+}
+
+static av_always_inline int noise_sf(int offset)
+{
+    return offset;
+}
+
+static av_always_inline int band_sf(int offset)
+{
+    return offset - 100;
+}
+
+static av_always_inline int tns_coef(int tmp2_idx, int code)
+{
+    return tns_tmp2_map_fixed[tmp2_idx][code];
+}
+
+/**
+ * Convert Q31 reflection coefficients to Q20 LPC coefficients,
+ * as compute_lpc_coefs() does in floating point.
+ * The recursion runs in Q24 with Q29 reflection coefficients; the
+ * LPC coefficients of an order 12 filter can reach 924 in magnitude.
+ */
+static void compute_tns_lpc(const int *refl, int order, int *lpc)
+{
+    int64_t tmp[TNS_MAX_ORDER];
+    int i, j;
+
+    for (i = 0; i < order; i++) {
+        int64_t r = -((refl[i] + 2) >> 2);
+
+        tmp[i] = (r + 16) >> 5;
+        for (j = 0; j < (i + 1) >> 1; j++) {
+            int64_t f = tmp[j];
+            int64_t b = tmp[i - 1 - j];
+            tmp[j]         = f + ((r * b + (1 << 28)) >> 29);
+            tmp[i - 1 - j] = b + ((r * f + (1 << 28)) >> 29);
+        }
+    }
+    for (i = 0; i < order; i++)
+        lpc[i] = (tmp[i] + 8) >> 4;
+}
+
+static void tns_ar_filter(int *coef, int size, int inc,
+                          const int *lpc, int order)
+{
+    int m, i;
+
+    for (m = 0; m < size; m++, coef += inc) {
+        int64_t sum = 0;
+        for (i = 1; i <= FFMIN(m, order); i++)
+            sum += (int64_t)coef[-i * inc] * lpc[i - 1];
+        *coef = av_clipl_int32(*coef - ((sum + (1 << 19)) >> 20));
+    }
+}
+
+static void tns_ma_filter(int *coef, int size, int inc,
+                          const int *lpc, int order)
+{
+    int tmp[TNS_MAX_ORDER + 1];
+    int m, i;
+
+    for (m = 0; m < size; m++, coef += inc) {
+        int64_t sum = 0;
+        tmp[0] = *coef;
+        for (i = 1; i <= FFMIN(m, order); i++)
+            sum += (int64_t)tmp[i] * lpc[i - 1];
+        *coef = av_clipl_int32(*coef + ((sum + (1 << 19)) >> 20));
+        for (i = order; i > 0; i--)
+            tmp[i] = tmp[i - 1];
+    }
+}
+
+/**
+ * Scale a band of random values to the PNS energy 2^(sf/4).
+ */
+static void noise_scale(AACContext *ac, int *cf, int sf, int len)
+{
+    uint64_t band_energy = 0;
+    int64_t scale;
+    int k, shift = 0;
+
+    for (k = 0; k < len; k++) {
+        cf[k] >>= 16;
+        band_energy += (int64_t)cf[k] * cf[k];
+    }
+
+    for (; band_energy > UINT32_MAX; band_energy >>= 2)
+        shift++;
+    band_energy = ff_sqrt(band_energy) << shift;
+    if (!band_energy) {
+        memset(cf, 0, len * sizeof(*cf));
+        return;
+    }
+    /* normalize to 1 << 30, then apply the negated gain */
+    scale = (1LL << 45) / band_energy;
+    for (k = 0; k < len; k++)
+        cf[k] = -aac_scale((cf[k] * scale) >> 15, sf - 120);
+}
+
+/* The fixed-point decoder keeps the quantized values, dequantized later. */
+static inline int *VMUL2(int *dst, const int8_t *v, unsigned idx,
+                         const int *scale)
+{
+    *dst++ = v[idx    & 15];
+    *dst++ = v[idx>>4 & 15];
+    return dst;
+}
+
+static inline int *VMUL4(int *dst, const int8_t *v, unsigned idx,
+                         const int *scale)
+{
+    *dst++ = v[idx    & 3];
+    *dst++ = v[idx>>2 & 3];
+    *dst++ = v[idx>>4 & 3];
+    *dst++ = v[idx>>6 & 3];
+    return dst;
+}
+
+static inline int *VMUL2S(int *dst, const int8_t *v, unsigned idx,
+                          unsigned sign, const int *scale)
+{
+    int v0 = v[idx & 15], v1 = v[idx>>4 & 15];
+
+    *dst++ = sign & 2 ? -v0 : v0;
+    *dst++ = sign & 1 ? -v1 : v1;
+    return dst;
+}
+
+static inline int *VMUL4S(int *dst, const int8_t *v, unsigned idx,
+                          unsigned sign, const int *scale)
+{
+    unsigned nz = idx >> 12;
+    int t;
+
+    t = v[idx    & 3];
+    *dst++ = sign & 1U<<31 ? -t : t;
+
+    sign <<= nz & 1; nz >>= 1;
+    t = v[idx>>2 & 3];
+    *dst++ = sign & 1U<<31 ? -t : t;
+
+    sign <<= nz & 1; nz >>= 1;
+    t = v[idx>>4 & 3];
+    *dst++ = sign & 1U<<31 ? -t : t;
+
+    sign <<= nz & 1;
+    t = v[idx>>6 & 3];
+    *dst++ = sign & 1U<<31 ? -t : t;
+
+    return dst;
+}
+
+static av_always_inline int esc_value(int n)
+{
+    return n;
+}
+
+static av_always_inline int sign_value(int v, uint32_t sign)
+{
+    return sign & 1U<<31 ? -v : v;
+}
+
+static av_always_inline void scale_esc_band(AACContext *ac, int *cf,
+                                            int sf, int len)
+{
+}
+
+/**
+ * Add the pulses to the quantized values and dequantize them.
+ */
+static void dequant_spectrum(AACContext *ac, int *coef_base, const int *sf,
+                             int pulse_present, const Pulse *pulse,
+                             const IndividualChannelStream *ics,
+                             const enum BandType *band_type)
+{
+    const uint16_t *offsets = ics->swb_offset;
+    int *coef;
+    int g, i, k, idx;
+
+    if (pulse_present) {
+        idx = 0;
+        for (i = 0; i < pulse->num_pulse; i++) {
+            int *co = &coef_base[pulse->pos[i]];
+            while (offsets[idx + 1] <= pulse->pos[i])
+                idx++;
+            if (band_type[idx] != NOISE_BT && band_type[idx] != ZERO_BT)
+                *co += *co > 0 ? pulse->amp[i] : -pulse->amp[i];
+        }
+    }
+
+    /* dequantize: -sign(q) * |q|^(4/3) * 2^(sf/4) */
+    idx  = 0;
+    coef = coef_base;
+    for (g = 0; g < ics->num_window_groups; g++) {
+        unsigned g_len = ics->group_len[g];
+
+        for (i = 0; i < ics->max_sfb; i++, idx++) {
+            int *cfo = coef + offsets[i];
+            int off_len = offsets[i + 1] - offsets[i];
+            int group, e = sf[idx] - 52;
+
+            if (band_type[idx] == ZERO_BT || band_type[idx] >= NOISE_BT)
+                continue;
+            for (group = 0; group < g_len; group++, cfo += 128) {
+                for (k = 0; k < off_len; k++) {
+                    int q = cfo[k];
+                    if (q)
+                        cfo[k] = aac_scale(q > 0 ? -pow43_tab[q] : pow43_tab[-q], e);
+                }
+            }
+        }
+        coef += g_len << 7;
+    }
+}
+
+static av_always_inline void butterflies(AACContext *ac, int *l, int *r,
+                                         int len)
+{
+    int k;
+
+    for (k = 0; k < len; k++) {
+        int t = l[k] - r[k];
+        l[k] += r[k];
+        r[k]  = t;
+    }
+}
+
+static av_always_inline void intensity_scale(AACContext *ac, int *dst,
+                                             const int *src, int c,
+                                             int sf, int len)
+{
+    int k;
+
+    for (k = 0; k < len; k++)
+        dst[k] = c * aac_scale(src[k], sf);
+}
+
+static void vector_fmul_window(AACContext *ac, int *dst, const int *src0,
+                               const int *src1, const int *win, int len)
+{
+    int i, j;
+
+    dst  += len;
+    win  += len;
+    src0 += len;
+    for (i = -len, j = len - 1; i < 0; i++, j--) {
+        int64_t s0 = src0[i];
+        int64_t s1 = src1[j];
+        int64_t wi = win[i];
+        int64_t wj = win[j];
+        dst[i] = (s0 * wj - s1 * wi + 0x40000000) >> 31;
+        dst[j] = (s0 * wi + s1 * wj + 0x40000000) >> 31;
+    }
+}
+
+#include "aacdec_template.c"
+
+/* AAC Main is rejected by check_object_type(). */
+static void apply_prediction(AACContext *ac, SingleChannelElement *sce)
+{
+}
+
+static int decode_cce(AACContext *ac, GetBitContext *gb, ChannelElement *che)
+{
+    avpriv_report_missing_feature(ac->avctx, "Channel coupling "
+                                  "in the fixed-point decoder");
+    return AVERROR_PATCHWELCOME;
+}
+
+/**
+ * Convert spectral data to samples, applying TNS and SBR, the only tools
+ * left after the spectral decoding in AAC-LC and HE-AAC.
+ */
+static void spectral_to_sample(AACContext *ac)
+{
+    int i, type;
+    for (type = 3; type >= 0; type--) {
+        for (i = 0; i < MAX_ELEM_ID; i++) {
+            ChannelElement *che = ac->che[type][i];
+            if (che && type != TYPE_CCE) {
+                if (che->ch[0].tns.present)
+                    apply_tns(che->ch[0].coeffs, &che->ch[0].tns, &che->ch[0].ics, 1);
+                if (che->ch[1].tns.present)
+                    apply_tns(che->ch[1].coeffs, &che->ch[1].tns, &che->ch[1].ics, 1);
+                imdct_and_windowing(ac, &che->ch[0]);
+                if (type == TYPE_CPE)
+                    imdct_and_windowing(ac, &che->ch[1]);
+                if (ac->oc[1].m4ac.sbr > 0)
+                    ff_sbr_apply_fixed(ac, &che->sbr, type, che->ch[0].ret, che->ch[1].ret);
+            }
+        }
+    }
+}
+
+AVCodec ff_aac_fixed_decoder = {
+    .name            = "aac_fixed",
+    .long_name       = NULL_IF_CONFIG_SMALL("AAC (Advanced Audio Coding), fixed-point"),
+    .type            = AVMEDIA_TYPE_AUDIO,
+    .id              = AV_CODEC_ID_AAC,
+    .priv_data_size  = sizeof(AACContext),
+    .init            = aac_decode_init,
+    .close           = aac_decode_close,
+    .decode          = aac_decode_frame,
+    .sample_fmts     = (const enum AVSampleFormat[]) {
+        AV_SAMPLE_FMT_S16P, AV_SAMPLE_FMT_NONE
+    },
+    .capabilities    = CODEC_CAP_CHANNEL_CONF | CODEC_CAP_DR1,
+    .channel_layouts = aac_channel_layout,
+};
@@ -0,0 +1,156 @@
+/*
+ * MPEG-4 Parametric Stereo decoding functions, fixed-point
+ *
+ * This file is part of Libav.
+ *
+ * Libav is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * Libav is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Libav; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file
+ * MPEG-4 Parametric Stereo decoding functions, fixed-point
+ *
+ * The tables are generated in floating point and converted once: the
+ * hybrid filters, the fractional delays and the all-pass coefficients to Q31,
+ * the phase smoothing tables to Q30 and the mixing matrices to Q29.
+ */
+
+#define CONFIG_AACDEC_FIXED 1
+
+#include <stdint.h>
+#include "libavutil/common.h"
+#include "libavutil/internal.h"
+#include "libavutil/mathematics.h"
+#include "avcodec.h"
+#include "get_bits.h"
+#include "aacps.h"
+#include "aacps_tablegen.h"
+#include "aacpsdata.c"
+
+/* the converted tables are written at init */
+#undef TABLE_CONST
+#define TABLE_CONST
+
+static int pd_re_smooth_fixed[8*8*8];
+static int pd_im_smooth_fixed[8*8*8];
+static int HA_fixed[46][8][4];
+static int HB_fixed[46][8][4];
+static DECLARE_ALIGNED(16, int, f20_0_8_fixed) [ 8][8][2];
+static DECLARE_ALIGNED(16, int, f34_0_12_fixed)[12][8][2];
+static DECLARE_ALIGNED(16, int, f34_1_8_fixed) [ 8][8][2];
+static DECLARE_ALIGNED(16, int, f34_2_4_fixed) [ 4][8][2];
+static DECLARE_ALIGNED(16, int, Q_fract_allpass_fixed)[2][50][3][2];
+static DECLARE_ALIGNED(16, int, phi_fract_fixed)[2][50][2];
+
+static av_cold void convert_table(int *dst, const float *src, int n, int frac)
+{
+    int i;
+    for (i = 0; i < n; i++)
+        dst[i] = av_clipl_int32(llrint(src[i] * (double)(1LL << frac)));
+}
+
+#define CONVERT_TABLE(name, frac)                                       \
+    convert_table((int *)name ## _fixed, (const float *)name,          \
+                  sizeof(name) / sizeof(float), frac)
+
+static av_cold void ps_tableinit_fixed(void)
+{
+    ps_tableinit();
+
+    CONVERT_TABLE(pd_re_smooth,    30);
+    CONVERT_TABLE(pd_im_smooth,    30);
+    CONVERT_TABLE(HA,              29);
+    CONVERT_TABLE(HB,              29);
+    CONVERT_TABLE(f20_0_8,         31);
+    CONVERT_TABLE(f34_0_12,        31);
+    CONVERT_TABLE(f34_1_8,         31);
+    CONVERT_TABLE(f34_2_4,         31);
+    CONVERT_TABLE(Q_fract_allpass, 31);
+    CONVERT_TABLE(phi_fract,       31);
+}
+
+/// All-pass filter decay slope in Q30
+#define DECAY_SLOPE Q30(0.05f)
+
+#define PS_MAP3(a, b)        ((int)((2 * (int64_t)(a) + (b)) / 3))
+#define PS_MEAN2(a, b)       ((int)(((int64_t)(a) + (b)) >> 1))
+#define PS_MEAN4(a, b, c, d) ((int)(((int64_t)(a) + (b) + (c) + (d)) >> 2))
+
+/** Split one subband into 2 subsubbands with a symmetric real filter.
+ * The filter must have its non-center even coefficients equal to zero. */
+static void hybrid2_re(int (*in)[2], int (*out)[32][2], const int filter[8], int len, int reverse)
+{
+    int i, j;
+    for (i = 0; i < len; i++, in++) {
+        int64_t re_in = (int64_t)filter[6] * in[6][0];   //real inphase
+        int64_t re_op = 0;                               //real out of phase
+        int64_t im_in = (int64_t)filter[6] * in[6][1];   //imag inphase
+        int64_t im_op = 0;                               //imag out of phase
+        for (j = 0; j < 6; j += 2) {
+            re_op += (int64_t)filter[j+1] * (in[j+1][0] + (int64_t)in[12-j-1][0]);
+            im_op += (int64_t)filter[j+1] * (in[j+1][1] + (int64_t)in[12-j-1][1]);
+        }
+        out[ reverse][i][0] = (int)((re_in + re_op + 0x40000000) >> 31);
+        out[ reverse][i][1] = (int)((im_in + im_op + 0x40000000) >> 31);
+        out[!reverse][i][0] = (int)((re_in - re_op + 0x40000000) >> 31);
+        out[!reverse][i][1] = (int)((im_in - im_op + 0x40000000) >> 31);
+    }
+}
+
+/* The energies are integers, the gain is Q30. */
+static void transient_detection(PSContext *ps, int i, const int64_t *power,
+                                int *transient_gain, int n0, int nL)
+{
+    int64_t *peak_decay_nrg = ps->peak_decay_nrg;
+    int64_t *power_smooth = ps->power_smooth;
+    int64_t *peak_decay_diff_smooth = ps->peak_decay_diff_smooth;
+    int n;
+
+    for (n = n0; n < nL; n++) {
+        // peak_decay_factor 0.76592833836465 in Q15
+        int64_t decayed_peak = (peak_decay_nrg[i] * 25098) >> 15;
+        int64_t num, denom;
+        peak_decay_nrg[i] = FFMAX(decayed_peak, power[n]);
+        // a_smooth 0.25
+        power_smooth[i] += (power[n] - power_smooth[i]) >> 2;
+        peak_decay_diff_smooth[i] += (peak_decay_nrg[i] - power[n] - peak_decay_diff_smooth[i]) >> 2;
+        // transient_impact 1.5
+        denom = peak_decay_diff_smooth[i] + (peak_decay_diff_smooth[i] >> 1);
+        if (denom > power_smooth[i]) {
+            num = power_smooth[i];
+            while (denom >= 1LL << 32) {
+                num   >>= 1;
+                denom >>= 1;
+            }
+            transient_gain[n] = (int)((num << 30) / denom);
+        } else {
+            transient_gain[n] = 1 << 30;
+        }
+    }
+}
+
+/**
+ * @param k number of bands above the start of the decay slope
+ */
+static int decay_slope(int k)
+{
+    if (k <= 0)
+        return 1 << 30;
+    if (k >= 20)
+        return 0;
+    return (1 << 30) - k * DECAY_SLOPE;
+}
+
+#include "aacps_template.c"
@@ -209,6 +209,8 @@ av_cold void ff_psdsp_init(PSDSPContext *s)
     s->stereo_interpolate[0]  = ps_stereo_interpolate_c;
     s->stereo_interpolate[1]  = ps_stereo_interpolate_ipdopd_c;
 
+    if (ARCH_AARCH64)
+        ff_psdsp_init_aarch64(s);
     if (ARCH_ARM)
         ff_psdsp_init_arm(s);
 }
@@ -0,0 +1,403 @@
+/*
+ * AAC Spectral Band Replication decoding functions, fixed-point
+ *
+ * This file is part of Libav.
+ *
+ * Libav is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * Libav is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Libav; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file
+ * AAC Spectral Band Replication decoding functions, fixed-point
+ *
+ * The decoder samples are 1.0 = 1 << 22. The QMF values are integers
+ * scaled by 2^5 from the 16-bit range the floating-point decoder works in,
+ * so the energies are scaled by 2^10. Energies, noise floors and gains are
+ * SoftFloat, the filter coefficients Q29 and the chirp factors Q31.
+ */
+
+#define FFT_FLOAT 0
+#define FFT_FIXED_32 1
+#define CONFIG_AACDEC_FIXED 1
+
+#include "aac.h"
+#include "sbr.h"
+#include "aacsbr.h"
+#include "aacsbrdata.h"
+#include "fft.h"
+#include "aacps.h"
+#include "sbrdsp.h"
+#include "softfloat.h"
+#include "libavutil/internal.h"
+#include "libavutil/libm.h"
+
+#include <stdint.h>
+
+static av_cold void sbr_mdct_init(AACContext *ac, SpectralBandReplication *sbr)
+{
+    /* the analysis scales 1 << 22 to the QMF range, 2^5 above the 16-bit
+     * one, the synthesis windowing scales back up */
+    ff_mdct_init(&sbr->mdct,     7, 1, 1.0 / 64);
+    ff_mdct_init(&sbr->mdct_ana, 7, 1, -0.5);
+}
+
+/// Dequantization and stereo decoding (14496-3 sp04 p203)
+static void sbr_dequant(SpectralBandReplication *sbr, int id_aac)
+{
+    int k, e;
+    int ch;
+
+    /* the scalefactors are exponents of 2 in half steps */
+    if (id_aac == TYPE_CPE && sbr->bs_coupling) {
+        int alpha = sbr->data[0].bs_amp_res ? 2 : 1;
+        for (e = 1; e <= sbr->data[0].bs_num_env; e++) {
+            for (k = 0; k < sbr->n[sbr->data[0].bs_freq_res[e]]; k++) {
+                SoftFloat temp1 = sf_exp2_half(sbr->data[0].env_facs_q[e][k] * alpha + 2 * (7 + 10));
+                SoftFloat temp2 = sf_exp2_half(24 - sbr->data[1].env_facs_q[e][k] * alpha);
+                SoftFloat fac   = sf_div(temp1, sf_add(SF_ONE, temp2));
+                sbr->data[0].env_facs[e][k] = fac;
+                sbr->data[1].env_facs[e][k] = sf_mul(fac, temp2);
+            }
+        }
+        for (e = 1; e <= sbr->data[0].bs_num_noise; e++) {
+            for (k = 0; k < sbr->n_q; k++) {
+                SoftFloat temp1 = sf_exp2_half(2 * (NOISE_FLOOR_OFFSET - sbr->data[0].noise_facs_q[e][k] + 1));
+                SoftFloat temp2 = sf_exp2_half(2 * (12 - sbr->data[1].noise_facs_q[e][k]));
+                SoftFloat fac   = sf_div(temp1, sf_add(SF_ONE, temp2));
+                sbr->data[0].noise_facs[e][k] = fac;
+                sbr->data[1].noise_facs[e][k] = sf_mul(fac, temp2);
+            }
+        }
+    } else { // SCE or one non-coupled CPE
+        for (ch = 0; ch < (id_aac == TYPE_CPE) + 1; ch++) {
+            int alpha = sbr->data[ch].bs_amp_res ? 2 : 1;
+            for (e = 1; e <= sbr->data[ch].bs_num_env; e++)
+                for (k = 0; k < sbr->n[sbr->data[ch].bs_freq_res[e]]; k++)
+                    sbr->data[ch].env_facs[e][k] =
+                        sf_exp2_half(alpha * sbr->data[ch].env_facs_q[e][k] + 2 * (6 + 10));
+            for (e = 1; e <= sbr->data[ch].bs_num_noise; e++)
+                for (k = 0; k < sbr->n_q; k++)
+                    sbr->data[ch].noise_facs[e][k] =
+                        sf_exp2_half(2 * (NOISE_FLOOR_OFFSET - sbr->data[ch].noise_facs_q[e][k]));
+        }
+    }
+}
+
+/**
+ * Analysis QMF Bank (14496-3 sp04 p206)
+ *
+ * @param   x       pointer to the beginning of the first sample window
+ * @param   W       array of complex-valued samples split into subbands
+ */
+static void sbr_qmf_analysis(AACContext *ac, FFTContext *mdct,
+                             SBRDSPContext *sbrdsp, const int *in, int *x,
+                             int z[320], int W[2][32][32][2], int buf_idx)
+{
+    int i, n;
+    memcpy(x, x+1024, (320-32)*sizeof(x[0]));
+    /* 4 times the 16-bit range, the transform needs the headroom */
+    for (i = 0; i < 1024; i++)
+        x[288 + i] = av_clip(in[i], -(1 << 24), 1 << 24);
+    for (i = 0; i < 32; i++) { // numTimeSlots*RATE = 16*2 as 960 sample frames
+                               // are not supported
+        for (n = 0; n < 320; n++)
+            z[n] = ((int64_t)sbr_qmf_window_ds[n] * x[319 - n] + 0x40000000) >> 31;
+        sbrdsp->sum64x5(z);
+        sbrdsp->qmf_pre_shuffle(z);
+        mdct->imdct_half(mdct, z, z+64);
+        sbrdsp->qmf_post_shuffle(W[buf_idx][i], z);
+        x += 32;
+    }
+}
+
+/**
+ * Synthesis QMF Bank (14496-3 sp04 p206) and Downsampled Synthesis QMF Bank
+ * (14496-3 sp04 p206)
+ */
+static void sbr_qmf_synthesis(AACContext *ac, FFTContext *mdct,
+                              SBRDSPContext *sbrdsp,
+                              int *out, int X[2][38][64],
+                              int mdct_buf[2][64],
+                              int *v0, int *v_off, const unsigned int div)
+{
+    static const int v_pos[10] = { 0, 192, 256, 448, 512, 704, 768, 960, 1024, 1216 };
+    int i, j, n;
+    const int *sbr_qmf_window = div ? sbr_qmf_window_ds : sbr_qmf_window_us;
+    const int step = 128 >> div;
+    int *v;
+    for (i = 0; i < 32; i++) {
+        if (*v_off < step) {
+            int saved_samples = (1280 - 128) >> div;
+            memcpy(&v0[SBR_SYNTHESIS_BUF_SIZE - saved_samples], v0, saved_samples * sizeof(int));
+            *v_off = SBR_SYNTHESIS_BUF_SIZE - saved_samples - step;
+        } else {
+            *v_off -= step;
+        }
+        v = v0 + *v_off;
+        /* the transform needs log2(64) bits of headroom */
+        for (n = 0; n < 64; n++) {
+            X[0][i][n] = av_clip(X[0][i][n], -(1 << 28), 1 << 28);
+            X[1][i][n] = av_clip(X[1][i][n], -(1 << 28), 1 << 28);
+        }
+        if (div) {
+            for (n = 0; n < 32; n++) {
+                X[0][i][   n] = -X[0][i][n];
+                X[0][i][32+n] =  X[1][i][31-n];
+            }
+            mdct->imdct_half(mdct, mdct_buf[0], X[0][i]);
+            sbrdsp->qmf_deint_neg(v, mdct_buf[0]);
+        } else {
+            sbrdsp->neg_odd_64(X[1][i]);
+            mdct->imdct_half(mdct, mdct_buf[0], X[0][i]);
+            mdct->imdct_half(mdct, mdct_buf[1], X[1][i]);
+            sbrdsp->qmf_deint_bfly(v, mdct_buf[1], mdct_buf[0]);
+        }
+        /* the Q31 window scales back to 1 << 22 */
+        for (n = 0; n < 64 >> div; n++) {
+            int64_t sum = 0;
+            for (j = 0; j < 10; j++)
+                sum += (int64_t)v[(v_pos[j] >> div) + n] *
+                       sbr_qmf_window[(j << (6 - div)) + n];
+            out[n] = av_clipl_int32((sum + 0x10000000) >> 29);
+        }
+        out += 64 >> div;
+    }
+}
+
+/** High Frequency Generation (14496-3 sp04 p214+) and Inverse Filtering
+ * (14496-3 sp04 p214)
+ */
+static void sbr_hf_inverse_filter(SBRDSPContext *dsp,
+                                  int (*alpha0)[2], int (*alpha1)[2],
+                                  const int X_low[32][40][2], int k0)
+{
+    /* 1 / 1.000001 */
+    static const SoftFloat dk_bias = { 1073740750, -1 };
+    static const SoftFloat alpha_max = { 1 << SF_ONE_BITS, 4 };
+    int k;
+    for (k = 0; k < k0; k++) {
+        LOCAL_ALIGNED_16(SoftFloat, phi, [3], [2][2]);
+        SoftFloat dk, a0[2], a1[2];
+
+        dsp->autocorrelate(X_low[k], phi);
+
+        dk = sf_sub(sf_mul(phi[2][1][0], phi[1][0][0]),
+                    sf_mul(sf_add(sf_mul(phi[1][1][0], phi[1][1][0]),
+                                  sf_mul(phi[1][1][1], phi[1][1][1])), dk_bias));
+
+        if (!dk.mant) {
+            a1[0] = SF_ZERO;
+            a1[1] = SF_ZERO;
+        } else {
+            SoftFloat temp_real, temp_im;
+            temp_real = sf_sub(sf_sub(sf_mul(phi[0][0][0], phi[1][1][0]),
+                                      sf_mul(phi[0][0][1], phi[1][1][1])),
+                               sf_mul(phi[0][1][0], phi[1][0][0]));
+            temp_im   = sf_sub(sf_add(sf_mul(phi[0][0][0], phi[1][1][1]),
+                                      sf_mul(phi[0][0][1], phi[1][1][0])),
+                               sf_mul(phi[0][1][1], phi[1][0][0]));
+
+            a1[0] = sf_div(temp_real, dk);
+            a1[1] = sf_div(temp_im,   dk);
+        }
+
+        if (!phi[1][0][0].mant) {
+            a0[0] = SF_ZERO;
+            a0[1] = SF_ZERO;
+        } else {
+            SoftFloat temp_real, temp_im;
+            temp_real = sf_add(sf_add(phi[0][0][0], sf_mul(a1[0], phi[1][1][0])),
+                                                    sf_mul(a1[1], phi[1][1][1]));
+            temp_im   = sf_sub(sf_add(phi[0][0][1], sf_mul(a1[1], phi[1][1][0])),
+                                                    sf_mul(a1[0], phi[1][1][1]));
+
+            a0[0] = sf_div(temp_real, phi[1][0][0]);
+            a0[1] = sf_div(temp_im,   phi[1][0][0]);
+            a0[0].mant = -a0[0].mant;
+            a0[1].mant = -a0[1].mant;
+        }
+
+        if (!sf_gt(alpha_max, sf_add(sf_mul(a1[0], a1[0]), sf_mul(a1[1], a1[1]))) ||
+            !sf_gt(alpha_max, sf_add(sf_mul(a0[0], a0[0]), sf_mul(a0[1], a0[1])))) {
+            alpha1[k][0] = 0;
+            alpha1[k][1] = 0;
+            alpha0[k][0] = 0;
+            alpha0[k][1] = 0;
+        } else {
+            alpha1[k][0] = sf_to_fixed(a1[0], 29);
+            alpha1[k][1] = sf_to_fixed(a1[1], 29);
+            alpha0[k][0] = sf_to_fixed(a0[0], 29);
+            alpha0[k][1] = sf_to_fixed(a0[1], 29);
+        }
+    }
+}
+
+/// Chirp Factors (14496-3 sp04 p214)
+static void sbr_chirp(SpectralBandReplication *sbr, SBRData *ch_data)
+{
+    int i;
+    int new_bw;
+    static const int bw_tab[] = { 0, Q31(0.75f), Q31(0.9f), Q31(0.98f) };
+
+    for (i = 0; i < sbr->n_q; i++) {
+        if (ch_data->bs_invf_mode[0][i] + ch_data->bs_invf_mode[1][i] == 1) {
+            new_bw = Q31(0.6f);
+        } else
+            new_bw = bw_tab[ch_data->bs_invf_mode[0][i]];
+
+        if (new_bw < ch_data->bw_array[i]) {
+            new_bw = AAC_MUL31(Q31(0.75f),    new_bw) + AAC_MUL31(Q31(0.25f),    ch_data->bw_array[i]);
+        } else
+            new_bw = AAC_MUL31(Q31(0.90625f), new_bw) + AAC_MUL31(Q31(0.09375f), ch_data->bw_array[i]);
+        ch_data->bw_array[i] = new_bw < Q31(0.015625f) ? 0 : new_bw;
+    }
+}
+
+/// Estimation of current envelope (14496-3 sp04 p218)
+static void sbr_env_estimate(SoftFloat (*e_curr)[48], int X_high[64][40][2],
+                             SpectralBandReplication *sbr, SBRData *ch_data)
+{
+    int e, m;
+    int kx1 = sbr->kx[1];
+
+    if (sbr->bs_interpol_freq) {
+        for (e = 0; e < ch_data->bs_num_env; e++) {
+            const SoftFloat env_size = sf_from_int(2 * (ch_data->t_env[e + 1] - ch_data->t_env[e]));
+            int ilb = ch_data->t_env[e]     * 2 + ENVELOPE_ADJUSTMENT_OFFSET;
+            int iub = ch_data->t_env[e + 1] * 2 + ENVELOPE_ADJUSTMENT_OFFSET;
+
+            for (m = 0; m < sbr->m[1]; m++) {
+                SoftFloat sum = sbr->dsp.sum_square(X_high[m+kx1] + ilb, iub - ilb);
+                e_curr[e][m] = sf_div(sum, env_size);
+            }
+        }
+    } else {
+        int k, p;
+
+        for (e = 0; e < ch_data->bs_num_env; e++) {
+            const int env_size = 2 * (ch_data->t_env[e + 1] - ch_data->t_env[e]);
+            int ilb = ch_data->t_env[e]     * 2 + ENVELOPE_ADJUSTMENT_OFFSET;
+            int iub = ch_data->t_env[e + 1] * 2 + ENVELOPE_ADJUSTMENT_OFFSET;
+            const uint16_t *table = ch_data->bs_freq_res[e + 1] ? sbr->f_tablehigh : sbr->f_tablelow;
+
+            for (p = 0; p < sbr->n[ch_data->bs_freq_res[e + 1]]; p++) {
+                SoftFloat sum = SF_ZERO;
+                const int den = env_size * (table[p + 1] - table[p]);
+
+                for (k = table[p]; k < table[p + 1]; k++) {
+                    sum = sf_add(sum, sbr->dsp.sum_square(X_high[k] + ilb, iub - ilb));
+                }
+                sum = sf_div(sum, sf_from_int(den));
+                for (k = table[p]; k < table[p + 1]; k++) {
+                    e_curr[e][k - kx1] = sum;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Calculation of levels of additional HF signal components (14496-3 sp04 p219)
+ * and Calculation of gain (14496-3 sp04 p219)
+ */
+static void sbr_gain_calc(AACContext *ac, SpectralBandReplication *sbr,
+                          SBRData *ch_data, const int e_a[2])
+{
+    int e, k, m;
+    // max gain limits : -3dB, 0dB, 3dB, inf dB (limiter off)
+    static const SoftFloat limgain[4] = {
+        { 760155524, -1 }, { 536870912, 0 }, { 758351638, 0 }, { 625000000, 33 },
+    };
+    static const SoftFloat max_gain   = { 819200000, 16 }; // 100000
+    static const SoftFloat max_boost  = { 850883053,  0 }; // 1.584893192
+    // 1.0 and FLT_EPSILON in the energy domain
+    const SoftFloat one_e = sf_exp2_half(2 * 10);
+    const SoftFloat eps   = sf_exp2_half(2 * (-23 + 10));
+
+    for (e = 0; e < ch_data->bs_num_env; e++) {
+        int delta = !((e == e_a[1]) || (e == e_a[0]));
+        for (k = 0; k < sbr->n_lim; k++) {
+            SoftFloat gain_boost, gain_max;
+            SoftFloat sum[2] = { SF_ZERO, SF_ZERO };
+            for (m = sbr->f_tablelim[k] - sbr->kx[1]; m < sbr->f_tablelim[k + 1] - sbr->kx[1]; m++) {
+                const SoftFloat temp = sf_div(sbr->e_origmapped[e][m], sf_add(SF_ONE, sbr->q_mapped[e][m]));
+                sbr->q_m[e][m] = sf_sqrt(sf_mul(temp, sbr->q_mapped[e][m]));
+                sbr->s_m[e][m] = ch_data->s_indexmapped[e + 1][m] ? sf_sqrt(temp) : SF_ZERO;
+                if (!sbr->s_mapped[e][m]) {
+                    sbr->gain[e][m] = sf_sqrt(sf_div(sbr->e_origmapped[e][m],
+                                                     sf_mul(sf_add(one_e, sbr->e_curr[e][m]),
+                                                            delta ? sf_add(SF_ONE, sbr->q_mapped[e][m]) : SF_ONE)));
+                } else {
+                    sbr->gain[e][m] = sf_sqrt(sf_div(sf_mul(sbr->e_origmapped[e][m], sbr->q_mapped[e][m]),
+                                                     sf_mul(sf_add(one_e, sbr->e_curr[e][m]),
+                                                            sf_add(SF_ONE, sbr->q_mapped[e][m]))));
+                }
+            }
+            for (m = sbr->f_tablelim[k] - sbr->kx[1]; m < sbr->f_tablelim[k + 1] - sbr->kx[1]; m++) {
+                sum[0] = sf_add(sum[0], sbr->e_origmapped[e][m]);
+                sum[1] = sf_add(sum[1], sbr->e_curr[e][m]);
+            }
+            gain_max = sf_mul(limgain[sbr->bs_limiter_gains],
+                              sf_sqrt(sf_div(sf_add(eps, sum[0]), sf_add(eps, sum[1]))));
+            gain_max = sf_min(max_gain, gain_max);
+            for (m = sbr->f_tablelim[k] - sbr->kx[1]; m < sbr->f_tablelim[k + 1] - sbr->kx[1]; m++) {
+                SoftFloat q_m_max = sf_div(sf_mul(sbr->q_m[e][m], gain_max), sbr->gain[e][m]);
+                sbr->q_m[e][m]  = sf_min(sbr->q_m[e][m], q_m_max);
+                sbr->gain[e][m] = sf_min(sbr->gain[e][m], gain_max);
+            }
+            sum[0] = sum[1] = SF_ZERO;
+            for (m = sbr->f_tablelim[k] - sbr->kx[1]; m < sbr->f_tablelim[k + 1] - sbr->kx[1]; m++) {
+                sum[0] = sf_add(sum[0], sbr->e_origmapped[e][m]);
+                sum[1] = sf_add(sum[1], sf_mul(sbr->e_curr[e][m],
+                                               sf_mul(sbr->gain[e][m], sbr->gain[e][m])));
+                sum[1] = sf_add(sum[1], sf_mul(sbr->s_m[e][m], sbr->s_m[e][m]));
+                if (delta && !sbr->s_m[e][m].mant)
+                    sum[1] = sf_add(sum[1], sf_mul(sbr->q_m[e][m], sbr->q_m[e][m]));
+            }
+            gain_boost = sf_sqrt(sf_div(sf_add(eps, sum[0]), sf_add(eps, sum[1])));
+            gain_boost = sf_min(max_boost, gain_boost);
+            for (m = sbr->f_tablelim[k] - sbr->kx[1]; m < sbr->f_tablelim[k + 1] - sbr->kx[1]; m++) {
+                sbr->gain[e][m] = sf_mul(sbr->gain[e][m], gain_boost);
+                sbr->q_m[e][m]  = sf_mul(sbr->q_m[e][m],  gain_boost);
+                sbr->s_m[e][m]  = sf_mul(sbr->s_m[e][m],  gain_boost);
+            }
+        }
+    }
+}
+
+static void sbr_smooth(SoftFloat *filt, SoftFloat (*temp)[48], int idx, int m_max)
+{
+    static const SoftFloat h_smooth[5] = {
+        { 715827883, -2 }, // 0.33333333333333
+        { 647472402, -2 }, // 0.30150283239582
+        { 937030863, -3 }, // 0.21816949906249
+        { 989249804, -4 }, // 0.11516383427084
+        { 546843842, -5 }, // 0.03183050093751
+    };
+    int j, m;
+
+    for (m = 0; m < m_max; m++) {
+        filt[m] = SF_ZERO;
+        for (j = 0; j <= 4; j++)
+            filt[m] = sf_add(filt[m], sf_mul(temp[idx - j][m], h_smooth[j]));
+    }
+}
+
+static av_always_inline int sbr_level(SoftFloat level)
+{
+    return sf_to_fixed(level, 0);
+}
+
+#include "aacsbr_template.c"
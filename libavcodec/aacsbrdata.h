@@ -30,6 +30,7 @@
 
 #include <stdint.h>
 #include "libavutil/mem.h"
+#include "aac_defines.h"
 
 ///< Huffman tables for SBR
 
@@ -267,350 +268,350 @@ static const int8_t sbr_offset[6][16] = {
 };
 
 ///< window coefficients for analysis/synthesis QMF banks
-static DECLARE_ALIGNED(32, float, sbr_qmf_window_ds)[320];
-static DECLARE_ALIGNED(32, float, sbr_qmf_window_us)[640] = {
-     0.0000000000, -0.0005525286, -0.0005617692, -0.0004947518,
-    -0.0004875227, -0.0004893791, -0.0005040714, -0.0005226564,
-    -0.0005466565, -0.0005677802, -0.0005870930, -0.0006132747,
-    -0.0006312493, -0.0006540333, -0.0006777690, -0.0006941614,
-    -0.0007157736, -0.0007255043, -0.0007440941, -0.0007490598,
-    -0.0007681371, -0.0007724848, -0.0007834332, -0.0007779869,
-    -0.0007803664, -0.0007801449, -0.0007757977, -0.0007630793,
-    -0.0007530001, -0.0007319357, -0.0007215391, -0.0006917937,
-    -0.0006650415, -0.0006341594, -0.0005946118, -0.0005564576,
-    -0.0005145572, -0.0004606325, -0.0004095121, -0.0003501175,
-    -0.0002896981, -0.0002098337, -0.0001446380, -0.0000617334,
-     0.0000134949,  0.0001094383,  0.0002043017,  0.0002949531,
-     0.0004026540,  0.0005107388,  0.0006239376,  0.0007458025,
-     0.0008608443,  0.0009885988,  0.0011250155,  0.0012577884,
-     0.0013902494,  0.0015443219,  0.0016868083,  0.0018348265,
-     0.0019841140,  0.0021461583,  0.0023017254,  0.0024625616,
-     0.0026201758,  0.0027870464,  0.0029469447,  0.0031125420,
-     0.0032739613,  0.0034418874,  0.0036008268,  0.0037603922,
-     0.0039207432,  0.0040819753,  0.0042264269,  0.0043730719,
-     0.0045209852,  0.0046606460,  0.0047932560,  0.0049137603,
-     0.0050393022,  0.0051407353,  0.0052461166,  0.0053471681,
-     0.0054196775,  0.0054876040,  0.0055475714,  0.0055938023,
-     0.0056220643,  0.0056455196,  0.0056389199,  0.0056266114,
-     0.0055917128,  0.0055404363,  0.0054753783,  0.0053838975,
-     0.0052715758,  0.0051382275,  0.0049839687,  0.0048109469,
-     0.0046039530,  0.0043801861,  0.0041251642,  0.0038456408,
-     0.0035401246,  0.0032091885,  0.0028446757,  0.0024508540,
-     0.0020274176,  0.0015784682,  0.0010902329,  0.0005832264,
-     0.0000276045, -0.0005464280, -0.0011568135, -0.0018039472,
-    -0.0024826723, -0.0031933778, -0.0039401124, -0.0047222596,
-    -0.0055337211, -0.0063792293, -0.0072615816, -0.0081798233,
-    -0.0091325329, -0.0101150215, -0.0111315548, -0.0121849995,
-     0.0132718220,  0.0143904666,  0.0155405553,  0.0167324712,
-     0.0179433381,  0.0191872431,  0.0204531793,  0.0217467550,
-     0.0230680169,  0.0244160992,  0.0257875847,  0.0271859429,
-     0.0286072173,  0.0300502657,  0.0315017608,  0.0329754081,
-     0.0344620948,  0.0359697560,  0.0374812850,  0.0390053679,
-     0.0405349170,  0.0420649094,  0.0436097542,  0.0451488405,
-     0.0466843027,  0.0482165720,  0.0497385755,  0.0512556155,
-     0.0527630746,  0.0542452768,  0.0557173648,  0.0571616450,
-     0.0585915683,  0.0599837480,  0.0613455171,  0.0626857808,
-     0.0639715898,  0.0652247106,  0.0664367512,  0.0676075985,
-     0.0687043828,  0.0697630244,  0.0707628710,  0.0717002673,
-     0.0725682583,  0.0733620255,  0.0741003642,  0.0747452558,
-     0.0753137336,  0.0758008358,  0.0761992479,  0.0764992170,
-     0.0767093490,  0.0768173975,  0.0768230011,  0.0767204924,
-     0.0765050718,  0.0761748321,  0.0757305756,  0.0751576255,
-     0.0744664394,  0.0736406005,  0.0726774642,  0.0715826364,
-     0.0703533073,  0.0689664013,  0.0674525021,  0.0657690668,
-     0.0639444805,  0.0619602779,  0.0598166570,  0.0575152691,
-     0.0550460034,  0.0524093821,  0.0495978676,  0.0466303305,
-     0.0434768782,  0.0401458278,  0.0366418116,  0.0329583930,
-     0.0290824006,  0.0250307561,  0.0207997072,  0.0163701258,
-     0.0117623832,  0.0069636862,  0.0019765601, -0.0032086896,
-    -0.0085711749, -0.0141288827, -0.0198834129, -0.0258227288,
-    -0.0319531274, -0.0382776572, -0.0447806821, -0.0514804176,
-    -0.0583705326, -0.0654409853, -0.0726943300, -0.0801372934,
-    -0.0877547536, -0.0955533352, -0.1035329531, -0.1116826931,
-    -0.1200077984, -0.1285002850, -0.1371551761, -0.1459766491,
-    -0.1549607071, -0.1640958855, -0.1733808172, -0.1828172548,
-    -0.1923966745, -0.2021250176, -0.2119735853, -0.2219652696,
-    -0.2320690870, -0.2423016884, -0.2526480309, -0.2631053299,
-    -0.2736634040, -0.2843214189, -0.2950716717, -0.3059098575,
-    -0.3168278913, -0.3278113727, -0.3388722693, -0.3499914122,
-     0.3611589903,  0.3723795546,  0.3836350013,  0.3949211761,
-     0.4062317676,  0.4175696896,  0.4289119920,  0.4402553754,
-     0.4515996535,  0.4629308085,  0.4742453214,  0.4855253091,
-     0.4967708254,  0.5079817500,  0.5191234970,  0.5302240895,
-     0.5412553448,  0.5522051258,  0.5630789140,  0.5738524131,
-     0.5845403235,  0.5951123086,  0.6055783538,  0.6159109932,
-     0.6261242695,  0.6361980107,  0.6461269695,  0.6559016302,
-     0.6655139880,  0.6749663190,  0.6842353293,  0.6933282376,
-     0.7022388719,  0.7109410426,  0.7194462634,  0.7277448900,
-     0.7358211758,  0.7436827863,  0.7513137456,  0.7587080760,
-     0.7658674865,  0.7727780881,  0.7794287519,  0.7858353120,
-     0.7919735841,  0.7978466413,  0.8034485751,  0.8087695004,
-     0.8138191270,  0.8185776004,  0.8230419890,  0.8272275347,
-     0.8311038457,  0.8346937361,  0.8379717337,  0.8409541392,
-     0.8436238281,  0.8459818469,  0.8480315777,  0.8497805198,
-     0.8511971524,  0.8523047035,  0.8531020949,  0.8535720573,
-     0.8537385600,
+static DECLARE_ALIGNED(32, INTFLOAT, sbr_qmf_window_ds)[320];
+static DECLARE_ALIGNED(32, INTFLOAT, sbr_qmf_window_us)[640] = {
+    Q31( 0.0000000000), Q31(-0.0005525286), Q31(-0.0005617692), Q31(-0.0004947518),
+    Q31(-0.0004875227), Q31(-0.0004893791), Q31(-0.0005040714), Q31(-0.0005226564),
+    Q31(-0.0005466565), Q31(-0.0005677802), Q31(-0.0005870930), Q31(-0.0006132747),
+    Q31(-0.0006312493), Q31(-0.0006540333), Q31(-0.0006777690), Q31(-0.0006941614),
+    Q31(-0.0007157736), Q31(-0.0007255043), Q31(-0.0007440941), Q31(-0.0007490598),
+    Q31(-0.0007681371), Q31(-0.0007724848), Q31(-0.0007834332), Q31(-0.0007779869),
+    Q31(-0.0007803664), Q31(-0.0007801449), Q31(-0.0007757977), Q31(-0.0007630793),
+    Q31(-0.0007530001), Q31(-0.0007319357), Q31(-0.0007215391), Q31(-0.0006917937),
+    Q31(-0.0006650415), Q31(-0.0006341594), Q31(-0.0005946118), Q31(-0.0005564576),
+    Q31(-0.0005145572), Q31(-0.0004606325), Q31(-0.0004095121), Q31(-0.0003501175),
+    Q31(-0.0002896981), Q31(-0.0002098337), Q31(-0.0001446380), Q31(-0.0000617334),
+    Q31( 0.0000134949), Q31( 0.0001094383), Q31( 0.0002043017), Q31( 0.0002949531),
+    Q31( 0.0004026540), Q31( 0.0005107388), Q31( 0.0006239376), Q31( 0.0007458025),
+    Q31( 0.0008608443), Q31( 0.0009885988), Q31( 0.0011250155), Q31( 0.0012577884),
+    Q31( 0.0013902494), Q31( 0.0015443219), Q31( 0.0016868083), Q31( 0.0018348265),
+    Q31( 0.0019841140), Q31( 0.0021461583), Q31( 0.0023017254), Q31( 0.0024625616),
+    Q31( 0.0026201758), Q31( 0.0027870464), Q31( 0.0029469447), Q31( 0.0031125420),
+    Q31( 0.0032739613), Q31( 0.0034418874), Q31( 0.0036008268), Q31( 0.0037603922),
+    Q31( 0.0039207432), Q31( 0.0040819753), Q31( 0.0042264269), Q31( 0.0043730719),
+    Q31( 0.0045209852), Q31( 0.0046606460), Q31( 0.0047932560), Q31( 0.0049137603),
+    Q31( 0.0050393022), Q31( 0.0051407353), Q31( 0.0052461166), Q31( 0.0053471681),
+    Q31( 0.0054196775), Q31( 0.0054876040), Q31( 0.0055475714), Q31( 0.0055938023),
+    Q31( 0.0056220643), Q31( 0.0056455196), Q31( 0.0056389199), Q31( 0.0056266114),
+    Q31( 0.0055917128), Q31( 0.0055404363), Q31( 0.0054753783), Q31( 0.0053838975),
+    Q31( 0.0052715758), Q31( 0.0051382275), Q31( 0.0049839687), Q31( 0.0048109469),
+    Q31( 0.0046039530), Q31( 0.0043801861), Q31( 0.0041251642), Q31( 0.0038456408),
+    Q31( 0.0035401246), Q31( 0.0032091885), Q31( 0.0028446757), Q31( 0.0024508540),
+    Q31( 0.0020274176), Q31( 0.0015784682), Q31( 0.0010902329), Q31( 0.0005832264),
+    Q31( 0.0000276045), Q31(-0.0005464280), Q31(-0.0011568135), Q31(-0.0018039472),
+    Q31(-0.0024826723), Q31(-0.0031933778), Q31(-0.0039401124), Q31(-0.0047222596),
+    Q31(-0.0055337211), Q31(-0.0063792293), Q31(-0.0072615816), Q31(-0.0081798233),
+    Q31(-0.0091325329), Q31(-0.0101150215), Q31(-0.0111315548), Q31(-0.0121849995),
+    Q31( 0.0132718220), Q31( 0.0143904666), Q31( 0.0155405553), Q31( 0.0167324712),
+    Q31( 0.0179433381), Q31( 0.0191872431), Q31( 0.0204531793), Q31( 0.0217467550),
+    Q31( 0.0230680169), Q31( 0.0244160992), Q31( 0.0257875847), Q31( 0.0271859429),
+    Q31( 0.0286072173), Q31( 0.0300502657), Q31( 0.0315017608), Q31( 0.0329754081),
+    Q31( 0.0344620948), Q31( 0.0359697560), Q31( 0.0374812850), Q31( 0.0390053679),
+    Q31( 0.0405349170), Q31( 0.0420649094), Q31( 0.0436097542), Q31( 0.0451488405),
+    Q31( 0.0466843027), Q31( 0.0482165720), Q31( 0.0497385755), Q31( 0.0512556155),
+    Q31( 0.0527630746), Q31( 0.0542452768), Q31( 0.0557173648), Q31( 0.0571616450),
+    Q31( 0.0585915683), Q31( 0.0599837480), Q31( 0.0613455171), Q31( 0.0626857808),
+    Q31( 0.0639715898), Q31( 0.0652247106), Q31( 0.0664367512), Q31( 0.0676075985),
+    Q31( 0.0687043828), Q31( 0.0697630244), Q31( 0.0707628710), Q31( 0.0717002673),
+    Q31( 0.0725682583), Q31( 0.0733620255), Q31( 0.0741003642), Q31( 0.0747452558),
+    Q31( 0.0753137336), Q31( 0.0758008358), Q31( 0.0761992479), Q31( 0.0764992170),
+    Q31( 0.0767093490), Q31( 0.0768173975), Q31( 0.0768230011), Q31( 0.0767204924),
+    Q31( 0.0765050718), Q31( 0.0761748321), Q31( 0.0757305756), Q31( 0.0751576255),
+    Q31( 0.0744664394), Q31( 0.0736406005), Q31( 0.0726774642), Q31( 0.0715826364),
+    Q31( 0.0703533073), Q31( 0.0689664013), Q31( 0.0674525021), Q31( 0.0657690668),
+    Q31( 0.0639444805), Q31( 0.0619602779), Q31( 0.0598166570), Q31( 0.0575152691),
+    Q31( 0.0550460034), Q31( 0.0524093821), Q31( 0.0495978676), Q31( 0.0466303305),
+    Q31( 0.0434768782), Q31( 0.0401458278), Q31( 0.0366418116), Q31( 0.0329583930),
+    Q31( 0.0290824006), Q31( 0.0250307561), Q31( 0.0207997072), Q31( 0.0163701258),
+    Q31( 0.0117623832), Q31( 0.0069636862), Q31( 0.0019765601), Q31(-0.0032086896),
+    Q31(-0.0085711749), Q31(-0.0141288827), Q31(-0.0198834129), Q31(-0.0258227288),
+    Q31(-0.0319531274), Q31(-0.0382776572), Q31(-0.0447806821), Q31(-0.0514804176),
+    Q31(-0.0583705326), Q31(-0.0654409853), Q31(-0.0726943300), Q31(-0.0801372934),
+    Q31(-0.0877547536), Q31(-0.0955533352), Q31(-0.1035329531), Q31(-0.1116826931),
+    Q31(-0.1200077984), Q31(-0.1285002850), Q31(-0.1371551761), Q31(-0.1459766491),
+    Q31(-0.1549607071), Q31(-0.1640958855), Q31(-0.1733808172), Q31(-0.1828172548),
+    Q31(-0.1923966745), Q31(-0.2021250176), Q31(-0.2119735853), Q31(-0.2219652696),
+    Q31(-0.2320690870), Q31(-0.2423016884), Q31(-0.2526480309), Q31(-0.2631053299),
+    Q31(-0.2736634040), Q31(-0.2843214189), Q31(-0.2950716717), Q31(-0.3059098575),
+    Q31(-0.3168278913), Q31(-0.3278113727), Q31(-0.3388722693), Q31(-0.3499914122),
+    Q31( 0.3611589903), Q31( 0.3723795546), Q31( 0.3836350013), Q31( 0.3949211761),
+    Q31( 0.4062317676), Q31( 0.4175696896), Q31( 0.4289119920), Q31( 0.4402553754),
+    Q31( 0.4515996535), Q31( 0.4629308085), Q31( 0.4742453214), Q31( 0.4855253091),
+    Q31( 0.4967708254), Q31( 0.5079817500), Q31( 0.5191234970), Q31( 0.5302240895),
+    Q31( 0.5412553448), Q31( 0.5522051258), Q31( 0.5630789140), Q31( 0.5738524131),
+    Q31( 0.5845403235), Q31( 0.5951123086), Q31( 0.6055783538), Q31( 0.6159109932),
+    Q31( 0.6261242695), Q31( 0.6361980107), Q31( 0.6461269695), Q31( 0.6559016302),
+    Q31( 0.6655139880), Q31( 0.6749663190), Q31( 0.6842353293), Q31( 0.6933282376),
+    Q31( 0.7022388719), Q31( 0.7109410426), Q31( 0.7194462634), Q31( 0.7277448900),
+    Q31( 0.7358211758), Q31( 0.7436827863), Q31( 0.7513137456), Q31( 0.7587080760),
+    Q31( 0.7658674865), Q31( 0.7727780881), Q31( 0.7794287519), Q31( 0.7858353120),
+    Q31( 0.7919735841), Q31( 0.7978466413), Q31( 0.8034485751), Q31( 0.8087695004),
+    Q31( 0.8138191270), Q31( 0.8185776004), Q31( 0.8230419890), Q31( 0.8272275347),
+    Q31( 0.8311038457), Q31( 0.8346937361), Q31( 0.8379717337), Q31( 0.8409541392),
+    Q31( 0.8436238281), Q31( 0.8459818469), Q31( 0.8480315777), Q31( 0.8497805198),
+    Q31( 0.8511971524), Q31( 0.8523047035), Q31( 0.8531020949), Q31( 0.8535720573),
+    Q31( 0.8537385600),
 };
 
 /* First two entries repeated at end to simplify SIMD implementations. */
-const DECLARE_ALIGNED(16, float, ff_sbr_noise_table)[][2] = {
-{-0.99948153278296, -0.59483417516607}, { 0.97113454393991, -0.67528515225647},
-{ 0.14130051758487, -0.95090983575689}, {-0.47005496701697, -0.37340549728647},
-{ 0.80705063769351,  0.29653668284408}, {-0.38981478896926,  0.89572605717087},
-{-0.01053049862020, -0.66959058036166}, {-0.91266367957293, -0.11522938140034},
-{ 0.54840422910309,  0.75221367176302}, { 0.40009252867955, -0.98929400334421},
-{-0.99867974711855, -0.88147068645358}, {-0.95531076805040,  0.90908757154593},
-{-0.45725933317144, -0.56716323646760}, {-0.72929675029275, -0.98008272727324},
-{ 0.75622801399036,  0.20950329995549}, { 0.07069442601050, -0.78247898470706},
-{ 0.74496252926055, -0.91169004445807}, {-0.96440182703856, -0.94739918296622},
-{ 0.30424629369539, -0.49438267012479}, { 0.66565033746925,  0.64652935542491},
-{ 0.91697008020594,  0.17514097332009}, {-0.70774918760427,  0.52548653416543},
-{-0.70051415345560, -0.45340028808763}, {-0.99496513054797, -0.90071908066973},
-{ 0.98164490790123, -0.77463155528697}, {-0.54671580548181, -0.02570928536004},
-{-0.01689629065389,  0.00287506445732}, {-0.86110349531986,  0.42548583726477},
-{-0.98892980586032, -0.87881132267556}, { 0.51756627678691,  0.66926784710139},
-{-0.99635026409640, -0.58107730574765}, {-0.99969370862163,  0.98369989360250},
-{ 0.55266258627194,  0.59449057465591}, { 0.34581177741673,  0.94879421061866},
-{ 0.62664209577999, -0.74402970906471}, {-0.77149701404973, -0.33883658042801},
-{-0.91592244254432,  0.03687901376713}, {-0.76285492357887, -0.91371867919124},
-{ 0.79788337195331, -0.93180971199849}, { 0.54473080610200, -0.11919206037186},
-{-0.85639281671058,  0.42429854760451}, {-0.92882402971423,  0.27871809078609},
-{-0.11708371046774, -0.99800843444966}, { 0.21356749817493, -0.90716295627033},
-{-0.76191692573909,  0.99768118356265}, { 0.98111043100884, -0.95854459734407},
-{-0.85913269895572,  0.95766566168880}, {-0.93307242253692,  0.49431757696466},
-{ 0.30485754879632, -0.70540034357529}, { 0.85289650925190,  0.46766131791044},
-{ 0.91328082618125, -0.99839597361769}, {-0.05890199924154,  0.70741827819497},
-{ 0.28398686150148,  0.34633555702188}, { 0.95258164539612, -0.54893416026939},
-{-0.78566324168507, -0.75568541079691}, {-0.95789495447877, -0.20423194696966},
-{ 0.82411158711197,  0.96654618432562}, {-0.65185446735885, -0.88734990773289},
-{-0.93643603134666,  0.99870790442385}, { 0.91427159529618, -0.98290505544444},
-{-0.70395684036886,  0.58796798221039}, { 0.00563771969365,  0.61768196727244},
-{ 0.89065051931895,  0.52783352697585}, {-0.68683707712762,  0.80806944710339},
-{ 0.72165342518718, -0.69259857349564}, {-0.62928247730667,  0.13627037407335},
-{ 0.29938434065514, -0.46051329682246}, {-0.91781958879280, -0.74012716684186},
-{ 0.99298717043688,  0.40816610075661}, { 0.82368298622748, -0.74036047190173},
-{-0.98512833386833, -0.99972330709594}, {-0.95915368242257, -0.99237800466040},
-{-0.21411126572790, -0.93424819052545}, {-0.68821476106884, -0.26892306315457},
-{ 0.91851997982317,  0.09358228901785}, {-0.96062769559127,  0.36099095133739},
-{ 0.51646184922287, -0.71373332873917}, { 0.61130721139669,  0.46950141175917},
-{ 0.47336129371299, -0.27333178296162}, { 0.90998308703519,  0.96715662938132},
-{ 0.44844799194357,  0.99211574628306}, { 0.66614891079092,  0.96590176169121},
-{ 0.74922239129237, -0.89879858826087}, {-0.99571588506485,  0.52785521494349},
-{ 0.97401082477563, -0.16855870075190}, { 0.72683747733879, -0.48060774432251},
-{ 0.95432193457128,  0.68849603408441}, {-0.72962208425191, -0.76608443420917},
-{-0.85359479233537,  0.88738125901579}, {-0.81412430338535, -0.97480768049637},
-{-0.87930772356786,  0.74748307690436}, {-0.71573331064977, -0.98570608178923},
-{ 0.83524300028228,  0.83702537075163}, {-0.48086065601423, -0.98848504923531},
-{ 0.97139128574778,  0.80093621198236}, { 0.51992825347895,  0.80247631400510},
-{-0.00848591195325, -0.76670128000486}, {-0.70294374303036,  0.55359910445577},
-{-0.95894428168140, -0.43265504344783}, { 0.97079252950321,  0.09325857238682},
-{-0.92404293670797,  0.85507704027855}, {-0.69506469500450,  0.98633412625459},
-{ 0.26559203620024,  0.73314307966524}, { 0.28038443336943,  0.14537913654427},
-{-0.74138124825523,  0.99310339807762}, {-0.01752795995444, -0.82616635284178},
-{-0.55126773094930, -0.98898543862153}, { 0.97960898850996, -0.94021446752851},
-{-0.99196309146936,  0.67019017358456}, {-0.67684928085260,  0.12631491649378},
-{ 0.09140039465500, -0.20537731453108}, {-0.71658965751996, -0.97788200391224},
-{ 0.81014640078925,  0.53722648362443}, { 0.40616991671205, -0.26469008598449},
-{-0.67680188682972,  0.94502052337695}, { 0.86849774348749, -0.18333598647899},
-{-0.99500381284851, -0.02634122068550}, { 0.84329189340667,  0.10406957462213},
-{-0.09215968531446,  0.69540012101253}, { 0.99956173327206, -0.12358542001404},
-{-0.79732779473535, -0.91582524736159}, { 0.96349973642406,  0.96640458041000},
-{-0.79942778496547,  0.64323902822857}, {-0.11566039853896,  0.28587846253726},
-{-0.39922954514662,  0.94129601616966}, { 0.99089197565987, -0.92062625581587},
-{ 0.28631285179909, -0.91035047143603}, {-0.83302725605608, -0.67330410892084},
-{ 0.95404443402072,  0.49162765398743}, {-0.06449863579434,  0.03250560813135},
-{-0.99575054486311,  0.42389784469507}, {-0.65501142790847,  0.82546114655624},
-{-0.81254441908887, -0.51627234660629}, {-0.99646369485481,  0.84490533520752},
-{ 0.00287840603348,  0.64768261158166}, { 0.70176989408455, -0.20453028573322},
-{ 0.96361882270190,  0.40706967140989}, {-0.68883758192426,  0.91338958840772},
-{-0.34875585502238,  0.71472290693300}, { 0.91980081243087,  0.66507455644919},
-{-0.99009048343881,  0.85868021604848}, { 0.68865791458395,  0.55660316809678},
-{-0.99484402129368, -0.20052559254934}, { 0.94214511408023, -0.99696425367461},
-{-0.67414626793544,  0.49548221180078}, {-0.47339353684664, -0.85904328834047},
-{ 0.14323651387360, -0.94145598222488}, {-0.29268293575672,  0.05759224927952},
-{ 0.43793861458754, -0.78904969892724}, {-0.36345126374441,  0.64874435357162},
-{-0.08750604656825,  0.97686944362527}, {-0.96495267812511, -0.53960305946511},
-{ 0.55526940659947,  0.78891523734774}, { 0.73538215752630,  0.96452072373404},
-{-0.30889773919437, -0.80664389776860}, { 0.03574995626194, -0.97325616900959},
-{ 0.98720684660488,  0.48409133691962}, {-0.81689296271203, -0.90827703628298},
-{ 0.67866860118215,  0.81284503870856}, {-0.15808569732583,  0.85279555024382},
-{ 0.80723395114371, -0.24717418514605}, { 0.47788757329038, -0.46333147839295},
-{ 0.96367554763201,  0.38486749303242}, {-0.99143875716818, -0.24945277239809},
-{ 0.83081876925833, -0.94780851414763}, {-0.58753191905341,  0.01290772389163},
-{ 0.95538108220960, -0.85557052096538}, {-0.96490920476211, -0.64020970923102},
-{-0.97327101028521,  0.12378128133110}, { 0.91400366022124,  0.57972471346930},
-{-0.99925837363824,  0.71084847864067}, {-0.86875903507313, -0.20291699203564},
-{-0.26240034795124, -0.68264554369108}, {-0.24664412953388, -0.87642273115183},
-{ 0.02416275806869,  0.27192914288905}, { 0.82068619590515, -0.85087787994476},
-{ 0.88547373760759, -0.89636802901469}, {-0.18173078152226, -0.26152145156800},
-{ 0.09355476558534,  0.54845123045604}, {-0.54668414224090,  0.95980774020221},
-{ 0.37050990604091, -0.59910140383171}, {-0.70373594262891,  0.91227665827081},
-{-0.34600785879594, -0.99441426144200}, {-0.68774481731008, -0.30238837956299},
-{-0.26843291251234,  0.83115668004362}, { 0.49072334613242, -0.45359708737775},
-{ 0.38975993093975,  0.95515358099121}, {-0.97757125224150,  0.05305894580606},
-{-0.17325552859616, -0.92770672250494}, { 0.99948035025744,  0.58285545563426},
-{-0.64946246527458,  0.68645507104960}, {-0.12016920576437, -0.57147322153312},
-{-0.58947456517751, -0.34847132454388}, {-0.41815140454465,  0.16276422358861},
-{ 0.99885650204884,  0.11136095490444}, {-0.56649614128386, -0.90494866361587},
-{ 0.94138021032330,  0.35281916733018}, {-0.75725076534641,  0.53650549640587},
-{ 0.20541973692630, -0.94435144369918}, { 0.99980371023351,  0.79835913565599},
-{ 0.29078277605775,  0.35393777921520}, {-0.62858772103030,  0.38765693387102},
-{ 0.43440904467688, -0.98546330463232}, {-0.98298583762390,  0.21021524625209},
-{ 0.19513029146934, -0.94239832251867}, {-0.95476662400101,  0.98364554179143},
-{ 0.93379635304810, -0.70881994583682}, {-0.85235410573336, -0.08342347966410},
-{-0.86425093011245, -0.45795025029466}, { 0.38879779059045,  0.97274429344593},
-{ 0.92045124735495, -0.62433652524220}, { 0.89162532251878,  0.54950955570563},
-{-0.36834336949252,  0.96458298020975}, { 0.93891760988045, -0.89968353740388},
-{ 0.99267657565094, -0.03757034316958}, {-0.94063471614176,  0.41332338538963},
-{ 0.99740224117019, -0.16830494996370}, {-0.35899413170555, -0.46633226649613},
-{ 0.05237237274947, -0.25640361602661}, { 0.36703583957424, -0.38653265641875},
-{ 0.91653180367913, -0.30587628726597}, { 0.69000803499316,  0.90952171386132},
-{-0.38658751133527,  0.99501571208985}, {-0.29250814029851,  0.37444994344615},
-{-0.60182204677608,  0.86779651036123}, {-0.97418588163217,  0.96468523666475},
-{ 0.88461574003963,  0.57508405276414}, { 0.05198933055162,  0.21269661669964},
-{-0.53499621979720,  0.97241553731237}, {-0.49429560226497,  0.98183865291903},
-{-0.98935142339139, -0.40249159006933}, {-0.98081380091130, -0.72856895534041},
-{-0.27338148835532,  0.99950922447209}, { 0.06310802338302, -0.54539587529618},
-{-0.20461677199539, -0.14209977628489}, { 0.66223843141647,  0.72528579940326},
-{-0.84764345483665,  0.02372316801261}, {-0.89039863483811,  0.88866581484602},
-{ 0.95903308477986,  0.76744927173873}, { 0.73504123909879, -0.03747203173192},
-{-0.31744434966056, -0.36834111883652}, {-0.34110827591623,  0.40211222807691},
-{ 0.47803883714199, -0.39423219786288}, { 0.98299195879514,  0.01989791390047},
-{-0.30963073129751, -0.18076720599336}, { 0.99992588229018, -0.26281872094289},
-{-0.93149731080767, -0.98313162570490}, { 0.99923472302773, -0.80142993767554},
-{-0.26024169633417, -0.75999759855752}, {-0.35712514743563,  0.19298963768574},
-{-0.99899084509530,  0.74645156992493}, { 0.86557171579452,  0.55593866696299},
-{ 0.33408042438752,  0.86185953874709}, { 0.99010736374716,  0.04602397576623},
-{-0.66694269691195, -0.91643611810148}, { 0.64016792079480,  0.15649530836856},
-{ 0.99570534804836,  0.45844586038111}, {-0.63431466947340,  0.21079116459234},
-{-0.07706847005931, -0.89581437101329}, { 0.98590090577724,  0.88241721133981},
-{ 0.80099335254678, -0.36851896710853}, { 0.78368131392666,  0.45506999802597},
-{ 0.08707806671691,  0.80938994918745}, {-0.86811883080712,  0.39347308654705},
-{-0.39466529740375, -0.66809432114456}, { 0.97875325649683, -0.72467840967746},
-{-0.95038560288864,  0.89563219587625}, { 0.17005239424212,  0.54683053962658},
-{-0.76910792026848, -0.96226617549298}, { 0.99743281016846,  0.42697157037567},
-{ 0.95437383549973,  0.97002324109952}, { 0.99578905365569, -0.54106826257356},
-{ 0.28058259829990, -0.85361420634036}, { 0.85256524470573, -0.64567607735589},
-{-0.50608540105128, -0.65846015480300}, {-0.97210735183243, -0.23095213067791},
-{ 0.95424048234441, -0.99240147091219}, {-0.96926570524023,  0.73775654896574},
-{ 0.30872163214726,  0.41514960556126}, {-0.24523839572639,  0.63206633394807},
-{-0.33813265086024, -0.38661779441897}, {-0.05826828420146, -0.06940774188029},
-{-0.22898461455054,  0.97054853316316}, {-0.18509915019881,  0.47565762892084},
-{-0.10488238045009, -0.87769947402394}, {-0.71886586182037,  0.78030982480538},
-{ 0.99793873738654,  0.90041310491497}, { 0.57563307626120, -0.91034337352097},
-{ 0.28909646383717,  0.96307783970534}, { 0.42188998312520,  0.48148651230437},
-{ 0.93335049681047, -0.43537023883588}, {-0.97087374418267,  0.86636445711364},
-{ 0.36722871286923,  0.65291654172961}, {-0.81093025665696,  0.08778370229363},
-{-0.26240603062237, -0.92774095379098}, { 0.83996497984604,  0.55839849139647},
-{-0.99909615720225, -0.96024605713970}, { 0.74649464155061,  0.12144893606462},
-{-0.74774595569805, -0.26898062008959}, { 0.95781667469567, -0.79047927052628},
-{ 0.95472308713099, -0.08588776019550}, { 0.48708332746299,  0.99999041579432},
-{ 0.46332038247497,  0.10964126185063}, {-0.76497004940162,  0.89210929242238},
-{ 0.57397389364339,  0.35289703373760}, { 0.75374316974495,  0.96705214651335},
-{-0.59174397685714, -0.89405370422752}, { 0.75087906691890, -0.29612672982396},
-{-0.98607857336230,  0.25034911730023}, {-0.40761056640505, -0.90045573444695},
-{ 0.66929266740477,  0.98629493401748}, {-0.97463695257310, -0.00190223301301},
-{ 0.90145509409859,  0.99781390365446}, {-0.87259289048043,  0.99233587353666},
-{-0.91529461447692, -0.15698707534206}, {-0.03305738840705, -0.37205262859764},
-{ 0.07223051368337, -0.88805001733626}, { 0.99498012188353,  0.97094358113387},
-{-0.74904939500519,  0.99985483641521}, { 0.04585228574211,  0.99812337444082},
-{-0.89054954257993, -0.31791913188064}, {-0.83782144651251,  0.97637632547466},
-{ 0.33454804933804, -0.86231516800408}, {-0.99707579362824,  0.93237990079441},
-{-0.22827527843994,  0.18874759397997}, { 0.67248046289143, -0.03646211390569},
-{-0.05146538187944, -0.92599700120679}, { 0.99947295749905,  0.93625229707912},
-{ 0.66951124390363,  0.98905825623893}, {-0.99602956559179, -0.44654715757688},
-{ 0.82104905483590,  0.99540741724928}, { 0.99186510988782,  0.72023001312947},
-{-0.65284592392918,  0.52186723253637}, { 0.93885443798188, -0.74895312615259},
-{ 0.96735248738388,  0.90891816978629}, {-0.22225968841114,  0.57124029781228},
-{-0.44132783753414, -0.92688840659280}, {-0.85694974219574,  0.88844532719844},
-{ 0.91783042091762, -0.46356892383970}, { 0.72556974415690, -0.99899555770747},
-{-0.99711581834508,  0.58211560180426}, { 0.77638976371966,  0.94321834873819},
-{ 0.07717324253925,  0.58638399856595}, {-0.56049829194163,  0.82522301569036},
-{ 0.98398893639988,  0.39467440420569}, { 0.47546946844938,  0.68613044836811},
-{ 0.65675089314631,  0.18331637134880}, { 0.03273375457980, -0.74933109564108},
-{-0.38684144784738,  0.51337349030406}, {-0.97346267944545, -0.96549364384098},
-{-0.53282156061942, -0.91423265091354}, { 0.99817310731176,  0.61133572482148},
-{-0.50254500772635, -0.88829338134294}, { 0.01995873238855,  0.85223515096765},
-{ 0.99930381973804,  0.94578896296649}, { 0.82907767600783, -0.06323442598128},
-{-0.58660709669728,  0.96840773806582}, {-0.17573736667267, -0.48166920859485},
-{ 0.83434292401346, -0.13023450646997}, { 0.05946491307025,  0.20511047074866},
-{ 0.81505484574602, -0.94685947861369}, {-0.44976380954860,  0.40894572671545},
-{-0.89746474625671,  0.99846578838537}, { 0.39677256130792, -0.74854668609359},
-{-0.07588948563079,  0.74096214084170}, { 0.76343198951445,  0.41746629422634},
-{-0.74490104699626,  0.94725911744610}, { 0.64880119792759,  0.41336660830571},
-{ 0.62319537462542, -0.93098313552599}, { 0.42215817594807, -0.07712787385208},
-{ 0.02704554141885, -0.05417518053666}, { 0.80001773566818,  0.91542195141039},
-{-0.79351832348816, -0.36208897989136}, { 0.63872359151636,  0.08128252493444},
-{ 0.52890520960295,  0.60048872455592}, { 0.74238552914587,  0.04491915291044},
-{ 0.99096131449250, -0.19451182854402}, {-0.80412329643109, -0.88513818199457},
-{-0.64612616129736,  0.72198674804544}, { 0.11657770663191, -0.83662833815041},
-{-0.95053182488101, -0.96939905138082}, {-0.62228872928622,  0.82767262846661},
-{ 0.03004475787316, -0.99738896333384}, {-0.97987214341034,  0.36526129686425},
-{-0.99986980746200, -0.36021610299715}, { 0.89110648599879, -0.97894250343044},
-{ 0.10407960510582,  0.77357793811619}, { 0.95964737821728, -0.35435818285502},
-{ 0.50843233159162,  0.96107691266205}, { 0.17006334670615, -0.76854025314829},
-{ 0.25872675063360,  0.99893303933816}, {-0.01115998681937,  0.98496019742444},
-{-0.79598702973261,  0.97138411318894}, {-0.99264708948101, -0.99542822402536},
-{-0.99829663752818,  0.01877138824311}, {-0.70801016548184,  0.33680685948117},
-{-0.70467057786826,  0.93272777501857}, { 0.99846021905254, -0.98725746254433},
-{-0.63364968534650, -0.16473594423746}, {-0.16258217500792, -0.95939125400802},
-{-0.43645594360633, -0.94805030113284}, {-0.99848471702976,  0.96245166923809},
-{-0.16796458968998, -0.98987511890470}, {-0.87979225745213, -0.71725725041680},
-{ 0.44183099021786, -0.93568974498761}, { 0.93310180125532, -0.99913308068246},
-{-0.93941931782002, -0.56409379640356}, {-0.88590003188677,  0.47624600491382},
-{ 0.99971463703691, -0.83889954253462}, {-0.75376385639978,  0.00814643438625},
-{ 0.93887685615875, -0.11284528204636}, { 0.85126435782309,  0.52349251543547},
-{ 0.39701421446381,  0.81779634174316}, {-0.37024464187437, -0.87071656222959},
-{-0.36024828242896,  0.34655735648287}, {-0.93388812549209, -0.84476541096429},
-{-0.65298804552119, -0.18439575450921}, { 0.11960319006843,  0.99899346780168},
-{ 0.94292565553160,  0.83163906518293}, { 0.75081145286948, -0.35533223142265},
-{ 0.56721979748394, -0.24076836414499}, { 0.46857766746029, -0.30140233457198},
-{ 0.97312313923635, -0.99548191630031}, {-0.38299976567017,  0.98516909715427},
-{ 0.41025800019463,  0.02116736935734}, { 0.09638062008048,  0.04411984381457},
-{-0.85283249275397,  0.91475563922421}, { 0.88866808958124, -0.99735267083226},
-{-0.48202429536989, -0.96805608884164}, { 0.27572582416567,  0.58634753335832},
-{-0.65889129659168,  0.58835634138583}, { 0.98838086953732,  0.99994349600236},
-{-0.20651349620689,  0.54593044066355}, {-0.62126416356920, -0.59893681700392},
-{ 0.20320105410437, -0.86879180355289}, {-0.97790548600584,  0.96290806999242},
-{ 0.11112534735126,  0.21484763313301}, {-0.41368337314182,  0.28216837680365},
-{ 0.24133038992960,  0.51294362630238}, {-0.66393410674885, -0.08249679629081},
-{-0.53697829178752, -0.97649903936228}, {-0.97224737889348,  0.22081333579837},
-{ 0.87392477144549, -0.12796173740361}, { 0.19050361015753,  0.01602615387195},
-{-0.46353441212724, -0.95249041539006}, {-0.07064096339021, -0.94479803205886},
-{-0.92444085484466, -0.10457590187436}, {-0.83822593578728, -0.01695043208885},
-{ 0.75214681811150, -0.99955681042665}, {-0.42102998829339,  0.99720941999394},
-{-0.72094786237696, -0.35008961934255}, { 0.78843311019251,  0.52851398958271},
-{ 0.97394027897442, -0.26695944086561}, { 0.99206463477946, -0.57010120849429},
-{ 0.76789609461795, -0.76519356730966}, {-0.82002421836409, -0.73530179553767},
-{ 0.81924990025724,  0.99698425250579}, {-0.26719850873357,  0.68903369776193},
-{-0.43311260380975,  0.85321815947490}, { 0.99194979673836,  0.91876249766422},
-{-0.80692001248487, -0.32627540663214}, { 0.43080003649976, -0.21919095636638},
-{ 0.67709491937357, -0.95478075822906}, { 0.56151770568316, -0.70693811747778},
-{ 0.10831862810749, -0.08628837174592}, { 0.91229417540436, -0.65987351408410},
-{-0.48972893932274,  0.56289246362686}, {-0.89033658689697, -0.71656563987082},
-{ 0.65269447475094,  0.65916004833932}, { 0.67439478141121, -0.81684380846796},
-{-0.47770832416973, -0.16789556203025}, {-0.99715979260878, -0.93565784007648},
-{-0.90889593602546,  0.62034397054380}, {-0.06618622548177, -0.23812217221359},
-{ 0.99430266919728,  0.18812555317553}, { 0.97686402381843, -0.28664534366620},
-{ 0.94813650221268, -0.97506640027128}, {-0.95434497492853, -0.79607978501983},
-{-0.49104783137150,  0.32895214359663}, { 0.99881175120751,  0.88993983831354},
-{ 0.50449166760303, -0.85995072408434}, { 0.47162891065108, -0.18680204049569},
-{-0.62081581361840,  0.75000676218956}, {-0.43867015250812,  0.99998069244322},
-{ 0.98630563232075, -0.53578899600662}, {-0.61510362277374, -0.89515019899997},
-{-0.03841517601843, -0.69888815681179}, {-0.30102157304644, -0.07667808922205},
-{ 0.41881284182683,  0.02188098922282}, {-0.86135454941237,  0.98947480909359},
-{ 0.67226861393788, -0.13494389011014}, {-0.70737398842068, -0.76547349325992},
-{ 0.94044946687963,  0.09026201157416}, {-0.82386352534327,  0.08924768823676},
-{-0.32070666698656,  0.50143421908753}, { 0.57593163224487, -0.98966422921509},
-{-0.36326018419965,  0.07440243123228}, { 0.99979044674350, -0.14130287347405},
-{-0.92366023326932, -0.97979298068180}, {-0.44607178518598, -0.54233252016394},
-{ 0.44226800932956,  0.71326756742752}, { 0.03671907158312,  0.63606389366675},
-{ 0.52175424682195, -0.85396826735705}, {-0.94701139690956, -0.01826348194255},
-{-0.98759606946049,  0.82288714303073}, { 0.87434794743625,  0.89399495655433},
-{-0.93412041758744,  0.41374052024363}, { 0.96063943315511,  0.93116709541280},
-{ 0.97534253457837,  0.86150930812689}, { 0.99642466504163,  0.70190043427512},
-{-0.94705089665984, -0.29580042814306}, { 0.91599807087376, -0.98147830385781},
-{-0.99948153278296, -0.59483417516607}, { 0.97113454393991, -0.67528515225647},
+const DECLARE_ALIGNED(16, INTFLOAT, AAC_RENAME(ff_sbr_noise_table))[][2] = {
+{ Q31(-0.99948153278296), Q31(-0.59483417516607) }, { Q31( 0.97113454393991), Q31(-0.67528515225647) },
+{ Q31( 0.14130051758487), Q31(-0.95090983575689) }, { Q31(-0.47005496701697), Q31(-0.37340549728647) },
+{ Q31( 0.80705063769351), Q31( 0.29653668284408) }, { Q31(-0.38981478896926), Q31( 0.89572605717087) },
+{ Q31(-0.01053049862020), Q31(-0.66959058036166) }, { Q31(-0.91266367957293), Q31(-0.11522938140034) },
+{ Q31( 0.54840422910309), Q31( 0.75221367176302) }, { Q31( 0.40009252867955), Q31(-0.98929400334421) },
+{ Q31(-0.99867974711855), Q31(-0.88147068645358) }, { Q31(-0.95531076805040), Q31( 0.90908757154593) },
+{ Q31(-0.45725933317144), Q31(-0.56716323646760) }, { Q31(-0.72929675029275), Q31(-0.98008272727324) },
+{ Q31( 0.75622801399036), Q31( 0.20950329995549) }, { Q31( 0.07069442601050), Q31(-0.78247898470706) },
+{ Q31( 0.74496252926055), Q31(-0.91169004445807) }, { Q31(-0.96440182703856), Q31(-0.94739918296622) },
+{ Q31( 0.30424629369539), Q31(-0.49438267012479) }, { Q31( 0.66565033746925), Q31( 0.64652935542491) },
+{ Q31( 0.91697008020594), Q31( 0.17514097332009) }, { Q31(-0.70774918760427), Q31( 0.52548653416543) },
+{ Q31(-0.70051415345560), Q31(-0.45340028808763) }, { Q31(-0.99496513054797), Q31(-0.90071908066973) },
+{ Q31( 0.98164490790123), Q31(-0.77463155528697) }, { Q31(-0.54671580548181), Q31(-0.02570928536004) },
+{ Q31(-0.01689629065389), Q31( 0.00287506445732) }, { Q31(-0.86110349531986), Q31( 0.42548583726477) },
+{ Q31(-0.98892980586032), Q31(-0.87881132267556) }, { Q31( 0.51756627678691), Q31( 0.66926784710139) },
+{ Q31(-0.99635026409640), Q31(-0.58107730574765) }, { Q31(-0.99969370862163), Q31( 0.98369989360250) },
+{ Q31( 0.55266258627194), Q31( 0.59449057465591) }, { Q31( 0.34581177741673), Q31( 0.94879421061866) },
+{ Q31( 0.62664209577999), Q31(-0.74402970906471) }, { Q31(-0.77149701404973), Q31(-0.33883658042801) },
+{ Q31(-0.91592244254432), Q31( 0.03687901376713) }, { Q31(-0.76285492357887), Q31(-0.91371867919124) },
+{ Q31( 0.79788337195331), Q31(-0.93180971199849) }, { Q31( 0.54473080610200), Q31(-0.11919206037186) },
+{ Q31(-0.85639281671058), Q31( 0.42429854760451) }, { Q31(-0.92882402971423), Q31( 0.27871809078609) },
+{ Q31(-0.11708371046774), Q31(-0.99800843444966) }, { Q31( 0.21356749817493), Q31(-0.90716295627033) },
+{ Q31(-0.76191692573909), Q31( 0.99768118356265) }, { Q31( 0.98111043100884), Q31(-0.95854459734407) },
+{ Q31(-0.85913269895572), Q31( 0.95766566168880) }, { Q31(-0.93307242253692), Q31( 0.49431757696466) },
+{ Q31( 0.30485754879632), Q31(-0.70540034357529) }, { Q31( 0.85289650925190), Q31( 0.46766131791044) },
+{ Q31( 0.91328082618125), Q31(-0.99839597361769) }, { Q31(-0.05890199924154), Q31( 0.70741827819497) },
+{ Q31( 0.28398686150148), Q31( 0.34633555702188) }, { Q31( 0.95258164539612), Q31(-0.54893416026939) },
+{ Q31(-0.78566324168507), Q31(-0.75568541079691) }, { Q31(-0.95789495447877), Q31(-0.20423194696966) },
+{ Q31( 0.82411158711197), Q31( 0.96654618432562) }, { Q31(-0.65185446735885), Q31(-0.88734990773289) },
+{ Q31(-0.93643603134666), Q31( 0.99870790442385) }, { Q31( 0.91427159529618), Q31(-0.98290505544444) },
+{ Q31(-0.70395684036886), Q31( 0.58796798221039) }, { Q31( 0.00563771969365), Q31( 0.61768196727244) },
+{ Q31( 0.89065051931895), Q31( 0.52783352697585) }, { Q31(-0.68683707712762), Q31( 0.80806944710339) },
+{ Q31( 0.72165342518718), Q31(-0.69259857349564) }, { Q31(-0.62928247730667), Q31( 0.13627037407335) },
+{ Q31( 0.29938434065514), Q31(-0.46051329682246) }, { Q31(-0.91781958879280), Q31(-0.74012716684186) },
+{ Q31( 0.99298717043688), Q31( 0.40816610075661) }, { Q31( 0.82368298622748), Q31(-0.74036047190173) },
+{ Q31(-0.98512833386833), Q31(-0.99972330709594) }, { Q31(-0.95915368242257), Q31(-0.99237800466040) },
+{ Q31(-0.21411126572790), Q31(-0.93424819052545) }, { Q31(-0.68821476106884), Q31(-0.26892306315457) },
+{ Q31( 0.91851997982317), Q31( 0.09358228901785) }, { Q31(-0.96062769559127), Q31( 0.36099095133739) },
+{ Q31( 0.51646184922287), Q31(-0.71373332873917) }, { Q31( 0.61130721139669), Q31( 0.46950141175917) },
+{ Q31( 0.47336129371299), Q31(-0.27333178296162) }, { Q31( 0.90998308703519), Q31( 0.96715662938132) },
+{ Q31( 0.44844799194357), Q31( 0.99211574628306) }, { Q31( 0.66614891079092), Q31( 0.96590176169121) },
+{ Q31( 0.74922239129237), Q31(-0.89879858826087) }, { Q31(-0.99571588506485), Q31( 0.52785521494349) },
+{ Q31( 0.97401082477563), Q31(-0.16855870075190) }, { Q31( 0.72683747733879), Q31(-0.48060774432251) },
+{ Q31( 0.95432193457128), Q31( 0.68849603408441) }, { Q31(-0.72962208425191), Q31(-0.76608443420917) },
+{ Q31(-0.85359479233537), Q31( 0.88738125901579) }, { Q31(-0.81412430338535), Q31(-0.97480768049637) },
+{ Q31(-0.87930772356786), Q31( 0.74748307690436) }, { Q31(-0.71573331064977), Q31(-0.98570608178923) },
+{ Q31( 0.83524300028228), Q31( 0.83702537075163) }, { Q31(-0.48086065601423), Q31(-0.98848504923531) },
+{ Q31( 0.97139128574778), Q31( 0.80093621198236) }, { Q31( 0.51992825347895), Q31( 0.80247631400510) },
+{ Q31(-0.00848591195325), Q31(-0.76670128000486) }, { Q31(-0.70294374303036), Q31( 0.55359910445577) },
+{ Q31(-0.95894428168140), Q31(-0.43265504344783) }, { Q31( 0.97079252950321), Q31( 0.09325857238682) },
+{ Q31(-0.92404293670797), Q31( 0.85507704027855) }, { Q31(-0.69506469500450), Q31( 0.98633412625459) },
+{ Q31( 0.26559203620024), Q31( 0.73314307966524) }, { Q31( 0.28038443336943), Q31( 0.14537913654427) },
+{ Q31(-0.74138124825523), Q31( 0.99310339807762) }, { Q31(-0.01752795995444), Q31(-0.82616635284178) },
+{ Q31(-0.55126773094930), Q31(-0.98898543862153) }, { Q31( 0.97960898850996), Q31(-0.94021446752851) },
+{ Q31(-0.99196309146936), Q31( 0.67019017358456) }, { Q31(-0.67684928085260), Q31( 0.12631491649378) },
+{ Q31( 0.09140039465500), Q31(-0.20537731453108) }, { Q31(-0.71658965751996), Q31(-0.97788200391224) },
+{ Q31( 0.81014640078925), Q31( 0.53722648362443) }, { Q31( 0.40616991671205), Q31(-0.26469008598449) },
+{ Q31(-0.67680188682972), Q31( 0.94502052337695) }, { Q31( 0.86849774348749), Q31(-0.18333598647899) },
+{ Q31(-0.99500381284851), Q31(-0.02634122068550) }, { Q31( 0.84329189340667), Q31( 0.10406957462213) },
+{ Q31(-0.09215968531446), Q31( 0.69540012101253) }, { Q31( 0.99956173327206), Q31(-0.12358542001404) },
+{ Q31(-0.79732779473535), Q31(-0.91582524736159) }, { Q31( 0.96349973642406), Q31( 0.96640458041000) },
+{ Q31(-0.79942778496547), Q31( 0.64323902822857) }, { Q31(-0.11566039853896), Q31( 0.28587846253726) },
+{ Q31(-0.39922954514662), Q31( 0.94129601616966) }, { Q31( 0.99089197565987), Q31(-0.92062625581587) },
+{ Q31( 0.28631285179909), Q31(-0.91035047143603) }, { Q31(-0.83302725605608), Q31(-0.67330410892084) },
+{ Q31( 0.95404443402072), Q31( 0.49162765398743) }, { Q31(-0.06449863579434), Q31( 0.03250560813135) },
+{ Q31(-0.99575054486311), Q31( 0.42389784469507) }, { Q31(-0.65501142790847), Q31( 0.82546114655624) },
+{ Q31(-0.81254441908887), Q31(-0.51627234660629) }, { Q31(-0.99646369485481), Q31( 0.84490533520752) },
+{ Q31( 0.00287840603348), Q31( 0.64768261158166) }, { Q31( 0.70176989408455), Q31(-0.20453028573322) },
+{ Q31( 0.96361882270190), Q31( 0.40706967140989) }, { Q31(-0.68883758192426), Q31( 0.91338958840772) },
+{ Q31(-0.34875585502238), Q31( 0.71472290693300) }, { Q31( 0.91980081243087), Q31( 0.66507455644919) },
+{ Q31(-0.99009048343881), Q31( 0.85868021604848) }, { Q31( 0.68865791458395), Q31( 0.55660316809678) },
+{ Q31(-0.99484402129368), Q31(-0.20052559254934) }, { Q31( 0.94214511408023), Q31(-0.99696425367461) },
+{ Q31(-0.67414626793544), Q31( 0.49548221180078) }, { Q31(-0.47339353684664), Q31(-0.85904328834047) },
+{ Q31( 0.14323651387360), Q31(-0.94145598222488) }, { Q31(-0.29268293575672), Q31( 0.05759224927952) },
+{ Q31( 0.43793861458754), Q31(-0.78904969892724) }, { Q31(-0.36345126374441), Q31( 0.64874435357162) },
+{ Q31(-0.08750604656825), Q31( 0.97686944362527) }, { Q31(-0.96495267812511), Q31(-0.53960305946511) },
+{ Q31( 0.55526940659947), Q31( 0.78891523734774) }, { Q31( 0.73538215752630), Q31( 0.96452072373404) },
+{ Q31(-0.30889773919437), Q31(-0.80664389776860) }, { Q31( 0.03574995626194), Q31(-0.97325616900959) },
+{ Q31( 0.98720684660488), Q31( 0.48409133691962) }, { Q31(-0.81689296271203), Q31(-0.90827703628298) },
+{ Q31( 0.67866860118215), Q31( 0.81284503870856) }, { Q31(-0.15808569732583), Q31( 0.85279555024382) },
+{ Q31( 0.80723395114371), Q31(-0.24717418514605) }, { Q31( 0.47788757329038), Q31(-0.46333147839295) },
+{ Q31( 0.96367554763201), Q31( 0.38486749303242) }, { Q31(-0.99143875716818), Q31(-0.24945277239809) },
+{ Q31( 0.83081876925833), Q31(-0.94780851414763) }, { Q31(-0.58753191905341), Q31( 0.01290772389163) },
+{ Q31( 0.95538108220960), Q31(-0.85557052096538) }, { Q31(-0.96490920476211), Q31(-0.64020970923102) },
+{ Q31(-0.97327101028521), Q31( 0.12378128133110) }, { Q31( 0.91400366022124), Q31( 0.57972471346930) },
+{ Q31(-0.99925837363824), Q31( 0.71084847864067) }, { Q31(-0.86875903507313), Q31(-0.20291699203564) },
+{ Q31(-0.26240034795124), Q31(-0.68264554369108) }, { Q31(-0.24664412953388), Q31(-0.87642273115183) },
+{ Q31( 0.02416275806869), Q31( 0.27192914288905) }, { Q31( 0.82068619590515), Q31(-0.85087787994476) },
+{ Q31( 0.88547373760759), Q31(-0.89636802901469) }, { Q31(-0.18173078152226), Q31(-0.26152145156800) },
+{ Q31( 0.09355476558534), Q31( 0.54845123045604) }, { Q31(-0.54668414224090), Q31( 0.95980774020221) },
+{ Q31( 0.37050990604091), Q31(-0.59910140383171) }, { Q31(-0.70373594262891), Q31( 0.91227665827081) },
+{ Q31(-0.34600785879594), Q31(-0.99441426144200) }, { Q31(-0.68774481731008), Q31(-0.30238837956299) },
+{ Q31(-0.26843291251234), Q31( 0.83115668004362) }, { Q31( 0.49072334613242), Q31(-0.45359708737775) },
+{ Q31( 0.38975993093975), Q31( 0.95515358099121) }, { Q31(-0.97757125224150), Q31( 0.05305894580606) },
+{ Q31(-0.17325552859616), Q31(-0.92770672250494) }, { Q31( 0.99948035025744), Q31( 0.58285545563426) },
+{ Q31(-0.64946246527458), Q31( 0.68645507104960) }, { Q31(-0.12016920576437), Q31(-0.57147322153312) },
+{ Q31(-0.58947456517751), Q31(-0.34847132454388) }, { Q31(-0.41815140454465), Q31( 0.16276422358861) },
+{ Q31( 0.99885650204884), Q31( 0.11136095490444) }, { Q31(-0.56649614128386), Q31(-0.90494866361587) },
+{ Q31( 0.94138021032330), Q31( 0.35281916733018) }, { Q31(-0.75725076534641), Q31( 0.53650549640587) },
+{ Q31( 0.20541973692630), Q31(-0.94435144369918) }, { Q31( 0.99980371023351), Q31( 0.79835913565599) },
+{ Q31( 0.29078277605775), Q31( 0.35393777921520) }, { Q31(-0.62858772103030), Q31( 0.38765693387102) },
+{ Q31( 0.43440904467688), Q31(-0.98546330463232) }, { Q31(-0.98298583762390), Q31( 0.21021524625209) },
+{ Q31( 0.19513029146934), Q31(-0.94239832251867) }, { Q31(-0.95476662400101), Q31( 0.98364554179143) },
+{ Q31( 0.93379635304810), Q31(-0.70881994583682) }, { Q31(-0.85235410573336), Q31(-0.08342347966410) },
+{ Q31(-0.86425093011245), Q31(-0.45795025029466) }, { Q31( 0.38879779059045), Q31( 0.97274429344593) },
+{ Q31( 0.92045124735495), Q31(-0.62433652524220) }, { Q31( 0.89162532251878), Q31( 0.54950955570563) },
+{ Q31(-0.36834336949252), Q31( 0.96458298020975) }, { Q31( 0.93891760988045), Q31(-0.89968353740388) },
+{ Q31( 0.99267657565094), Q31(-0.03757034316958) }, { Q31(-0.94063471614176), Q31( 0.41332338538963) },
+{ Q31( 0.99740224117019), Q31(-0.16830494996370) }, { Q31(-0.35899413170555), Q31(-0.46633226649613) },
+{ Q31( 0.05237237274947), Q31(-0.25640361602661) }, { Q31( 0.36703583957424), Q31(-0.38653265641875) },
+{ Q31( 0.91653180367913), Q31(-0.30587628726597) }, { Q31( 0.69000803499316), Q31( 0.90952171386132) },
+{ Q31(-0.38658751133527), Q31( 0.99501571208985) }, { Q31(-0.29250814029851), Q31( 0.37444994344615) },
+{ Q31(-0.60182204677608), Q31( 0.86779651036123) }, { Q31(-0.97418588163217), Q31( 0.96468523666475) },
+{ Q31( 0.88461574003963), Q31( 0.57508405276414) }, { Q31( 0.05198933055162), Q31( 0.21269661669964) },
+{ Q31(-0.53499621979720), Q31( 0.97241553731237) }, { Q31(-0.49429560226497), Q31( 0.98183865291903) },
+{ Q31(-0.98935142339139), Q31(-0.40249159006933) }, { Q31(-0.98081380091130), Q31(-0.72856895534041) },
+{ Q31(-0.27338148835532), Q31( 0.99950922447209) }, { Q31( 0.06310802338302), Q31(-0.54539587529618) },
+{ Q31(-0.20461677199539), Q31(-0.14209977628489) }, { Q31( 0.66223843141647), Q31( 0.72528579940326) },
+{ Q31(-0.84764345483665), Q31( 0.02372316801261) }, { Q31(-0.89039863483811), Q31( 0.88866581484602) },
+{ Q31( 0.95903308477986), Q31( 0.76744927173873) }, { Q31( 0.73504123909879), Q31(-0.03747203173192) },
+{ Q31(-0.31744434966056), Q31(-0.36834111883652) }, { Q31(-0.34110827591623), Q31( 0.40211222807691) },
+{ Q31( 0.47803883714199), Q31(-0.39423219786288) }, { Q31( 0.98299195879514), Q31( 0.01989791390047) },
+{ Q31(-0.30963073129751), Q31(-0.18076720599336) }, { Q31( 0.99992588229018), Q31(-0.26281872094289) },
+{ Q31(-0.93149731080767), Q31(-0.98313162570490) }, { Q31( 0.99923472302773), Q31(-0.80142993767554) },
+{ Q31(-0.26024169633417), Q31(-0.75999759855752) }, { Q31(-0.35712514743563), Q31( 0.19298963768574) },
+{ Q31(-0.99899084509530), Q31( 0.74645156992493) }, { Q31( 0.86557171579452), Q31( 0.55593866696299) },
+{ Q31( 0.33408042438752), Q31( 0.86185953874709) }, { Q31( 0.99010736374716), Q31( 0.04602397576623) },
+{ Q31(-0.66694269691195), Q31(-0.91643611810148) }, { Q31( 0.64016792079480), Q31( 0.15649530836856) },
+{ Q31( 0.99570534804836), Q31( 0.45844586038111) }, { Q31(-0.63431466947340), Q31( 0.21079116459234) },
+{ Q31(-0.07706847005931), Q31(-0.89581437101329) }, { Q31( 0.98590090577724), Q31( 0.88241721133981) },
+{ Q31( 0.80099335254678), Q31(-0.36851896710853) }, { Q31( 0.78368131392666), Q31( 0.45506999802597) },
+{ Q31( 0.08707806671691), Q31( 0.80938994918745) }, { Q31(-0.86811883080712), Q31( 0.39347308654705) },
+{ Q31(-0.39466529740375), Q31(-0.66809432114456) }, { Q31( 0.97875325649683), Q31(-0.72467840967746) },
+{ Q31(-0.95038560288864), Q31( 0.89563219587625) }, { Q31( 0.17005239424212), Q31( 0.54683053962658) },
+{ Q31(-0.76910792026848), Q31(-0.96226617549298) }, { Q31( 0.99743281016846), Q31( 0.42697157037567) },
+{ Q31( 0.95437383549973), Q31( 0.97002324109952) }, { Q31( 0.99578905365569), Q31(-0.54106826257356) },
+{ Q31( 0.28058259829990), Q31(-0.85361420634036) }, { Q31( 0.85256524470573), Q31(-0.64567607735589) },
+{ Q31(-0.50608540105128), Q31(-0.65846015480300) }, { Q31(-0.97210735183243), Q31(-0.23095213067791) },
+{ Q31( 0.95424048234441), Q31(-0.99240147091219) }, { Q31(-0.96926570524023), Q31( 0.73775654896574) },
+{ Q31( 0.30872163214726), Q31( 0.41514960556126) }, { Q31(-0.24523839572639), Q31( 0.63206633394807) },
+{ Q31(-0.33813265086024), Q31(-0.38661779441897) }, { Q31(-0.05826828420146), Q31(-0.06940774188029) },
+{ Q31(-0.22898461455054), Q31( 0.97054853316316) }, { Q31(-0.18509915019881), Q31( 0.47565762892084) },
+{ Q31(-0.10488238045009), Q31(-0.87769947402394) }, { Q31(-0.71886586182037), Q31( 0.78030982480538) },
+{ Q31( 0.99793873738654), Q31( 0.90041310491497) }, { Q31( 0.57563307626120), Q31(-0.91034337352097) },
+{ Q31( 0.28909646383717), Q31( 0.96307783970534) }, { Q31( 0.42188998312520), Q31( 0.48148651230437) },
+{ Q31( 0.93335049681047), Q31(-0.43537023883588) }, { Q31(-0.97087374418267), Q31( 0.86636445711364) },
+{ Q31( 0.36722871286923), Q31( 0.65291654172961) }, { Q31(-0.81093025665696), Q31( 0.08778370229363) },
+{ Q31(-0.26240603062237), Q31(-0.92774095379098) }, { Q31( 0.83996497984604), Q31( 0.55839849139647) },
+{ Q31(-0.99909615720225), Q31(-0.96024605713970) }, { Q31( 0.74649464155061), Q31( 0.12144893606462) },
+{ Q31(-0.74774595569805), Q31(-0.26898062008959) }, { Q31( 0.95781667469567), Q31(-0.79047927052628) },
+{ Q31( 0.95472308713099), Q31(-0.08588776019550) }, { Q31( 0.48708332746299), Q31( 0.99999041579432) },
+{ Q31( 0.46332038247497), Q31( 0.10964126185063) }, { Q31(-0.76497004940162), Q31( 0.89210929242238) },
+{ Q31( 0.57397389364339), Q31( 0.35289703373760) }, { Q31( 0.75374316974495), Q31( 0.96705214651335) },
+{ Q31(-0.59174397685714), Q31(-0.89405370422752) }, { Q31( 0.75087906691890), Q31(-0.29612672982396) },
+{ Q31(-0.98607857336230), Q31( 0.25034911730023) }, { Q31(-0.40761056640505), Q31(-0.90045573444695) },
+{ Q31( 0.66929266740477), Q31( 0.98629493401748) }, { Q31(-0.97463695257310), Q31(-0.00190223301301) },
+{ Q31( 0.90145509409859), Q31( 0.99781390365446) }, { Q31(-0.87259289048043), Q31( 0.99233587353666) },
+{ Q31(-0.91529461447692), Q31(-0.15698707534206) }, { Q31(-0.03305738840705), Q31(-0.37205262859764) },
+{ Q31( 0.07223051368337), Q31(-0.88805001733626) }, { Q31( 0.99498012188353), Q31( 0.97094358113387) },
+{ Q31(-0.74904939500519), Q31( 0.99985483641521) }, { Q31( 0.04585228574211), Q31( 0.99812337444082) },
+{ Q31(-0.89054954257993), Q31(-0.31791913188064) }, { Q31(-0.83782144651251), Q31( 0.97637632547466) },
+{ Q31( 0.33454804933804), Q31(-0.86231516800408) }, { Q31(-0.99707579362824), Q31( 0.93237990079441) },
+{ Q31(-0.22827527843994), Q31( 0.18874759397997) }, { Q31( 0.67248046289143), Q31(-0.03646211390569) },
+{ Q31(-0.05146538187944), Q31(-0.92599700120679) }, { Q31( 0.99947295749905), Q31( 0.93625229707912) },
+{ Q31( 0.66951124390363), Q31( 0.98905825623893) }, { Q31(-0.99602956559179), Q31(-0.44654715757688) },
+{ Q31( 0.82104905483590), Q31( 0.99540741724928) }, { Q31( 0.99186510988782), Q31( 0.72023001312947) },
+{ Q31(-0.65284592392918), Q31( 0.52186723253637) }, { Q31( 0.93885443798188), Q31(-0.74895312615259) },
+{ Q31( 0.96735248738388), Q31( 0.90891816978629) }, { Q31(-0.22225968841114), Q31( 0.57124029781228) },
+{ Q31(-0.44132783753414), Q31(-0.92688840659280) }, { Q31(-0.85694974219574), Q31( 0.88844532719844) },
+{ Q31( 0.91783042091762), Q31(-0.46356892383970) }, { Q31( 0.72556974415690), Q31(-0.99899555770747) },
+{ Q31(-0.99711581834508), Q31( 0.58211560180426) }, { Q31( 0.77638976371966), Q31( 0.94321834873819) },
+{ Q31( 0.07717324253925), Q31( 0.58638399856595) }, { Q31(-0.56049829194163), Q31( 0.82522301569036) },
+{ Q31( 0.98398893639988), Q31( 0.39467440420569) }, { Q31( 0.47546946844938), Q31( 0.68613044836811) },
+{ Q31( 0.65675089314631), Q31( 0.18331637134880) }, { Q31( 0.03273375457980), Q31(-0.74933109564108) },
+{ Q31(-0.38684144784738), Q31( 0.51337349030406) }, { Q31(-0.97346267944545), Q31(-0.96549364384098) },
+{ Q31(-0.53282156061942), Q31(-0.91423265091354) }, { Q31( 0.99817310731176), Q31( 0.61133572482148) },
+{ Q31(-0.50254500772635), Q31(-0.88829338134294) }, { Q31( 0.01995873238855), Q31( 0.85223515096765) },
+{ Q31( 0.99930381973804), Q31( 0.94578896296649) }, { Q31( 0.82907767600783), Q31(-0.06323442598128) },
+{ Q31(-0.58660709669728), Q31( 0.96840773806582) }, { Q31(-0.17573736667267), Q31(-0.48166920859485) },
+{ Q31( 0.83434292401346), Q31(-0.13023450646997) }, { Q31( 0.05946491307025), Q31( 0.20511047074866) },
+{ Q31( 0.81505484574602), Q31(-0.94685947861369) }, { Q31(-0.44976380954860), Q31( 0.40894572671545) },
+{ Q31(-0.89746474625671), Q31( 0.99846578838537) }, { Q31( 0.39677256130792), Q31(-0.74854668609359) },
+{ Q31(-0.07588948563079), Q31( 0.74096214084170) }, { Q31( 0.76343198951445), Q31( 0.41746629422634) },
+{ Q31(-0.74490104699626), Q31( 0.94725911744610) }, { Q31( 0.64880119792759), Q31( 0.41336660830571) },
+{ Q31( 0.62319537462542), Q31(-0.93098313552599) }, { Q31( 0.42215817594807), Q31(-0.07712787385208) },
+{ Q31( 0.02704554141885), Q31(-0.05417518053666) }, { Q31( 0.80001773566818), Q31( 0.91542195141039) },
+{ Q31(-0.79351832348816), Q31(-0.36208897989136) }, { Q31( 0.63872359151636), Q31( 0.08128252493444) },
+{ Q31( 0.52890520960295), Q31( 0.60048872455592) }, { Q31( 0.74238552914587), Q31( 0.04491915291044) },
+{ Q31( 0.99096131449250), Q31(-0.19451182854402) }, { Q31(-0.80412329643109), Q31(-0.88513818199457) },
+{ Q31(-0.64612616129736), Q31( 0.72198674804544) }, { Q31( 0.11657770663191), Q31(-0.83662833815041) },
+{ Q31(-0.95053182488101), Q31(-0.96939905138082) }, { Q31(-0.62228872928622), Q31( 0.82767262846661) },
+{ Q31( 0.03004475787316), Q31(-0.99738896333384) }, { Q31(-0.97987214341034), Q31( 0.36526129686425) },
+{ Q31(-0.99986980746200), Q31(-0.36021610299715) }, { Q31( 0.89110648599879), Q31(-0.97894250343044) },
+{ Q31( 0.10407960510582), Q31( 0.77357793811619) }, { Q31( 0.95964737821728), Q31(-0.35435818285502) },
+{ Q31( 0.50843233159162), Q31( 0.96107691266205) }, { Q31( 0.17006334670615), Q31(-0.76854025314829) },
+{ Q31( 0.25872675063360), Q31( 0.99893303933816) }, { Q31(-0.01115998681937), Q31( 0.98496019742444) },
+{ Q31(-0.79598702973261), Q31( 0.97138411318894) }, { Q31(-0.99264708948101), Q31(-0.99542822402536) },
+{ Q31(-0.99829663752818), Q31( 0.01877138824311) }, { Q31(-0.70801016548184), Q31( 0.33680685948117) },
+{ Q31(-0.70467057786826), Q31( 0.93272777501857) }, { Q31( 0.99846021905254), Q31(-0.98725746254433) },
+{ Q31(-0.63364968534650), Q31(-0.16473594423746) }, { Q31(-0.16258217500792), Q31(-0.95939125400802) },
+{ Q31(-0.43645594360633), Q31(-0.94805030113284) }, { Q31(-0.99848471702976), Q31( 0.96245166923809) },
+{ Q31(-0.16796458968998), Q31(-0.98987511890470) }, { Q31(-0.87979225745213), Q31(-0.71725725041680) },
+{ Q31( 0.44183099021786), Q31(-0.93568974498761) }, { Q31( 0.93310180125532), Q31(-0.99913308068246) },
+{ Q31(-0.93941931782002), Q31(-0.56409379640356) }, { Q31(-0.88590003188677), Q31( 0.47624600491382) },
+{ Q31( 0.99971463703691), Q31(-0.83889954253462) }, { Q31(-0.75376385639978), Q31( 0.00814643438625) },
+{ Q31( 0.93887685615875), Q31(-0.11284528204636) }, { Q31( 0.85126435782309), Q31( 0.52349251543547) },
+{ Q31( 0.39701421446381), Q31( 0.81779634174316) }, { Q31(-0.37024464187437), Q31(-0.87071656222959) },
+{ Q31(-0.36024828242896), Q31( 0.34655735648287) }, { Q31(-0.93388812549209), Q31(-0.84476541096429) },
+{ Q31(-0.65298804552119), Q31(-0.18439575450921) }, { Q31( 0.11960319006843), Q31( 0.99899346780168) },
+{ Q31( 0.94292565553160), Q31( 0.83163906518293) }, { Q31( 0.75081145286948), Q31(-0.35533223142265) },
+{ Q31( 0.56721979748394), Q31(-0.24076836414499) }, { Q31( 0.46857766746029), Q31(-0.30140233457198) },
+{ Q31( 0.97312313923635), Q31(-0.99548191630031) }, { Q31(-0.38299976567017), Q31( 0.98516909715427) },
+{ Q31( 0.41025800019463), Q31( 0.02116736935734) }, { Q31( 0.09638062008048), Q31( 0.04411984381457) },
+{ Q31(-0.85283249275397), Q31( 0.91475563922421) }, { Q31( 0.88866808958124), Q31(-0.99735267083226) },
+{ Q31(-0.48202429536989), Q31(-0.96805608884164) }, { Q31( 0.27572582416567), Q31( 0.58634753335832) },
+{ Q31(-0.65889129659168), Q31( 0.58835634138583) }, { Q31( 0.98838086953732), Q31( 0.99994349600236) },
+{ Q31(-0.20651349620689), Q31( 0.54593044066355) }, { Q31(-0.62126416356920), Q31(-0.59893681700392) },
+{ Q31( 0.20320105410437), Q31(-0.86879180355289) }, { Q31(-0.97790548600584), Q31( 0.96290806999242) },
+{ Q31( 0.11112534735126), Q31( 0.21484763313301) }, { Q31(-0.41368337314182), Q31( 0.28216837680365) },
+{ Q31( 0.24133038992960), Q31( 0.51294362630238) }, { Q31(-0.66393410674885), Q31(-0.08249679629081) },
+{ Q31(-0.53697829178752), Q31(-0.97649903936228) }, { Q31(-0.97224737889348), Q31( 0.22081333579837) },
+{ Q31( 0.87392477144549), Q31(-0.12796173740361) }, { Q31( 0.19050361015753), Q31( 0.01602615387195) },
+{ Q31(-0.46353441212724), Q31(-0.95249041539006) }, { Q31(-0.07064096339021), Q31(-0.94479803205886) },
+{ Q31(-0.92444085484466), Q31(-0.10457590187436) }, { Q31(-0.83822593578728), Q31(-0.01695043208885) },
+{ Q31( 0.75214681811150), Q31(-0.99955681042665) }, { Q31(-0.42102998829339), Q31( 0.99720941999394) },
+{ Q31(-0.72094786237696), Q31(-0.35008961934255) }, { Q31( 0.78843311019251), Q31( 0.52851398958271) },
+{ Q31( 0.97394027897442), Q31(-0.26695944086561) }, { Q31( 0.99206463477946), Q31(-0.57010120849429) },
+{ Q31( 0.76789609461795), Q31(-0.76519356730966) }, { Q31(-0.82002421836409), Q31(-0.73530179553767) },
+{ Q31( 0.81924990025724), Q31( 0.99698425250579) }, { Q31(-0.26719850873357), Q31( 0.68903369776193) },
+{ Q31(-0.43311260380975), Q31( 0.85321815947490) }, { Q31( 0.99194979673836), Q31( 0.91876249766422) },
+{ Q31(-0.80692001248487), Q31(-0.32627540663214) }, { Q31( 0.43080003649976), Q31(-0.21919095636638) },
+{ Q31( 0.67709491937357), Q31(-0.95478075822906) }, { Q31( 0.56151770568316), Q31(-0.70693811747778) },
+{ Q31( 0.10831862810749), Q31(-0.08628837174592) }, { Q31( 0.91229417540436), Q31(-0.65987351408410) },
+{ Q31(-0.48972893932274), Q31( 0.56289246362686) }, { Q31(-0.89033658689697), Q31(-0.71656563987082) },
+{ Q31( 0.65269447475094), Q31( 0.65916004833932) }, { Q31( 0.67439478141121), Q31(-0.81684380846796) },
+{ Q31(-0.47770832416973), Q31(-0.16789556203025) }, { Q31(-0.99715979260878), Q31(-0.93565784007648) },
+{ Q31(-0.90889593602546), Q31( 0.62034397054380) }, { Q31(-0.06618622548177), Q31(-0.23812217221359) },
+{ Q31( 0.99430266919728), Q31( 0.18812555317553) }, { Q31( 0.97686402381843), Q31(-0.28664534366620) },
+{ Q31( 0.94813650221268), Q31(-0.97506640027128) }, { Q31(-0.95434497492853), Q31(-0.79607978501983) },
+{ Q31(-0.49104783137150), Q31( 0.32895214359663) }, { Q31( 0.99881175120751), Q31( 0.88993983831354) },
+{ Q31( 0.50449166760303), Q31(-0.85995072408434) }, { Q31( 0.47162891065108), Q31(-0.18680204049569) },
+{ Q31(-0.62081581361840), Q31( 0.75000676218956) }, { Q31(-0.43867015250812), Q31( 0.99998069244322) },
+{ Q31( 0.98630563232075), Q31(-0.53578899600662) }, { Q31(-0.61510362277374), Q31(-0.89515019899997) },
+{ Q31(-0.03841517601843), Q31(-0.69888815681179) }, { Q31(-0.30102157304644), Q31(-0.07667808922205) },
+{ Q31( 0.41881284182683), Q31( 0.02188098922282) }, { Q31(-0.86135454941237), Q31( 0.98947480909359) },
+{ Q31( 0.67226861393788), Q31(-0.13494389011014) }, { Q31(-0.70737398842068), Q31(-0.76547349325992) },
+{ Q31( 0.94044946687963), Q31( 0.09026201157416) }, { Q31(-0.82386352534327), Q31( 0.08924768823676) },
+{ Q31(-0.32070666698656), Q31( 0.50143421908753) }, { Q31( 0.57593163224487), Q31(-0.98966422921509) },
+{ Q31(-0.36326018419965), Q31( 0.07440243123228) }, { Q31( 0.99979044674350), Q31(-0.14130287347405) },
+{ Q31(-0.92366023326932), Q31(-0.97979298068180) }, { Q31(-0.44607178518598), Q31(-0.54233252016394) },
+{ Q31( 0.44226800932956), Q31( 0.71326756742752) }, { Q31( 0.03671907158312), Q31( 0.63606389366675) },
+{ Q31( 0.52175424682195), Q31(-0.85396826735705) }, { Q31(-0.94701139690956), Q31(-0.01826348194255) },
+{ Q31(-0.98759606946049), Q31( 0.82288714303073) }, { Q31( 0.87434794743625), Q31( 0.89399495655433) },
+{ Q31(-0.93412041758744), Q31( 0.41374052024363) }, { Q31( 0.96063943315511), Q31( 0.93116709541280) },
+{ Q31( 0.97534253457837), Q31( 0.86150930812689) }, { Q31( 0.99642466504163), Q31( 0.70190043427512) },
+{ Q31(-0.94705089665984), Q31(-0.29580042814306) }, { Q31( 0.91599807087376), Q31(-0.98147830385781) },
+{ Q31(-0.99948153278296), Q31(-0.59483417516607) }, { Q31( 0.97113454393991), Q31(-0.67528515225647) },
 };
 
 #endif /* AVCODEC_AACSBRDATA_H */
@@ -0,0 +1,246 @@
+/*
+ * This file is part of Libav.
+ *
+ * Libav is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * Libav is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Libav; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "libavutil/attributes.h"
+#include "libavutil/cpu.h"
+#include "libavutil/aarch64/cpu.h"
+#include "libavcodec/hevcdsp.h"
+
+#define QPEL_FUNC(name, depth)                                                \
+void ff_hevc_put_qpel_ ## name ## _ ## depth ## _neon(int16_t *dst,           \
+                                                      ptrdiff_t dststride,    \
+                                                      uint8_t *src,           \
+                                                      ptrdiff_t srcstride,    \
+                                                      int width, int height,  \
+                                                      int16_t *mcbuffer);
+
+#define EPEL_FUNC(name, depth)                                                \
+void ff_hevc_put_epel_ ## name ## _ ## depth ## _neon(int16_t *dst,           \
+                                                      ptrdiff_t dststride,    \
+                                                      uint8_t *src,           \
+                                                      ptrdiff_t srcstride,    \
+                                                      int width, int height,  \
+                                                      int mx, int my,         \
+                                                      int16_t *mcbuffer);
+
+#define HEVC_NEON_FUNCS(depth)                                                \
+    QPEL_FUNC(pixels, depth)                                                  \
+    QPEL_FUNC(h1,   depth) QPEL_FUNC(h2,   depth) QPEL_FUNC(h3,   depth)      \
+    QPEL_FUNC(v1,   depth) QPEL_FUNC(v2,   depth) QPEL_FUNC(v3,   depth)      \
+    QPEL_FUNC(h1v1, depth) QPEL_FUNC(h2v1, depth) QPEL_FUNC(h3v1, depth)      \
+    QPEL_FUNC(h1v2, depth) QPEL_FUNC(h2v2, depth) QPEL_FUNC(h3v2, depth)      \
+    QPEL_FUNC(h1v3, depth) QPEL_FUNC(h2v3, depth) QPEL_FUNC(h3v3, depth)      \
+    EPEL_FUNC(pixels, depth) EPEL_FUNC(h, depth)                              \
+    EPEL_FUNC(v, depth)      EPEL_FUNC(hv, depth)                             \
+                                                                              \
+void ff_hevc_transform_4x4_luma_add_ ## depth ## _neon(uint8_t *dst,          \
+                                                       int16_t *coeffs,       \
+                                                       ptrdiff_t stride);     \
+void ff_hevc_transform_4x4_add_ ## depth ## _neon(uint8_t *dst,               \
+                                                  int16_t *coeffs,            \
+                                                  ptrdiff_t stride);          \
+void ff_hevc_transform_8x8_add_ ## depth ## _neon(uint8_t *dst,               \
+                                                  int16_t *coeffs,            \
+                                                  ptrdiff_t stride);          \
+void ff_hevc_transform_16x16_add_ ## depth ## _neon(uint8_t *dst,             \
+                                                    int16_t *coeffs,          \
+                                                    ptrdiff_t stride);        \
+void ff_hevc_transform_32x32_add_ ## depth ## _neon(uint8_t *dst,             \
+                                                    int16_t *coeffs,          \
+                                                    ptrdiff_t stride);        \
+                                                                              \
+void ff_hevc_put_unweighted_pred_ ## depth ## _neon(uint8_t *dst,             \
+                                                    ptrdiff_t dststride,      \
+                                                    int16_t *src,             \
+                                                    ptrdiff_t srcstride,      \
+                                                    int width, int height);   \
+void ff_hevc_put_weighted_pred_avg_ ## depth ## _neon(uint8_t *dst,           \
+                                                      ptrdiff_t dststride,    \
+                                                      int16_t *src1,          \
+                                                      int16_t *src2,          \
+                                                      ptrdiff_t srcstride,    \
+                                                      int width, int height); \
+void ff_hevc_weighted_pred_ ## depth ## _neon(uint8_t *dst,                   \
+                                              ptrdiff_t dststride,            \
+                                              int16_t *src, const int *wp,    \
+                                              ptrdiff_t srcstride,            \
+                                              int width, int height);         \
+void ff_hevc_weighted_pred_avg_ ## depth ## _neon(uint8_t *dst,               \
+                                                  ptrdiff_t dststride,        \
+                                                  int16_t *src1,              \
+                                                  int16_t *src2,              \
+                                                  ptrdiff_t srcstride,        \
+                                                  int width, int height,      \
+                                                  const int *wp);             \
+                                                                              \
+void ff_hevc_h_loop_filter_luma_ ## depth ## _neon(uint8_t *pix,              \
+                                                   ptrdiff_t stride,          \
+                                                   int beta, int *tc,         \
+                                                   uint8_t *no_p,             \
+                                                   uint8_t *no_q);            \
+void ff_hevc_v_loop_filter_luma_ ## depth ## _neon(uint8_t *pix,              \
+                                                   ptrdiff_t stride,          \
+                                                   int beta, int *tc,         \
+                                                   uint8_t *no_p,             \
+                                                   uint8_t *no_q);            \
+void ff_hevc_h_loop_filter_chroma_ ## depth ## _neon(uint8_t *pix,            \
+                                                     ptrdiff_t stride,        \
+                                                     int *tc, uint8_t *no_p,  \
+                                                     uint8_t *no_q);          \
+void ff_hevc_v_loop_filter_chroma_ ## depth ## _neon(uint8_t *pix,            \
+                                                     ptrdiff_t stride,        \
+                                                     int *tc, uint8_t *no_p,  \
+                                                     uint8_t *no_q);          \
+                                                                              \
+void ff_hevc_sao_band_filter_ ## depth ## _neon(uint8_t *dst, uint8_t *src,   \
+                                                ptrdiff_t stride,             \
+                                                const int8_t *offset_table,   \
+                                                int width, int height);       \
+void ff_hevc_sao_edge_filter_ ## depth ## _neon(uint8_t *dst, uint8_t *src,   \
+                                                ptrdiff_t stride,             \
+                                                const int8_t *offset_table,   \
+                                                ptrdiff_t a, ptrdiff_t b,     \
+                                                int width, int height);
+
+HEVC_NEON_FUNCS(8)
+HEVC_NEON_FUNCS(10)
+
+#define HEVC_NEON_WRAPPERS(depth)                                             \
+static void weighted_pred_ ## depth ## _neon(uint8_t denom,                   \
+                                             int16_t wlxFlag,                 \
+                                             int16_t olxFlag,                 \
+                                             uint8_t *dst,                    \
+                                             ptrdiff_t dststride,             \
+                                             int16_t *src,                    \
+                                             ptrdiff_t srcstride,             \
+                                             int width, int height)           \
+{                                                                             \
+    const int wp[3] = { denom + 14 - depth, wlxFlag,                          \
+                        olxFlag * (1 << (depth - 8)) };                       \
+    ff_hevc_weighted_pred_ ## depth ## _neon(dst, dststride, src, wp,         \
+                                             srcstride, width, height);       \
+}                                                                             \
+                                                                              \
+static void weighted_pred_avg_ ## depth ## _neon(uint8_t denom,               \
+                                                 int16_t wl0Flag,             \
+                                                 int16_t wl1Flag,             \
+                                                 int16_t ol0Flag,             \
+                                                 int16_t ol1Flag,             \
+                                                 uint8_t *dst,                \
+                                                 ptrdiff_t dststride,         \
+                                                 int16_t *src1,               \
+                                                 int16_t *src2,               \
+                                                 ptrdiff_t srcstride,         \
+                                                 int width, int height)       \
+{                                                                             \
+    const int log2Wd = denom + 14 - depth;                                    \
+    const int o0     = ol0Flag * (1 << (depth - 8));                          \
+    const int o1     = ol1Flag * (1 << (depth - 8));                          \
+    const int wp[4]  = { log2Wd + 1, wl0Flag, wl1Flag,                        \
+                         (o0 + o1 + 1) << log2Wd };                           \
+    ff_hevc_weighted_pred_avg_ ## depth ## _neon(dst, dststride, src1, src2,  \
+                                                 srcstride, width, height,    \
+                                                 wp);                         \
+}                                                                             \
+                                                                              \
+static void sao_band_filter_0_ ## depth ## _neon(uint8_t *dst, uint8_t *src,  \
+                                                 ptrdiff_t stride,            \
+                                                 SAOParams *sao,              \
+                                                 int *borders, int width,     \
+                                                 int height, int c_idx)       \
+{                                                                             \
+    ff_hevc_sao_band_filter_0(dst, src, stride, sao, borders, width, height,  \
+                              c_idx,                                          \
+                              ff_hevc_sao_band_filter_ ## depth ## _neon);    \
+}                                                                             \
+                                                                              \
+static void sao_edge_filter_0_ ## depth ## _neon(uint8_t *dst, uint8_t *src,  \
+                                                 ptrdiff_t stride,            \
+                                                 SAOParams *sao,              \
+                                                 int *borders, int width,     \
+                                                 int height, int c_idx,       \
+                                                 uint8_t vert_edge,           \
+                                                 uint8_t horiz_edge,          \
+                                                 uint8_t diag_edge)           \
+{                                                                             \
+    ff_hevc_sao_edge_filter_0(dst, src, stride, sao, borders, width, height,  \
+                              c_idx, vert_edge, horiz_edge, diag_edge,        \
+                              depth > 8,                                      \
+                              ff_hevc_sao_edge_filter_ ## depth ## _neon);    \
+}
+
+HEVC_NEON_WRAPPERS(8)
+HEVC_NEON_WRAPPERS(10)
+
+#define HEVC_NEON_INIT(depth)                                                 \
+    c->put_hevc_qpel[0][0] = ff_hevc_put_qpel_pixels_ ## depth ## _neon;      \
+    c->put_hevc_qpel[0][1] = ff_hevc_put_qpel_h1_    ## depth ## _neon;       \
+    c->put_hevc_qpel[0][2] = ff_hevc_put_qpel_h2_    ## depth ## _neon;       \
+    c->put_hevc_qpel[0][3] = ff_hevc_put_qpel_h3_    ## depth ## _neon;       \
+    c->put_hevc_qpel[1][0] = ff_hevc_put_qpel_v1_    ## depth ## _neon;       \
+    c->put_hevc_qpel[1][1] = ff_hevc_put_qpel_h1v1_  ## depth ## _neon;       \
+    c->put_hevc_qpel[1][2] = ff_hevc_put_qpel_h2v1_  ## depth ## _neon;       \
+    c->put_hevc_qpel[1][3] = ff_hevc_put_qpel_h3v1_  ## depth ## _neon;       \
+    c->put_hevc_qpel[2][0] = ff_hevc_put_qpel_v2_    ## depth ## _neon;       \
+    c->put_hevc_qpel[2][1] = ff_hevc_put_qpel_h1v2_  ## depth ## _neon;       \
+    c->put_hevc_qpel[2][2] = ff_hevc_put_qpel_h2v2_  ## depth ## _neon;       \
+    c->put_hevc_qpel[2][3] = ff_hevc_put_qpel_h3v2_  ## depth ## _neon;       \
+    c->put_hevc_qpel[3][0] = ff_hevc_put_qpel_v3_    ## depth ## _neon;       \
+    c->put_hevc_qpel[3][1] = ff_hevc_put_qpel_h1v3_  ## depth ## _neon;       \
+    c->put_hevc_qpel[3][2] = ff_hevc_put_qpel_h2v3_  ## depth ## _neon;       \
+    c->put_hevc_qpel[3][3] = ff_hevc_put_qpel_h3v3_  ## depth ## _neon;       \
+                                                                              \
+    c->put_hevc_epel[0][0] = ff_hevc_put_epel_pixels_ ## depth ## _neon;      \
+    c->put_hevc_epel[0][1] = ff_hevc_put_epel_h_      ## depth ## _neon;      \
+    c->put_hevc_epel[1][0] = ff_hevc_put_epel_v_      ## depth ## _neon;      \
+    c->put_hevc_epel[1][1] = ff_hevc_put_epel_hv_     ## depth ## _neon;      \
+                                                                              \
+    c->transform_4x4_luma_add = ff_hevc_transform_4x4_luma_add_ ## depth ## _neon; \
+    c->transform_add[0]       = ff_hevc_transform_4x4_add_   ## depth ## _neon; \
+    c->transform_add[1]       = ff_hevc_transform_8x8_add_   ## depth ## _neon; \
+    c->transform_add[2]       = ff_hevc_transform_16x16_add_ ## depth ## _neon; \
+    c->transform_add[3]       = ff_hevc_transform_32x32_add_ ## depth ## _neon; \
+                                                                              \
+    c->sao_band_filter[0] = sao_band_filter_0_ ## depth ## _neon;             \
+    c->sao_edge_filter[0] = sao_edge_filter_0_ ## depth ## _neon;             \
+                                                                              \
+    c->put_unweighted_pred   = ff_hevc_put_unweighted_pred_   ## depth ## _neon; \
+    c->put_weighted_pred_avg = ff_hevc_put_weighted_pred_avg_ ## depth ## _neon; \
+    c->weighted_pred         = weighted_pred_     ## depth ## _neon;          \
+    c->weighted_pred_avg     = weighted_pred_avg_ ## depth ## _neon;          \
+                                                                              \
+    c->hevc_h_loop_filter_luma   = ff_hevc_h_loop_filter_luma_   ## depth ## _neon; \
+    c->hevc_v_loop_filter_luma   = ff_hevc_v_loop_filter_luma_   ## depth ## _neon; \
+    c->hevc_h_loop_filter_chroma = ff_hevc_h_loop_filter_chroma_ ## depth ## _neon; \
+    c->hevc_v_loop_filter_chroma = ff_hevc_v_loop_filter_chroma_ ## depth ## _neon;
+
+av_cold void ff_hevc_dsp_init_aarch64(HEVCDSPContext *c, const int bit_depth)
+{
+    int cpu_flags = av_get_cpu_flags();
+
+    if (have_neon(cpu_flags)) {
+        if (bit_depth == 8) {
+            HEVC_NEON_INIT(8);
+        } else if (bit_depth == 10) {
+            HEVC_NEON_INIT(10);
+        }
+    }
+}
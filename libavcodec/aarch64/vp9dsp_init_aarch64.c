@@ -0,0 +1,307 @@
+/*
+ * This file is part of Libav.
+ *
+ * Libav is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * Libav is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Libav; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "libavutil/attributes.h"
+#include "libavutil/internal.h"
+#include "libavutil/mem.h"
+#include "libavutil/aarch64/cpu.h"
+#include "libavcodec/vp9.h"
+
+#define fpel_func(type, sz)                                             \
+void ff_vp9_ ## type ## sz ## _neon(uint8_t *dst, const uint8_t *src,   \
+                                    ptrdiff_t dst_stride,               \
+                                    ptrdiff_t src_stride,               \
+                                    int h, int mx, int my)
+
+#define fpel_funcs(sz)     \
+    fpel_func(copy, sz);   \
+    fpel_func(avg,  sz)
+
+fpel_funcs(64);
+fpel_funcs(32);
+fpel_funcs(16);
+fpel_funcs(8);
+fpel_funcs(4);
+
+#undef fpel_funcs
+#undef fpel_func
+
+#define mc_func(op, dir, sz)                                                \
+void ff_vp9_ ## op ## _8tap_ ## dir ## _ ## sz ## _neon(uint8_t *dst,       \
+                                                        const uint8_t *src, \
+                                                        ptrdiff_t dst_stride, \
+                                                        ptrdiff_t src_stride, \
+                                                        int h,              \
+                                                        const int8_t *filter)
+
+#define mc_funcs(sz)      \
+    mc_func(put, h, sz);  \
+    mc_func(avg, h, sz);  \
+    mc_func(put, v, sz);  \
+    mc_func(avg, v, sz)
+
+mc_funcs(64);
+mc_funcs(32);
+mc_funcs(16);
+mc_funcs(8);
+mc_funcs(4);
+
+#undef mc_funcs
+#undef mc_func
+
+#define filter_8tap_1d_fn(op, sz, f, fname, dir, dvar)                  \
+static void                                                             \
+op ## _8tap_ ## fname ## _ ## sz ## dir ## _neon(uint8_t *dst,          \
+                                                 const uint8_t *src,    \
+                                                 ptrdiff_t dst_stride,  \
+                                                 ptrdiff_t src_stride,  \
+                                                 int h, int mx, int my) \
+{                                                                       \
+    ff_vp9_ ## op ## _8tap_ ## dir ## _ ## sz ## _neon(dst, src,        \
+                                                       dst_stride,      \
+                                                       src_stride, h,   \
+                                                       ff_vp9_subpel_filters[f][dvar - 1]); \
+}
+
+/* The 2D case filters h + 7 rows horizontally into a temporary buffer
+ * first, then vertically from there. */
+#define filter_8tap_2d_fn(op, sz, f, fname)                             \
+static void                                                             \
+op ## _8tap_ ## fname ## _ ## sz ## hv_neon(uint8_t *dst,               \
+                                            const uint8_t *src,         \
+                                            ptrdiff_t dst_stride,       \
+                                            ptrdiff_t src_stride,       \
+                                            int h, int mx, int my)      \
+{                                                                       \
+    LOCAL_ALIGNED_16(uint8_t, temp, [71 * 64]);                         \
+    ff_vp9_put_8tap_h_ ## sz ## _neon(temp, src - 3 * src_stride,       \
+                                      64, src_stride, h + 7,            \
+                                      ff_vp9_subpel_filters[f][mx - 1]); \
+    ff_vp9_ ## op ## _8tap_v_ ## sz ## _neon(dst, temp + 3 * 64,        \
+                                             dst_stride, 64, h,         \
+                                             ff_vp9_subpel_filters[f][my - 1]); \
+}
+
+#define filters_8tap_fn(op, sz, f, fname)      \
+    filter_8tap_1d_fn(op, sz, f, fname, h, mx) \
+    filter_8tap_1d_fn(op, sz, f, fname, v, my) \
+    filter_8tap_2d_fn(op, sz, f, fname)
+
+#define filters_8tap_fn2(op, sz)                          \
+    filters_8tap_fn(op, sz, FILTER_8TAP_REGULAR, regular) \
+    filters_8tap_fn(op, sz, FILTER_8TAP_SHARP,   sharp)   \
+    filters_8tap_fn(op, sz, FILTER_8TAP_SMOOTH,  smooth)
+
+#define filters_8tap_fn3(op)  \
+    filters_8tap_fn2(op, 64)  \
+    filters_8tap_fn2(op, 32)  \
+    filters_8tap_fn2(op, 16)  \
+    filters_8tap_fn2(op, 8)   \
+    filters_8tap_fn2(op, 4)
+
+filters_8tap_fn3(put)
+filters_8tap_fn3(avg)
+
+#undef filters_8tap_fn3
+#undef filters_8tap_fn2
+#undef filters_8tap_fn
+#undef filter_8tap_2d_fn
+#undef filter_8tap_1d_fn
+
+#define ipred_func(mode, sz)                                            \
+void ff_vp9_ ## mode ## _ ## sz ## _neon(uint8_t *dst, ptrdiff_t stride, \
+                                         const uint8_t *left,           \
+                                         const uint8_t *top)
+
+#define ipred_funcs(sz)      \
+    ipred_func(vert,    sz); \
+    ipred_func(hor,     sz); \
+    ipred_func(dc,      sz); \
+    ipred_func(dc_left, sz); \
+    ipred_func(dc_top,  sz); \
+    ipred_func(tm,      sz)
+
+ipred_funcs(4x4);
+ipred_funcs(8x8);
+ipred_funcs(16x16);
+ipred_funcs(32x32);
+
+#undef ipred_funcs
+#undef ipred_func
+
+#define itxfm_func(type_a, type_b, sz)                                  \
+void ff_vp9_ ## type_a ## _ ## type_b ## _ ## sz ## _add_neon(uint8_t *dst, \
+                                                              ptrdiff_t stride, \
+                                                              int16_t *block, \
+                                                              int eob)
+
+#define itxfm_funcs(sz)           \
+    itxfm_func(idct,  idct,  sz); \
+    itxfm_func(iadst, idct,  sz); \
+    itxfm_func(idct,  iadst, sz); \
+    itxfm_func(iadst, iadst, sz)
+
+itxfm_funcs(4x4);
+itxfm_funcs(8x8);
+itxfm_funcs(16x16);
+itxfm_func(idct, idct, 32x32);
+
+#undef itxfm_funcs
+#undef itxfm_func
+
+#define lf_func(dir, wd, sz)                                            \
+void ff_vp9_loop_filter_ ## dir ## _ ## wd ## _ ## sz ## _neon(uint8_t *dst, \
+                                                               ptrdiff_t stride, \
+                                                               int E, int I, \
+                                                               int H)
+
+#define lf_funcs(wd, sz)   \
+    lf_func(h, wd, sz);    \
+    lf_func(v, wd, sz)
+
+lf_funcs(4,  8);
+lf_funcs(8,  8);
+lf_funcs(16, 8);
+lf_funcs(16, 16);
+lf_funcs(44, 16);
+lf_funcs(48, 16);
+lf_funcs(84, 16);
+lf_funcs(88, 16);
+
+#undef lf_funcs
+#undef lf_func
+
+static av_cold void vp9dsp_mc_init_aarch64(VP9DSPContext *dsp)
+{
+#define init_fpel(idx1, idx2, sz, type)                                 \
+    dsp->mc[idx1][FILTER_8TAP_SMOOTH ][idx2][0][0] =                    \
+    dsp->mc[idx1][FILTER_8TAP_REGULAR][idx2][0][0] =                    \
+    dsp->mc[idx1][FILTER_8TAP_SHARP  ][idx2][0][0] =                    \
+    dsp->mc[idx1][FILTER_BILINEAR    ][idx2][0][0] = ff_vp9_ ## type ## sz ## _neon
+
+#define init_subpel1(idx1, idx2, idxh, idxv, sz, dir, type)                                    \
+    dsp->mc[idx1][FILTER_8TAP_SMOOTH ][idx2][idxh][idxv] = type ## _8tap_smooth_  ## sz ## dir ## _neon; \
+    dsp->mc[idx1][FILTER_8TAP_REGULAR][idx2][idxh][idxv] = type ## _8tap_regular_ ## sz ## dir ## _neon; \
+    dsp->mc[idx1][FILTER_8TAP_SHARP  ][idx2][idxh][idxv] = type ## _8tap_sharp_   ## sz ## dir ## _neon
+
+#define init_subpel2(idx, idxh, idxv, dir, type)     \
+    init_subpel1(0, idx, idxh, idxv, 64, dir, type); \
+    init_subpel1(1, idx, idxh, idxv, 32, dir, type); \
+    init_subpel1(2, idx, idxh, idxv, 16, dir, type); \
+    init_subpel1(3, idx, idxh, idxv,  8, dir, type); \
+    init_subpel1(4, idx, idxh, idxv,  4, dir, type)
+
+#define init_subpel3(idx, type)        \
+    init_subpel2(idx, 1, 1, hv, type); \
+    init_subpel2(idx, 0, 1,  v, type); \
+    init_subpel2(idx, 1, 0,  h, type)
+
+    init_fpel(0, 0, 64, copy);
+    init_fpel(1, 0, 32, copy);
+    init_fpel(2, 0, 16, copy);
+    init_fpel(3, 0,  8, copy);
+    init_fpel(4, 0,  4, copy);
+    init_fpel(0, 1, 64, avg);
+    init_fpel(1, 1, 32, avg);
+    init_fpel(2, 1, 16, avg);
+    init_fpel(3, 1,  8, avg);
+    init_fpel(4, 1,  4, avg);
+
+    init_subpel3(0, put);
+    init_subpel3(1, avg);
+
+#undef init_subpel3
+#undef init_subpel2
+#undef init_subpel1
+#undef init_fpel
+}
+
+static av_cold void vp9dsp_intrapred_init_aarch64(VP9DSPContext *dsp)
+{
+#define init_ipred(tx, sz)                                                   \
+    dsp->intra_pred[tx][VERT_PRED]    = ff_vp9_vert_    ## sz ## _neon;      \
+    dsp->intra_pred[tx][HOR_PRED]     = ff_vp9_hor_     ## sz ## _neon;      \
+    dsp->intra_pred[tx][DC_PRED]      = ff_vp9_dc_      ## sz ## _neon;      \
+    dsp->intra_pred[tx][TM_VP8_PRED]  = ff_vp9_tm_      ## sz ## _neon;      \
+    dsp->intra_pred[tx][LEFT_DC_PRED] = ff_vp9_dc_left_ ## sz ## _neon;      \
+    dsp->intra_pred[tx][TOP_DC_PRED]  = ff_vp9_dc_top_  ## sz ## _neon
+
+    init_ipred(TX_4X4,   4x4);
+    init_ipred(TX_8X8,   8x8);
+    init_ipred(TX_16X16, 16x16);
+    init_ipred(TX_32X32, 32x32);
+
+#undef init_ipred
+}
+
+static av_cold void vp9dsp_itxfm_init_aarch64(VP9DSPContext *dsp)
+{
+#define init_itxfm(tx, sz)                                                   \
+    dsp->itxfm_add[tx][DCT_DCT]   = ff_vp9_idct_idct_   ## sz ## _add_neon;  \
+    dsp->itxfm_add[tx][DCT_ADST]  = ff_vp9_iadst_idct_  ## sz ## _add_neon;  \
+    dsp->itxfm_add[tx][ADST_DCT]  = ff_vp9_idct_iadst_  ## sz ## _add_neon;  \
+    dsp->itxfm_add[tx][ADST_ADST] = ff_vp9_iadst_iadst_ ## sz ## _add_neon
+
+    init_itxfm(TX_4X4,   4x4);
+    init_itxfm(TX_8X8,   8x8);
+    init_itxfm(TX_16X16, 16x16);
+
+    dsp->itxfm_add[TX_32X32][DCT_DCT]   =
+    dsp->itxfm_add[TX_32X32][ADST_DCT]  =
+    dsp->itxfm_add[TX_32X32][DCT_ADST]  =
+    dsp->itxfm_add[TX_32X32][ADST_ADST] = ff_vp9_idct_idct_32x32_add_neon;
+
+#undef init_itxfm
+}
+
+static av_cold void vp9dsp_loopfilter_init_aarch64(VP9DSPContext *dsp)
+{
+    dsp->loop_filter_8[0][0] = ff_vp9_loop_filter_h_4_8_neon;
+    dsp->loop_filter_8[0][1] = ff_vp9_loop_filter_v_4_8_neon;
+    dsp->loop_filter_8[1][0] = ff_vp9_loop_filter_h_8_8_neon;
+    dsp->loop_filter_8[1][1] = ff_vp9_loop_filter_v_8_8_neon;
+    dsp->loop_filter_8[2][0] = ff_vp9_loop_filter_h_16_8_neon;
+    dsp->loop_filter_8[2][1] = ff_vp9_loop_filter_v_16_8_neon;
+
+    dsp->loop_filter_16[0] = ff_vp9_loop_filter_h_16_16_neon;
+    dsp->loop_filter_16[1] = ff_vp9_loop_filter_v_16_16_neon;
+
+    dsp->loop_filter_mix2[0][0][0] = ff_vp9_loop_filter_h_44_16_neon;
+    dsp->loop_filter_mix2[0][0][1] = ff_vp9_loop_filter_v_44_16_neon;
+    dsp->loop_filter_mix2[0][1][0] = ff_vp9_loop_filter_h_48_16_neon;
+    dsp->loop_filter_mix2[0][1][1] = ff_vp9_loop_filter_v_48_16_neon;
+    dsp->loop_filter_mix2[1][0][0] = ff_vp9_loop_filter_h_84_16_neon;
+    dsp->loop_filter_mix2[1][0][1] = ff_vp9_loop_filter_v_84_16_neon;
+    dsp->loop_filter_mix2[1][1][0] = ff_vp9_loop_filter_h_88_16_neon;
+    dsp->loop_filter_mix2[1][1][1] = ff_vp9_loop_filter_v_88_16_neon;
+}
+
+av_cold void ff_vp9dsp_init_aarch64(VP9DSPContext *dsp)
+{
+    int cpu_flags = av_get_cpu_flags();
+
+    if (have_neon(cpu_flags)) {
+        vp9dsp_mc_init_aarch64(dsp);
+        vp9dsp_intrapred_init_aarch64(dsp);
+        vp9dsp_itxfm_init_aarch64(dsp);
+        vp9dsp_loopfilter_init_aarch64(dsp);
+    }
+}
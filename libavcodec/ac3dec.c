@@ -180,14 +180,43 @@ static av_cold int ac3_decode_init(AVCodecContext *avctx)
     ac3_tables_init();
     ff_mdct_init(&s->imdct_256, 8, 1, 1.0);
     ff_mdct_init(&s->imdct_512, 9, 1, 1.0);
-    ff_kbd_window_init(s->window, 5.0, 256);
     ff_bswapdsp_init(&s->bdsp);
-    avpriv_float_dsp_init(&s->fdsp, avctx->flags & CODEC_FLAG_BITEXACT);
     ff_ac3dsp_init(&s->ac3dsp, avctx->flags & CODEC_FLAG_BITEXACT);
-    ff_fmt_convert_init(&s->fmt_conv, avctx);
     av_lfg_init(&s->dith_state, 0);
 
-    avctx->sample_fmt = AV_SAMPLE_FMT_FLTP;
+#if CONFIG_AC3DEC_FIXED
+    {
+        float window[AC3_BLOCK_SIZE];
+
+        ff_kbd_window_init(window, 5.0, 256);
+        for (i = 0; i < AC3_BLOCK_SIZE; i++)
+            s->window[i] = av_clipl_int32(llrint(window[i] * 2147483648.0));
+    }
+    for (i = 0; i < 256; i++) {
+        /* Allow asymmetric application of DRC when drc_scale > 1.
+           Amplification of quiet sounds is enhanced */
+        float range = dynamic_range_tab[i];
+        if (range > 1.0 || s->drc_scale <= 1.0)
+            range = powf(range, s->drc_scale);
+        s->dynamic_range_tab[i] = FFMIN(llrintf(range * (1 << 24)), INT_MAX);
+    }
+
+    avctx->sample_fmt = avctx->request_sample_fmt == AV_SAMPLE_FMT_S32P ?
+                        AV_SAMPLE_FMT_S32P : AV_SAMPLE_FMT_S16P;
+#else
+    ff_kbd_window_init(s->window, 5.0, 256);
+    avpriv_float_dsp_init(&s->fdsp, avctx->flags & CODEC_FLAG_BITEXACT);
+    ff_fmt_convert_init(&s->fmt_conv, avctx);
+
+    if (avctx->request_sample_fmt == AV_SAMPLE_FMT_S16) {
+        /* windowing scales the output to the 16-bit range */
+        for (i = 0; i < AC3_BLOCK_SIZE; i++)
+            s->window[i] *= 32768.0f;
+        avctx->sample_fmt = AV_SAMPLE_FMT_S16;
+    } else {
+        avctx->sample_fmt = AV_SAMPLE_FMT_FLTP;
+    }
+#endif
 
     /* allow downmixing to stereo or mono */
 #if FF_API_REQUEST_CHANNELS
@@ -327,7 +356,7 @@ static int parse_frame_header(AC3DecodeContext *s)
         s->skip_syntax           = 1;
         memset(s->channel_uses_aht, 0, sizeof(s->channel_uses_aht));
         return ac3_parse_header(s);
-    } else if (CONFIG_EAC3_DECODER) {
+    } else if (CONFIG_AC3DEC_EAC3) {
         s->eac3 = 1;
         return ff_eac3_parse_header(s);
     } else {
@@ -346,40 +375,51 @@ static void set_downmix_coeffs(AC3DecodeContext *s)
     float cmix = gain_levels[s->  center_mix_level];
     float smix = gain_levels[s->surround_mix_level];
     float norm0, norm1;
+    float downmix_coeffs[AC3_MAX_CHANNELS][2];
 
     for (i = 0; i < s->fbw_channels; i++) {
-        s->downmix_coeffs[i][0] = gain_levels[ac3_default_coeffs[s->channel_mode][i][0]];
-        s->downmix_coeffs[i][1] = gain_levels[ac3_default_coeffs[s->channel_mode][i][1]];
+        downmix_coeffs[i][0] = gain_levels[ac3_default_coeffs[s->channel_mode][i][0]];
+        downmix_coeffs[i][1] = gain_levels[ac3_default_coeffs[s->channel_mode][i][1]];
     }
     if (s->channel_mode > 1 && s->channel_mode & 1) {
-        s->downmix_coeffs[1][0] = s->downmix_coeffs[1][1] = cmix;
+        downmix_coeffs[1][0] = downmix_coeffs[1][1] = cmix;
     }
     if (s->channel_mode == AC3_CHMODE_2F1R || s->channel_mode == AC3_CHMODE_3F1R) {
         int nf = s->channel_mode - 2;
-        s->downmix_coeffs[nf][0] = s->downmix_coeffs[nf][1] = smix * LEVEL_MINUS_3DB;
+        downmix_coeffs[nf][0] = downmix_coeffs[nf][1] = smix * LEVEL_MINUS_3DB;
     }
     if (s->channel_mode == AC3_CHMODE_2F2R || s->channel_mode == AC3_CHMODE_3F2R) {
         int nf = s->channel_mode - 4;
-        s->downmix_coeffs[nf][0] = s->downmix_coeffs[nf+1][1] = smix;
+        downmix_coeffs[nf][0] = downmix_coeffs[nf+1][1] = smix;
     }
 
     /* renormalize */
     norm0 = norm1 = 0.0;
     for (i = 0; i < s->fbw_channels; i++) {
-        norm0 += s->downmix_coeffs[i][0];
-        norm1 += s->downmix_coeffs[i][1];
+        norm0 += downmix_coeffs[i][0];
+        norm1 += downmix_coeffs[i][1];
     }
     norm0 = 1.0f / norm0;
     norm1 = 1.0f / norm1;
     for (i = 0; i < s->fbw_channels; i++) {
-        s->downmix_coeffs[i][0] *= norm0;
-        s->downmix_coeffs[i][1] *= norm1;
+        downmix_coeffs[i][0] *= norm0;
+        downmix_coeffs[i][1] *= norm1;
     }
 
     if (s->output_mode == AC3_CHMODE_MONO) {
         for (i = 0; i < s->fbw_channels; i++)
-            s->downmix_coeffs[i][0] = (s->downmix_coeffs[i][0] +
-                                       s->downmix_coeffs[i][1]) * LEVEL_MINUS_3DB;
+            downmix_coeffs[i][0] = (downmix_coeffs[i][0] +
+                                    downmix_coeffs[i][1]) * LEVEL_MINUS_3DB;
+    }
+
+    for (i = 0; i < s->fbw_channels; i++) {
+#if CONFIG_AC3DEC_FIXED
+        s->downmix_coeffs[i][0] = lrintf(downmix_coeffs[i][0] * (1 << 24));
+        s->downmix_coeffs[i][1] = lrintf(downmix_coeffs[i][1] * (1 << 24));
+#else
+        s->downmix_coeffs[i][0] = downmix_coeffs[i][0];
+        s->downmix_coeffs[i][1] = downmix_coeffs[i][1];
+#endif
     }
 }
 
@@ -565,7 +605,7 @@ static void decode_transform_coeffs_ch(AC3DecodeContext *s, int blk, int ch,
         /* if AHT is used, mantissas for all blocks are encoded in the first
            block of the frame. */
         int bin;
-        if (!blk && CONFIG_EAC3_DECODER)
+        if (!blk && CONFIG_AC3DEC_EAC3)
             ff_eac3_decode_transform_coeffs_aht_ch(s, ch);
         for (bin = s->start_freq[ch]; bin < s->end_freq[ch]; bin++) {
             s->fixed_coeffs[ch][bin] = s->pre_mantissa[ch][bin][blk] >> s->dexps[ch][bin];
@@ -631,6 +671,27 @@ static void do_rematrixing(AC3DecodeContext *s)
     }
 }
 
+/**
+ * Overlap the windowed first half of tmp_output with the delay samples.
+ */
+static inline void window_output(AC3DecodeContext *s, SampleType *dst,
+                                 const SampleType *delay)
+{
+#if CONFIG_AC3DEC_FIXED
+    const SampleType *src = s->tmp_output;
+    int i, j;
+
+    for (i = 0, j = 255; i < 128; i++, j--) {
+        int64_t s0 = delay[i], s1 = src[j - 128];
+        int64_t wi = s->window[i], wj = s->window[j];
+        dst[i] = (s0 * wj - s1 * wi + 0x40000000) >> 31;
+        dst[j] = (s0 * wi + s1 * wj + 0x40000000) >> 31;
+    }
+#else
+    s->fdsp.vector_fmul_window(dst, delay, s->tmp_output, s->window, 128);
+#endif
+}
+
 /**
  * Inverse MDCT Transform.
  * Convert frequency domain coefficients to time-domain audio samples.
@@ -643,24 +704,33 @@ static inline void do_imdct(AC3DecodeContext *s, int channels)
     for (ch = 1; ch <= channels; ch++) {
         if (s->block_switch[ch]) {
             int i;
-            float *x = s->tmp_output + 128;
+            SampleType *x = s->tmp_output + 128;
             for (i = 0; i < 128; i++)
                 x[i] = s->transform_coeffs[ch][2 * i];
             s->imdct_256.imdct_half(&s->imdct_256, s->tmp_output, x);
-            s->fdsp.vector_fmul_window(s->outptr[ch - 1], s->delay[ch - 1],
-                                       s->tmp_output, s->window, 128);
+            window_output(s, s->outptr[ch - 1], s->delay[ch - 1]);
             for (i = 0; i < 128; i++)
                 x[i] = s->transform_coeffs[ch][2 * i + 1];
             s->imdct_256.imdct_half(&s->imdct_256, s->delay[ch - 1], x);
         } else {
             s->imdct_512.imdct_half(&s->imdct_512, s->tmp_output, s->transform_coeffs[ch]);
-            s->fdsp.vector_fmul_window(s->outptr[ch - 1], s->delay[ch - 1],
-                                       s->tmp_output, s->window, 128);
-            memcpy(s->delay[ch - 1], s->tmp_output + 128, 128 * sizeof(float));
+            window_output(s, s->outptr[ch - 1], s->delay[ch - 1]);
+            memcpy(s->delay[ch - 1], s->tmp_output + 128, 128 * sizeof(SampleType));
         }
     }
 }
 
+static void downmix(AC3DecodeContext *s, SampleType **samples, int len)
+{
+#if CONFIG_AC3DEC_FIXED
+    s->ac3dsp.downmix_fixed(samples, s->downmix_coeffs, s->out_channels,
+                            s->fbw_channels, len);
+#else
+    s->ac3dsp.downmix(samples, s->downmix_coeffs, s->out_channels,
+                      s->fbw_channels, len);
+#endif
+}
+
 /**
  * Upmix delay samples from stereo to original channel layout.
  */
@@ -789,6 +859,9 @@ static int decode_audio_block(AC3DecodeContext *s, int blk)
     i = !s->channel_mode;
     do {
         if (get_bits1(gbc)) {
+#if CONFIG_AC3DEC_FIXED
+            s->dynamic_range[i] = s->dynamic_range_tab[get_bits(gbc, 8)];
+#else
             /* Allow asymmetric application of DRC when drc_scale > 1.
                Amplification of quiet sounds is enhanced */
             float range = dynamic_range_tab[get_bits(gbc, 8)];
@@ -796,8 +869,13 @@ static int decode_audio_block(AC3DecodeContext *s, int blk)
                 s->dynamic_range[i] = powf(range, s->drc_scale);
             else
                 s->dynamic_range[i] = range;
+#endif
         } else if (blk == 0) {
+#if CONFIG_AC3DEC_FIXED
+            s->dynamic_range[i] = 1 << 24;
+#else
             s->dynamic_range[i] = 1.0f;
+#endif
         }
     } while (i--);
 
@@ -863,26 +941,46 @@ static int decode_audio_block(AC3DecodeContext *s, int blk)
         for (ch = 1; ch <= fbw_channels; ch++) {
             if (s->channel_uses_spx[ch]) {
                 if (s->first_spx_coords[ch] || get_bits1(gbc)) {
-                    float spx_blend;
                     int bin, master_spx_coord;
+#if CONFIG_AC3DEC_FIXED
+                    int spx_blend;
+#else
+                    float spx_blend;
+#endif
 
                     s->first_spx_coords[ch] = 0;
+#if CONFIG_AC3DEC_FIXED
+                    spx_blend = get_bits(gbc, 5) << 10;
+#else
                     spx_blend = get_bits(gbc, 5) * (1.0f/32);
+#endif
                     master_spx_coord = get_bits(gbc, 2) * 3;
 
                     bin = s->spx_src_start_freq;
                     for (bnd = 0; bnd < s->num_spx_bands; bnd++) {
                         int bandsize;
                         int spx_coord_exp, spx_coord_mant;
+#if CONFIG_AC3DEC_FIXED
+                        int nratio, sblend, nblend;
+#else
                         float nratio, sblend, nblend, spx_coord;
+#endif
 
                         /* calculate blending factors */
                         bandsize = s->spx_band_sizes[bnd];
+#if CONFIG_AC3DEC_FIXED
+                        /* Q15 */
+                        nratio = ((bin + (bandsize >> 1)) << 15) / s->spx_dst_end_freq - spx_blend;
+                        nratio = av_clip(nratio, 0, 1 << 15);
+                        nblend = ff_sqrt((3U * nratio) << 15);
+                        sblend = ff_sqrt(((1 << 15) - nratio) << 15);
+#else
                         nratio = ((float)((bin + (bandsize >> 1))) / s->spx_dst_end_freq) - spx_blend;
                         nratio = av_clipf(nratio, 0.0f, 1.0f);
                         nblend = sqrtf(3.0f * nratio); // noise is scaled by sqrt(3)
                                                        // to give unity variance
                         sblend = sqrtf(1.0f - nratio);
+#endif
                         bin += bandsize;
 
                         /* decode spx coordinates */
@@ -891,11 +989,16 @@ static int decode_audio_block(AC3DecodeContext *s, int blk)
                         if (spx_coord_exp == 15) spx_coord_mant <<= 1;
                         else                     spx_coord_mant += 4;
                         spx_coord_mant <<= (25 - spx_coord_exp - master_spx_coord);
-                        spx_coord = spx_coord_mant * (1.0f / (1 << 23));
 
                         /* multiply noise and signal blending factors by spx coordinate */
+#if CONFIG_AC3DEC_FIXED
+                        s->spx_noise_blend [ch][bnd] = ((int64_t)nblend * spx_coord_mant + (1 << 14)) >> 15;
+                        s->spx_signal_blend[ch][bnd] = ((int64_t)sblend * spx_coord_mant + (1 << 14)) >> 15;
+#else
+                        spx_coord = spx_coord_mant * (1.0f / (1 << 23));
                         s->spx_noise_blend [ch][bnd] = nblend * spx_coord;
                         s->spx_signal_blend[ch][bnd] = sblend * spx_coord;
+#endif
                     }
                 }
             } else {
@@ -1252,6 +1355,13 @@ static int decode_audio_block(AC3DecodeContext *s, int blk)
 
     /* apply scaling to coefficients (headroom, dynrng) */
     for (ch = 1; ch <= s->channels; ch++) {
+#if CONFIG_AC3DEC_FIXED
+        int gain = s->dynamic_range[s->channel_mode == AC3_CHMODE_DUALMONO ?
+                                    2 - ch : 0];
+        for (i = 0; i < 256; i++)
+            s->transform_coeffs[ch][i] = ((int64_t)s->fixed_coeffs[ch][i] *
+                                          gain + (1 << 23)) >> 24;
+#else
         float gain = 1.0 / 4194304.0f;
         if (s->channel_mode == AC3_CHMODE_DUALMONO) {
             gain *= s->dynamic_range[2 - ch];
@@ -1260,10 +1370,11 @@ static int decode_audio_block(AC3DecodeContext *s, int blk)
         }
         s->fmt_conv.int32_to_float_fmul_scalar(s->transform_coeffs[ch],
                                                s->fixed_coeffs[ch], gain, 256);
+#endif
     }
 
     /* apply spectral extension to high frequency bins */
-    if (s->spx_in_use && CONFIG_EAC3_DECODER) {
+    if (s->spx_in_use && CONFIG_AC3DEC_EAC3) {
         ff_eac3_apply_spectral_extension(s);
     }
 
@@ -1284,19 +1395,16 @@ static int decode_audio_block(AC3DecodeContext *s, int blk)
         do_imdct(s, s->channels);
 
         if (downmix_output) {
-            s->ac3dsp.downmix(s->outptr, s->downmix_coeffs,
-                              s->out_channels, s->fbw_channels, 256);
+            downmix(s, s->outptr, 256);
         }
     } else {
         if (downmix_output) {
-            s->ac3dsp.downmix(s->xcfptr + 1, s->downmix_coeffs,
-                              s->out_channels, s->fbw_channels, 256);
+            downmix(s, s->xcfptr + 1, 256);
         }
 
         if (downmix_output && !s->downmixed) {
             s->downmixed = 1;
-            s->ac3dsp.downmix(s->dlyptr, s->downmix_coeffs, s->out_channels,
-                              s->fbw_channels, 128);
+            downmix(s, s->dlyptr, 128);
         }
 
         do_imdct(s, s->out_channels);
@@ -1305,6 +1413,27 @@ static int decode_audio_block(AC3DecodeContext *s, int blk)
     return 0;
 }
 
+#if CONFIG_AC3DEC_FIXED
+/**
+ * Convert one block of a channel from 1.0 = 1 << 22 to the output format.
+ */
+static void output_block(AC3DecodeContext *s, AVFrame *frame, int ch,
+                         const int32_t *src, int blk)
+{
+    int i;
+
+    if (s->avctx->sample_fmt == AV_SAMPLE_FMT_S32P) {
+        int32_t *dst = (int32_t *)frame->extended_data[ch] + blk * AC3_BLOCK_SIZE;
+        for (i = 0; i < AC3_BLOCK_SIZE; i++)
+            dst[i] = av_clipl_int32((int64_t)src[i] << 9);
+    } else {
+        int16_t *dst = (int16_t *)frame->extended_data[ch] + blk * AC3_BLOCK_SIZE;
+        for (i = 0; i < AC3_BLOCK_SIZE; i++)
+            dst[i] = av_clip_int16((src[i] + 64) >> 7);
+    }
+}
+#endif
+
 /**
  * Decode a single AC-3 frame.
  */
@@ -1317,7 +1446,9 @@ static int ac3_decode_frame(AVCodecContext * avctx, void *data,
     AC3DecodeContext *s = avctx->priv_data;
     int blk, ch, err, ret;
     const uint8_t *channel_map;
+#if !CONFIG_AC3DEC_FIXED
     const float *output[AC3_MAX_CHANNELS];
+#endif
     enum AVMatrixEncoding matrix_encoding;
     AVDownmixInfo *downmix_info;
 
@@ -1437,30 +1568,64 @@ static int ac3_decode_frame(AVCodecContext * avctx, void *data,
 
     /* decode the audio blocks */
     channel_map = ff_ac3_dec_channel_map[s->output_mode & ~AC3_OUTPUT_LFEON][s->lfe_on];
-    for (ch = 0; ch < s->channels; ch++) {
-        if (ch < s->out_channels)
-            s->outptr[channel_map[ch]] = (float *)frame->data[ch];
-        else
-            s->outptr[ch] = s->output[ch];
-        output[ch] = s->output[ch];
-    }
+#if CONFIG_AC3DEC_FIXED
+    /* blocks are decoded into s->output, which keeps the last good block
+       for error concealment, and then converted to the output format */
+    for (ch = 0; ch < s->channels; ch++)
+        s->outptr[ch] = s->output[ch];
     for (blk = 0; blk < s->num_blocks; blk++) {
         if (!err && decode_audio_block(s, blk)) {
             av_log(avctx, AV_LOG_ERROR, "error decoding the audio block\n");
             err = 1;
         }
-        if (err)
-            for (ch = 0; ch < s->out_channels; ch++)
-                memcpy(s->outptr[channel_map[ch]], output[ch], sizeof(**output) * AC3_BLOCK_SIZE);
         for (ch = 0; ch < s->out_channels; ch++)
-            output[ch] = s->outptr[channel_map[ch]];
-        for (ch = 0; ch < s->out_channels; ch++)
-            s->outptr[ch] += AC3_BLOCK_SIZE;
+            output_block(s, frame, ch, s->output[channel_map[ch]], blk);
     }
+#else
+    if (avctx->sample_fmt == AV_SAMPLE_FMT_S16) {
+        /* as in the fixed-point decoder, s->output keeps the last good block
+           and each block is interleaved into the frame */
+        for (ch = 0; ch < s->channels; ch++)
+            s->outptr[ch] = s->output[ch];
+        for (ch = 0; ch < s->out_channels; ch++)
+            output[ch] = s->output[channel_map[ch]];
+        for (blk = 0; blk < s->num_blocks; blk++) {
+            if (!err && decode_audio_block(s, blk)) {
+                av_log(avctx, AV_LOG_ERROR, "error decoding the audio block\n");
+                err = 1;
+            }
+            s->fmt_conv.float_to_int16_interleave((int16_t *)frame->data[0] +
+                                                  blk * AC3_BLOCK_SIZE * s->out_channels,
+                                                  output, AC3_BLOCK_SIZE,
+                                                  s->out_channels);
+        }
+    } else {
+        for (ch = 0; ch < s->channels; ch++) {
+            if (ch < s->out_channels)
+                s->outptr[channel_map[ch]] = (float *)frame->data[ch];
+            else
+                s->outptr[ch] = s->output[ch];
+            output[ch] = s->output[ch];
+        }
+        for (blk = 0; blk < s->num_blocks; blk++) {
+            if (!err && decode_audio_block(s, blk)) {
+                av_log(avctx, AV_LOG_ERROR, "error decoding the audio block\n");
+                err = 1;
+            }
+            if (err)
+                for (ch = 0; ch < s->out_channels; ch++)
+                    memcpy(s->outptr[channel_map[ch]], output[ch], sizeof(**output) * AC3_BLOCK_SIZE);
+            for (ch = 0; ch < s->out_channels; ch++)
+                output[ch] = s->outptr[channel_map[ch]];
+            for (ch = 0; ch < s->out_channels; ch++)
+                s->outptr[ch] += AC3_BLOCK_SIZE;
+        }
 
-    /* keep last block for error concealment in next frame */
-    for (ch = 0; ch < s->out_channels; ch++)
-        memcpy(s->output[ch], output[ch], sizeof(**output) * AC3_BLOCK_SIZE);
+        /* keep last block for error concealment in next frame */
+        for (ch = 0; ch < s->out_channels; ch++)
+            memcpy(s->output[ch], output[ch], sizeof(**output) * AC3_BLOCK_SIZE);
+    }
+#endif
 
     /*
      * AVMatrixEncoding
@@ -1542,6 +1707,14 @@ static const AVOption options[] = {
     { NULL},
 };
 
+#if CONFIG_AC3DEC_FIXED
+#define AC3_DECODER_NAME(name) ff_ ## name ## _fixed_decoder
+#define AC3_SAMPLE_FMTS        AV_SAMPLE_FMT_S16P, AV_SAMPLE_FMT_S32P
+#else
+#define AC3_DECODER_NAME(name) ff_ ## name ## _decoder
+#define AC3_SAMPLE_FMTS        AV_SAMPLE_FMT_FLTP, AV_SAMPLE_FMT_S16
+#endif
+
 static const AVClass ac3_decoder_class = {
     .class_name = "AC3 decoder",
     .item_name  = av_default_item_name,
@@ -1549,9 +1722,14 @@ static const AVClass ac3_decoder_class = {
     .version    = LIBAVUTIL_VERSION_INT,
 };
 
-AVCodec ff_ac3_decoder = {
+AVCodec AC3_DECODER_NAME(ac3) = {
+#if CONFIG_AC3DEC_FIXED
+    .name           = "ac3_fixed",
+    .long_name      = NULL_IF_CONFIG_SMALL("ATSC A/52A (AC-3), fixed-point"),
+#else
     .name           = "ac3",
     .long_name      = NULL_IF_CONFIG_SMALL("ATSC A/52A (AC-3)"),
+#endif
     .type           = AVMEDIA_TYPE_AUDIO,
     .id             = AV_CODEC_ID_AC3,
     .priv_data_size = sizeof (AC3DecodeContext),
@@ -1559,12 +1737,12 @@ AVCodec ff_ac3_decoder = {
     .close          = ac3_decode_end,
     .decode         = ac3_decode_frame,
     .capabilities   = CODEC_CAP_DR1,
-    .sample_fmts    = (const enum AVSampleFormat[]) { AV_SAMPLE_FMT_FLTP,
+    .sample_fmts    = (const enum AVSampleFormat[]) { AC3_SAMPLE_FMTS,
                                                       AV_SAMPLE_FMT_NONE },
     .priv_class     = &ac3_decoder_class,
 };
 
-#if CONFIG_EAC3_DECODER
+#if CONFIG_AC3DEC_EAC3
 static const AVClass eac3_decoder_class = {
     .class_name = "E-AC3 decoder",
     .item_name  = av_default_item_name,
@@ -1572,9 +1750,14 @@ static const AVClass eac3_decoder_class = {
     .version    = LIBAVUTIL_VERSION_INT,
 };
 
-AVCodec ff_eac3_decoder = {
+AVCodec AC3_DECODER_NAME(eac3) = {
+#if CONFIG_AC3DEC_FIXED
+    .name           = "eac3_fixed",
+    .long_name      = NULL_IF_CONFIG_SMALL("ATSC A/52B (AC-3, E-AC-3), fixed-point"),
+#else
     .name           = "eac3",
     .long_name      = NULL_IF_CONFIG_SMALL("ATSC A/52B (AC-3, E-AC-3)"),
+#endif
     .type           = AVMEDIA_TYPE_AUDIO,
     .id             = AV_CODEC_ID_EAC3,
     .priv_data_size = sizeof (AC3DecodeContext),
@@ -1582,7 +1765,7 @@ AVCodec ff_eac3_decoder = {
     .close          = ac3_decode_end,
     .decode         = ac3_decode_frame,
     .capabilities   = CODEC_CAP_DR1,
-    .sample_fmts    = (const enum AVSampleFormat[]) { AV_SAMPLE_FMT_FLTP,
+    .sample_fmts    = (const enum AVSampleFormat[]) { AC3_SAMPLE_FMTS,
                                                       AV_SAMPLE_FMT_NONE },
     .priv_class     = &eac3_decoder_class,
 };
@@ -59,6 +59,19 @@
 #include "fft.h"
 #include "fmtconvert.h"
 
+#ifndef CONFIG_AC3DEC_FIXED
+#define CONFIG_AC3DEC_FIXED 0
+#endif
+
+#if CONFIG_AC3DEC_FIXED
+#define CONFIG_AC3DEC_EAC3 CONFIG_EAC3_FIXED_DECODER
+/* transform coefficients and time-domain samples, 1.0 is 1 << 22 */
+typedef int32_t SampleType;
+#else
+#define CONFIG_AC3DEC_EAC3 CONFIG_EAC3_DECODER
+typedef float SampleType;
+#endif
+
 #define AC3_OUTPUT_LFEON  8
 
 #define SPX_MAX_BANDS    17
@@ -132,8 +145,13 @@ typedef struct AC3DecodeContext {
     int num_spx_bands;                          ///< number of spx bands                    (nspxbnds)
     uint8_t spx_band_sizes[SPX_MAX_BANDS];      ///< number of bins in each spx band
     uint8_t first_spx_coords[AC3_MAX_CHANNELS]; ///< first spx coordinates states           (firstspxcos)
+#if CONFIG_AC3DEC_FIXED
+    int spx_noise_blend[AC3_MAX_CHANNELS][SPX_MAX_BANDS];   ///< spx noise blending factor, Q23
+    int spx_signal_blend[AC3_MAX_CHANNELS][SPX_MAX_BANDS];  ///< spx signal blending factor, Q23
+#else
     float spx_noise_blend[AC3_MAX_CHANNELS][SPX_MAX_BANDS]; ///< spx noise blending factor  (nblendfact)
     float spx_signal_blend[AC3_MAX_CHANNELS][SPX_MAX_BANDS];///< spx signal blending factor (sblendfact)
+#endif
 ///@}
 
 ///@name Adaptive hybrid transform
@@ -145,14 +163,23 @@ typedef struct AC3DecodeContext {
     int fbw_channels;                           ///< number of full-bandwidth channels
     int channels;                               ///< number of total channels
     int lfe_ch;                                 ///< index of LFE channel
+#if CONFIG_AC3DEC_FIXED
+    int32_t downmix_coeffs[AC3_MAX_CHANNELS][2];///< stereo downmix coefficients, Q24
+#else
     float downmix_coeffs[AC3_MAX_CHANNELS][2];  ///< stereo downmix coefficients
+#endif
     int downmixed;                              ///< indicates if coeffs are currently downmixed
     int output_mode;                            ///< output channel configuration
     int out_channels;                           ///< number of output channels
 ///@}
 
 ///@name Dynamic range
+#if CONFIG_AC3DEC_FIXED
+    int dynamic_range[2];                   ///< dynamic range, Q24
+    int dynamic_range_tab[256];             ///< dynamic range codes with drc_scale applied, Q24
+#else
     float dynamic_range[2];                 ///< dynamic range
+#endif
     float drc_scale;                        ///< percentage of dynamic range compression to be applied
 ///@}
 
@@ -201,26 +228,34 @@ typedef struct AC3DecodeContext {
 
 ///@name Optimization
     BswapDSPContext bdsp;
+#if !CONFIG_AC3DEC_FIXED
     AVFloatDSPContext fdsp;
-    AC3DSPContext ac3dsp;
     FmtConvertContext fmt_conv;             ///< optimized conversion functions
+#endif
+    AC3DSPContext ac3dsp;
 ///@}
 
-    float *outptr[AC3_MAX_CHANNELS];
-    float *xcfptr[AC3_MAX_CHANNELS];
-    float *dlyptr[AC3_MAX_CHANNELS];
+    SampleType *outptr[AC3_MAX_CHANNELS];
+    SampleType *xcfptr[AC3_MAX_CHANNELS];
+    SampleType *dlyptr[AC3_MAX_CHANNELS];
 
 ///@name Aligned arrays
     DECLARE_ALIGNED(16, int32_t, fixed_coeffs)[AC3_MAX_CHANNELS][AC3_MAX_COEFS];     ///< fixed-point transform coefficients
-    DECLARE_ALIGNED(32, float, transform_coeffs)[AC3_MAX_CHANNELS][AC3_MAX_COEFS];   ///< transform coefficients
-    DECLARE_ALIGNED(32, float, delay)[AC3_MAX_CHANNELS][AC3_BLOCK_SIZE];             ///< delay - added to the next block
-    DECLARE_ALIGNED(32, float, window)[AC3_BLOCK_SIZE];                              ///< window coefficients
-    DECLARE_ALIGNED(32, float, tmp_output)[AC3_BLOCK_SIZE];                          ///< temporary storage for output before windowing
-    DECLARE_ALIGNED(32, float, output)[AC3_MAX_CHANNELS][AC3_BLOCK_SIZE];            ///< output after imdct transform and windowing
+    DECLARE_ALIGNED(32, SampleType, transform_coeffs)[AC3_MAX_CHANNELS][AC3_MAX_COEFS]; ///< transform coefficients
+    DECLARE_ALIGNED(32, SampleType, delay)[AC3_MAX_CHANNELS][AC3_BLOCK_SIZE];        ///< delay - added to the next block
+    DECLARE_ALIGNED(32, SampleType, window)[AC3_BLOCK_SIZE];                         ///< window coefficients (Q31 in fixed-point, scaled to 16 bits for packed S16)
+    DECLARE_ALIGNED(32, SampleType, tmp_output)[AC3_BLOCK_SIZE];                     ///< temporary storage for output before windowing
+    DECLARE_ALIGNED(32, SampleType, output)[AC3_MAX_CHANNELS][AC3_BLOCK_SIZE];       ///< output after imdct transform and windowing
     DECLARE_ALIGNED(32, uint8_t, input_buffer)[AC3_FRAME_BUFFER_SIZE + FF_INPUT_BUFFER_PADDING_SIZE]; ///< temp buffer to prevent overread
 ///@}
 } AC3DecodeContext;
 
+#if CONFIG_AC3DEC_FIXED
+#define ff_eac3_parse_header                   ff_eac3_parse_header_fixed
+#define ff_eac3_decode_transform_coeffs_aht_ch ff_eac3_decode_transform_coeffs_aht_ch_fixed
+#define ff_eac3_apply_spectral_extension       ff_eac3_apply_spectral_extension_fixed
+#endif
+
 /**
  * Parse the E-AC-3 frame header.
  * This parses both the bit stream info and audio frame header.
@@ -129,6 +129,13 @@ typedef struct AC3DSPContext {
     void (*downmix)(float **samples, float (*matrix)[2], int out_ch,
                     int in_ch, int len);
 
+    /**
+     * Fixed-point version of downmix.
+     * @param matrix downmix coefficients in Q24
+     */
+    void (*downmix_fixed)(int32_t **samples, int32_t (*matrix)[2], int out_ch,
+                          int in_ch, int len);
+
     /**
      * Apply symmetric window in 16-bit fixed-point.
      * @param output destination array
@@ -145,6 +152,7 @@ typedef struct AC3DSPContext {
 } AC3DSPContext;
 
 void ff_ac3dsp_init    (AC3DSPContext *c, int bit_exact);
+void ff_ac3dsp_init_aarch64(AC3DSPContext *c, int bit_exact);
 void ff_ac3dsp_init_arm(AC3DSPContext *c, int bit_exact);
 void ff_ac3dsp_init_x86(AC3DSPContext *c, int bit_exact);
 
@@ -289,9 +289,10 @@ void avcodec_register_all(void)
 
     /* audio codecs */
     REGISTER_ENCDEC (AAC,               aac);
+    REGISTER_DECODER(AAC_FIXED,         aac_fixed);
     REGISTER_DECODER(AAC_LATM,          aac_latm);
     REGISTER_ENCDEC (AC3,               ac3);
-    REGISTER_ENCODER(AC3_FIXED,         ac3_fixed);
+    REGISTER_ENCDEC (AC3_FIXED,         ac3_fixed);
     REGISTER_ENCDEC (ALAC,              alac);
     REGISTER_DECODER(ALS,               als);
     REGISTER_DECODER(AMRNB,             amrnb);
@@ -307,6 +308,7 @@ void avcodec_register_all(void)
     REGISTER_DECODER(DCA,               dca);
     REGISTER_DECODER(DSICINAUDIO,       dsicinaudio);
     REGISTER_ENCDEC (EAC3,              eac3);
+    REGISTER_DECODER(EAC3_FIXED,        eac3_fixed);
     REGISTER_ENCDEC (FLAC,              flac);
     REGISTER_DECODER(G723_1,            g723_1);
     REGISTER_DECODER(GSM,               gsm);
@@ -27,6 +27,7 @@
 #define BITS 16
 #define FLOATFMT "%.18e"
 #define FIXEDFMT "%6d"
+#define FIXED32FMT "%11d"
 
 static int clip_f15(int v)
 {
@@ -37,7 +38,15 @@ static int clip_f15(int v)
 
 static void printval(double val, int fixed)
 {
-    if (fixed) {
+    if (fixed == 32) {
+        double new_val = val * 2147483648.0;
+
+        new_val = new_val >= 0 ? floor(new_val + 0.5) : ceil(new_val - 0.5);
+        if (new_val > 2147483647.0)
+            new_val = 2147483647.0;
+
+        printf(" "FIXED32FMT",", (int) new_val);
+    } else if (fixed) {
         /* lrint() isn't always available, so round and cast manually. */
         double new_val = val * (double) (1 << 15);
 
@@ -56,8 +65,13 @@ int main(int argc, char *argv[])
     int fixed  = argc > 1 &&  strstr(argv[1], "fixed");
     double (*func)(double) = do_sin ? sin : cos;
 
+    if (fixed && strstr(argv[1], "fixed_32"))
+        fixed = 32;
+
     printf("/* This file was automatically generated. */\n");
     printf("#define FFT_FLOAT %d\n", !fixed);
+    if (fixed == 32)
+        printf("#define FFT_FIXED_32 1\n");
     printf("#include \"libavcodec/%s\"\n", do_sin ? "rdft.h" : "fft.h");
     for (i = 4; i <= BITS; i++) {
         int m = 1 << i;
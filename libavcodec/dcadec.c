@@ -362,6 +362,7 @@ typedef struct {
     DECLARE_ALIGNED(32, float, raXin)[32];
 
     int output;                 ///< type of output
+    float output_scale;         ///< 32768.0 for packed S16 output, else 1.0
 
     DECLARE_ALIGNED(32, float, subband_samples)[DCA_BLOCKS_MAX][DCA_PRIM_CHANNELS_MAX][DCA_SUBBANDS][8];
     float *samples_chanptr[DCA_PRIM_CHANNELS_MAX + 1];
@@ -843,7 +844,7 @@ static int dca_subframe_header(DCAContext *s, int base_channel, int block_index)
         s->lfe_scale_factor = scale_factor_quant7[get_bits(&s->gb, 7)];
 
         /* Quantization step size * scale factor */
-        lfe_scale = 0.035 * s->lfe_scale_factor;
+        lfe_scale = 0.035 * s->lfe_scale_factor * s->output_scale;
 
         for (j = lfe_samples; j < lfe_end_sample; j++)
             s->lfe_data[j] *= lfe_scale;
@@ -1253,7 +1254,7 @@ static int dca_filter_channels(DCAContext *s, int block_index)
         if (s->channel_order_tab[k] >= 0)
             qmf_32_subbands(s, k, subband_samples[k],
                             s->samples_chanptr[s->channel_order_tab[k]],
-                            M_SQRT1_2 / 32768.0 /* pcm_to_double[s->source_pcm_res] */);
+                            M_SQRT1_2 / 32768.0 * s->output_scale /* pcm_to_double[s->source_pcm_res] */);
     }
 
     /* Generate LFE samples for this subsubframe FIXME!!! */
@@ -1718,7 +1719,7 @@ static int dca_decode_frame(AVCodecContext *avctx, void *data,
     int i, ret;
     float  **samples_flt;
     DCAContext *s = avctx->priv_data;
-    int channels, full_channels;
+    int channels, full_channels, frame_channels;
     int core_ss_end;
 
 
@@ -1956,11 +1957,15 @@ FF_ENABLE_DEPRECATION_WARNINGS
     }
     samples_flt = (float **)frame->extended_data;
 
+    /* Planar float channels are synthesized in the frame. Packed S16 is
+     * synthesized in the extra channel buffer and interleaved per block. */
+    frame_channels = avctx->sample_fmt == AV_SAMPLE_FMT_S16 ? 0 : channels;
+
     /* allocate buffer for extra channels if downmixing */
-    if (avctx->channels < full_channels) {
-        ret = av_samples_get_buffer_size(NULL, full_channels - channels,
+    if (frame_channels < full_channels) {
+        ret = av_samples_get_buffer_size(NULL, full_channels - frame_channels,
                                          frame->nb_samples,
-                                         avctx->sample_fmt, 0);
+                                         AV_SAMPLE_FMT_FLTP, 0);
         if (ret < 0)
             return ret;
 
@@ -1971,8 +1976,8 @@ FF_ENABLE_DEPRECATION_WARNINGS
 
         ret = av_samples_fill_arrays((uint8_t **)s->extra_channels, NULL,
                                      s->extra_channels_buffer,
-                                     full_channels - channels,
-                                     frame->nb_samples, avctx->sample_fmt, 0);
+                                     full_channels - frame_channels,
+                                     frame->nb_samples, AV_SAMPLE_FMT_FLTP, 0);
         if (ret < 0)
             return ret;
     }
@@ -1981,10 +1986,10 @@ FF_ENABLE_DEPRECATION_WARNINGS
     for (i = 0; i < (s->sample_blocks / 8); i++) {
         int ch;
 
-        for (ch = 0; ch < channels; ch++)
+        for (ch = 0; ch < frame_channels; ch++)
             s->samples_chanptr[ch] = samples_flt[ch] + i * 256;
         for (; ch < full_channels; ch++)
-            s->samples_chanptr[ch] = s->extra_channels[ch - channels] + i * 256;
+            s->samples_chanptr[ch] = s->extra_channels[ch - frame_channels] + i * 256;
 
         dca_filter_channels(s, i);
 
@@ -1997,6 +2002,16 @@ FF_ENABLE_DEPRECATION_WARNINGS
             s->fdsp.vector_fmac_scalar(lt_chan, back_chan, -M_SQRT1_2, 256);
             s->fdsp.vector_fmac_scalar(rt_chan, back_chan, -M_SQRT1_2, 256);
         }
+
+        if (!frame_channels) {
+            const float *src[DCA_PRIM_CHANNELS_MAX + 1];
+
+            for (ch = 0; ch < channels; ch++)
+                src[ch] = s->samples_chanptr[ch];
+            s->fmt_conv.float_to_int16_interleave((int16_t *)frame->data[0] +
+                                                  i * 256 * channels,
+                                                  src, 256, channels);
+        }
     }
 
     /* update lfe history */
@@ -2039,7 +2054,13 @@ static av_cold int dca_decode_init(AVCodecContext *avctx)
     ff_dcadsp_init(&s->dcadsp);
     ff_fmt_convert_init(&s->fmt_conv, avctx);
 
-    avctx->sample_fmt = AV_SAMPLE_FMT_FLTP;
+    if (avctx->request_sample_fmt == AV_SAMPLE_FMT_S16) {
+        avctx->sample_fmt = AV_SAMPLE_FMT_S16;
+        s->output_scale   = 32768.0;
+    } else {
+        avctx->sample_fmt = AV_SAMPLE_FMT_FLTP;
+        s->output_scale   = 1.0;
+    }
 
     /* allow downmixing to stereo */
 #if FF_API_REQUEST_CHANNELS
@@ -2095,6 +2116,7 @@ AVCodec ff_dca_decoder = {
     .close           = dca_decode_end,
     .capabilities    = CODEC_CAP_CHANNEL_CONF | CODEC_CAP_DR1,
     .sample_fmts     = (const enum AVSampleFormat[]) { AV_SAMPLE_FMT_FLTP,
+                                                       AV_SAMPLE_FMT_S16,
                                                        AV_SAMPLE_FMT_NONE },
     .profiles        = NULL_IF_CONFIG_SMALL(profiles),
     .priv_class      = &dca_decoder_class,
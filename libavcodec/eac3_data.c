@@ -1132,3 +1132,42 @@ const float ff_eac3_spx_atten_tab[32][3] = {
     { 0.238710400977604098f, 0.056982655534888536f, 0.013602352551501938f },
     { 0.227930622139554201f, 0.051952368508924235f, 0.011841535675862483f }
 };
+
+/**
+ * ff_eac3_spx_atten_tab in Q15
+ * ff_eac3_spx_atten_tab_fixed[code][bin]=lrint(pow(2.0,(bin+1)*(code+1)/-15.0)*32768);
+ */
+const int16_t ff_eac3_spx_atten_tab_fixed[32][3] = {
+    { 31288, 29875, 28526 },
+    { 29875, 27238, 24834 },
+    { 28526, 24834, 21619 },
+    { 27238, 22641, 18820 },
+    { 26008, 20643, 16384 },
+    { 24834, 18820, 14263 },
+    { 23712, 17159, 12417 },
+    { 22641, 15644, 10809 },
+    { 21619, 14263,  9410 },
+    { 20643, 13004,  8192 },
+    { 19710, 11856,  7132 },
+    { 18820, 10809,  6208 },
+    { 17970,  9855,  5405 },
+    { 17159,  8985,  4705 },
+    { 16384,  8192,  4096 },
+    { 15644,  7469,  3566 },
+    { 14938,  6810,  3104 },
+    { 14263,  6208,  2702 },
+    { 13619,  5660,  2353 },
+    { 13004,  5161,  2048 },
+    { 12417,  4705,  1783 },
+    { 11856,  4290,  1552 },
+    { 11321,  3911,  1351 },
+    { 10809,  3566,  1176 },
+    { 10321,  3251,  1024 },
+    {  9855,  2964,   891 },
+    {  9410,  2702,   776 },
+    {  8985,  2464,   676 },
+    {  8579,  2246,   588 },
+    {  8192,  2048,   512 },
+    {  7822,  1867,   446 },
+    {  7469,  1702,   388 }
+};
@@ -67,7 +67,11 @@ void ff_eac3_apply_spectral_extension(AC3DecodeContext *s)
 {
     int bin, bnd, ch, i;
     uint8_t wrapflag[SPX_MAX_BANDS]={1,0,}, num_copy_sections, copy_sizes[SPX_MAX_BANDS];
+#if CONFIG_AC3DEC_FIXED
+    int rms_energy[SPX_MAX_BANDS];
+#else
     float rms_energy[SPX_MAX_BANDS];
+#endif
 
     /* Set copy index mapping table. Set wrap flags to apply a notch filter at
        wrap points later on. */
@@ -101,7 +105,7 @@ void ff_eac3_apply_spectral_extension(AC3DecodeContext *s)
         for (i = 0; i < num_copy_sections; i++) {
             memcpy(&s->transform_coeffs[ch][bin],
                    &s->transform_coeffs[ch][s->spx_dst_start_freq],
-                   copy_sizes[i]*sizeof(float));
+                   copy_sizes[i]*sizeof(SampleType));
             bin += copy_sizes[i];
         }
 
@@ -109,27 +113,52 @@ void ff_eac3_apply_spectral_extension(AC3DecodeContext *s)
         bin = s->spx_src_start_freq;
         for (bnd = 0; bnd < s->num_spx_bands; bnd++) {
             int bandsize = s->spx_band_sizes[bnd];
+#if CONFIG_AC3DEC_FIXED
+            uint64_t accum = 0;
+            int shift = 0;
+            for (i = 0; i < bandsize; i++) {
+                int64_t coeff = s->transform_coeffs[ch][bin++];
+                accum += coeff * coeff;
+            }
+            accum /= bandsize;
+            for (; accum > UINT32_MAX; accum >>= 2)
+                shift++;
+            rms_energy[bnd] = ff_sqrt(accum) << shift;
+#else
             float accum = 0.0f;
             for (i = 0; i < bandsize; i++) {
                 float coeff = s->transform_coeffs[ch][bin++];
                 accum += coeff * coeff;
             }
             rms_energy[bnd] = sqrtf(accum / bandsize);
+#endif
         }
 
         /* Apply a notch filter at transitions between normal and extension
            bands and at all wrap points. */
         if (s->spx_atten_code[ch] >= 0) {
+#if CONFIG_AC3DEC_FIXED
+            const int16_t *atten_tab = ff_eac3_spx_atten_tab_fixed[s->spx_atten_code[ch]];
+#else
             const float *atten_tab = ff_eac3_spx_atten_tab[s->spx_atten_code[ch]];
+#endif
             bin = s->spx_src_start_freq - 2;
             for (bnd = 0; bnd < s->num_spx_bands; bnd++) {
                 if (wrapflag[bnd]) {
-                    float *coeffs = &s->transform_coeffs[ch][bin];
+                    SampleType *coeffs = &s->transform_coeffs[ch][bin];
+#if CONFIG_AC3DEC_FIXED
+                    coeffs[0] = (coeffs[0] * (int64_t)atten_tab[0]) >> 15;
+                    coeffs[1] = (coeffs[1] * (int64_t)atten_tab[1]) >> 15;
+                    coeffs[2] = (coeffs[2] * (int64_t)atten_tab[2]) >> 15;
+                    coeffs[3] = (coeffs[3] * (int64_t)atten_tab[1]) >> 15;
+                    coeffs[4] = (coeffs[4] * (int64_t)atten_tab[0]) >> 15;
+#else
                     coeffs[0] *= atten_tab[0];
                     coeffs[1] *= atten_tab[1];
                     coeffs[2] *= atten_tab[2];
                     coeffs[3] *= atten_tab[1];
                     coeffs[4] *= atten_tab[0];
+#endif
                 }
                 bin += s->spx_band_sizes[bnd];
             }
@@ -140,6 +169,16 @@ void ff_eac3_apply_spectral_extension(AC3DecodeContext *s)
            each band. */
         bin = s->spx_src_start_freq;
         for (bnd = 0; bnd < s->num_spx_bands; bnd++) {
+#if CONFIG_AC3DEC_FIXED
+            /* dividing by INT32_MIN: negated here, shifted by 31 below */
+            int64_t nscale = -(((int64_t)s->spx_noise_blend[ch][bnd] * rms_energy[bnd]) >> 23);
+            int64_t sscale = s->spx_signal_blend[ch][bnd];
+            for (i = 0; i < s->spx_band_sizes[bnd]; i++) {
+                int noise = (nscale * (int32_t)av_lfg_get(&s->dith_state)) >> 31;
+                s->transform_coeffs[ch][bin] = (s->transform_coeffs[ch][bin] * sscale) >> 23;
+                s->transform_coeffs[ch][bin++] += noise;
+            }
+#else
             float nscale = s->spx_noise_blend[ch][bnd] * rms_energy[bnd] * (1.0f / INT32_MIN);
             float sscale = s->spx_signal_blend[ch][bnd];
             for (i = 0; i < s->spx_band_sizes[bnd]; i++) {
@@ -147,6 +186,7 @@ void ff_eac3_apply_spectral_extension(AC3DecodeContext *s)
                 s->transform_coeffs[ch][bin]   *= sscale;
                 s->transform_coeffs[ch][bin++] += noise;
             }
+#endif
         }
     }
 }
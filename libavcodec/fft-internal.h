@@ -34,6 +34,29 @@
         (dim) = (are) * (bim) + (aim) * (bre);  \
     } while (0)
 
+#elif FFT_FIXED_32
+
+#include "fft.h"
+#include "mathops.h"
+
+/* Q31 twiddle factors and no scaling of the butterflies, so the input needs
+ * log2(n) bits of headroom. */
+#define FIX15(a) av_clipl_int32(llrint((a) * 2147483648.0))
+
+#define sqrthalf ((int32_t)(M_SQRT1_2 * 2147483648.0 + 0.5))
+
+#define BF(x, y, a, b) do {                     \
+        x = a - b;                              \
+        y = a + b;                              \
+    } while (0)
+
+#define CMUL(dre, dim, are, aim, bre, bim) do {                         \
+        (dre) = (int)(((int64_t)(are) * (bre) - (int64_t)(aim) * (bim) + \
+                       0x40000000) >> 31);                              \
+        (dim) = (int)(((int64_t)(are) * (bim) + (int64_t)(aim) * (bre) + \
+                       0x40000000) >> 31);                              \
+    } while (0)
+
 #else
 
 #include "fft.h"
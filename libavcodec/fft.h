@@ -26,6 +26,10 @@
 #define FFT_FLOAT 1
 #endif
 
+#ifndef FFT_FIXED_32
+#define FFT_FIXED_32 0
+#endif
+
 #include <stdint.h>
 #include "config.h"
 #include "libavutil/mem.h"
@@ -38,6 +42,19 @@
 
 typedef float FFTDouble;
 
+#elif FFT_FIXED_32
+
+#define FFT_NAME(x) x ## _fixed_32
+
+typedef int32_t FFTSample;
+typedef int     FFTDouble;
+
+typedef struct FFTComplex {
+    int32_t re, im;
+} FFTComplex;
+
+typedef struct FFTContext FFTContext;
+
 #else
 
 #define FFT_NAME(x) x ## _fixed
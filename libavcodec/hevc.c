@@ -181,6 +181,20 @@ static void pic_arrays_free(HEVCContext *s)
     av_freep(&s->horizontal_bs);
     av_freep(&s->vertical_bs);
 
+#if HAVE_THREADS
+    if (s->row_mutex) {
+        int i;
+        for (i = 0; i < s->nb_rows; i++) {
+            pthread_mutex_destroy(&s->row_mutex[i]);
+            pthread_cond_destroy(&s->row_cond[i]);
+        }
+    }
+    av_freep(&s->row_mutex);
+    av_freep(&s->row_cond);
+#endif
+    av_freep(&s->row_progress);
+    s->nb_rows = 0;
+
     av_buffer_pool_uninit(&s->tab_mvf_pool);
     av_buffer_pool_uninit(&s->rpl_tab_pool);
 }
@@ -228,6 +242,25 @@ static int pic_arrays_init(HEVCContext *s, const HEVCSPS *sps)
     if (!s->horizontal_bs || !s->vertical_bs)
         goto fail;
 
+    if (s->threads_number > 1) {
+        s->row_progress = av_mallocz_array(sps->ctb_height,
+                                           sizeof(*s->row_progress));
+        if (!s->row_progress)
+            goto fail;
+#if HAVE_THREADS
+        s->row_mutex = av_malloc_array(sps->ctb_height, sizeof(*s->row_mutex));
+        s->row_cond  = av_malloc_array(sps->ctb_height, sizeof(*s->row_cond));
+        if (!s->row_mutex || !s->row_cond)
+            goto fail;
+        for (s->nb_rows = 0; s->nb_rows < sps->ctb_height; s->nb_rows++) {
+            pthread_mutex_init(&s->row_mutex[s->nb_rows], NULL);
+            pthread_cond_init(&s->row_cond[s->nb_rows], NULL);
+        }
+#else
+        s->nb_rows = sps->ctb_height;
+#endif
+    }
+
     s->tab_mvf_pool = av_buffer_pool_init(min_pu_size * sizeof(MvField),
                                           av_buffer_alloc);
     s->rpl_tab_pool = av_buffer_pool_init(ctb_count * sizeof(RefPicListTab),
@@ -455,7 +488,7 @@ fail:
 
 static int hls_slice_header(HEVCContext *s)
 {
-    GetBitContext *gb = &s->HEVClc.gb;
+    GetBitContext *gb = &s->HEVClc->gb;
     SliceHeader *sh   = &s->sh;
     int i, ret;
 
@@ -751,12 +784,50 @@ static int hls_slice_header(HEVCContext *s)
 
     sh->num_entry_point_offsets = 0;
     if (s->pps->tiles_enabled_flag || s->pps->entropy_coding_sync_enabled_flag) {
-        sh->num_entry_point_offsets = get_ue_golomb_long(gb);
-        if (sh->num_entry_point_offsets > 0) {
-            int offset_len = get_ue_golomb_long(gb) + 1;
+        unsigned int num_entry_point_offsets = get_ue_golomb_long(gb);
+        unsigned int max_entry_point_offsets;
+
+        if (s->pps->entropy_coding_sync_enabled_flag)
+            max_entry_point_offsets = s->pps->tiles_enabled_flag ?
+                                      s->pps->num_tile_columns * s->sps->ctb_height - 1 :
+                                      s->sps->ctb_height - 1;
+        else
+            max_entry_point_offsets = s->pps->num_tile_columns *
+                                      s->pps->num_tile_rows - 1;
+
+        if (num_entry_point_offsets > max_entry_point_offsets) {
+            av_log(s->avctx, AV_LOG_ERROR,
+                   "Invalid number of entry points: %u.\n",
+                   num_entry_point_offsets);
+            return AVERROR_INVALIDDATA;
+        }
+
+        if (num_entry_point_offsets > 0) {
+            unsigned int offset_len = get_ue_golomb_long(gb) + 1;
+
+            if (offset_len > 32) {
+                av_log(s->avctx, AV_LOG_ERROR,
+                       "Invalid entry point offset length: %u.\n", offset_len);
+                return AVERROR_INVALIDDATA;
+            }
 
-            for (i = 0; i < sh->num_entry_point_offsets; i++)
-                skip_bits(gb, offset_len);
+            av_fast_malloc(&sh->entry_point_offset,
+                           &sh->entry_point_offset_allocated,
+                           num_entry_point_offsets *
+                           sizeof(*sh->entry_point_offset));
+            if (!sh->entry_point_offset)
+                return AVERROR(ENOMEM);
+
+            for (i = 0; i < num_entry_point_offsets; i++) {
+                uint32_t offset = get_bits_long(gb, offset_len) + 1;
+                if (!offset || offset > INT_MAX) {
+                    av_log(s->avctx, AV_LOG_ERROR,
+                           "Invalid entry point offset.\n");
+                    return AVERROR_INVALIDDATA;
+                }
+                sh->entry_point_offset[i] = offset;
+            }
+            sh->num_entry_point_offsets = num_entry_point_offsets;
         }
     }
 
@@ -785,10 +856,10 @@ static int hls_slice_header(HEVCContext *s)
         return AVERROR_INVALIDDATA;
     }
 
-    s->HEVClc.first_qp_group = !s->sh.dependent_slice_segment_flag;
+    s->HEVClc->first_qp_group = !s->sh.dependent_slice_segment_flag;
 
     if (!s->pps->cu_qp_delta_enabled_flag)
-        s->HEVClc.qp_y = FFUMOD(s->sh.slice_qp + 52 + 2 * s->sps->qp_bd_offset,
+        s->HEVClc->qp_y = FFUMOD(s->sh.slice_qp + 52 + 2 * s->sps->qp_bd_offset,
                                 52 + s->sps->qp_bd_offset) - s->sps->qp_bd_offset;
 
     s->slice_initialized = 1;
@@ -812,7 +883,7 @@ do {                                                    \
 
 static void hls_sao_param(HEVCContext *s, int rx, int ry)
 {
-    HEVCLocalContext *lc    = &s->HEVClc;
+    HEVCLocalContext *lc    = s->HEVClc;
     int sao_merge_left_flag = 0;
     int sao_merge_up_flag   = 0;
     int shift               = s->sps->bit_depth - FFMIN(s->sps->bit_depth, 10);
@@ -890,7 +961,7 @@ static void hls_residual_coding(HEVCContext *s, int x0, int y0,
         x_c = (scan_x_cg[offset >> 4] << 2) + scan_x_off[n];    \
         y_c = (scan_y_cg[offset >> 4] << 2) + scan_y_off[n];    \
     } while (0)
-    HEVCLocalContext *lc    = &s->HEVClc;
+    HEVCLocalContext *lc    = s->HEVClc;
     int transform_skip_flag = 0;
 
     int last_significant_coeff_x, last_significant_coeff_y;
@@ -1236,7 +1307,7 @@ static int hls_transform_unit(HEVCContext *s, int x0, int y0,
                               int trafo_depth, int blk_idx,
                               int cbf_luma, int cbf_cb, int cbf_cr)
 {
-    HEVCLocalContext *lc = &s->HEVClc;
+    HEVCLocalContext *lc = s->HEVClc;
 
     if (lc->cu.pred_mode == MODE_INTRA) {
         int trafo_size = 1 << log2_trafo_size;
@@ -1338,7 +1409,7 @@ static int hls_transform_tree(HEVCContext *s, int x0, int y0,
                               int trafo_depth, int blk_idx,
                               int cbf_cb, int cbf_cr)
 {
-    HEVCLocalContext *lc = &s->HEVClc;
+    HEVCLocalContext *lc = s->HEVClc;
     uint8_t split_transform_flag;
     int ret;
 
@@ -1432,7 +1503,7 @@ do {
 static int hls_pcm_sample(HEVCContext *s, int x0, int y0, int log2_cb_size)
 {
     //TODO: non-4:2:0 support
-    HEVCLocalContext *lc = &s->HEVClc;
+    HEVCLocalContext *lc = s->HEVClc;
     GetBitContext gb;
     int cb_size   = 1 << log2_cb_size;
     int stride0   = s->frame->linesize[0];
@@ -1461,7 +1532,7 @@ static int hls_pcm_sample(HEVCContext *s, int x0, int y0, int log2_cb_size)
 
 static void hls_mvd_coding(HEVCContext *s, int x0, int y0, int log2_cb_size)
 {
-    HEVCLocalContext *lc = &s->HEVClc;
+    HEVCLocalContext *lc = s->HEVClc;
     int x = ff_hevc_abs_mvd_greater0_flag_decode(s);
     int y = ff_hevc_abs_mvd_greater0_flag_decode(s);
 
@@ -1500,7 +1571,7 @@ static void luma_mc(HEVCContext *s, int16_t *dst, ptrdiff_t dststride,
                     AVFrame *ref, const Mv *mv, int x_off, int y_off,
                     int block_w, int block_h)
 {
-    HEVCLocalContext *lc = &s->HEVClc;
+    HEVCLocalContext *lc = s->HEVClc;
     uint8_t *src         = ref->data[0];
     ptrdiff_t srcstride  = ref->linesize[0];
     int pic_width        = s->sps->width;
@@ -1554,7 +1625,7 @@ static void chroma_mc(HEVCContext *s, int16_t *dst1, int16_t *dst2,
                       ptrdiff_t dststride, AVFrame *ref, const Mv *mv,
                       int x_off, int y_off, int block_w, int block_h)
 {
-    HEVCLocalContext *lc = &s->HEVClc;
+    HEVCLocalContext *lc = s->HEVClc;
     uint8_t *src1        = ref->data[1];
     uint8_t *src2        = ref->data[2];
     ptrdiff_t src1stride = ref->linesize[1];
@@ -1629,7 +1700,7 @@ static void hls_prediction_unit(HEVCContext *s, int x0, int y0,
 #define POS(c_idx, x, y)                                                              \
     &s->frame->data[c_idx][((y) >> s->sps->vshift[c_idx]) * s->frame->linesize[c_idx] + \
                            (((x) >> s->sps->hshift[c_idx]) << s->sps->pixel_shift)]
-    HEVCLocalContext *lc = &s->HEVClc;
+    HEVCLocalContext *lc = s->HEVClc;
     int merge_idx = 0;
     struct MvField current_mv = {{{ 0 }}};
 
@@ -1888,7 +1959,7 @@ static void hls_prediction_unit(HEVCContext *s, int x0, int y0,
 static int luma_intra_pred_mode(HEVCContext *s, int x0, int y0, int pu_size,
                                 int prev_intra_luma_pred_flag)
 {
-    HEVCLocalContext *lc = &s->HEVClc;
+    HEVCLocalContext *lc = s->HEVClc;
     int x_pu             = x0 >> s->sps->log2_min_pu_size;
     int y_pu             = y0 >> s->sps->log2_min_pu_size;
     int min_pu_width     = s->sps->min_pu_width;
@@ -1989,7 +2060,7 @@ static av_always_inline void set_ct_depth(HEVCContext *s, int x0, int y0,
 static void intra_prediction_unit(HEVCContext *s, int x0, int y0,
                                   int log2_cb_size)
 {
-    HEVCLocalContext *lc = &s->HEVClc;
+    HEVCLocalContext *lc = s->HEVClc;
     static const uint8_t intra_chroma_table[4] = { 0, 26, 10, 1 };
     uint8_t prev_intra_luma_pred_flag[4];
     int split   = lc->cu.part_mode == PART_NxN;
@@ -2030,7 +2101,7 @@ static void intra_prediction_unit_default_value(HEVCContext *s,
                                                 int x0, int y0,
                                                 int log2_cb_size)
 {
-    HEVCLocalContext *lc = &s->HEVClc;
+    HEVCLocalContext *lc = s->HEVClc;
     int pb_size          = 1 << log2_cb_size;
     int size_in_pus      = pb_size >> s->sps->log2_min_pu_size;
     int min_pu_width     = s->sps->min_pu_width;
@@ -2051,7 +2122,7 @@ static void intra_prediction_unit_default_value(HEVCContext *s,
 static int hls_coding_unit(HEVCContext *s, int x0, int y0, int log2_cb_size)
 {
     int cb_size          = 1 << log2_cb_size;
-    HEVCLocalContext *lc = &s->HEVClc;
+    HEVCLocalContext *lc = s->HEVClc;
     int log2_min_cb_size = s->sps->log2_min_cb_size;
     int length           = cb_size >> log2_min_cb_size;
     int min_cb_width     = s->sps->min_cb_width;
@@ -2199,7 +2270,7 @@ static int hls_coding_unit(HEVCContext *s, int x0, int y0, int log2_cb_size)
 static int hls_coding_quadtree(HEVCContext *s, int x0, int y0,
                                int log2_cb_size, int cb_depth)
 {
-    HEVCLocalContext *lc = &s->HEVClc;
+    HEVCLocalContext *lc = s->HEVClc;
     const int cb_size    = 1 << log2_cb_size;
     int split_cu;
 
@@ -2250,7 +2321,7 @@ do {                                                                   \
 static void hls_decode_neighbour(HEVCContext *s, int x_ctb, int y_ctb,
                                  int ctb_addr_ts)
 {
-    HEVCLocalContext *lc  = &s->HEVClc;
+    HEVCLocalContext *lc  = s->HEVClc;
     int ctb_size          = 1 << s->sps->log2_ctb_size;
     int ctb_addr_rs       = s->pps->ctb_addr_ts_to_rs[ctb_addr_ts];
     int ctb_addr_in_slice = ctb_addr_rs - s->sh.slice_addr;
@@ -2297,7 +2368,7 @@ static void hls_decode_neighbour(HEVCContext *s, int x_ctb, int y_ctb,
     lc->ctb_up_left_flag = ((x_ctb > 0) && (y_ctb > 0)  && (ctb_addr_in_slice-1 >= s->sps->ctb_width) && (s->pps->tile_id[ctb_addr_ts] == s->pps->tile_id[s->pps->ctb_addr_rs_to_ts[ctb_addr_rs-1 - s->sps->ctb_width]]));
 }
 
-static int hls_slice_data(HEVCContext *s)
+static int hls_decode_entry(HEVCContext *s)
 {
     int ctb_size    = 1 << s->sps->log2_ctb_size;
     int more_data   = 1;
@@ -2328,23 +2399,296 @@ static int hls_slice_data(HEVCContext *s)
 
         ctb_addr_ts++;
         ff_hevc_save_states(s, ctb_addr_ts);
-        ff_hevc_hls_filters(s, x_ctb, y_ctb, ctb_size);
+        if (!s->deferred_filter)
+            ff_hevc_hls_filters(s, x_ctb, y_ctb, ctb_size);
     }
 
     if (x_ctb + ctb_size >= s->sps->width &&
-        y_ctb + ctb_size >= s->sps->height)
+        y_ctb + ctb_size >= s->sps->height && !s->deferred_filter)
         ff_hevc_hls_filter(s, x_ctb, y_ctb);
 
     return ctb_addr_ts;
 }
 
+#if HAVE_THREADS
+/**
+ * Wait until the given number of CTBs of a CTB row have been processed.
+ * @return 0 on success, a negative error code if a row failed to decode
+ */
+static int await_row(HEVCContext *s, int row, int progress)
+{
+    int err;
+
+    pthread_mutex_lock(&s->row_mutex[row]);
+    while (s->row_progress[row] < progress)
+        pthread_cond_wait(&s->row_cond[row], &s->row_mutex[row]);
+    err = s->row_err;
+    pthread_mutex_unlock(&s->row_mutex[row]);
+
+    return err ? AVERROR_INVALIDDATA : 0;
+}
+
+static void report_row(HEVCContext *s, int row, int progress)
+{
+    pthread_mutex_lock(&s->row_mutex[row]);
+    s->row_progress[row] = progress;
+    pthread_cond_broadcast(&s->row_cond[row]);
+    pthread_mutex_unlock(&s->row_mutex[row]);
+}
+#else
+static int await_row(HEVCContext *s, int row, int progress)
+{
+    return 0;
+}
+
+static void report_row(HEVCContext *s, int row, int progress)
+{
+}
+#endif
+
+static void copy_local_state(HEVCLocalContext *dst, const HEVCLocalContext *src)
+{
+    memcpy(dst->cabac_state, src->cabac_state, HEVC_CONTEXTS);
+    dst->gb               = src->gb;
+    dst->qp_y             = src->qp_y;
+    dst->first_qp_group   = src->first_qp_group;
+    dst->start_of_tiles_x = src->start_of_tiles_x;
+    dst->end_of_tiles_x   = src->end_of_tiles_x;
+}
+
+/**
+ * Decode one substream of a slice segment: a CTB row when WPP is enabled,
+ * a tile otherwise. Rows wait for the row above to be two CTBs ahead,
+ * which covers both the CABAC state inheritance and the in-loop filters.
+ */
+static int hls_decode_entry_parallel(AVCodecContext *avctx, void *arg,
+                                     int job, int self_id)
+{
+    HEVCContext *s0             = avctx->priv_data;
+    HEVCContext *s              = s0->sList[self_id];
+    HEVCLocalContext *lc        = s->HEVClc;
+    HEVCEntryPoint *entry       = &s0->entries[job];
+    int log2_ctb_size           = s->sps->log2_ctb_size;
+    int ctb_size                = 1 << log2_ctb_size;
+    int wpp                     = s->pps->entropy_coding_sync_enabled_flag;
+    int last                    = job == s->sh.num_entry_point_offsets;
+    int ctb_addr_end            = last ? s->sps->ctb_size : entry[1].ctb_addr_ts;
+    int ctb_addr_ts             = entry->ctb_addr_ts;
+    int row                     = s->pps->ctb_addr_ts_to_rs[ctb_addr_ts] / s->sps->ctb_width;
+    int more_data               = 1;
+    int x_ctb                   = 0;
+    int y_ctb                   = 0;
+    int ret                     = 0;
+
+    copy_local_state(lc, s0->HEVClc);
+
+    while (more_data && ctb_addr_ts < ctb_addr_end) {
+        int ctb_addr_rs = s->pps->ctb_addr_ts_to_rs[ctb_addr_ts];
+
+        x_ctb = (ctb_addr_rs % s->sps->ctb_width) << log2_ctb_size;
+        y_ctb = (ctb_addr_rs / s->sps->ctb_width) << log2_ctb_size;
+
+        if (wpp && job) {
+            ret = await_row(s0, row - 1, FFMIN((x_ctb >> log2_ctb_size) + 2,
+                                               s->sps->ctb_width));
+            if (ret < 0)
+                break;
+        }
+
+        hls_decode_neighbour(s, x_ctb, y_ctb, ctb_addr_ts);
+
+        if (job && ctb_addr_ts == entry->ctb_addr_ts)
+            ff_hevc_cabac_init_entry(s, ctb_addr_ts, entry->data, entry->size);
+        else
+            ff_hevc_cabac_init(s, ctb_addr_ts);
+
+        hls_sao_param(s, x_ctb >> log2_ctb_size, y_ctb >> log2_ctb_size);
+
+        s->deblock[ctb_addr_rs].beta_offset = s->sh.beta_offset;
+        s->deblock[ctb_addr_rs].tc_offset   = s->sh.tc_offset;
+        s->filter_slice_edges[ctb_addr_rs]  = s->sh.slice_loop_filter_across_slices_enabled_flag;
+
+        ret = hls_coding_quadtree(s, x_ctb, y_ctb, log2_ctb_size, 0);
+        if (ret < 0)
+            break;
+        more_data = !ff_hevc_end_of_slice_flag_decode(s);
+
+        ctb_addr_ts++;
+        ff_hevc_save_states(s, ctb_addr_ts);
+        if (!s->deferred_filter)
+            ff_hevc_hls_filters(s, x_ctb, y_ctb, ctb_size);
+        if (wpp)
+            report_row(s0, row, (x_ctb >> log2_ctb_size) + 1);
+    }
+
+    if (!ret && !more_data && !last) {
+        av_log(avctx, AV_LOG_ERROR, "Slice segment ended in entry point %d.\n",
+               job);
+        ret = AVERROR_INVALIDDATA;
+    }
+
+    if (ret < 0) {
+        s0->row_err = 1;
+    } else {
+        if (x_ctb + ctb_size >= s->sps->width &&
+            y_ctb + ctb_size >= s->sps->height && !s->deferred_filter)
+            ff_hevc_hls_filter(s, x_ctb, y_ctb);
+        if (last)
+            s0->last_entry_lc = lc;
+    }
+
+    if (wpp)
+        report_row(s0, row, INT_MAX);
+
+    entry->ret = ret < 0 ? ret : ctb_addr_ts;
+    return 0;
+}
+
+static int hls_slice_data_parallel(HEVCContext *s, const HEVCNAL *nal)
+{
+    GetBitContext *gb = &s->HEVClc->gb;
+    int nb_entries    = s->sh.num_entry_point_offsets + 1;
+    int wpp           = s->pps->entropy_coding_sync_enabled_flag;
+    int ctb_width     = s->sps->ctb_width;
+    int i, j, start, raw;
+
+    av_fast_malloc(&s->entries, &s->entries_allocated,
+                   nb_entries * sizeof(*s->entries));
+    if (!s->entries)
+        return AVERROR(ENOMEM);
+
+    /* The entry point offsets count the emulation prevention bytes, map
+     * them to the unescaped data. The slice data starts after the
+     * byte_alignment() following the slice header. */
+    start = (get_bits_count(gb) + 8) >> 3;
+    for (j = 0; j < nal->skipped_bytes && nal->skipped_bytes_pos[j] <= start; j++)
+        ;
+    raw = start + j;
+
+    for (i = 0; i < nb_entries; i++) {
+        HEVCEntryPoint *entry = &s->entries[i];
+        int offset;
+
+        if (i) {
+            if (s->sh.entry_point_offset[i - 1] > nal->size + nal->skipped_bytes - raw)
+                goto invalid;
+            raw += s->sh.entry_point_offset[i - 1];
+            while (j < nal->skipped_bytes && nal->skipped_bytes_pos[j] + j < raw)
+                j++;
+        }
+        offset = raw - j;
+        if (offset >= nal->size)
+            goto invalid;
+        entry->data = nal->data + offset;
+
+        if (!i) {
+            entry->ctb_addr_ts = s->pps->ctb_addr_rs_to_ts[s->sh.slice_ctb_addr_rs];
+        } else if (wpp) {
+            entry->ctb_addr_ts = (entry[-1].ctb_addr_ts / ctb_width + 1) * ctb_width;
+        } else {
+            int ctb_addr_ts = entry[-1].ctb_addr_ts + 1;
+            while (ctb_addr_ts < s->sps->ctb_size &&
+                   s->pps->tile_id[ctb_addr_ts] == s->pps->tile_id[ctb_addr_ts - 1])
+                ctb_addr_ts++;
+            entry->ctb_addr_ts = ctb_addr_ts;
+        }
+        if (entry->ctb_addr_ts >= s->sps->ctb_size)
+            goto invalid;
+
+        if (i) {
+            entry[-1].size = entry->data - entry[-1].data;
+            if (entry[-1].size <= 0)
+                goto invalid;
+        }
+    }
+    s->entries[nb_entries - 1].size = nal->data + nal->size -
+                                      s->entries[nb_entries - 1].data;
+
+    for (i = 0; i < s->threads_number; i++) {
+        memcpy(s->sList[i], s, sizeof(*s));
+        s->sList[i]->HEVClc = s->HEVClcList[i];
+    }
+
+    if (wpp) {
+        for (i = 0; i < nb_entries; i++)
+            s->row_progress[s->entries[i].ctb_addr_ts / ctb_width] = 0;
+    }
+    s->row_err       = 0;
+    s->last_entry_lc = NULL;
+
+    s->avctx->execute2(s->avctx, hls_decode_entry_parallel, NULL, NULL,
+                       nb_entries);
+
+    for (i = 0; i < nb_entries; i++)
+        if (s->entries[i].ret < 0)
+            return s->entries[i].ret;
+
+    copy_local_state(s->HEVClc, s->last_entry_lc);
+
+    return s->entries[nb_entries - 1].ret;
+
+invalid:
+    av_log(s->avctx, AV_LOG_ERROR, "Invalid entry point offsets.\n");
+    return AVERROR_INVALIDDATA;
+}
+
+static int hls_slice_data(HEVCContext *s, const HEVCNAL *nal)
+{
+    if (s->threads_number > 1 && s->sh.num_entry_point_offsets > 0 &&
+        !(s->pps->tiles_enabled_flag &&
+          s->pps->entropy_coding_sync_enabled_flag))
+        return hls_slice_data_parallel(s, nal);
+
+    return hls_decode_entry(s);
+}
+
+/**
+ * Run the in-loop filters on a CTB row once the whole picture is decoded,
+ * in the same wavefront order as during WPP decoding.
+ */
+static int hls_filter_row(AVCodecContext *avctx, void *arg, int row,
+                          int self_id)
+{
+    HEVCContext *s    = avctx->priv_data;
+    int log2_ctb_size = s->sps->log2_ctb_size;
+    int ctb_size      = 1 << log2_ctb_size;
+    int x;
+
+    for (x = 0; x < s->sps->ctb_width; x++)
+        ff_hevc_tile_boundary_strengths(s, x << log2_ctb_size,
+                                        row << log2_ctb_size);
+
+    for (x = 0; x < s->sps->ctb_width; x++) {
+        if (row)
+            await_row(s, row - 1, FFMIN(x + 2, s->sps->ctb_width));
+        ff_hevc_hls_filters(s, x << log2_ctb_size, row << log2_ctb_size,
+                            ctb_size);
+        report_row(s, row, x + 1);
+    }
+
+    if (row == s->sps->ctb_height - 1)
+        ff_hevc_hls_filter(s, (s->sps->ctb_width - 1) << log2_ctb_size,
+                           row << log2_ctb_size);
+
+    return 0;
+}
+
+static void hls_filter_picture(HEVCContext *s)
+{
+    memset(s->row_progress, 0, s->sps->ctb_height * sizeof(*s->row_progress));
+    s->row_err = 0;
+
+    s->avctx->execute2(s->avctx, hls_filter_row, NULL, NULL,
+                       s->sps->ctb_height);
+}
+
 /**
  * @return AVERROR_INVALIDDATA if the packet is not a valid NAL unit,
  * 0 if the unit should be skipped, 1 otherwise
  */
 static int hls_nal_unit(HEVCContext *s)
 {
-    GetBitContext *gb = &s->HEVClc.gb;
+    GetBitContext *gb = &s->HEVClc->gb;
     int nuh_layer_id;
 
     if (get_bits1(gb) != 0)
@@ -2442,7 +2786,7 @@ static int set_side_data(HEVCContext *s)
 
 static int hevc_frame_start(HEVCContext *s)
 {
-    HEVCLocalContext *lc = &s->HEVClc;
+    HEVCLocalContext *lc = s->HEVClc;
     int ret;
 
     memset(s->horizontal_bs, 0, 2 * s->bs_width * (s->bs_height + 1));
@@ -2454,6 +2798,10 @@ static int hevc_frame_start(HEVCContext *s)
     s->is_decoded        = 0;
     s->first_nal_type    = s->nal_unit_type;
 
+    /* tiles decoded in parallel are filtered once the picture is complete */
+    s->deferred_filter = s->threads_number > 1 && s->pps->tiles_enabled_flag &&
+                         !s->pps->entropy_coding_sync_enabled_flag;
+
     if (s->pps->tiles_enabled_flag)
         lc->end_of_tiles_x = s->pps->column_width[0] << s->sps->log2_ctb_size;
 
@@ -2490,13 +2838,13 @@ fail:
     return ret;
 }
 
-static int decode_nal_unit(HEVCContext *s, const uint8_t *nal, int length)
+static int decode_nal_unit(HEVCContext *s, const HEVCNAL *nal)
 {
-    HEVCLocalContext *lc = &s->HEVClc;
+    HEVCLocalContext *lc = s->HEVClc;
     GetBitContext *gb    = &lc->gb;
     int ctb_addr_ts, ret;
 
-    ret = init_get_bits8(gb, nal, length);
+    ret = init_get_bits8(gb, nal->data, nal->size);
     if (ret < 0)
         return ret;
 
@@ -2594,9 +2942,11 @@ static int decode_nal_unit(HEVCContext *s, const uint8_t *nal, int length)
             }
         }
 
-        ctb_addr_ts = hls_slice_data(s);
+        ctb_addr_ts = hls_slice_data(s, nal);
         if (ctb_addr_ts >= (s->sps->ctb_width * s->sps->ctb_height)) {
             s->is_decoded = 1;
+            if (s->deferred_filter)
+                hls_filter_picture(s);
             if ((s->pps->transquant_bypass_enable_flag ||
                  (s->sps->pcm.loop_filter_disable_flag && s->sps->pcm_enabled_flag)) &&
                 s->sps->sao_enabled)
@@ -2636,6 +2986,8 @@ static int extract_rbsp(const uint8_t *src, int length,
     int i, si, di;
     uint8_t *dst;
 
+    nal->skipped_bytes = 0;
+
 #define STARTCODE_TEST                                                  \
         if (i + 2 < length && src[i + 1] == 0 && src[i + 2] <= 3) {     \
             if (src[i + 2] != 3) {                                      \
@@ -2707,6 +3059,17 @@ static int extract_rbsp(const uint8_t *src, int length,
                 dst[di++] = 0;
                 si       += 3;
 
+                if (nal->skipped_bytes >= nal->skipped_bytes_pos_size) {
+                    int new_size = FFMAX(2 * nal->skipped_bytes_pos_size, 16);
+                    if (av_reallocp_array(&nal->skipped_bytes_pos, new_size,
+                                          sizeof(*nal->skipped_bytes_pos)) < 0) {
+                        nal->skipped_bytes_pos_size = 0;
+                        return AVERROR(ENOMEM);
+                    }
+                    nal->skipped_bytes_pos_size = new_size;
+                }
+                nal->skipped_bytes_pos[nal->skipped_bytes++] = di;
+
                 continue;
             } else // next start code
                 goto nsc;
@@ -2787,7 +3150,7 @@ static int decode_nal_units(HEVCContext *s, const uint8_t *buf, int length)
             goto fail;
         }
 
-        ret = init_get_bits8(&s->HEVClc.gb, nal->data, nal->size);
+        ret = init_get_bits8(&s->HEVClc->gb, nal->data, nal->size);
         if (ret < 0)
             goto fail;
         hls_nal_unit(s);
@@ -2802,7 +3165,7 @@ static int decode_nal_units(HEVCContext *s, const uint8_t *buf, int length)
 
     /* parse the NAL units */
     for (i = 0; i < s->nb_nals; i++) {
-        int ret = decode_nal_unit(s, s->nals[i].data, s->nals[i].size);
+        int ret = decode_nal_unit(s, &s->nals[i]);
         if (ret < 0) {
             av_log(s->avctx, AV_LOG_WARNING,
                    "Error parsing NAL unit #%d.\n", i);
@@ -2990,11 +3353,28 @@ static av_cold int hevc_decode_free(AVCodecContext *avctx)
     for (i = 0; i < FF_ARRAY_ELEMS(s->pps_list); i++)
         av_buffer_unref(&s->pps_list[i]);
 
-    for (i = 0; i < s->nals_allocated; i++)
+    for (i = 0; i < s->nals_allocated; i++) {
         av_freep(&s->nals[i].rbsp_buffer);
+        av_freep(&s->nals[i].skipped_bytes_pos);
+    }
     av_freep(&s->nals);
     s->nals_allocated = 0;
 
+    av_freep(&s->sh.entry_point_offset);
+    av_freep(&s->entries);
+
+    if (s->sList) {
+        for (i = 0; i < s->threads_number; i++) {
+            av_freep(&s->sList[i]);
+            av_freep(&s->HEVClcList[i]);
+        }
+    }
+    av_freep(&s->sList);
+    av_freep(&s->HEVClcList);
+
+    av_freep(&s->cabac_state);
+    av_freep(&s->HEVClc);
+
     return 0;
 }
 
@@ -3005,6 +3385,14 @@ static av_cold int hevc_init_context(AVCodecContext *avctx)
 
     s->avctx = avctx;
 
+    s->HEVClc = av_mallocz(sizeof(HEVCLocalContext));
+    if (!s->HEVClc)
+        goto fail;
+
+    s->cabac_state = av_malloc(HEVC_CONTEXTS);
+    if (!s->cabac_state)
+        goto fail;
+
     s->tmp_frame = av_frame_alloc();
     if (!s->tmp_frame)
         goto fail;
@@ -3169,6 +3557,27 @@ static int hevc_decode_extradata(HEVCContext *s)
     return 0;
 }
 
+static av_cold int hevc_init_slice_threads(AVCodecContext *avctx)
+{
+    HEVCContext *s = avctx->priv_data;
+    int i;
+
+    s->sList      = av_mallocz_array(avctx->thread_count, sizeof(*s->sList));
+    s->HEVClcList = av_mallocz_array(avctx->thread_count, sizeof(*s->HEVClcList));
+    if (!s->sList || !s->HEVClcList)
+        return AVERROR(ENOMEM);
+    s->threads_number = avctx->thread_count;
+
+    for (i = 0; i < s->threads_number; i++) {
+        s->sList[i]      = av_malloc(sizeof(*s->sList[i]));
+        s->HEVClcList[i] = av_mallocz(sizeof(*s->HEVClcList[i]));
+        if (!s->sList[i] || !s->HEVClcList[i])
+            return AVERROR(ENOMEM);
+    }
+
+    return 0;
+}
+
 static av_cold int hevc_decode_init(AVCodecContext *avctx)
 {
     HEVCContext *s = avctx->priv_data;
@@ -3182,6 +3591,16 @@ static av_cold int hevc_decode_init(AVCodecContext *avctx)
     if (ret < 0)
         return ret;
 
+    s->threads_number = 1;
+    if (avctx->active_thread_type & FF_THREAD_SLICE &&
+        avctx->thread_count > 1) {
+        ret = hevc_init_slice_threads(avctx);
+        if (ret < 0) {
+            hevc_decode_free(avctx);
+            return ret;
+        }
+    }
+
     if (avctx->extradata_size > 0 && avctx->extradata) {
         ret = hevc_decode_extradata(s);
         if (ret < 0) {
@@ -3251,6 +3670,6 @@ AVCodec ff_hevc_decoder = {
     .update_thread_context = hevc_update_thread_context,
     .init_thread_copy      = hevc_init_thread_copy,
     .capabilities          = CODEC_CAP_DR1 | CODEC_CAP_DELAY |
-                             CODEC_CAP_FRAME_THREADS,
+                             CODEC_CAP_SLICE_THREADS | CODEC_CAP_FRAME_THREADS,
     .profiles              = NULL_IF_CONFIG_SMALL(profiles),
 };
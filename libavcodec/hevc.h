@@ -38,6 +38,12 @@
 #include "thread.h"
 #include "videodsp.h"
 
+#if HAVE_PTHREADS
+#   include <pthread.h>
+#elif HAVE_W32THREADS
+#   include "compat/w32pthreads.h"
+#endif
+
 #define MAX_DPB_SIZE 16 // A.4.1
 #define MAX_REFS 16
 
@@ -574,6 +580,8 @@ typedef struct SliceHeader {
     unsigned int max_num_merge_cand; ///< 5 - 5_minus_max_num_merge_cand
 
     int num_entry_point_offsets;
+    int *entry_point_offset;        ///< entry_point_offset_minus1 + 1
+    unsigned int entry_point_offset_allocated;
 
     int8_t slice_qp;
 
@@ -696,8 +704,20 @@ typedef struct HEVCNAL {
 
     int size;
     const uint8_t *data;
+
+    /** positions in data of the emulation prevention bytes removed from it */
+    int *skipped_bytes_pos;
+    int skipped_bytes;
+    int skipped_bytes_pos_size;
 } HEVCNAL;
 
+typedef struct HEVCEntryPoint {
+    const uint8_t *data; ///< start of the substream in the unescaped NAL data
+    int size;
+    int ctb_addr_ts;     ///< first CTB of the substream, in tile scan
+    int ret;             ///< end of the substream in tile scan or an error code
+} HEVCEntryPoint;
+
 struct HEVCContext;
 
 typedef struct HEVCPredContext {
@@ -753,9 +773,38 @@ typedef struct HEVCContext {
     const AVClass *c;  // needed by private avoptions
     AVCodecContext *avctx;
 
-    HEVCLocalContext HEVClc;
+    HEVCLocalContext *HEVClc;
 
-    uint8_t cabac_state[HEVC_CONTEXTS];
+    /** CABAC state saved for the next CTB row when WPP is enabled */
+    uint8_t *cabac_state;
+
+    /**
+     * Slice threading: one context copy and one local context per thread.
+     * The copies share all the tables with the main context.
+     */
+    int threads_number;
+    struct HEVCContext **sList;
+    HEVCLocalContext **HEVClcList;
+    HEVCLocalContext *last_entry_lc; ///< local context that decoded the last entry
+
+    /**
+     * Number of CTBs completed in each CTB row during the current parallel
+     * pass, used to keep the wavefront dependencies between rows.
+     */
+    int *row_progress;
+    int row_err;
+#if HAVE_THREADS
+    pthread_mutex_t *row_mutex;
+    pthread_cond_t *row_cond;
+#endif
+    int nb_rows;
+
+    /** in-loop filters run once the whole picture is decoded */
+    int deferred_filter;
+
+    /** substreams of the slice segment being decoded in parallel */
+    HEVCEntryPoint *entries;
+    unsigned int entries_allocated;
 
     /** 1 if the independent slice segment header was successfully parsed */
     uint8_t slice_initialized;
@@ -896,6 +945,13 @@ int ff_hevc_slice_rpl(HEVCContext *s);
 
 void ff_hevc_save_states(HEVCContext *s, int ctb_addr_ts);
 void ff_hevc_cabac_init(HEVCContext *s, int ctb_addr_ts);
+
+/**
+ * Initialize the CABAC decoder for an entry point (a CTB row with WPP or a
+ * tile) that is decoded independently from the preceding one.
+ */
+void ff_hevc_cabac_init_entry(HEVCContext *s, int ctb_addr_ts,
+                              const uint8_t *buf, int size);
 int ff_hevc_sao_merge_flag_decode(HEVCContext *s);
 int ff_hevc_sao_type_idx_decode(HEVCContext *s);
 int ff_hevc_sao_band_position_decode(HEVCContext *s);
@@ -976,6 +1032,12 @@ void ff_hevc_set_qPy(HEVCContext *s, int xC, int yC, int xBase, int yBase,
                      int log2_cb_size);
 void ff_hevc_deblocking_boundary_strengths(HEVCContext *s, int x0, int y0,
                                            int log2_trafo_size);
+
+/**
+ * Compute the boundary strengths of the edges of a CTB shared with another
+ * tile, once both tiles are decoded. Used when tiles are decoded in parallel.
+ */
+void ff_hevc_tile_boundary_strengths(HEVCContext *s, int x0, int y0);
 int ff_hevc_cu_qp_delta_sign_flag(HEVCContext *s);
 int ff_hevc_cu_qp_delta_abs(HEVCContext *s);
 void ff_hevc_hls_filter(HEVCContext *s, int x, int y);
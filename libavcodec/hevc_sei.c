@@ -28,7 +28,7 @@
 static void decode_nal_sei_decoded_picture_hash(HEVCContext *s)
 {
     int cIdx, i;
-    GetBitContext *gb = &s->HEVClc.gb;
+    GetBitContext *gb = &s->HEVClc->gb;
     uint8_t hash_type = get_bits(gb, 8);
 
     for (cIdx = 0; cIdx < 3; cIdx++) {
@@ -48,7 +48,7 @@ static void decode_nal_sei_decoded_picture_hash(HEVCContext *s)
 
 static void decode_nal_sei_frame_packing_arrangement(HEVCContext *s)
 {
-    GetBitContext *gb = &s->HEVClc.gb;
+    GetBitContext *gb = &s->HEVClc->gb;
 
     get_ue_golomb(gb);                  // frame_packing_arrangement_id
     s->sei_frame_packing_present = !get_bits1(gb);
@@ -73,7 +73,7 @@ static void decode_nal_sei_frame_packing_arrangement(HEVCContext *s)
 
 static void decode_nal_sei_display_orientation(HEVCContext *s)
 {
-    GetBitContext *gb = &s->HEVClc.gb;
+    GetBitContext *gb = &s->HEVClc->gb;
 
     s->sei_display_orientation_present = !get_bits1(gb);
 
@@ -88,7 +88,7 @@ static void decode_nal_sei_display_orientation(HEVCContext *s)
 
 static int decode_nal_sei_message(HEVCContext *s)
 {
-    GetBitContext *gb = &s->HEVClc.gb;
+    GetBitContext *gb = &s->HEVClc->gb;
 
     int payload_type = 0;
     int payload_size = 0;
@@ -135,6 +135,6 @@ int ff_hevc_decode_nal_sei(HEVCContext *s)
 {
     do {
         decode_nal_sei_message(s);
-    } while (more_rbsp_data(&s->HEVClc.gb));
+    } while (more_rbsp_data(&s->HEVClc->gb));
     return 0;
 }
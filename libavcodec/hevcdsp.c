@@ -20,6 +20,8 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+#include <string.h>
+
 #include "hevcdsp.h"
 
 static const int8_t transform[32][32] = {
@@ -111,6 +113,121 @@ DECLARE_ALIGNED(16, const int8_t, ff_hevc_epel_filters[7][16]) = {
 #include "hevcdsp_template.c"
 #undef BIT_DEPTH
 
+/* The border pixels the C code writes with offset_val[0], which is always
+ * 0, are plain copies of the source. */
+static void sao_copy_column(uint8_t *dst, uint8_t *src, ptrdiff_t stride,
+                            int height, int pixel_shift)
+{
+    int y;
+
+    for (y = 0; y < height; y++)
+        memcpy(dst + y * stride, src + y * stride, 1 << pixel_shift);
+}
+
+void ff_hevc_sao_band_filter_0(uint8_t *dst, uint8_t *src, ptrdiff_t stride,
+                               SAOParams *sao, int *borders, int width,
+                               int height, int c_idx,
+                               hevc_sao_band_func filter)
+{
+    int8_t offset_table[32] = { 0 };
+    int chroma = !!c_idx;
+    int k;
+
+    if (!borders[2])
+        width -= (8 >> chroma) + 2;
+    if (!borders[3])
+        height -= (4 >> chroma) + 2;
+
+    for (k = 0; k < 4; k++)
+        offset_table[(k + sao->band_position[c_idx]) & 31] =
+            sao->offset_val[c_idx][k + 1];
+
+    filter(dst, src, stride, offset_table, width, height);
+}
+
+void ff_hevc_sao_edge_filter_0(uint8_t *dst, uint8_t *src, ptrdiff_t stride,
+                               SAOParams *sao, int *borders, int width,
+                               int height, int c_idx, uint8_t vert_edge,
+                               uint8_t horiz_edge, uint8_t diag_edge,
+                               int pixel_shift, hevc_sao_edge_func filter)
+{
+    static const int8_t pos[4][2][2] = {
+        { { -1,  0 }, {  1, 0 } }, // horizontal
+        { {  0, -1 }, {  0, 1 } }, // vertical
+        { { -1, -1 }, {  1, 1 } }, // 45 degree
+        { {  1, -1 }, { -1, 1 } }, // 135 degree
+    };
+    static const uint8_t edge_idx[] = { 1, 2, 0, 3, 4 };
+    int8_t offset_table[8] = { 0 };
+    int chroma       = !!c_idx;
+    int sao_eo_class = sao->eo_class[c_idx];
+    int init_x = 0, init_y = 0, save_upper_left, k;
+
+    if (!borders[2])
+        width -= (8 >> chroma) + 2;
+    if (!borders[3])
+        height -= (4 >> chroma) + 2;
+
+    if (sao_eo_class != SAO_EO_VERT) {
+        if (borders[0]) {
+            sao_copy_column(dst, src, stride, height, pixel_shift);
+            init_x = 1;
+        }
+        if (borders[2]) {
+            sao_copy_column(dst + ((width - 1) << pixel_shift),
+                            src + ((width - 1) << pixel_shift),
+                            stride, height, pixel_shift);
+            width--;
+        }
+    }
+    if (sao_eo_class != SAO_EO_HORIZ) {
+        if (borders[1]) {
+            if (width > init_x)
+                memcpy(dst + (init_x << pixel_shift),
+                       src + (init_x << pixel_shift),
+                       (width - init_x) << pixel_shift);
+            init_y = 1;
+        }
+        if (borders[3]) {
+            ptrdiff_t y_stride = stride * (height - 1);
+            if (width > init_x)
+                memcpy(dst + y_stride + (init_x << pixel_shift),
+                       src + y_stride + (init_x << pixel_shift),
+                       (width - init_x) << pixel_shift);
+            height--;
+        }
+    }
+
+    for (k = 0; k < 5; k++)
+        offset_table[k] = sao->offset_val[c_idx][edge_idx[k]];
+
+    if (width > init_x && height > init_y) {
+        ptrdiff_t offset = init_y * stride + (init_x << pixel_shift);
+        ptrdiff_t a = pos[sao_eo_class][0][1] * stride +
+                      (pos[sao_eo_class][0][0] << pixel_shift);
+        ptrdiff_t b = pos[sao_eo_class][1][1] * stride +
+                      (pos[sao_eo_class][1][0] << pixel_shift);
+        filter(dst + offset, src + offset, stride, offset_table, a, b,
+               width - init_x, height - init_y);
+    }
+
+    // Restore pixels that can't be modified
+    save_upper_left = !diag_edge && sao_eo_class == SAO_EO_135D &&
+                      !borders[0] && !borders[1];
+    if (vert_edge && sao_eo_class != SAO_EO_VERT &&
+        height > init_y + save_upper_left)
+        sao_copy_column(dst + (init_y + save_upper_left) * stride,
+                        src + (init_y + save_upper_left) * stride, stride,
+                        height - init_y - save_upper_left, pixel_shift);
+    if (horiz_edge && sao_eo_class != SAO_EO_HORIZ &&
+        width > init_x + save_upper_left)
+        memcpy(dst + ((init_x + save_upper_left) << pixel_shift),
+               src + ((init_x + save_upper_left) << pixel_shift),
+               (width - init_x - save_upper_left) << pixel_shift);
+    if (diag_edge && sao_eo_class == SAO_EO_135D)
+        memcpy(dst, src, 1 << pixel_shift);
+}
+
 void ff_hevc_dsp_init(HEVCDSPContext *hevcdsp, int bit_depth)
 {
 #undef FUNC
@@ -188,6 +305,10 @@ void ff_hevc_dsp_init(HEVCDSPContext *hevcdsp, int bit_depth)
         break;
     }
 
+    if (ARCH_AARCH64)
+        ff_hevc_dsp_init_aarch64(hevcdsp, bit_depth);
+    if (ARCH_ARM)
+        ff_hevc_dsp_init_arm(hevcdsp, bit_depth);
     if (ARCH_X86)
         ff_hevc_dsp_init_x86(hevcdsp, bit_depth);
 }
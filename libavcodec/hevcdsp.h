@@ -104,6 +104,38 @@ typedef struct HEVCDSPContext {
 
 void ff_hevc_dsp_init(HEVCDSPContext *hpc, int bit_depth);
 
+/**
+ * SAO kernels filtering a plain rectangle. The band filter takes the
+ * offsets of all 32 bands, the edge filter's table is indexed by
+ * 2 + sign(src - a) + sign(src - b) where a and b are the byte offsets of
+ * the two neighbours.
+ */
+typedef void (*hevc_sao_band_func)(uint8_t *dst, uint8_t *src,
+                                   ptrdiff_t stride,
+                                   const int8_t *offset_table,
+                                   int width, int height);
+typedef void (*hevc_sao_edge_func)(uint8_t *dst, uint8_t *src,
+                                   ptrdiff_t stride,
+                                   const int8_t *offset_table,
+                                   ptrdiff_t a, ptrdiff_t b,
+                                   int width, int height);
+
+/**
+ * sao_band_filter[0] and sao_edge_filter[0] on top of a rectangle kernel;
+ * picture borders and unfilterable edges are handled in C.
+ */
+void ff_hevc_sao_band_filter_0(uint8_t *dst, uint8_t *src, ptrdiff_t stride,
+                               SAOParams *sao, int *borders, int width,
+                               int height, int c_idx,
+                               hevc_sao_band_func filter);
+void ff_hevc_sao_edge_filter_0(uint8_t *dst, uint8_t *src, ptrdiff_t stride,
+                               SAOParams *sao, int *borders, int width,
+                               int height, int c_idx, uint8_t vert_edge,
+                               uint8_t horiz_edge, uint8_t diag_edge,
+                               int pixel_shift, hevc_sao_edge_func filter);
+
+void ff_hevc_dsp_init_aarch64(HEVCDSPContext *c, const int bit_depth);
+void ff_hevc_dsp_init_arm(HEVCDSPContext *c, const int bit_depth);
 void ff_hevc_dsp_init_x86(HEVCDSPContext *c, const int bit_depth);
 
 extern const int8_t ff_hevc_epel_filters[7][16];
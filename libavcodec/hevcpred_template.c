@@ -68,7 +68,7 @@ do {                                  \
         for (i = (start); i < (start) + (length); i++) \
             if (!IS_INTRA(-1, i)) \
                 ptr[i] = ptr[i - 1]
-    HEVCLocalContext *lc = &s->HEVClc;
+    HEVCLocalContext *lc = s->HEVClc;
     int i;
     int hshift = s->sps->hshift[c_idx];
     int vshift = s->sps->vshift[c_idx];
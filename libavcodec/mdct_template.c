@@ -31,7 +31,7 @@
  * MDCT/IMDCT transforms.
  */
 
-#if FFT_FLOAT
+#if FFT_FLOAT || FFT_FIXED_32
 #   define RSCALE(x) (x)
 #else
 #   define RSCALE(x) ((x) >> 1)
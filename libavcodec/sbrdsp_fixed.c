@@ -0,0 +1,263 @@
+/*
+ * AAC Spectral Band Replication decoding functions, fixed-point
+ *
+ * This file is part of Libav.
+ *
+ * Libav is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * Libav is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Libav; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file
+ * SBR DSP functions on integer QMF values, energies and gains are SoftFloat.
+ */
+
+#define CONFIG_AACDEC_FIXED 1
+
+#include "config.h"
+#include "libavutil/attributes.h"
+#include "libavutil/common.h"
+#include "sbrdsp.h"
+#include "softfloat.h"
+
+/** limit of the HF adjusted QMF values, leaves headroom for the noise */
+#define SBR_Y_MAX (1 << 27)
+
+/**
+ * @return x * g * 2^-frac, rounded and clipped to +-SBR_Y_MAX
+ */
+static av_always_inline int sbr_gain_apply(int x, SoftFloat g, int frac)
+{
+    int shift = SF_ONE_BITS + frac - g.exp;
+    int64_t r = (int64_t)x * g.mant;
+
+    if (shift > 62)
+        return 0;
+    if (shift > 0)
+        r = (r + (1LL << (shift - 1))) >> shift;
+    else if (r)
+        r = av_clipl_int32(r) * (1LL << FFMIN(-shift, 31));
+    return FFMAX(FFMIN(r, SBR_Y_MAX), -SBR_Y_MAX);
+}
+
+static void sbr_sum64x5_c(int *z)
+{
+    int k;
+    for (k = 0; k < 64; k++) {
+        int f = z[k] + z[k + 64] + z[k + 128] + z[k + 192] + z[k + 256];
+        z[k] = f;
+    }
+}
+
+static SoftFloat sbr_sum_square_c(int (*x)[2], int n)
+{
+    int64_t sum = 0;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        sum += (int64_t)x[i][0] * x[i][0] >> 8;
+        sum += (int64_t)x[i][1] * x[i][1] >> 8;
+    }
+
+    return sf_from_fixed(sum, -8);
+}
+
+static void sbr_neg_odd_64_c(int *x)
+{
+    int i;
+    for (i = 1; i < 64; i += 2)
+        x[i] = -x[i];
+}
+
+static void sbr_qmf_pre_shuffle_c(int *z)
+{
+    int k;
+    z[64] = z[0];
+    z[65] = z[1];
+    for (k = 1; k < 32; k++) {
+        z[64 + 2 * k    ] = -z[64 - k];
+        z[64 + 2 * k + 1] =  z[ k + 1];
+    }
+}
+
+static void sbr_qmf_post_shuffle_c(int W[32][2], const int *z)
+{
+    int k;
+    for (k = 0; k < 32; k++) {
+        W[k][0] = -z[63 - k];
+        W[k][1] =  z[k];
+    }
+}
+
+static void sbr_qmf_deint_neg_c(int *v, const int *src)
+{
+    int i;
+    for (i = 0; i < 32; i++) {
+        v[     i] =  src[63 - 2 * i    ];
+        v[63 - i] = -src[63 - 2 * i - 1];
+    }
+}
+
+static void sbr_qmf_deint_bfly_c(int *v, const int *src0, const int *src1)
+{
+    int i;
+    for (i = 0; i < 64; i++) {
+        v[      i] = src0[i] - src1[63 - i];
+        v[127 - i] = src0[i] + src1[63 - i];
+    }
+}
+
+static av_always_inline int64_t mul8(int a, int b)
+{
+    return (int64_t)a * b >> 8;
+}
+
+static void sbr_autocorrelate_c(const int x[40][2], SoftFloat phi[3][2][2])
+{
+    int64_t real_sum2 = mul8(x[0][0], x[2][0]) + mul8(x[0][1], x[2][1]);
+    int64_t imag_sum2 = mul8(x[0][0], x[2][1]) - mul8(x[0][1], x[2][0]);
+    int64_t real_sum1 = 0, imag_sum1 = 0, real_sum0 = 0;
+    int     i;
+    for (i = 1; i < 38; i++) {
+        real_sum0 += mul8(x[i][0], x[i    ][0]) + mul8(x[i][1], x[i    ][1]);
+        real_sum1 += mul8(x[i][0], x[i + 1][0]) + mul8(x[i][1], x[i + 1][1]);
+        imag_sum1 += mul8(x[i][0], x[i + 1][1]) - mul8(x[i][1], x[i + 1][0]);
+        real_sum2 += mul8(x[i][0], x[i + 2][0]) + mul8(x[i][1], x[i + 2][1]);
+        imag_sum2 += mul8(x[i][0], x[i + 2][1]) - mul8(x[i][1], x[i + 2][0]);
+    }
+    phi[2 - 2][1][0] = sf_from_fixed(real_sum2, -8);
+    phi[2 - 2][1][1] = sf_from_fixed(imag_sum2, -8);
+    phi[2    ][1][0] = sf_from_fixed(real_sum0 + mul8(x[ 0][0], x[ 0][0]) + mul8(x[ 0][1], x[ 0][1]), -8);
+    phi[1    ][0][0] = sf_from_fixed(real_sum0 + mul8(x[38][0], x[38][0]) + mul8(x[38][1], x[38][1]), -8);
+    phi[2 - 1][1][0] = sf_from_fixed(real_sum1 + mul8(x[ 0][0], x[ 1][0]) + mul8(x[ 0][1], x[ 1][1]), -8);
+    phi[2 - 1][1][1] = sf_from_fixed(imag_sum1 + mul8(x[ 0][0], x[ 1][1]) - mul8(x[ 0][1], x[ 1][0]), -8);
+    phi[0    ][0][0] = sf_from_fixed(real_sum1 + mul8(x[38][0], x[39][0]) + mul8(x[38][1], x[39][1]), -8);
+    phi[0    ][0][1] = sf_from_fixed(imag_sum1 + mul8(x[38][0], x[39][1]) - mul8(x[38][1], x[39][0]), -8);
+}
+
+/* alpha0/alpha1 in Q29, bw in Q31 */
+static void sbr_hf_gen_c(int (*X_high)[2], const int (*X_low)[2],
+                         const int alpha0[2], const int alpha1[2],
+                         int bw, int start, int end)
+{
+    int64_t bw2 = ((int64_t)bw * bw + 0x40000000) >> 31;
+    int alpha[4];
+    int i;
+
+    alpha[0] = (int)((alpha1[0] * bw2 + 0x40000000) >> 31);
+    alpha[1] = (int)((alpha1[1] * bw2 + 0x40000000) >> 31);
+    alpha[2] = AAC_MUL31(alpha0[0], bw);
+    alpha[3] = AAC_MUL31(alpha0[1], bw);
+
+    for (i = start; i < end; i++) {
+        int64_t re = (int64_t)X_low[i - 2][0] * alpha[0] -
+                     (int64_t)X_low[i - 2][1] * alpha[1] +
+                     (int64_t)X_low[i - 1][0] * alpha[2] -
+                     (int64_t)X_low[i - 1][1] * alpha[3];
+        int64_t im = (int64_t)X_low[i - 2][1] * alpha[0] +
+                     (int64_t)X_low[i - 2][0] * alpha[1] +
+                     (int64_t)X_low[i - 1][1] * alpha[2] +
+                     (int64_t)X_low[i - 1][0] * alpha[3];
+        X_high[i][0] = av_clipl_int32(((re + 0x10000000) >> 29) + X_low[i][0]);
+        X_high[i][1] = av_clipl_int32(((im + 0x10000000) >> 29) + X_low[i][1]);
+    }
+}
+
+static void sbr_hf_g_filt_c(int (*Y)[2], const int (*X_high)[40][2],
+                            const SoftFloat *g_filt, int m_max, intptr_t ixh)
+{
+    int m;
+
+    for (m = 0; m < m_max; m++) {
+        Y[m][0] = sbr_gain_apply(X_high[m][ixh][0], g_filt[m], 0);
+        Y[m][1] = sbr_gain_apply(X_high[m][ixh][1], g_filt[m], 0);
+    }
+}
+
+static av_always_inline void sbr_hf_apply_noise(int (*Y)[2],
+                                                const SoftFloat *s_m,
+                                                const SoftFloat *q_filt,
+                                                int noise,
+                                                int phi_sign0,
+                                                int phi_sign1,
+                                                int m_max)
+{
+    int m;
+
+    for (m = 0; m < m_max; m++) {
+        int y0 = Y[m][0];
+        int y1 = Y[m][1];
+        noise = (noise + 1) & 0x1ff;
+        if (s_m[m].mant) {
+            int s = sf_to_fixed(s_m[m], 0);
+            y0 += s * phi_sign0;
+            y1 += s * phi_sign1;
+        } else {
+            y0 += sbr_gain_apply(ff_sbr_noise_table_fixed[noise][0], q_filt[m], 31);
+            y1 += sbr_gain_apply(ff_sbr_noise_table_fixed[noise][1], q_filt[m], 31);
+        }
+        Y[m][0] = y0;
+        Y[m][1] = y1;
+        phi_sign1 = -phi_sign1;
+    }
+}
+
+static void sbr_hf_apply_noise_0(int (*Y)[2], const SoftFloat *s_m,
+                                 const SoftFloat *q_filt, int noise,
+                                 int kx, int m_max)
+{
+    sbr_hf_apply_noise(Y, s_m, q_filt, noise, 1, 0, m_max);
+}
+
+static void sbr_hf_apply_noise_1(int (*Y)[2], const SoftFloat *s_m,
+                                 const SoftFloat *q_filt, int noise,
+                                 int kx, int m_max)
+{
+    int phi_sign = 1 - 2 * (kx & 1);
+    sbr_hf_apply_noise(Y, s_m, q_filt, noise, 0, phi_sign, m_max);
+}
+
+static void sbr_hf_apply_noise_2(int (*Y)[2], const SoftFloat *s_m,
+                                 const SoftFloat *q_filt, int noise,
+                                 int kx, int m_max)
+{
+    sbr_hf_apply_noise(Y, s_m, q_filt, noise, -1, 0, m_max);
+}
+
+static void sbr_hf_apply_noise_3(int (*Y)[2], const SoftFloat *s_m,
+                                 const SoftFloat *q_filt, int noise,
+                                 int kx, int m_max)
+{
+    int phi_sign = 1 - 2 * (kx & 1);
+    sbr_hf_apply_noise(Y, s_m, q_filt, noise, 0, -phi_sign, m_max);
+}
+
+av_cold void ff_sbrdsp_init_fixed(SBRDSPContext *s)
+{
+    s->sum64x5 = sbr_sum64x5_c;
+    s->sum_square = sbr_sum_square_c;
+    s->neg_odd_64 = sbr_neg_odd_64_c;
+    s->qmf_pre_shuffle = sbr_qmf_pre_shuffle_c;
+    s->qmf_post_shuffle = sbr_qmf_post_shuffle_c;
+    s->qmf_deint_neg = sbr_qmf_deint_neg_c;
+    s->qmf_deint_bfly = sbr_qmf_deint_bfly_c;
+    s->autocorrelate = sbr_autocorrelate_c;
+    s->hf_gen = sbr_hf_gen_c;
+    s->hf_g_filt = sbr_hf_g_filt_c;
+
+    s->hf_apply_noise[0] = sbr_hf_apply_noise_0;
+    s->hf_apply_noise[1] = sbr_hf_apply_noise_1;
+    s->hf_apply_noise[2] = sbr_hf_apply_noise_2;
+    s->hf_apply_noise[3] = sbr_hf_apply_noise_3;
+}
@@ -0,0 +1,203 @@
+/*
+ * Floating-point arithmetic on integers
+ *
+ * This file is part of Libav.
+ *
+ * Libav is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * Libav is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Libav; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file
+ * Floating-point arithmetic on integers, for the values of the fixed-point
+ * decoders whose range does not fit a fixed Q format (energies, gains).
+ * Results are truncated, not rounded.
+ */
+
+#ifndef AVCODEC_SOFTFLOAT_H
+#define AVCODEC_SOFTFLOAT_H
+
+#include <stdint.h>
+
+#include "libavutil/attributes.h"
+#include "libavutil/common.h"
+
+/** position of the binary point in a normalized mantissa */
+#define SF_ONE_BITS 29
+#define SF_MIN_EXP  -1000
+#define SF_MAX_EXP   1000
+
+/**
+ * value = mant * 2^(exp - SF_ONE_BITS)
+ * Normalized values have 2^29 <= |mant| < 2^30, zero has mant == 0.
+ */
+typedef struct SoftFloat {
+    int32_t mant;
+    int32_t exp;
+} SoftFloat;
+
+#define SF_ZERO ((SoftFloat){ 0, SF_MIN_EXP })
+#define SF_ONE  ((SoftFloat){ 1 << SF_ONE_BITS, 0 })
+#define SF_MAX  ((SoftFloat){ (2 << SF_ONE_BITS) - 1, SF_MAX_EXP })
+
+/**
+ * @return m * 2^(e - SF_ONE_BITS), normalized
+ */
+static av_always_inline SoftFloat sf_normalize(int64_t m, int e)
+{
+    uint64_t a = m < 0 ? -(uint64_t)m : m;
+    SoftFloat r;
+    int shift;
+
+    if (!a)
+        return SF_ZERO;
+    shift = (a >> 32 ? 32 + av_log2(a >> 32) : av_log2(a)) - SF_ONE_BITS;
+    if (shift > 0)
+        a >>= shift;
+    else
+        a <<= -shift;
+    e += shift;
+    if (e < SF_MIN_EXP)
+        return SF_ZERO;
+    if (e > SF_MAX_EXP) {
+        a = (2 << SF_ONE_BITS) - 1;
+        e = SF_MAX_EXP;
+    }
+    r.mant = m < 0 ? -(int32_t)a : (int32_t)a;
+    r.exp  = e;
+    return r;
+}
+
+static av_always_inline SoftFloat sf_from_int(int v)
+{
+    return sf_normalize(v, SF_ONE_BITS);
+}
+
+/**
+ * @return v * 2^-frac
+ */
+static av_always_inline SoftFloat sf_from_fixed(int64_t v, int frac)
+{
+    return sf_normalize(v, SF_ONE_BITS - frac);
+}
+
+/**
+ * @return a * 2^frac rounded to an integer, saturated to 32 bits
+ */
+static av_always_inline int sf_to_fixed(SoftFloat a, int frac)
+{
+    int shift = SF_ONE_BITS - a.exp - frac;
+
+    if (shift > 31)
+        return 0;
+    if (shift > 0)
+        return ((int64_t)a.mant + (1 << (shift - 1))) >> shift;
+    if (shift < -31)
+        return a.mant < 0 ? INT32_MIN : INT32_MAX;
+    return av_clipl_int32((int64_t)a.mant << -shift);
+}
+
+/**
+ * @return 2^(h / 2)
+ */
+static av_always_inline SoftFloat sf_exp2_half(int h)
+{
+    SoftFloat r;
+
+    r.mant = h & 1 ? 759250125 : 1 << SF_ONE_BITS; // sqrt(2) << 29
+    r.exp  = av_clip(h >> 1, SF_MIN_EXP, SF_MAX_EXP);
+    return r;
+}
+
+static av_always_inline SoftFloat sf_mul(SoftFloat a, SoftFloat b)
+{
+    return sf_normalize((int64_t)a.mant * b.mant, a.exp + b.exp - SF_ONE_BITS);
+}
+
+/**
+ * Division, a division by zero saturates.
+ */
+static av_always_inline SoftFloat sf_div(SoftFloat a, SoftFloat b)
+{
+    if (!b.mant)
+        return SF_MAX;
+    return sf_normalize(((int64_t)a.mant << 30) / b.mant, a.exp - b.exp - 1);
+}
+
+static av_always_inline SoftFloat sf_add(SoftFloat a, SoftFloat b)
+{
+    int d;
+
+    if (!a.mant)
+        return b;
+    if (!b.mant)
+        return a;
+    if (a.exp < b.exp)
+        FFSWAP(SoftFloat, a, b);
+    d = a.exp - b.exp;
+    if (d > 32)
+        return a;
+    return sf_normalize(((int64_t)a.mant << 32) + ((int64_t)b.mant << (32 - d)),
+                        a.exp - 32);
+}
+
+static av_always_inline SoftFloat sf_sub(SoftFloat a, SoftFloat b)
+{
+    b.mant = -b.mant;
+    return sf_add(a, b);
+}
+
+/**
+ * @return 1 if a > b, 0 otherwise
+ */
+static av_always_inline int sf_gt(SoftFloat a, SoftFloat b)
+{
+    return sf_sub(a, b).mant > 0;
+}
+
+static av_always_inline SoftFloat sf_min(SoftFloat a, SoftFloat b)
+{
+    return sf_gt(a, b) ? b : a;
+}
+
+/**
+ * Square root, negative values return zero.
+ */
+static av_always_inline SoftFloat sf_sqrt(SoftFloat a)
+{
+    uint64_t m, r = 0, bit = 1ULL << 62;
+    int e = a.exp - SF_ONE_BITS;
+
+    if (a.mant <= 0)
+        return SF_ZERO;
+    m = a.mant;
+    if (e & 1) {
+        m <<= 1;
+        e--;
+    }
+    m <<= 32;
+    while (bit > m)
+        bit >>= 2;
+    while (bit) {
+        if (m >= r + bit) {
+            m -= r + bit;
+            r  = (r >> 1) + bit;
+        } else
+            r >>= 1;
+        bit >>= 2;
+    }
+    return sf_normalize(r, e / 2 - 16 + SF_ONE_BITS);
+}
+
+#endif /* AVCODEC_SOFTFLOAT_H */
@@ -35,6 +35,7 @@
 #include "h263.h"
 #include "h264chroma.h"
 #include "qpeldsp.h"
+#include "thread.h"
 #include "vc1.h"
 #include "vc1data.h"
 #include "vc1acdata.h"
@@ -339,6 +340,19 @@ static void vc1_smooth_overlap_filter_iblk(VC1Context *v)
     }
 }
 
+/** Wait until the reference picture in direction dir is decoded down to
+ * luma line y, counted in field lines for field pictures.
+ */
+static void vc1_await_ref(VC1Context *v, int dir, int y)
+{
+    MpegEncContext *s = &v->s;
+    Picture *ref = dir ? s->next_picture_ptr : s->last_picture_ptr;
+
+    if (HAVE_THREADS && s->avctx->active_thread_type & FF_THREAD_FRAME && ref)
+        ff_thread_await_progress(&ref->tf,
+                                 ((y << v->field_mode) | v->field_mode) >> 4, 0);
+}
+
 /** Do motion compensation over 1 macroblock
  * Mostly adapted hpel_motion and qpel_motion from mpegvideo.c
  */
@@ -432,6 +446,9 @@ static void vc1_mc_1mv(VC1Context *v, int dir)
         uvsrc_y = av_clip(uvsrc_y,  -8, s->avctx->coded_height >> 1);
     }
 
+    if (srcY != s->current_picture.f->data[0])
+        vc1_await_ref(v, dir, FFMAX(src_y + 19, 2 * uvsrc_y + 18));
+
     srcY += src_y   * s->linesize   + src_x;
     srcU += uvsrc_y * s->uvlinesize + uvsrc_x;
     srcV += uvsrc_y * s->uvlinesize + uvsrc_x;
@@ -687,6 +704,9 @@ static void vc1_mc_4mv_luma(VC1Context *v, int n, int dir, int avg)
         }
     }
 
+    if (srcY != s->current_picture.f->data[0])
+        vc1_await_ref(v, dir, src_y + (12 << fieldmv));
+
     srcY += src_y * s->linesize + src_x;
     if (v->field_mode && v->ref_field_type[dir])
         srcY += s->current_picture_ptr->f->linesize[0];
@@ -903,6 +923,9 @@ static void vc1_mc_4mv_chroma(VC1Context *v, int dir)
         return;
     }
 
+    if (srcU != s->current_picture.f->data[1])
+        vc1_await_ref(v, dir, 2 * uvsrc_y + 18);
+
     srcU += uvsrc_y * s->uvlinesize + uvsrc_x;
     srcV += uvsrc_y * s->uvlinesize + uvsrc_x;
 
@@ -1013,6 +1036,7 @@ static void vc1_mc_4mv_chroma4(VC1Context *v, int dir, int dir2, int avg)
         // FIXME: implement proper pull-back (see vc1cropmv.c, vc1CROPMV_ChromaPullBack())
         uvsrc_x = av_clip(uvsrc_x, -8, s->avctx->coded_width  >> 1);
         uvsrc_y = av_clip(uvsrc_y, -8, s->avctx->coded_height >> 1);
+        vc1_await_ref(v, i < 2 ? dir : dir2, 2 * (uvsrc_y + (5 << fieldmv)));
         if (i < 2 ? dir : dir2) {
             srcU = s->next_picture.f->data[1] + uvsrc_y * s->uvlinesize + uvsrc_x;
             srcV = s->next_picture.f->data[2] + uvsrc_y * s->uvlinesize + uvsrc_x;
@@ -1947,6 +1971,8 @@ static void vc1_interp_mc(VC1Context *v)
         uvsrc_y = av_clip(uvsrc_y,  -8, s->avctx->coded_height >> 1);
     }
 
+    vc1_await_ref(v, 1, FFMAX(src_y + 19, 2 * uvsrc_y + 18));
+
     srcY += src_y   * s->linesize   + src_x;
     srcU += uvsrc_y * s->uvlinesize + uvsrc_x;
     srcV += uvsrc_y * s->uvlinesize + uvsrc_x;
@@ -4761,6 +4787,20 @@ static int vc1_decode_b_mb_intfr(VC1Context *v)
     return 0;
 }
 
+/** Report the MB rows of a reference picture that are final to the frame
+ * threads waiting on it. Overlap smoothing and loop filtering run up to two
+ * rows behind the decoding loop, so the rows above those are reported.
+ * Field pictures are only reported once complete, by ff_mpv_frame_end().
+ */
+static void vc1_report_decode_progress(VC1Context *v)
+{
+    MpegEncContext *s = &v->s;
+
+    if (!v->field_mode && s->pict_type != AV_PICTURE_TYPE_B &&
+        !s->er.error_occurred)
+        ff_thread_report_progress(&s->current_picture_ptr->tf, s->mb_y - 2, 0);
+}
+
 /** Decode blocks of I-frame
  */
 static void vc1_decode_i_blocks(VC1Context *v)
@@ -4894,6 +4934,7 @@ static void vc1_decode_i_blocks(VC1Context *v)
             ff_mpeg_draw_horiz_band(s, s->mb_y * 16, 16);
         else if (s->mb_y)
             ff_mpeg_draw_horiz_band(s, (s->mb_y - 1) * 16, 16);
+        vc1_report_decode_progress(v);
 
         s->first_slice_line = 0;
     }
@@ -5022,6 +5063,7 @@ static void vc1_decode_i_blocks_adv(VC1Context *v)
             ff_mpeg_draw_horiz_band(s, s->mb_y * 16, 16);
         else if (s->mb_y)
             ff_mpeg_draw_horiz_band(s, (s->mb_y-1) * 16, 16);
+        vc1_report_decode_progress(v);
         s->first_slice_line = 0;
     }
 
@@ -5101,6 +5143,7 @@ static void vc1_decode_p_blocks(VC1Context *v)
         memmove(v->is_intra_base, v->is_intra, sizeof(v->is_intra_base[0]) * s->mb_stride);
         memmove(v->luma_mv_base,  v->luma_mv,  sizeof(v->luma_mv_base[0])  * s->mb_stride);
         if (s->mb_y != s->start_mb_y) ff_mpeg_draw_horiz_band(s, (s->mb_y - 1) * 16, 16);
+        vc1_report_decode_progress(v);
         s->first_slice_line = 0;
     }
     if (apply_loop_filter) {
@@ -5150,6 +5193,8 @@ static void vc1_decode_b_blocks(VC1Context *v)
     for (s->mb_y = s->start_mb_y; s->mb_y < s->end_mb_y; s->mb_y++) {
         s->mb_x = 0;
         init_block_index(v);
+        /* direct mode reads the motion vectors of the co-located MBs */
+        vc1_await_ref(v, 1, s->mb_y * 16 + 15);
         for (; s->mb_x < s->mb_width; s->mb_x++) {
             ff_update_block_index(s);
 
@@ -5193,10 +5238,12 @@ static void vc1_decode_skip_blocks(VC1Context *v)
         s->mb_x = 0;
         init_block_index(v);
         ff_update_block_index(s);
+        vc1_await_ref(v, 0, s->mb_y * 16 + 15);
         memcpy(s->dest[0], s->last_picture.f->data[0] + s->mb_y * 16 * s->linesize,   s->linesize   * 16);
         memcpy(s->dest[1], s->last_picture.f->data[1] + s->mb_y *  8 * s->uvlinesize, s->uvlinesize *  8);
         memcpy(s->dest[2], s->last_picture.f->data[2] + s->mb_y *  8 * s->uvlinesize, s->uvlinesize *  8);
         ff_mpeg_draw_horiz_band(s, s->mb_y * 16, 16);
+        vc1_report_decode_progress(v);
         s->first_slice_line = 0;
     }
     s->pict_type = AV_PICTURE_TYPE_P;
@@ -5707,6 +5754,7 @@ static av_cold int vc1_decode_init(AVCodecContext *avctx)
         avctx->level = v->level;
 
     avctx->has_b_frames = !!avctx->max_b_frames;
+    avctx->internal->allocate_progress = 1;
 
     s->mb_width  = (avctx->coded_width  + 15) >> 4;
     s->mb_height = (avctx->coded_height + 15) >> 4;
@@ -5769,6 +5817,83 @@ av_cold int ff_vc1_decode_end(AVCodecContext *avctx)
     return 0;
 }
 
+#if HAVE_THREADS
+static av_cold int vc1_decode_init_thread_copy(AVCodecContext *avctx)
+{
+    VC1Context *v = avctx->priv_data;
+
+    /* the block tables are allocated once the first update provides the
+     * frame size, and the sprite frame is only needed by the image decoders */
+    v->sprite_output_frame = NULL;
+    v->s.avctx             = avctx;
+
+    return 0;
+}
+
+static int vc1_update_thread_context(AVCodecContext *dst,
+                                     const AVCodecContext *src)
+{
+    VC1Context *v = dst->priv_data;
+    const VC1Context *v1 = src->priv_data;
+    MpegEncContext *s = &v->s;
+    const MpegEncContext *s1 = &v1->s;
+    int init, ret;
+
+    if (dst == src || !s1->context_initialized)
+        return 0;
+
+    /* the block tables depend on the frame size, start over on a change
+     * just like vc1_decode_frame() does */
+    if (s->context_initialized &&
+        (s->width != s1->width || s->height != s1->height))
+        ff_vc1_decode_end(dst);
+    init = s->context_initialized;
+
+    if ((ret = ff_mpeg_update_thread_context(dst, src)) < 0)
+        return ret;
+    if (!init && (ret = ff_vc1_decode_init_alloc_tables(v)) < 0)
+        return ret;
+
+    s->h_edge_pos     = s1->h_edge_pos;
+    s->v_edge_pos     = s1->v_edge_pos;
+    s->loop_filter    = s1->loop_filter;
+    s->quarter_sample = s1->quarter_sample;
+
+    // sequence header and entry point parameters
+    memcpy(&v->res_sprite, &v1->res_sprite,
+           (const char *)&v1->finterpflag + sizeof(v1->finterpflag) -
+           (const char *)&v1->res_sprite);
+    v->broken_link      = v1->broken_link;
+    v->closed_entry     = v1->closed_entry;
+    v->range_mapy_flag  = v1->range_mapy_flag;
+    v->range_mapuv_flag = v1->range_mapuv_flag;
+    v->range_mapy       = v1->range_mapy;
+    v->range_mapuv      = v1->range_mapuv;
+
+    // state carried over from the previous pictures
+    memcpy(v->last_luty, v1->last_luty,
+           (const char *)v1->next_lutuv + sizeof(v1->next_lutuv) -
+           (const char *)v1->last_luty);
+    v->last_use_ic = v1->last_use_ic;
+    v->next_use_ic = v1->next_use_ic;
+    v->aux_use_ic  = v1->aux_use_ic;
+    v->rnd         = v1->rnd;
+    v->refdist     = v1->refdist;
+
+    /* field MV types of the last anchor, used by B-field direct mode;
+     * field pictures only finish setup once these are final */
+    if (v->mv_f_next_base && v1->mv_f_next_base) {
+        int mb_height = FFALIGN(s->mb_height, 2);
+        int size      = s->b8_stride * (mb_height * 2 + 1) +
+                        s->mb_stride * (mb_height + 1) * 2;
+        memcpy(v->mv_f_next[0] - s->b8_stride - 1,
+               v1->mv_f_next[0] - s1->b8_stride - 1, 2 * size);
+    }
+
+    return 0;
+}
+#endif
+
 
 /** Decode a VC1/WMV3 frame
  * @todo TODO: Handle VC-1 IDUs (Transport level?)
@@ -5783,7 +5908,7 @@ static int vc1_decode_frame(AVCodecContext *avctx, void *data,
     AVFrame *pict = data;
     uint8_t *buf2 = NULL;
     const uint8_t *buf_start = buf;
-    int mb_height, n_slices1;
+    int mb_height, n_slices1, frame_started = 0;
     struct {
         uint8_t *buf;
         GetBitContext gb;
@@ -5983,6 +6108,7 @@ static int vc1_decode_frame(AVCodecContext *avctx, void *data,
     if (ff_mpv_frame_start(s, avctx) < 0) {
         goto err;
     }
+    frame_started = 1;
 
     // process pulldown flags
     s->current_picture_ptr->f->repeat_pict = 0;
@@ -5999,6 +6125,11 @@ static int vc1_decode_frame(AVCodecContext *avctx, void *data,
     s->me.qpel_put = s->qdsp.put_qpel_pixels_tab;
     s->me.qpel_avg = s->qdsp.avg_qpel_pixels_tab;
 
+    /* Field pictures update the MV field tables and parse the second field
+     * header while decoding, so the next frame can only start afterwards. */
+    if (!v->field_mode && !avctx->hwaccel)
+        ff_thread_finish_setup(avctx);
+
     if (avctx->hwaccel) {
         if (avctx->hwaccel->start_frame(avctx, buf, buf_size) < 0)
             goto err;
@@ -6095,6 +6226,9 @@ static int vc1_decode_frame(AVCodecContext *avctx, void *data,
 
     ff_mpv_frame_end(s);
 
+    if (v->field_mode || avctx->hwaccel)
+        ff_thread_finish_setup(avctx);
+
     if (avctx->codec_id == AV_CODEC_ID_WMV3IMAGE || avctx->codec_id == AV_CODEC_ID_VC1IMAGE) {
 image:
         avctx->width  = avctx->coded_width  = v->output_width;
@@ -6130,6 +6264,9 @@ end:
     return buf_size;
 
 err:
+    /* do not leave other frame threads waiting on an unfinished picture */
+    if (frame_started)
+        ff_thread_report_progress(&s->current_picture_ptr->tf, INT_MAX, 0);
     av_free(buf2);
     for (i = 0; i < n_slices; i++)
         av_free(slices[i].buf);
@@ -6170,7 +6307,9 @@ AVCodec ff_vc1_decoder = {
     .close          = ff_vc1_decode_end,
     .decode         = vc1_decode_frame,
     .flush          = ff_mpeg_flush,
-    .capabilities   = CODEC_CAP_DR1 | CODEC_CAP_DELAY,
+    .init_thread_copy      = ONLY_IF_THREADS_ENABLED(vc1_decode_init_thread_copy),
+    .update_thread_context = ONLY_IF_THREADS_ENABLED(vc1_update_thread_context),
+    .capabilities   = CODEC_CAP_DR1 | CODEC_CAP_DELAY | CODEC_CAP_FRAME_THREADS,
     .pix_fmts       = vc1_hwaccel_pixfmt_list_420,
     .profiles       = NULL_IF_CONFIG_SMALL(profiles)
 };
@@ -6186,7 +6325,9 @@ AVCodec ff_wmv3_decoder = {
     .close          = ff_vc1_decode_end,
     .decode         = vc1_decode_frame,
     .flush          = ff_mpeg_flush,
-    .capabilities   = CODEC_CAP_DR1 | CODEC_CAP_DELAY,
+    .init_thread_copy      = ONLY_IF_THREADS_ENABLED(vc1_decode_init_thread_copy),
+    .update_thread_context = ONLY_IF_THREADS_ENABLED(vc1_update_thread_context),
+    .capabilities   = CODEC_CAP_DR1 | CODEC_CAP_DELAY | CODEC_CAP_FRAME_THREADS,
     .pix_fmts       = vc1_hwaccel_pixfmt_list_420,
     .profiles       = NULL_IF_CONFIG_SMALL(profiles)
 };
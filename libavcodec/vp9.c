@@ -26,6 +26,7 @@
 #include "avcodec.h"
 #include "get_bits.h"
 #include "internal.h"
+#include "thread.h"
 #include "videodsp.h"
 #include "vp56.h"
 #include "vp9.h"
@@ -34,40 +35,96 @@
 #define VP9_SYNCCODE 0x498342
 #define MAX_PROB 255
 
-static void vp9_decode_flush(AVCodecContext *avctx)
+static void vp9_frame_unref(AVCodecContext *avctx, VP9Frame *f)
+{
+    ff_thread_release_buffer(avctx, &f->tf);
+    av_buffer_unref(&f->extradata);
+    f->segmentation_map = NULL;
+    f->mv               = NULL;
+}
+
+static int vp9_frame_alloc(AVCodecContext *avctx, VP9Frame *f)
 {
     VP9Context *s = avctx->priv_data;
-    int i;
+    int ret, sz;
+
+    if ((ret = ff_thread_get_buffer(avctx, &f->tf, AV_GET_BUFFER_FLAG_REF)) < 0)
+        return ret;
 
-    for (i = 0; i < FF_ARRAY_ELEMS(s->refs); i++)
-        av_frame_unref(s->refs[i]);
+    /* the segmentation map and the MVs are read back by the next frame */
+    sz = 64 * s->sb_cols * s->sb_rows;
+    if (sz != s->extradata_pool_size) {
+        av_buffer_pool_uninit(&s->extradata_pool);
+        s->extradata_pool = av_buffer_pool_init(sz * (1 + sizeof(*f->mv)),
+                                                NULL);
+        if (!s->extradata_pool) {
+            s->extradata_pool_size = 0;
+            ret = AVERROR(ENOMEM);
+            goto fail;
+        }
+        s->extradata_pool_size = sz;
+    }
+    f->extradata = av_buffer_pool_get(s->extradata_pool);
+    if (!f->extradata) {
+        ret = AVERROR(ENOMEM);
+        goto fail;
+    }
+
+    f->segmentation_map = f->extradata->data;
+    f->mv               = (VP9MVRefPair *)(f->extradata->data + sz);
+
+    return 0;
+
+fail:
+    vp9_frame_unref(avctx, f);
+    return ret;
 }
 
-static int update_size(AVCodecContext *avctx, int w, int h)
+static int vp9_frame_ref(AVCodecContext *avctx, VP9Frame *dst, VP9Frame *src)
 {
-    VP9Context *s = avctx->priv_data;
-    uint8_t *p;
+    int ret;
 
-    if (s->above_partition_ctx && w == avctx->width && h == avctx->height)
-        return 0;
+    if ((ret = ff_thread_ref_frame(&dst->tf, &src->tf)) < 0)
+        return ret;
 
-    vp9_decode_flush(avctx);
+    dst->extradata = av_buffer_ref(src->extradata);
+    if (!dst->extradata) {
+        vp9_frame_unref(avctx, dst);
+        return AVERROR(ENOMEM);
+    }
 
-    if (w <= 0 || h <= 0)
-        return AVERROR_INVALIDDATA;
+    dst->segmentation_map = src->segmentation_map;
+    dst->mv               = src->mv;
 
-    avctx->width  = w;
-    avctx->height = h;
-    s->sb_cols    = (w + 63) >> 6;
-    s->sb_rows    = (h + 63) >> 6;
-    s->cols       = (w +  7) >> 3;
-    s->rows       = (h +  7) >> 3;
+    return 0;
+}
+
+static void vp9_decode_flush(AVCodecContext *avctx)
+{
+    VP9Context *s = avctx->priv_data;
+    int i;
+
+    for (i = 0; i < FF_ARRAY_ELEMS(s->frames); i++)
+        vp9_frame_unref(avctx, &s->frames[i]);
+    for (i = 0; i < FF_ARRAY_ELEMS(s->refs); i++) {
+        ff_thread_release_buffer(avctx, &s->refs[i]);
+        ff_thread_release_buffer(avctx, &s->next_refs[i]);
+    }
+}
+
+static int alloc_ctx_buffers(VP9Context *s, int w, int h)
+{
+    uint8_t *p;
+
+    s->sb_cols = (w + 63) >> 6;
+    s->sb_rows = (h + 63) >> 6;
+    s->cols    = (w +  7) >> 3;
+    s->rows    = (h +  7) >> 3;
 
 #define assign(var, type, n) var = (type)p; p += s->sb_cols * n * sizeof(*var)
-    av_free(s->above_partition_ctx);
-    p = av_malloc(s->sb_cols *
-                  (240 + sizeof(*s->lflvl) + 16 * sizeof(*s->above_mv_ctx) +
-                   64 * s->sb_rows * (1 + sizeof(*s->mv[0]) * 2)));
+    av_freep(&s->above_partition_ctx);
+    p = av_malloc(s->sb_cols * (240 + s->sb_rows * sizeof(*s->lflvl) +
+                                16 * sizeof(*s->above_mv_ctx)));
     if (!p)
         return AVERROR(ENOMEM);
     assign(s->above_partition_ctx, uint8_t *,     8);
@@ -85,16 +142,31 @@ static int update_size(AVCodecContext *avctx, int w, int h)
     assign(s->above_comp_ctx,      uint8_t *,     8);
     assign(s->above_ref_ctx,       uint8_t *,     8);
     assign(s->above_filter_ctx,    uint8_t *,     8);
-    assign(s->lflvl,               VP9Filter *,   1);
+    assign(s->lflvl,               VP9Filter *,   s->sb_rows);
     assign(s->above_mv_ctx,        VP56mv(*)[2], 16);
-    assign(s->segmentation_map,    uint8_t *,      64 * s->sb_rows);
-    assign(s->mv[0],               VP9MVRefPair *, 64 * s->sb_rows);
-    assign(s->mv[1],               VP9MVRefPair *, 64 * s->sb_rows);
 #undef assign
 
     return 0;
 }
 
+static int update_size(AVCodecContext *avctx, int w, int h)
+{
+    VP9Context *s = avctx->priv_data;
+
+    if (s->above_partition_ctx && w == avctx->width && h == avctx->height)
+        return 0;
+
+    vp9_decode_flush(avctx);
+
+    if (w <= 0 || h <= 0)
+        return AVERROR_INVALIDDATA;
+
+    avctx->width  = w;
+    avctx->height = h;
+
+    return alloc_ctx_buffers(s, w, h);
+}
+
 // The sign bit is at the end, not the start, of a bit sequence
 static av_always_inline int get_bits_with_sign(GetBitContext *gb, int n)
 {
@@ -205,7 +277,7 @@ static int decode_frame_header(AVCodecContext *avctx,
     last_invisible = s->invisible;
     s->invisible   = !get_bits1(&s->gb);
     s->errorres    = get_bits1(&s->gb);
-    // FIXME disable this upon resolution change
+    // also disabled upon resolution change, see vp9_decode_frame()
     s->use_last_frame_mvs = !s->errorres && !last_invisible;
 
     if (s->keyframe) {
@@ -246,22 +318,22 @@ static int decode_frame_header(AVCodecContext *avctx,
             s->signbias[1]    = get_bits1(&s->gb);
             s->refidx[2]      = get_bits(&s->gb, 3);
             s->signbias[2]    = get_bits1(&s->gb);
-            if (!s->refs[s->refidx[0]]->buf[0] ||
-                !s->refs[s->refidx[1]]->buf[0] ||
-                !s->refs[s->refidx[2]]->buf[0]) {
+            if (!s->refs[s->refidx[0]].f->buf[0] ||
+                !s->refs[s->refidx[1]].f->buf[0] ||
+                !s->refs[s->refidx[2]].f->buf[0]) {
                 av_log(avctx, AV_LOG_ERROR,
                        "Not all references are available\n");
                 return AVERROR_INVALIDDATA;
             }
             if (get_bits1(&s->gb)) {
-                w = s->refs[s->refidx[0]]->width;
-                h = s->refs[s->refidx[0]]->height;
+                w = s->refs[s->refidx[0]].f->width;
+                h = s->refs[s->refidx[0]].f->height;
             } else if (get_bits1(&s->gb)) {
-                w = s->refs[s->refidx[1]]->width;
-                h = s->refs[s->refidx[1]]->height;
+                w = s->refs[s->refidx[1]].f->width;
+                h = s->refs[s->refidx[1]].f->height;
             } else if (get_bits1(&s->gb)) {
-                w = s->refs[s->refidx[2]]->width;
-                h = s->refs[s->refidx[2]]->height;
+                w = s->refs[s->refidx[2]].f->width;
+                h = s->refs[s->refidx[2]].f->height;
             } else {
                 w = get_bits(&s->gb, 16) + 1;
                 h = get_bits(&s->gb, 16) + 1;
@@ -300,8 +372,20 @@ static int decode_frame_header(AVCodecContext *avctx,
     sharp           = get_bits(&s->gb, 3);
     /* If sharpness changed, reinit lim/mblim LUTs. if it didn't change,
      * keep the old cache values since they are still valid. */
-    if (s->filter.sharpness != sharp)
-        memset(s->filter.lim_lut, 0, sizeof(s->filter.lim_lut));
+    if (s->filter.sharpness != sharp) {
+        for (i = 1; i < FF_ARRAY_ELEMS(s->filter.lim_lut); i++) {
+            int limit = i;
+
+            if (sharp > 0) {
+                limit >>= (sharp + 3) >> 2;
+                limit   = FFMIN(limit, 9 - sharp);
+            }
+            limit = FFMAX(limit, 1);
+
+            s->filter.lim_lut[i]   = limit;
+            s->filter.mblim_lut[i] = 2 * (i + 2) + limit;
+        }
+    }
     s->filter.sharpness = sharp;
     if ((s->lf_delta.enabled = get_bits1(&s->gb))) {
         if (get_bits1(&s->gb)) {
@@ -420,12 +504,12 @@ static int decode_frame_header(AVCodecContext *avctx,
     s->tiling.tile_rows      = 1 << s->tiling.log2_tile_rows;
     if (s->tiling.tile_cols != (1 << s->tiling.log2_tile_cols)) {
         s->tiling.tile_cols = 1 << s->tiling.log2_tile_cols;
-        s->c_b              = av_fast_realloc(s->c_b, &s->c_b_size,
-                                              sizeof(VP56RangeCoder) *
-                                              s->tiling.tile_cols);
-        if (!s->c_b) {
+        av_fast_malloc(&s->td, &s->td_size,
+                       sizeof(*s->td) * s->tiling.tile_cols);
+        if (!s->td) {
+            s->tiling.tile_cols = 0;
             av_log(avctx, AV_LOG_ERROR,
-                   "Ran out of memory during range coder init\n");
+                   "Ran out of memory during tile context init\n");
             return AVERROR(ENOMEM);
         }
     }
@@ -652,13 +736,14 @@ static int decode_frame_header(AVCodecContext *avctx,
     return (data2 - data) + size2;
 }
 
-static int decode_subblock(AVCodecContext *avctx, int row, int col,
-                           VP9Filter *lflvl,
+static int decode_subblock(AVCodecContext *avctx, VP9TileData *td,
+                           int row, int col, VP9Filter *lflvl,
                            ptrdiff_t yoff, ptrdiff_t uvoff, enum BlockLevel bl)
 {
     VP9Context *s = avctx->priv_data;
-    int c = ((s->above_partition_ctx[col]       >> (3 - bl)) & 1) |
-            (((s->left_partition_ctx[row & 0x7] >> (3 - bl)) & 1) << 1);
+    AVFrame *f    = s->frames[CUR_FRAME].tf.f;
+    int c = ((s->above_partition_ctx[col]        >> (3 - bl)) & 1) |
+            (((td->left_partition_ctx[row & 0x7] >> (3 - bl)) & 1) << 1);
     int ret;
     const uint8_t *p = s->keyframe ? ff_vp9_default_kf_partition_probs[bl][c]
                                    : s->prob.p.partition[bl][c];
@@ -666,51 +751,53 @@ static int decode_subblock(AVCodecContext *avctx, int row, int col,
     ptrdiff_t hbs = 4 >> bl;
 
     if (bl == BL_8X8) {
-        bp  = vp8_rac_get_tree(&s->c, ff_vp9_partition_tree, p);
-        ret = ff_vp9_decode_block(avctx, row, col, lflvl, yoff, uvoff, bl, bp);
+        bp  = vp8_rac_get_tree(&td->c, ff_vp9_partition_tree, p);
+        ret = ff_vp9_decode_block(avctx, td, row, col, lflvl, yoff, uvoff,
+                                  bl, bp);
     } else if (col + hbs < s->cols) {
         if (row + hbs < s->rows) {
-            bp = vp8_rac_get_tree(&s->c, ff_vp9_partition_tree, p);
+            bp = vp8_rac_get_tree(&td->c, ff_vp9_partition_tree, p);
             switch (bp) {
             case PARTITION_NONE:
-                ret = ff_vp9_decode_block(avctx, row, col, lflvl, yoff, uvoff,
-                                          bl, bp);
+                ret = ff_vp9_decode_block(avctx, td, row, col, lflvl,
+                                          yoff, uvoff, bl, bp);
                 break;
             case PARTITION_H:
-                ret = ff_vp9_decode_block(avctx, row, col, lflvl, yoff, uvoff,
-                                          bl, bp);
+                ret = ff_vp9_decode_block(avctx, td, row, col, lflvl,
+                                          yoff, uvoff, bl, bp);
                 if (!ret) {
-                    yoff  += hbs * 8 * s->cur_frame->linesize[0];
-                    uvoff += hbs * 4 * s->cur_frame->linesize[1];
-                    ret    = ff_vp9_decode_block(avctx, row + hbs, col, lflvl,
-                                                 yoff, uvoff, bl, bp);
+                    yoff  += hbs * 8 * f->linesize[0];
+                    uvoff += hbs * 4 * f->linesize[1];
+                    ret    = ff_vp9_decode_block(avctx, td, row + hbs, col,
+                                                 lflvl, yoff, uvoff, bl, bp);
                 }
                 break;
             case PARTITION_V:
-                ret = ff_vp9_decode_block(avctx, row, col, lflvl, yoff, uvoff,
-                                          bl, bp);
+                ret = ff_vp9_decode_block(avctx, td, row, col, lflvl,
+                                          yoff, uvoff, bl, bp);
                 if (!ret) {
                     yoff  += hbs * 8;
                     uvoff += hbs * 4;
-                    ret    = ff_vp9_decode_block(avctx, row, col + hbs, lflvl,
-                                                 yoff, uvoff, bl, bp);
+                    ret    = ff_vp9_decode_block(avctx, td, row, col + hbs,
+                                                 lflvl, yoff, uvoff, bl, bp);
                 }
                 break;
             case PARTITION_SPLIT:
-                ret = decode_subblock(avctx, row, col, lflvl,
+                ret = decode_subblock(avctx, td, row, col, lflvl,
                                       yoff, uvoff, bl + 1);
                 if (!ret) {
-                    ret = decode_subblock(avctx, row, col + hbs, lflvl,
+                    ret = decode_subblock(avctx, td, row, col + hbs, lflvl,
                                           yoff + 8 * hbs, uvoff + 4 * hbs,
                                           bl + 1);
                     if (!ret) {
-                        yoff  += hbs * 8 * s->cur_frame->linesize[0];
-                        uvoff += hbs * 4 * s->cur_frame->linesize[1];
-                        ret    = decode_subblock(avctx, row + hbs, col, lflvl,
-                                                 yoff, uvoff, bl + 1);
+                        yoff  += hbs * 8 * f->linesize[0];
+                        uvoff += hbs * 4 * f->linesize[1];
+                        ret    = decode_subblock(avctx, td, row + hbs, col,
+                                                 lflvl, yoff, uvoff, bl + 1);
                         if (!ret) {
-                            ret = decode_subblock(avctx, row + hbs, col + hbs,
-                                                  lflvl, yoff + 8 * hbs,
+                            ret = decode_subblock(avctx, td, row + hbs,
+                                                  col + hbs, lflvl,
+                                                  yoff + 8 * hbs,
                                                   uvoff + 4 * hbs, bl + 1);
                         }
                     }
@@ -720,37 +807,39 @@ static int decode_subblock(AVCodecContext *avctx, int row, int col,
                 av_log(avctx, AV_LOG_ERROR, "Unexpected partition %d.", bp);
                 return AVERROR_INVALIDDATA;
             }
-        } else if (vp56_rac_get_prob_branchy(&s->c, p[1])) {
+        } else if (vp56_rac_get_prob_branchy(&td->c, p[1])) {
             bp  = PARTITION_SPLIT;
-            ret = decode_subblock(avctx, row, col, lflvl, yoff, uvoff, bl + 1);
+            ret = decode_subblock(avctx, td, row, col, lflvl,
+                                  yoff, uvoff, bl + 1);
             if (!ret)
-                ret = decode_subblock(avctx, row, col + hbs, lflvl,
+                ret = decode_subblock(avctx, td, row, col + hbs, lflvl,
                                       yoff + 8 * hbs, uvoff + 4 * hbs, bl + 1);
         } else {
             bp  = PARTITION_H;
-            ret = ff_vp9_decode_block(avctx, row, col, lflvl, yoff, uvoff,
+            ret = ff_vp9_decode_block(avctx, td, row, col, lflvl, yoff, uvoff,
                                       bl, bp);
         }
     } else if (row + hbs < s->rows) {
-        if (vp56_rac_get_prob_branchy(&s->c, p[2])) {
+        if (vp56_rac_get_prob_branchy(&td->c, p[2])) {
             bp  = PARTITION_SPLIT;
-            ret = decode_subblock(avctx, row, col, lflvl, yoff, uvoff, bl + 1);
+            ret = decode_subblock(avctx, td, row, col, lflvl,
+                                  yoff, uvoff, bl + 1);
             if (!ret) {
-                yoff  += hbs * 8 * s->cur_frame->linesize[0];
-                uvoff += hbs * 4 * s->cur_frame->linesize[1];
-                ret    = decode_subblock(avctx, row + hbs, col, lflvl,
+                yoff  += hbs * 8 * f->linesize[0];
+                uvoff += hbs * 4 * f->linesize[1];
+                ret    = decode_subblock(avctx, td, row + hbs, col, lflvl,
                                          yoff, uvoff, bl + 1);
             }
         } else {
             bp  = PARTITION_V;
-            ret = ff_vp9_decode_block(avctx, row, col, lflvl, yoff, uvoff,
+            ret = ff_vp9_decode_block(avctx, td, row, col, lflvl, yoff, uvoff,
                                       bl, bp);
         }
     } else {
         bp  = PARTITION_SPLIT;
-        ret = decode_subblock(avctx, row, col, lflvl, yoff, uvoff, bl + 1);
+        ret = decode_subblock(avctx, td, row, col, lflvl, yoff, uvoff, bl + 1);
     }
-    s->counts.partition[bl][c][bp]++;
+    td->counts.partition[bl][c][bp]++;
 
     return ret;
 }
@@ -759,9 +848,10 @@ static void loopfilter_subblock(AVCodecContext *avctx, VP9Filter *lflvl,
                                 int row, int col,
                                 ptrdiff_t yoff, ptrdiff_t uvoff)
 {
-    VP9Context *s = avctx->priv_data;
-    uint8_t *dst   = s->cur_frame->data[0] + yoff, *lvl = lflvl->level;
-    ptrdiff_t ls_y = s->cur_frame->linesize[0], ls_uv = s->cur_frame->linesize[1];
+    VP9Context *s  = avctx->priv_data;
+    AVFrame *f     = s->frames[CUR_FRAME].tf.f;
+    uint8_t *dst   = f->data[0] + yoff, *lvl = lflvl->level;
+    ptrdiff_t ls_y = f->linesize[0], ls_uv = f->linesize[1];
     int y, x, p;
 
     /* FIXME: In how far can we interleave the v/h loopfilter calls? E.g.
@@ -838,7 +928,7 @@ static void loopfilter_subblock(AVCodecContext *avctx, VP9Filter *lflvl,
     //                                          block1
     // filter edges between rows, Y plane (e.g. ------)
     //                                          block2
-    dst = s->cur_frame->data[0] + yoff;
+    dst = f->data[0] + yoff;
     lvl = lflvl->level;
     for (y = 0; y < 8; y++, dst += 8 * ls_y, lvl += 8) {
         uint8_t *ptr = dst, *l = lvl, *vmask = lflvl->mask[0][1][y];
@@ -902,7 +992,7 @@ static void loopfilter_subblock(AVCodecContext *avctx, VP9Filter *lflvl,
     // same principle but for U/V planes
     for (p = 0; p < 2; p++) {
         lvl = lflvl->level;
-        dst = s->cur_frame->data[1 + p] + uvoff;
+        dst = f->data[1 + p] + uvoff;
         for (y = 0; y < 8; y += 4, dst += 16 * ls_uv, lvl += 32) {
             uint8_t *ptr = dst, *l = lvl, *hmask1 = lflvl->mask[1][0][y];
             uint8_t *hmask2 = lflvl->mask[1][0][y + 2];
@@ -949,7 +1039,7 @@ static void loopfilter_subblock(AVCodecContext *avctx, VP9Filter *lflvl,
             }
         }
         lvl = lflvl->level;
-        dst = s->cur_frame->data[1 + p] + uvoff;
+        dst = f->data[1 + p] + uvoff;
         for (y = 0; y < 8; y++, dst += 4 * ls_uv) {
             uint8_t *ptr = dst, *l = lvl, *vmask = lflvl->mask[1][1][y];
             unsigned vm = vmask[0] | vmask[1] | vmask[2];
@@ -1004,43 +1094,137 @@ static void set_tile_offset(int *start, int *end, int idx, int log2_n, int n)
     *end   = FFMIN(sb_end,   n) << 3;
 }
 
-static int vp9_decode_frame(AVCodecContext *avctx, AVFrame *frame,
-                            int *got_frame, const uint8_t *data, int size)
+static int init_tile(VP9TileData *td, const uint8_t *data, int size)
 {
-    VP9Context *s = avctx->priv_data;
-    int ret, tile_row, tile_col, i, ref = -1, row, col;
-    ptrdiff_t yoff = 0, uvoff = 0;
+    ff_vp56_init_range_decoder(&td->c, data, size);
+    if (vp56_rac_get_prob_branchy(&td->c, 128)) // marker bit
+        return AVERROR_INVALIDDATA;
+    return 0;
+}
 
-    ret = decode_frame_header(avctx, data, size, &ref);
-    if (ret < 0) {
-        return ret;
-    } else if (!ret) {
-        if (!s->refs[ref]->buf[0]) {
-            av_log(avctx, AV_LOG_ERROR,
-                   "Requested reference %d not available\n", ref);
-            return AVERROR_INVALIDDATA;
+/**
+ * Decode the superblocks of one row in a tile, then save the bottom
+ * pixels of the tile columns for the intra prediction of the next row.
+ */
+static int decode_tile_sb_row(AVCodecContext *avctx, VP9TileData *td, int row)
+{
+    VP9Context *s    = avctx->priv_data;
+    AVFrame *f       = s->frames[CUR_FRAME].tf.f;
+    int start        = td->tile_col_start;
+    int end          = FFMIN(td->tile_col_end, s->cols);
+    ptrdiff_t yoff   = (row >> 3) * f->linesize[0] * 64 + start * 8;
+    ptrdiff_t uvoff  = (row >> 3) * f->linesize[1] * 32 + start * 4;
+    VP9Filter *lflvl = s->lflvl + (row >> 3) * s->sb_cols + (start >> 3);
+    int col, ret;
+
+    memset(td->left_partition_ctx, 0, 8);
+    memset(td->left_skip_ctx, 0, 8);
+    if (s->keyframe || s->intraonly)
+        memset(td->left_mode_ctx, DC_PRED, 16);
+    else
+        memset(td->left_mode_ctx, NEARESTMV, 8);
+    memset(td->left_y_nnz_ctx, 0, 16);
+    memset(td->left_uv_nnz_ctx, 0, 16);
+    memset(td->left_segpred_ctx, 0, 8);
+
+    for (col = start; col < td->tile_col_end;
+         col += 8, yoff += 64, uvoff += 32, lflvl++) {
+        // FIXME integrate with lf code (i.e. zero after each
+        // use, similar to invtxfm coefficients, or similar)
+        memset(lflvl->mask, 0, sizeof(lflvl->mask));
+
+        if ((ret = decode_subblock(avctx, td, row, col, lflvl,
+                                   yoff, uvoff, BL_64X64)) < 0)
+            return ret;
+    }
+
+    // backup pre-loopfilter reconstruction data for intra
+    // prediction of next row of sb64s
+    if (row + 8 < s->rows) {
+        yoff  = (row >> 3) * f->linesize[0] * 64 + start * 8;
+        uvoff = (row >> 3) * f->linesize[1] * 32 + start * 4;
+        memcpy(s->intra_pred_data[0] + start * 8,
+               f->data[0] + yoff + 63 * f->linesize[0],
+               8 * (end - start));
+        memcpy(s->intra_pred_data[1] + start * 4,
+               f->data[1] + uvoff + 31 * f->linesize[1],
+               4 * (end - start));
+        memcpy(s->intra_pred_data[2] + start * 4,
+               f->data[2] + uvoff + 31 * f->linesize[2],
+               4 * (end - start));
+    }
+
+    return 0;
+}
+
+/**
+ * Finish a row of superblocks once all tiles decoded it: carry the
+ * segmentation map over and apply the loopfilter.
+ */
+static void finish_sb_row(AVCodecContext *avctx, int row)
+{
+    VP9Context *s    = avctx->priv_data;
+    AVFrame *f       = s->frames[CUR_FRAME].tf.f;
+    ptrdiff_t yoff   = (row >> 3) * f->linesize[0] * 64;
+    ptrdiff_t uvoff  = (row >> 3) * f->linesize[1] * 32;
+    VP9Filter *lflvl = s->lflvl + (row >> 3) * s->sb_cols;
+    int col;
+
+    // carry the segmentation map over from the previous frame
+    // if this one does not code it
+    if (!s->keyframe &&
+        !(s->segmentation.enabled && s->segmentation.update_map)) {
+        VP9Frame *last = &s->frames[LAST_FRAME];
+        ptrdiff_t o    = row * 8 * s->sb_cols;
+        int n          = FFMIN(8, s->rows - row) * 8 * s->sb_cols;
+
+        if (last->segmentation_map) {
+            ff_thread_await_progress(&last->tf, row >> 3, 0);
+            memcpy(s->frames[CUR_FRAME].segmentation_map + o,
+                   last->segmentation_map + o, n);
+        } else {
+            memset(s->frames[CUR_FRAME].segmentation_map + o, 0, n);
         }
+    }
 
-        ret = av_frame_ref(frame, s->refs[ref]);
-        if (ret < 0)
+    // loopfilter one row
+    if (s->filter.level) {
+        for (col = 0; col < s->cols;
+             col += 8, yoff += 64, uvoff += 32, lflvl++)
+            loopfilter_subblock(avctx, lflvl, row, col, yoff, uvoff);
+    }
+
+    ff_thread_report_progress(&s->frames[CUR_FRAME].tf, row >> 3, 0);
+}
+
+/* Decode all the tiles of one tile column, in a slice thread. */
+static int decode_tile_col(AVCodecContext *avctx, void *arg,
+                           int tile_col, int threadnr)
+{
+    VP9Context *s   = avctx->priv_data;
+    VP9TileData *td = &s->td[tile_col];
+    int tile_row, row, row_start, row_end, ret;
+
+    for (tile_row = 0; tile_row < s->tiling.tile_rows; tile_row++) {
+        set_tile_offset(&row_start, &row_end,
+                        tile_row, s->tiling.log2_tile_rows, s->sb_rows);
+        if ((ret = init_tile(td, s->tile_data[tile_row][tile_col],
+                             s->tile_size[tile_row][tile_col])) < 0)
             return ret;
-        *got_frame = 1;
-        return 0;
+        for (row = row_start; row < row_end; row += 8)
+            if ((ret = decode_tile_sb_row(avctx, td, row)) < 0)
+                return ret;
     }
-    data += ret;
-    size -= ret;
 
-    s->cur_frame = frame;
+    return 0;
+}
 
-    av_frame_unref(s->cur_frame);
-    if ((ret = ff_get_buffer(avctx, s->cur_frame,
-                             s->refreshrefmask ? AV_GET_BUFFER_FLAG_REF : 0)) < 0)
-        return ret;
-    s->cur_frame->key_frame = s->keyframe;
-    s->cur_frame->pict_type = s->keyframe ? AV_PICTURE_TYPE_I
-                                          : AV_PICTURE_TYPE_P;
+static int decode_tiles(AVCodecContext *avctx,
+                        const uint8_t *data, int size)
+{
+    VP9Context *s = avctx->priv_data;
+    int ret, tile_row, tile_col, row, row_start, row_end;
 
-    // main tile decode loop
     memset(s->above_partition_ctx, 0, s->cols);
     memset(s->above_skip_ctx, 0, s->cols);
     if (s->keyframe || s->intraonly)
@@ -1051,9 +1235,8 @@ static int vp9_decode_frame(AVCodecContext *avctx, AVFrame *frame,
     memset(s->above_uv_nnz_ctx[0], 0, s->sb_cols * 8);
     memset(s->above_uv_nnz_ctx[1], 0, s->sb_cols * 8);
     memset(s->above_segpred_ctx, 0, s->cols);
+
     for (tile_row = 0; tile_row < s->tiling.tile_rows; tile_row++) {
-        set_tile_offset(&s->tiling.tile_row_start, &s->tiling.tile_row_end,
-                        tile_row, s->tiling.log2_tile_rows, s->sb_rows);
         for (tile_col = 0; tile_col < s->tiling.tile_cols; tile_col++) {
             int64_t tile_size;
 
@@ -1067,116 +1250,198 @@ static int vp9_decode_frame(AVCodecContext *avctx, AVFrame *frame,
             }
             if (tile_size > size)
                 return AVERROR_INVALIDDATA;
-            ff_vp56_init_range_decoder(&s->c_b[tile_col], data, tile_size);
-            if (vp56_rac_get_prob_branchy(&s->c_b[tile_col], 128)) // marker bit
-                return AVERROR_INVALIDDATA;
+            s->tile_data[tile_row][tile_col] = data;
+            s->tile_size[tile_row][tile_col] = tile_size;
             data += tile_size;
             size -= tile_size;
         }
+    }
 
-        for (row = s->tiling.tile_row_start;
-             row < s->tiling.tile_row_end;
-             row += 8, yoff += s->cur_frame->linesize[0] * 64,
-             uvoff += s->cur_frame->linesize[1] * 32) {
-            VP9Filter *lflvl = s->lflvl;
-            ptrdiff_t yoff2 = yoff, uvoff2 = uvoff;
-
-            for (tile_col = 0; tile_col < s->tiling.tile_cols; tile_col++) {
-                set_tile_offset(&s->tiling.tile_col_start,
-                                &s->tiling.tile_col_end,
-                                tile_col, s->tiling.log2_tile_cols, s->sb_cols);
-
-                memset(s->left_partition_ctx, 0, 8);
-                memset(s->left_skip_ctx, 0, 8);
-                if (s->keyframe || s->intraonly)
-                    memset(s->left_mode_ctx, DC_PRED, 16);
-                else
-                    memset(s->left_mode_ctx, NEARESTMV, 8);
-                memset(s->left_y_nnz_ctx, 0, 16);
-                memset(s->left_uv_nnz_ctx, 0, 16);
-                memset(s->left_segpred_ctx, 0, 8);
-
-                memcpy(&s->c, &s->c_b[tile_col], sizeof(s->c));
-                for (col = s->tiling.tile_col_start;
-                     col < s->tiling.tile_col_end;
-                     col += 8, yoff2 += 64, uvoff2 += 32, lflvl++) {
-                    // FIXME integrate with lf code (i.e. zero after each
-                    // use, similar to invtxfm coefficients, or similar)
-                    memset(lflvl->mask, 0, sizeof(lflvl->mask));
-
-                    if ((ret = decode_subblock(avctx, row, col, lflvl,
-                                               yoff2, uvoff2, BL_64X64)) < 0)
+    for (tile_col = 0; tile_col < s->tiling.tile_cols; tile_col++) {
+        VP9TileData *td = &s->td[tile_col];
+
+        td->s = s;
+        set_tile_offset(&td->tile_col_start, &td->tile_col_end,
+                        tile_col, s->tiling.log2_tile_cols, s->sb_cols);
+        memset(&td->counts, 0, sizeof(td->counts));
+    }
+
+    if (avctx->active_thread_type & FF_THREAD_SLICE &&
+        s->tiling.tile_cols > 1) {
+        // the tile columns only depend on each other through the
+        // loopfilter, which runs once all of them are decoded
+        int rets[64];
+
+        avctx->execute2(avctx, decode_tile_col, NULL, rets,
+                        s->tiling.tile_cols);
+        for (tile_col = 0; tile_col < s->tiling.tile_cols; tile_col++)
+            if (rets[tile_col] < 0)
+                return rets[tile_col];
+        for (row = 0; row < s->rows; row += 8)
+            finish_sb_row(avctx, row);
+    } else {
+        for (tile_row = 0; tile_row < s->tiling.tile_rows; tile_row++) {
+            set_tile_offset(&row_start, &row_end,
+                            tile_row, s->tiling.log2_tile_rows, s->sb_rows);
+            for (tile_col = 0; tile_col < s->tiling.tile_cols; tile_col++)
+                if ((ret = init_tile(&s->td[tile_col],
+                                     s->tile_data[tile_row][tile_col],
+                                     s->tile_size[tile_row][tile_col])) < 0)
+                    return ret;
+
+            for (row = row_start; row < row_end; row += 8) {
+                for (tile_col = 0; tile_col < s->tiling.tile_cols; tile_col++)
+                    if ((ret = decode_tile_sb_row(avctx, &s->td[tile_col],
+                                                  row)) < 0)
                         return ret;
-                }
-                memcpy(&s->c_b[tile_col], &s->c, sizeof(s->c));
+                finish_sb_row(avctx, row);
             }
+        }
+    }
 
-            // backup pre-loopfilter reconstruction data for intra
-            // prediction of next row of sb64s
-            if (row + 8 < s->rows) {
-                memcpy(s->intra_pred_data[0],
-                       s->cur_frame->data[0] + yoff +
-                       63 * s->cur_frame->linesize[0],
-                       8 * s->cols);
-                memcpy(s->intra_pred_data[1],
-                       s->cur_frame->data[1] + uvoff +
-                       31 * s->cur_frame->linesize[1],
-                       4 * s->cols);
-                memcpy(s->intra_pred_data[2],
-                       s->cur_frame->data[2] + uvoff +
-                       31 * s->cur_frame->linesize[2],
-                       4 * s->cols);
-            }
+    // merge the symbol counts of the tiles for the probability adaptation
+    if (s->refreshctx && !s->parallelmode) {
+        unsigned *dst = (unsigned *)&s->counts;
+        int i;
 
-            // loopfilter one row
-            if (s->filter.level) {
-                yoff2  = yoff;
-                uvoff2 = uvoff;
-                lflvl  = s->lflvl;
-                for (col = 0; col < s->cols;
-                     col += 8, yoff2 += 64, uvoff2 += 32, lflvl++)
-                    loopfilter_subblock(avctx, lflvl, row, col, yoff2, uvoff2);
-            }
+        for (tile_col = 0; tile_col < s->tiling.tile_cols; tile_col++) {
+            const unsigned *src = (const unsigned *)&s->td[tile_col].counts;
+
+            for (i = 0; i < sizeof(s->counts) / sizeof(*dst); i++)
+                dst[i] += src[i];
         }
     }
 
-    // bw adaptivity (or in case of parallel decoding mode, fw adaptivity
-    // probability maintenance between frames)
-    if (s->refreshctx) {
-        if (s->parallelmode) {
-            int j, k, l, m;
-            for (i = 0; i < 4; i++) {
-                for (j = 0; j < 2; j++)
-                    for (k = 0; k < 2; k++)
-                        for (l = 0; l < 6; l++)
-                            for (m = 0; m < 6; m++)
-                                memcpy(s->prob_ctx[s->framectxid].coef[i][j][k][l][m],
-                                       s->prob.coef[i][j][k][l][m], 3);
-                if (s->txfmmode == i)
-                    break;
-            }
-            s->prob_ctx[s->framectxid].p = s->prob.p;
-        } else {
-            ff_vp9_adapt_probs(s);
+    return 0;
+}
+
+/**
+ * Pass the references on unchanged, for frames that do not refresh any.
+ * The next frame thread takes its references from next_refs.
+ */
+static int vp9_keep_refs(AVCodecContext *avctx)
+{
+    VP9Context *s = avctx->priv_data;
+    int i, ret;
+
+    for (i = 0; i < 8; i++) {
+        ff_thread_release_buffer(avctx, &s->next_refs[i]);
+        if (s->refs[i].f->buf[0] &&
+            (ret = ff_thread_ref_frame(&s->next_refs[i], &s->refs[i])) < 0)
+            return ret;
+    }
+
+    return 0;
+}
+
+static int vp9_decode_frame(AVCodecContext *avctx, AVFrame *frame,
+                            int *got_frame, const uint8_t *data, int size,
+                            int can_finish_setup)
+{
+    VP9Context *s = avctx->priv_data;
+    int ret, i, ref = -1;
+
+    ret = decode_frame_header(avctx, data, size, &ref);
+    if (ret < 0) {
+        vp9_keep_refs(avctx);
+        return ret;
+    } else if (!ret) {
+        if ((ret = vp9_keep_refs(avctx)) < 0)
+            return ret;
+        if (!s->refs[ref].f->buf[0]) {
+            av_log(avctx, AV_LOG_ERROR,
+                   "Requested reference %d not available\n", ref);
+            return AVERROR_INVALIDDATA;
         }
+
+        ff_thread_await_progress(&s->refs[ref], INT_MAX, 0);
+        ret = av_frame_ref(frame, s->refs[ref].f);
+        if (ret < 0)
+            return ret;
+        *got_frame = 1;
+        return 0;
     }
-    FFSWAP(VP9MVRefPair *, s->mv[0], s->mv[1]);
+    data += ret;
+    size -= ret;
+
+    vp9_frame_unref(avctx, &s->frames[LAST_FRAME]);
+    if (s->frames[CUR_FRAME].tf.f->buf[0] &&
+        (ret = vp9_frame_ref(avctx, &s->frames[LAST_FRAME],
+                             &s->frames[CUR_FRAME])) < 0)
+        return ret;
+    vp9_frame_unref(avctx, &s->frames[CUR_FRAME]);
+    if ((ret = vp9_frame_alloc(avctx, &s->frames[CUR_FRAME])) < 0)
+        return ret;
+    s->frames[CUR_FRAME].tf.f->key_frame = s->keyframe;
+    s->frames[CUR_FRAME].tf.f->pict_type = s->keyframe ? AV_PICTURE_TYPE_I
+                                                       : AV_PICTURE_TYPE_P;
+
+    // a resize flushes the previous frame, so it can't provide MVs
+    if (!s->frames[LAST_FRAME].mv)
+        s->use_last_frame_mvs = 0;
 
     // ref frame setup
-    for (i = 0; i < 8; i++)
-        if (s->refreshrefmask & (1 << i)) {
-            av_frame_unref(s->refs[i]);
-            ret = av_frame_ref(s->refs[i], s->cur_frame);
-            if (ret < 0)
-                return ret;
+    for (i = 0; i < 8; i++) {
+        ThreadFrame *src = s->refreshrefmask & (1 << i) ?
+                           &s->frames[CUR_FRAME].tf : &s->refs[i];
+
+        ff_thread_release_buffer(avctx, &s->next_refs[i]);
+        if (src->f->buf[0] &&
+            (ret = ff_thread_ref_frame(&s->next_refs[i], src)) < 0)
+            goto fail;
+    }
+
+    // in parallel decoding mode, the probabilities for the next frame don't
+    // depend on this frame's symbol counts, so it can start right away
+    if (s->refreshctx && s->parallelmode) {
+        int j, k, l, m;
+        for (i = 0; i < 4; i++) {
+            for (j = 0; j < 2; j++)
+                for (k = 0; k < 2; k++)
+                    for (l = 0; l < 6; l++)
+                        for (m = 0; m < 6; m++)
+                            memcpy(s->prob_ctx[s->framectxid].coef[i][j][k][l][m],
+                                   s->prob.coef[i][j][k][l][m], 3);
+            if (s->txfmmode == i)
+                break;
         }
+        s->prob_ctx[s->framectxid].p = s->prob.p;
+    }
+    if (can_finish_setup && (!s->refreshctx || s->parallelmode))
+        ff_thread_finish_setup(avctx);
 
-    if (s->invisible)
-        av_frame_unref(s->cur_frame);
-    else
+    // main tile decode loop
+    ret = decode_tiles(avctx, data, size);
+    ff_thread_report_progress(&s->frames[CUR_FRAME].tf, INT_MAX, 0);
+    if (ret < 0)
+        return ret;
+
+    // bw adaptivity
+    if (s->refreshctx && !s->parallelmode) {
+        ff_vp9_adapt_probs(s);
+        if (can_finish_setup)
+            ff_thread_finish_setup(avctx);
+    }
+
+    for (i = 0; i < 8; i++) {
+        ff_thread_release_buffer(avctx, &s->refs[i]);
+        if (s->next_refs[i].f->buf[0] &&
+            (ret = ff_thread_ref_frame(&s->refs[i], &s->next_refs[i])) < 0)
+            return ret;
+    }
+
+    if (!s->invisible) {
+        av_frame_unref(frame);
+        if ((ret = av_frame_ref(frame, s->frames[CUR_FRAME].tf.f)) < 0)
+            return ret;
         *got_frame = 1;
+    }
 
     return 0;
+
+fail:
+    ff_thread_report_progress(&s->frames[CUR_FRAME].tf, INT_MAX, 0);
+    return ret;
 }
 
 static int vp9_decode_packet(AVCodecContext *avctx, void *frame,
@@ -1211,7 +1476,8 @@ static int vp9_decode_packet(AVCodecContext *avctx, void *frame,
                     return AVERROR_INVALIDDATA;
                 }
 
-                ret = vp9_decode_frame(avctx, frame, got_frame, data, sz);
+                ret = vp9_decode_frame(avctx, frame, got_frame, data, sz,
+                                       !n_frames);
                 if (ret < 0)
                     return ret;
                 data += sz;
@@ -1223,7 +1489,7 @@ static int vp9_decode_packet(AVCodecContext *avctx, void *frame,
 
     /* If we get here, there was no valid superframe index, i.e. this is just
      * one whole single frame. Decode it as such from the complete input buf. */
-    if ((ret = vp9_decode_frame(avctx, frame, got_frame, data, size)) < 0)
+    if ((ret = vp9_decode_frame(avctx, frame, got_frame, data, size, 1)) < 0)
         return ret;
     return size;
 }
@@ -1233,47 +1499,134 @@ static av_cold int vp9_decode_free(AVCodecContext *avctx)
     VP9Context *s = avctx->priv_data;
     int i;
 
-    for (i = 0; i < FF_ARRAY_ELEMS(s->refs); i++)
-        av_frame_free(&s->refs[i]);
+    for (i = 0; i < FF_ARRAY_ELEMS(s->frames); i++) {
+        vp9_frame_unref(avctx, &s->frames[i]);
+        av_frame_free(&s->frames[i].tf.f);
+    }
+    for (i = 0; i < FF_ARRAY_ELEMS(s->refs); i++) {
+        ff_thread_release_buffer(avctx, &s->refs[i]);
+        av_frame_free(&s->refs[i].f);
+        ff_thread_release_buffer(avctx, &s->next_refs[i]);
+        av_frame_free(&s->next_refs[i].f);
+    }
+    av_buffer_pool_uninit(&s->extradata_pool);
 
-    av_freep(&s->c_b);
+    av_freep(&s->td);
     av_freep(&s->above_partition_ctx);
 
     return 0;
 }
 
-static av_cold int vp9_decode_init(AVCodecContext *avctx)
+static av_cold int init_frames(AVCodecContext *avctx)
 {
     VP9Context *s = avctx->priv_data;
     int i;
 
+    for (i = 0; i < FF_ARRAY_ELEMS(s->frames); i++) {
+        s->frames[i].tf.f = av_frame_alloc();
+        if (!s->frames[i].tf.f)
+            goto fail;
+    }
+    for (i = 0; i < FF_ARRAY_ELEMS(s->refs); i++) {
+        s->refs[i].f      = av_frame_alloc();
+        s->next_refs[i].f = av_frame_alloc();
+        if (!s->refs[i].f || !s->next_refs[i].f)
+            goto fail;
+    }
+
+    return 0;
+
+fail:
+    vp9_decode_free(avctx);
+    return AVERROR(ENOMEM);
+}
+
+static av_cold int vp9_decode_init(AVCodecContext *avctx)
+{
+    VP9Context *s = avctx->priv_data;
+
+    avctx->internal->allocate_progress = 1;
     avctx->pix_fmt = AV_PIX_FMT_YUV420P;
 
     ff_vp9dsp_init(&s->dsp);
     ff_videodsp_init(&s->vdsp, 8);
 
+    s->filter.sharpness = -1;
+
+    return init_frames(avctx);
+}
+
+#if HAVE_THREADS
+static av_cold int vp9_decode_init_thread_copy(AVCodecContext *avctx)
+{
+    VP9Context *s = avctx->priv_data;
+
+    // the size-dependent buffers are reallocated on the first update
+    s->above_partition_ctx = NULL;
+    s->td                  = NULL;
+    s->td_size             = 0;
+    s->tiling.tile_cols    = 0;
+    s->extradata_pool      = NULL;
+    s->extradata_pool_size = 0;
+
+    return init_frames(avctx);
+}
+
+static int vp9_decode_update_thread_context(AVCodecContext *dst,
+                                            const AVCodecContext *src)
+{
+    VP9Context *s = dst->priv_data, *ssrc = src->priv_data;
+    int i, ret;
+
+    if (!ssrc->above_partition_ctx)
+        return 0;
+
+    if (!s->above_partition_ctx ||
+        s->cols != ssrc->cols || s->rows != ssrc->rows) {
+        if ((ret = alloc_ctx_buffers(s, src->width, src->height)) < 0)
+            return ret;
+    }
+
+    for (i = 0; i < FF_ARRAY_ELEMS(s->frames); i++) {
+        vp9_frame_unref(dst, &s->frames[i]);
+        if (ssrc->frames[i].tf.f->buf[0] &&
+            (ret = vp9_frame_ref(dst, &s->frames[i], &ssrc->frames[i])) < 0)
+            return ret;
+    }
     for (i = 0; i < FF_ARRAY_ELEMS(s->refs); i++) {
-        s->refs[i] = av_frame_alloc();
-        if (!s->refs[i]) {
-            vp9_decode_free(avctx);
-            return AVERROR(ENOMEM);
-        }
+        ff_thread_release_buffer(dst, &s->refs[i]);
+        if (ssrc->next_refs[i].f->buf[0] &&
+            (ret = ff_thread_ref_frame(&s->refs[i], &ssrc->next_refs[i])) < 0)
+            return ret;
     }
 
-    s->filter.sharpness = -1;
+    // header state that carries over between frames
+    s->keyframe     = ssrc->keyframe;
+    s->intraonly    = ssrc->intraonly;
+    s->invisible    = ssrc->invisible;
+    s->filter       = ssrc->filter;
+    s->lf_delta     = ssrc->lf_delta;
+    s->segmentation = ssrc->segmentation;
+    memcpy(&s->prob.seg, &ssrc->prob.seg, sizeof(s->prob.seg));
+    memcpy(&s->prob.segpred, &ssrc->prob.segpred, sizeof(s->prob.segpred));
+    memcpy(&s->prob_ctx, &ssrc->prob_ctx, sizeof(s->prob_ctx));
 
     return 0;
 }
+#endif
 
 AVCodec ff_vp9_decoder = {
-    .name           = "vp9",
-    .long_name      = NULL_IF_CONFIG_SMALL("Google VP9"),
-    .type           = AVMEDIA_TYPE_VIDEO,
-    .id             = AV_CODEC_ID_VP9,
-    .priv_data_size = sizeof(VP9Context),
-    .init           = vp9_decode_init,
-    .decode         = vp9_decode_packet,
-    .flush          = vp9_decode_flush,
-    .close          = vp9_decode_free,
-    .capabilities   = CODEC_CAP_DR1,
+    .name                  = "vp9",
+    .long_name             = NULL_IF_CONFIG_SMALL("Google VP9"),
+    .type                  = AVMEDIA_TYPE_VIDEO,
+    .id                    = AV_CODEC_ID_VP9,
+    .priv_data_size        = sizeof(VP9Context),
+    .init                  = vp9_decode_init,
+    .decode                = vp9_decode_packet,
+    .flush                 = vp9_decode_flush,
+    .close                 = vp9_decode_free,
+    .capabilities          = CODEC_CAP_DR1 | CODEC_CAP_FRAME_THREADS |
+                             CODEC_CAP_SLICE_THREADS,
+    .init_thread_copy      = ONLY_IF_THREADS_ENABLED(vp9_decode_init_thread_copy),
+    .update_thread_context = ONLY_IF_THREADS_ENABLED(vp9_decode_update_thread_context),
 };
@@ -27,9 +27,11 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "libavutil/buffer.h"
 #include "libavutil/internal.h"
 
 #include "avcodec.h"
+#include "thread.h"
 #include "vp56.h"
 
 enum TxfmMode {
@@ -219,6 +221,16 @@ typedef struct VP9MVRefPair {
     int8_t ref[2];
 } VP9MVRefPair;
 
+typedef struct VP9Frame {
+    ThreadFrame tf;
+    AVBufferRef *extradata;
+    uint8_t *segmentation_map;
+    VP9MVRefPair *mv;
+} VP9Frame;
+
+#define CUR_FRAME  0
+#define LAST_FRAME 1
+
 typedef struct VP9Filter {
     uint8_t level[8 * 8];
     uint8_t /* bit=col */ mask[2 /* 0=y, 1=uv */][2 /* 0=col, 1=row */]
@@ -261,14 +273,84 @@ typedef struct VP9Block {
     ptrdiff_t y_stride, uv_stride;
 } VP9Block;
 
+/* symbol counts for the backward probability adaptation */
+typedef struct VP9Counts {
+    unsigned y_mode[4][10];
+    unsigned uv_mode[10][10];
+    unsigned filter[4][3];
+    unsigned mv_mode[7][4];
+    unsigned intra[4][2];
+    unsigned comp[5][2];
+    unsigned single_ref[5][2][2];
+    unsigned comp_ref[5][2];
+    unsigned tx32p[2][4];
+    unsigned tx16p[2][3];
+    unsigned tx8p[2][2];
+    unsigned skip[3][2];
+    unsigned mv_joint[4];
+    struct {
+        unsigned sign[2];
+        unsigned classes[11];
+        unsigned class0[2];
+        unsigned bits[10][2];
+        unsigned class0_fp[2][4];
+        unsigned fp[4];
+        unsigned class0_hp[2];
+        unsigned hp[2];
+    } mv_comp[2];
+    unsigned partition[4][4][4];
+    unsigned coef[4][2][2][6][6][3];
+    unsigned eob[4][2][2][6][6][2];
+} VP9Counts;
+
+struct VP9Context;
+
+/**
+ * State of the tile column being decoded. The tile columns of a frame only
+ * share the above contexts, each one covers its own range of columns.
+ */
+typedef struct VP9TileData {
+    struct VP9Context *s;
+    VP56RangeCoder c;
+    VP9Block b;
+    int tile_col_start, tile_col_end;
+    VP9Counts counts;
+
+    // contextual (left) cache
+    uint8_t left_partition_ctx[8];
+    uint8_t left_mode_ctx[16];
+    uint8_t left_y_nnz_ctx[16];
+    uint8_t left_uv_nnz_ctx[2][8];
+    uint8_t left_skip_ctx[8];
+    uint8_t left_txfm_ctx[8];
+    uint8_t left_segpred_ctx[8];
+    uint8_t left_intra_ctx[8];
+    uint8_t left_comp_ctx[8];
+    uint8_t left_ref_ctx[8];
+    uint8_t left_filter_ctx[8];
+    VP56mv left_mv_ctx[16][2];
+
+    DECLARE_ALIGNED(32, uint8_t, edge_emu_buffer)[71 * 80];
+
+    // block reconstruction intermediates
+    DECLARE_ALIGNED(32, int16_t, block)[4096];
+    DECLARE_ALIGNED(32, int16_t, uvblock)[2][1024];
+    uint8_t eob[256];
+    uint8_t uveob[2][64];
+    VP56mv min_mv, max_mv;
+    DECLARE_ALIGNED(32, uint8_t, tmp_y)[64 * 64];
+    DECLARE_ALIGNED(32, uint8_t, tmp_uv)[2][32 * 32];
+} VP9TileData;
+
 typedef struct VP9Context {
     VP9DSPContext dsp;
     VideoDSPContext vdsp;
     GetBitContext gb;
     VP56RangeCoder c;
-    VP56RangeCoder *c_b;
-    unsigned c_b_size;
-    VP9Block b;
+    VP9TileData *td;
+    unsigned td_size;
+    const uint8_t *tile_data[4][64];
+    int tile_size[4][64];
 
     // bitstream header
     uint8_t profile;
@@ -291,8 +373,10 @@ typedef struct VP9Context {
     uint8_t refidx[3];
     uint8_t signbias[3];
     uint8_t varcompref[2];
-    AVFrame *refs[8];
-    AVFrame *cur_frame;
+    ThreadFrame refs[8], next_refs[8];
+    VP9Frame frames[2];
+    AVBufferPool *extradata_pool;
+    int extradata_pool_size;
 
     struct {
         uint8_t level;
@@ -328,7 +412,6 @@ typedef struct VP9Context {
     struct {
         unsigned log2_tile_cols, log2_tile_rows;
         unsigned tile_cols, tile_rows;
-        unsigned tile_row_start, tile_row_end, tile_col_start, tile_col_end;
     } tiling;
     unsigned sb_cols, sb_rows, rows, cols;
     struct {
@@ -341,78 +424,44 @@ typedef struct VP9Context {
         uint8_t seg[7];
         uint8_t segpred[3];
     } prob;
-    struct {
-        unsigned y_mode[4][10];
-        unsigned uv_mode[10][10];
-        unsigned filter[4][3];
-        unsigned mv_mode[7][4];
-        unsigned intra[4][2];
-        unsigned comp[5][2];
-        unsigned single_ref[5][2][2];
-        unsigned comp_ref[5][2];
-        unsigned tx32p[2][4];
-        unsigned tx16p[2][3];
-        unsigned tx8p[2][2];
-        unsigned skip[3][2];
-        unsigned mv_joint[4];
-        struct {
-            unsigned sign[2];
-            unsigned classes[11];
-            unsigned class0[2];
-            unsigned bits[10][2];
-            unsigned class0_fp[2][4];
-            unsigned fp[4];
-            unsigned class0_hp[2];
-            unsigned hp[2];
-        } mv_comp[2];
-        unsigned partition[4][4][4];
-        unsigned coef[4][2][2][6][6][3];
-        unsigned eob[4][2][2][6][6][2];
-    } counts;
+    VP9Counts counts;
     enum TxfmMode txfmmode;
     enum CompPredMode comppredmode;
 
-    // contextual (left/above) cache
-    uint8_t left_partition_ctx[8], *above_partition_ctx;
-    uint8_t left_mode_ctx[16], *above_mode_ctx;
+    // contextual (above) cache
+    uint8_t *above_partition_ctx;
+    uint8_t *above_mode_ctx;
     // FIXME maybe merge some of the below in a flags field?
-    uint8_t left_y_nnz_ctx[16], *above_y_nnz_ctx;
-    uint8_t left_uv_nnz_ctx[2][8], *above_uv_nnz_ctx[2];
-    uint8_t left_skip_ctx[8], *above_skip_ctx; // 1bit
-    uint8_t left_txfm_ctx[8], *above_txfm_ctx; // 2bit
-    uint8_t left_segpred_ctx[8], *above_segpred_ctx; // 1bit
-    uint8_t left_intra_ctx[8], *above_intra_ctx; // 1bit
-    uint8_t left_comp_ctx[8], *above_comp_ctx; // 1bit
-    uint8_t left_ref_ctx[8], *above_ref_ctx; // 2bit
-    uint8_t left_filter_ctx[8], *above_filter_ctx;
-    VP56mv left_mv_ctx[16][2], (*above_mv_ctx)[2];
+    uint8_t *above_y_nnz_ctx;
+    uint8_t *above_uv_nnz_ctx[2];
+    uint8_t *above_skip_ctx; // 1bit
+    uint8_t *above_txfm_ctx; // 2bit
+    uint8_t *above_segpred_ctx; // 1bit
+    uint8_t *above_intra_ctx; // 1bit
+    uint8_t *above_comp_ctx; // 1bit
+    uint8_t *above_ref_ctx; // 2bit
+    uint8_t *above_filter_ctx;
+    VP56mv (*above_mv_ctx)[2];
 
     // whole-frame cache
     uint8_t *intra_pred_data[3];
-    uint8_t *segmentation_map;
-    VP9MVRefPair *mv[2];
     VP9Filter *lflvl;
-    DECLARE_ALIGNED(32, uint8_t, edge_emu_buffer)[71 * 80];
-
-    // block reconstruction intermediates
-    DECLARE_ALIGNED(32, int16_t, block)[4096];
-    DECLARE_ALIGNED(32, int16_t, uvblock)[2][1024];
-    uint8_t eob[256];
-    uint8_t uveob[2][64];
-    VP56mv min_mv, max_mv;
-    DECLARE_ALIGNED(32, uint8_t, tmp_y)[64 * 64];
-    DECLARE_ALIGNED(32, uint8_t, tmp_uv)[2][32 * 32];
 } VP9Context;
 
 void ff_vp9dsp_init(VP9DSPContext *dsp);
 
+void ff_vp9dsp_init_aarch64(VP9DSPContext *dsp);
+void ff_vp9dsp_init_arm(VP9DSPContext *dsp);
 void ff_vp9dsp_init_x86(VP9DSPContext *dsp);
 
-void ff_vp9_fill_mv(VP9Context *s, VP56mv *mv, int mode, int sb);
+extern const int8_t ff_vp9_subpel_filters[3][15][8];
+
+void ff_vp9_fill_mv(VP9TileData *td, VP56mv *mv, int mode, int sb);
 
 void ff_vp9_adapt_probs(VP9Context *s);
 
-int ff_vp9_decode_block(AVCodecContext *avctx, int row, int col,
+int ff_vp9_decode_block(AVCodecContext *avctx, VP9TileData *td,
+                        int row, int col,
                         VP9Filter *lflvl, ptrdiff_t yoff, ptrdiff_t uvoff,
                         enum BlockLevel bl, enum BlockPartition bp);
 
@@ -1789,7 +1789,7 @@ copy_avg_fn(4)
 #undef fpel_fn
 #undef copy_avg_fn
 
-static const int8_t vp9_subpel_filters[3][15][8] = {
+const int8_t ff_vp9_subpel_filters[3][15][8] = {
     [FILTER_8TAP_REGULAR] = {
         {  0,  1,  -5, 126,   8,  -3,  1,  0 },
         { -1,  3, -10, 122,  18,  -6,  2,  0 },
@@ -1953,7 +1953,8 @@ avg ## _8tap_ ## type ## _ ## sz ## dir ## _c(uint8_t *dst,                 \
                                               int h, int mx, int my)        \
 {                                                                           \
     avg ## _8tap_1d_ ## dir ## _c(dst, src, dst_stride, src_stride, sz, h,  \
-                                  vp9_subpel_filters[type_idx][dir_m - 1]); \
+                                  ff_vp9_subpel_filters[type_idx]           \
+                                                       [dir_m - 1]);        \
 }
 
 #define filter_fn_2d(sz, type, type_idx, avg)                               \
@@ -1964,8 +1965,8 @@ static void avg ## _8tap_ ## type ## _ ## sz ## hv_c(uint8_t *dst,          \
                                                      int h, int mx, int my) \
 {                                                                           \
     avg ## _8tap_2d_hv_c(dst, src, dst_stride, src_stride, sz, h,           \
-                         vp9_subpel_filters[type_idx][mx - 1],              \
-                         vp9_subpel_filters[type_idx][my - 1]);             \
+                         ff_vp9_subpel_filters[type_idx][mx - 1],           \
+                         ff_vp9_subpel_filters[type_idx][my - 1]);          \
 }
 
 #define FILTER_BILIN(src, x, mxy, stride)                       \
@@ -2169,6 +2170,10 @@ av_cold void ff_vp9dsp_init(VP9DSPContext *dsp)
     vp9dsp_loopfilter_init(dsp);
     vp9dsp_mc_init(dsp);
 
+    if (ARCH_AARCH64)
+        ff_vp9dsp_init_aarch64(dsp);
+    if (ARCH_ARM)
+        ff_vp9dsp_init_arm(dsp);
     if (ARCH_X86)
         ff_vp9dsp_init_x86(dsp);
 }
@@ -0,0 +1,551 @@
+;******************************************************************************
+;* SIMD-optimized HEVC inverse transforms
+;*
+;* This file is part of Libav.
+;*
+;* Libav is free software; you can redistribute it and/or
+;* modify it under the terms of the GNU Lesser General Public
+;* License as published by the Free Software Foundation; either
+;* version 2.1 of the License, or (at your option) any later version.
+;*
+;* Libav is distributed in the hope that it will be useful,
+;* but WITHOUT ANY WARRANTY; without even the implied warranty of
+;* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+;* Lesser General Public License for more details.
+;*
+;* You should have received a copy of the GNU Lesser General Public
+;* License along with Libav; if not, write to the Free Software
+;* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+;******************************************************************************
+
+%include "libavutil/x86/x86util.asm"
+
+SECTION_RODATA 32
+
+pd_64:        times 8 dd 64
+pd_512:       times 8 dd 512
+pd_2048:      times 8 dd 2048
+pw_pixel_max: times 16 dw ((1 << 10)-1)
+
+pw_64_64:     times 4 dw 64,  64
+pw_64_m64:    times 4 dw 64, -64
+pw_83_36:     times 4 dw 83,  36
+pw_36_m83:    times 4 dw 36, -83
+
+; 4x4 DST, for each output the taps of (src0, src2) and (src1, src3)
+dst_coefs:    times 4 dw 29,  84
+              times 4 dw 74,  55
+              times 4 dw 55, -29
+              times 4 dw 74, -84
+              times 4 dw 74, -74
+              times 4 dw  0,  74
+              times 4 dw 84,  55
+              times 4 dw -74, -29
+
+; Takes column i of the NxN matrix and emits the taps of output i as pairs
+; for the odd inputs (1, 3), (5, 7)..., then the even ones (0, 2), (4, 6)...
+%macro IDCT_COEFS 4-*
+%rep %0 / 4
+    times 4 dw %2, %4
+%rotate 4
+%endrep
+%rep %0 / 4
+    times 4 dw %1, %3
+%rotate 4
+%endrep
+%endmacro
+
+idct8_coefs:
+IDCT_COEFS  64,  89,  83,  75,  64,  50,  36,  18
+IDCT_COEFS  64,  75,  36, -18, -64, -89, -83, -50
+IDCT_COEFS  64,  50, -36, -89, -64,  18,  83,  75
+IDCT_COEFS  64,  18, -83, -50,  64,  75, -36, -89
+
+idct16_coefs:
+IDCT_COEFS  64,  90,  89,  87,  83,  80,  75,  70,  64,  57,  50,  43,  36,  25,  18,   9
+IDCT_COEFS  64,  87,  75,  57,  36,   9, -18, -43, -64, -80, -89, -90, -83, -70, -50, -25
+IDCT_COEFS  64,  80,  50,   9, -36, -70, -89, -87, -64, -25,  18,  57,  83,  90,  75,  43
+IDCT_COEFS  64,  70,  18, -43, -83, -87, -50,   9,  64,  90,  75,  25, -36, -80, -89, -57
+IDCT_COEFS  64,  57, -18, -80, -83, -25,  50,  90,  64,  -9, -75, -87, -36,  43,  89,  70
+IDCT_COEFS  64,  43, -50, -90, -36,  57,  89,  25, -64, -87, -18,  70,  83,   9, -75, -80
+IDCT_COEFS  64,  25, -75, -70,  36,  90,  18, -80, -64,  43,  89,   9, -83, -57,  50,  87
+IDCT_COEFS  64,   9, -89, -25,  83,  43, -75, -57,  64,  70, -50, -80,  36,  87, -18, -90
+
+idct32_coefs:
+IDCT_COEFS  64,  90,  90,  90,  89,  88,  87,  85,  83,  82,  80,  78,  75,  73,  70,  67, \
+            64,  61,  57,  54,  50,  46,  43,  38,  36,  31,  25,  22,  18,  13,   9,   4
+IDCT_COEFS  64,  90,  87,  82,  75,  67,  57,  46,  36,  22,   9,  -4, -18, -31, -43, -54, \
+           -64, -73, -80, -85, -89, -90, -90, -88, -83, -78, -70, -61, -50, -38, -25, -13
+IDCT_COEFS  64,  88,  80,  67,  50,  31,   9, -13, -36, -54, -70, -82, -89, -90, -87, -78, \
+           -64, -46, -25,  -4,  18,  38,  57,  73,  83,  90,  90,  85,  75,  61,  43,  22
+IDCT_COEFS  64,  85,  70,  46,  18, -13, -43, -67, -83, -90, -87, -73, -50, -22,   9,  38, \
+            64,  82,  90,  88,  75,  54,  25,  -4, -36, -61, -80, -90, -89, -78, -57, -31
+IDCT_COEFS  64,  82,  57,  22, -18, -54, -80, -90, -83, -61, -25,  13,  50,  78,  90,  85, \
+            64,  31,  -9, -46, -75, -90, -87, -67, -36,   4,  43,  73,  89,  88,  70,  38
+IDCT_COEFS  64,  78,  43,  -4, -50, -82, -90, -73, -36,  13,  57,  85,  89,  67,  25, -22, \
+           -64, -88, -87, -61, -18,  31,  70,  90,  83,  54,   9, -38, -75, -90, -80, -46
+IDCT_COEFS  64,  73,  25, -31, -75, -90, -70, -22,  36,  78,  90,  67,  18, -38, -80, -90, \
+           -64, -13,  43,  82,  89,  61,   9, -46, -83, -88, -57,  -4,  50,  85,  87,  54
+IDCT_COEFS  64,  67,   9, -54, -89, -78, -25,  38,  83,  85,  43, -22, -75, -90, -57,   4, \
+            64,  90,  70,  13, -50, -88, -80, -31,  36,  82,  87,  46, -18, -73, -90, -61
+IDCT_COEFS  64,  61,  -9, -73, -89, -46,  25,  82,  83,  31, -43, -88, -75, -13,  57,  90, \
+            64,  -4, -70, -90, -50,  22,  80,  85,  36, -38, -87, -78, -18,  54,  90,  67
+IDCT_COEFS  64,  54, -25, -85, -75,  -4,  70,  88,  36, -46, -90, -61,  18,  82,  80,  13, \
+           -64, -90, -43,  38,  89,  67,  -9, -78, -83, -22,  57,  90,  50, -31, -87, -73
+IDCT_COEFS  64,  46, -43, -90, -50,  38,  90,  54, -36, -90, -57,  31,  89,  61, -25, -88, \
+           -64,  22,  87,  67, -18, -85, -70,  13,  83,  73,  -9, -82, -75,   4,  80,  78
+IDCT_COEFS  64,  38, -57, -88, -18,  73,  80,  -4, -83, -67,  25,  90,  50, -46, -90, -31, \
+            64,  85,   9, -78, -75,  13,  87,  61, -36, -90, -43,  54,  89,  22, -70, -82
+IDCT_COEFS  64,  31, -70, -78,  18,  90,  43, -61, -83,   4,  87,  54, -50, -88,  -9,  82, \
+            64, -38, -90, -22,  75,  73, -25, -90, -36,  67,  80, -13, -89, -46,  57,  85
+IDCT_COEFS  64,  22, -80, -61,  50,  85,  -9, -90, -36,  73,  70, -38, -89,  -4,  87,  46, \
+           -64, -78,  25,  90,  18, -82, -57,  54,  83, -13, -90, -31,  75,  67, -43, -88
+IDCT_COEFS  64,  13, -87, -38,  75,  61, -57, -78,  36,  88,  -9, -90, -18,  85,  43, -73, \
+           -64,  54,  80, -31, -89,   4,  90,  22, -83, -46,  70,  67, -50, -82,  25,  90
+IDCT_COEFS  64,   4, -90, -13,  89,  22, -87, -31,  83,  38, -80, -46,  75,  54, -70, -61, \
+            64,  67, -57, -73,  50,  78, -43, -82,  36,  85, -25, -88,  18,  90,  -9, -90
+
+cextern pb_0
+
+SECTION .text
+
+; m0: rows 0-1, m1: rows 2-3 of a 4x4 block of words, transformed along
+; the columns and returned in the same layout
+%macro TR_4x4 2 ; rounding, shift
+    mova            m2, m0
+    punpcklwd       m0, m1
+    punpckhwd       m2, m1
+    mova            m1, m0
+    mova            m3, m2
+    pmaddwd         m0, [pw_64_64]
+    pmaddwd         m1, [pw_64_m64]
+    pmaddwd         m2, [pw_83_36]
+    pmaddwd         m3, [pw_36_m83]
+    paddd           m0, %1
+    paddd           m1, %1
+    mova            m4, m0
+    mova            m5, m1
+    paddd           m0, m2
+    paddd           m1, m3
+    psubd           m4, m2
+    psubd           m5, m3
+    psrad           m0, %2
+    psrad           m1, %2
+    psrad           m4, %2
+    psrad           m5, %2
+    packssdw        m0, m1
+    packssdw        m5, m4
+    SWAP             1, 5
+%endmacro
+
+%macro DST_OUT 4 ; output register, output index, rounding, shift
+    mova           m%1, m0
+    mova            m4, m2
+    pmaddwd        m%1, [dst_coefs + %2 * 32]
+    pmaddwd         m4, [dst_coefs + %2 * 32 + 16]
+    paddd          m%1, %3
+    paddd          m%1, m4
+    psrad          m%1, %4
+%endmacro
+
+%macro DST_4x4 2
+    mova            m2, m0
+    punpcklwd       m0, m1
+    punpckhwd       m2, m1
+    DST_OUT          5, 0, %1, %2
+    DST_OUT          6, 1, %1, %2
+    DST_OUT          7, 2, %1, %2
+    DST_OUT          3, 3, %1, %2
+    packssdw        m5, m6
+    packssdw        m7, m3
+    SWAP             0, 5
+    SWAP             1, 7
+%endmacro
+
+%macro TRANSPOSE_4x4 0
+    mova            m2, m0
+    punpcklwd       m0, m1
+    punpckhwd       m2, m1
+    mova            m1, m0
+    punpcklwd       m0, m2
+    punpckhwd       m1, m2
+%endmacro
+
+%macro ADD_4x4 1 ; bit depth
+    lea          dst2q, [dstq + strideq * 2]
+    pxor            m7, m7
+%if %1 == 8
+    movd            m2, [dstq]
+    movd            m3, [dstq + strideq]
+    punpckldq       m2, m3
+    punpcklbw       m2, m7
+    paddsw          m0, m2
+    movd            m2, [dst2q]
+    movd            m3, [dst2q + strideq]
+    punpckldq       m2, m3
+    punpcklbw       m2, m7
+    paddsw          m1, m2
+    packuswb        m0, m1
+    movd        [dstq], m0
+    psrldq          m0, 4
+    movd [dstq + strideq], m0
+    psrldq          m0, 4
+    movd       [dst2q], m0
+    psrldq          m0, 4
+    movd [dst2q + strideq], m0
+%else
+    movh            m2, [dstq]
+    movhps          m2, [dstq + strideq]
+    movh            m3, [dst2q]
+    movhps          m3, [dst2q + strideq]
+    paddsw          m0, m2
+    paddsw          m1, m3
+    CLIPW           m0, m7, [pw_pixel_max]
+    CLIPW           m1, m7, [pw_pixel_max]
+    movh        [dstq], m0
+    movhps [dstq + strideq], m0
+    movh       [dst2q], m1
+    movhps [dst2q + strideq], m1
+%endif
+%endmacro
+
+; void transform_4x4_add(uint8_t *dst, int16_t *coeffs, ptrdiff_t stride)
+%macro TRANSFORM_4x4 3 ; name, 1D transform, bit depth
+cglobal hevc_transform_%1_add_%3, 3, 4, 8, dst, coeffs, stride, dst2
+    mova            m0, [coeffsq]
+    mova            m1, [coeffsq + 16]
+    %2    [pd_64], 7
+    TRANSPOSE_4x4
+%if %3 == 8
+    %2  [pd_2048], 12
+%else
+    %2   [pd_512], 10
+%endif
+    TRANSPOSE_4x4
+    ADD_4x4         %3
+    RET
+%endmacro
+
+; coeffs is only 16-byte aligned
+%macro MOVC 2
+%if mmsize == 32
+    movu            %1, %2
+%else
+    mova            %1, %2
+%endif
+%endmacro
+
+; multiplies both halves m%1, m%2 of a pair by the taps at coefq + %3
+%macro PMADDWD_PAIR 3
+%if mmsize == 32
+    vbroadcasti128  m6, [coefq + %3]
+    pmaddwd        m%1, m6
+    pmaddwd        m%2, m6
+%else
+    pmaddwd        m%1, [coefq + %3]
+    pmaddwd        m%2, [coefq + %3]
+%endif
+%endmacro
+
+; The NxN transforms work on strips of mmsize / 2 columns. The inputs of a
+; strip are interleaved in pairs on the stack, the odd ones first, and each
+; step of the loop below produces outputs i and N - 1 - i of all columns.
+; %1: N, %2: rounding, %3: shift, %4: step between output rows
+%macro IDCT_KERNEL 4
+    lea          coefq, [idct%1_coefs]
+    mov           cntd, %1 / 2
+%%loop:
+    mova            m0, [rsp]
+    mova            m1, [rsp + mmsize]
+    PMADDWD_PAIR     0, 1, 0
+%assign %%p 1
+%rep %1 / 4 - 1
+    mova            m2, [rsp + %%p * 2 * mmsize]
+    mova            m3, [rsp + %%p * 2 * mmsize + mmsize]
+    PMADDWD_PAIR     2, 3, %%p * 16
+    paddd           m0, m2
+    paddd           m1, m3
+%assign %%p %%p + 1
+%endrep
+    mova            m4, [%2]
+    mova            m5, m4
+%assign %%p 0
+%rep %1 / 4
+    mova            m2, [rsp + %1 * mmsize / 2 + %%p * 2 * mmsize]
+    mova            m3, [rsp + %1 * mmsize / 2 + %%p * 2 * mmsize + mmsize]
+    PMADDWD_PAIR     2, 3, (%1 / 4 + %%p) * 16
+    paddd           m4, m2
+    paddd           m5, m3
+%assign %%p %%p + 1
+%endrep
+    mova            m6, m4
+    mova            m7, m5
+    paddd           m4, m0
+    paddd           m5, m1
+    psubd           m6, m0
+    psubd           m7, m1
+    psrad           m4, %3
+    psrad           m5, %3
+    psrad           m6, %3
+    psrad           m7, %3
+    packssdw        m4, m5
+    packssdw        m6, m7
+    MOVC      [outloq], m4
+    MOVC      [outhiq], m6
+    add          coefq, %1 * 8
+    add         outloq, %4
+    sub         outhiq, %4
+    dec           cntd
+    jg %%loop
+%endmacro
+
+; interleaves two input rows into the pair at stack offset %3, %4: temp
+%macro STORE_PAIR 4
+    mova           m%4, m%1
+    punpcklwd      m%1, m%2
+    punpckhwd      m%4, m%2
+    mova   [rsp + %3], m%1
+    mova [rsp + %3 + mmsize], m%4
+%endmacro
+
+; pairs of the column transform from the strip of columns at coeffsq; with
+; SSE4 m5 is left zero if the whole strip is
+%macro IDCT_PAIRS_COLS 1
+%assign %%p 0
+%rep %1 / 4
+    MOVC            m0, [coeffsq + (4 * %%p + 1) * 2 * %1]
+    MOVC            m1, [coeffsq + (4 * %%p + 3) * 2 * %1]
+    MOVC            m2, [coeffsq + (4 * %%p + 0) * 2 * %1]
+    MOVC            m3, [coeffsq + (4 * %%p + 2) * 2 * %1]
+%if cpuflag(sse4)
+%if %%p == 0
+    por             m5, m0, m1
+%else
+    por             m5, m0
+    por             m5, m1
+%endif
+    por             m5, m2
+    por             m5, m3
+%endif
+    STORE_PAIR       0, 1, %%p * 2 * mmsize, 4
+    STORE_PAIR       2, 3, %1 * mmsize / 2 + %%p * 2 * mmsize, 4
+%assign %%p %%p + 1
+%endrep
+%endmacro
+
+; pairs of the row transform from the rows at coeffsq, transposed 8x8 block
+; by block; with ymm registers rows 8-15 go to the high lanes. On x86_32
+; the transpose spills into row 6 of the block, which has been read.
+%macro IDCT_PAIRS_ROWS 1
+%assign %%b 0
+%rep %1 / 8
+%if mmsize == 32
+%assign %%j 0
+%rep 8
+    movu       xm %+ %%j, [coeffsq + %%j * 2 * %1 + %%b * 16]
+    vinserti128 m %+ %%j, m %+ %%j, [coeffsq + (%%j + 8) * 2 * %1 + %%b * 16], 1
+%assign %%j %%j + 1
+%endrep
+%else
+%assign %%j 0
+%rep 8
+%if ARCH_X86_64 || %%j != 6
+    mova        m %+ %%j, [coeffsq + %%j * 2 * %1 + %%b * 16]
+%endif
+%assign %%j %%j + 1
+%endrep
+%endif
+%if ARCH_X86_64
+    TRANSPOSE8x8W    0, 1, 2, 3, 4, 5, 6, 7, 8
+    STORE_PAIR       1, 3, (2 * %%b) * 2 * mmsize, 8
+    STORE_PAIR       5, 7, (2 * %%b + 1) * 2 * mmsize, 8
+    STORE_PAIR       0, 2, %1 * mmsize / 2 + (2 * %%b) * 2 * mmsize, 8
+    STORE_PAIR       4, 6, %1 * mmsize / 2 + (2 * %%b + 1) * 2 * mmsize, 8
+%else
+    TRANSPOSE8x8W    0, 1, 2, 3, 4, 5, 6, 7, [coeffsq + 6 * 2 * %1 + %%b * 16], [rsp + %1 * 32], 1
+    STORE_PAIR       1, 3, (2 * %%b) * 32, 4
+    STORE_PAIR       5, 7, (2 * %%b + 1) * 32, 4
+    STORE_PAIR       0, 2, %1 * 8 + (2 * %%b) * 32, 4
+    mova            m4, [rsp + %1 * 32]
+    STORE_PAIR       4, 6, %1 * 8 + (2 * %%b + 1) * 32, 0
+%endif
+%assign %%b %%b + 1
+%endrep
+%endmacro
+
+; row, destination, bit depth, temp, zero, pixel max
+%macro ADD_ROW 6
+%if %3 == 8
+%if cpuflag(sse4)
+    pmovzxbw       m%4, %2
+%else
+    movh           m%4, %2
+    punpcklbw      m%4, %5
+%endif
+    paddsw         m%1, m%4
+    packuswb       m%1, m%1
+    movh            %2, m%1
+%else
+    movu           m%4, %2
+    paddsw         m%1, m%4
+    CLIPW          m%1, %5, %6
+    movu            %2, m%1
+%endif
+%endmacro
+
+; adds the two lanes of m%1 to the rows at %2 and %3
+%macro ADD_ROW2 4 ; row, destinations, bit depth
+%if %4 == 8
+    pmovzxbw       xm9, %2
+    pmovzxbw       xm8, %3
+    vinserti128     m9, m9, xm8, 1
+    paddsw         m%1, m9
+    packuswb       m%1, m%1
+    movq            %2, xm%1
+    vextracti128   xm%1, m%1, 1
+    movq            %3, xm%1
+%else
+    movu           xm9, %2
+    vinserti128     m9, m9, %3, 1
+    paddsw         m%1, m9
+    CLIPW          m%1, m10, m11
+    movu            %2, xm%1
+    vextracti128    %3, m%1, 1
+%endif
+%endmacro
+
+; transposes the row transform output back and adds it to the rows of dst
+%macro IDCT_ADD 2 ; N, bit depth
+    lea            s3q, [strideq * 3]
+    lea          dst4q, [dstq + strideq * 4]
+%if mmsize == 32
+    lea          dst8q, [dstq + strideq * 8]
+    lea         dst12q, [dst4q + strideq * 8]
+%endif
+%assign %%b 0
+%rep %1 / 8
+%assign %%x %%b * 8 * ((%2 + 7) / 8)
+%assign %%j 0
+%rep 8
+%if ARCH_X86_64 || %%j != 6
+    mova        m %+ %%j, [rsp + %1 * mmsize + (8 * %%b + %%j) * mmsize]
+%endif
+%assign %%j %%j + 1
+%endrep
+%if mmsize == 32
+    TRANSPOSE8x8W    0, 1, 2, 3, 4, 5, 6, 7, 8
+    ADD_ROW2         0, [dstq + %%x], [dst8q + %%x], %2
+    ADD_ROW2         1, [dstq + strideq + %%x], [dst8q + strideq + %%x], %2
+    ADD_ROW2         2, [dstq + strideq * 2 + %%x], [dst8q + strideq * 2 + %%x], %2
+    ADD_ROW2         3, [dstq + s3q + %%x], [dst8q + s3q + %%x], %2
+    ADD_ROW2         4, [dst4q + %%x], [dst12q + %%x], %2
+    ADD_ROW2         5, [dst4q + strideq + %%x], [dst12q + strideq + %%x], %2
+    ADD_ROW2         6, [dst4q + strideq * 2 + %%x], [dst12q + strideq * 2 + %%x], %2
+    ADD_ROW2         7, [dst4q + s3q + %%x], [dst12q + s3q + %%x], %2
+%elif ARCH_X86_64
+    TRANSPOSE8x8W    0, 1, 2, 3, 4, 5, 6, 7, 8
+    ADD_ROW          0, [dstq + %%x], %2, 9, m10, m11
+    ADD_ROW          1, [dstq + strideq + %%x], %2, 9, m10, m11
+    ADD_ROW          2, [dstq + strideq * 2 + %%x], %2, 9, m10, m11
+    ADD_ROW          3, [dstq + s3q + %%x], %2, 9, m10, m11
+    ADD_ROW          4, [dst4q + %%x], %2, 9, m10, m11
+    ADD_ROW          5, [dst4q + strideq + %%x], %2, 9, m10, m11
+    ADD_ROW          6, [dst4q + strideq * 2 + %%x], %2, 9, m10, m11
+    ADD_ROW          7, [dst4q + s3q + %%x], %2, 9, m10, m11
+%else
+    TRANSPOSE8x8W    0, 1, 2, 3, 4, 5, 6, 7, [rsp + %1 * 16 + (8 * %%b + 6) * 16], [rsp + %1 * 32], 1
+    ADD_ROW          0, [dstq + %%x], %2, 4, [pb_0], [pw_pixel_max]
+    ADD_ROW          1, [dstq + strideq + %%x], %2, 4, [pb_0], [pw_pixel_max]
+    ADD_ROW          2, [dstq + strideq * 2 + %%x], %2, 4, [pb_0], [pw_pixel_max]
+    ADD_ROW          3, [dstq + s3q + %%x], %2, 4, [pb_0], [pw_pixel_max]
+    ADD_ROW          5, [dst4q + strideq + %%x], %2, 4, [pb_0], [pw_pixel_max]
+    ADD_ROW          6, [dst4q + strideq * 2 + %%x], %2, 4, [pb_0], [pw_pixel_max]
+    ADD_ROW          7, [dst4q + s3q + %%x], %2, 4, [pb_0], [pw_pixel_max]
+    mova            m0, [rsp + %1 * 32]
+    ADD_ROW          0, [dst4q + %%x], %2, 1, [pb_0], [pw_pixel_max]
+%endif
+%assign %%b %%b + 1
+%endrep
+%endmacro
+
+; The first pass writes its output back into coeffs, untransposed; the
+; second pass transposes its input and output through registers. With SSE4
+; the first pass skips the strips of columns that are all zero.
+; On x86_32 the loop counters are kept on the stack, after the spill area
+; of the transposes.
+%macro TRANSFORM_NxN 2 ; N, bit depth
+%if ARCH_X86_64
+cglobal hevc_transform_%1x%1_add_%2, 3, 8, 12, %1 * mmsize * 2, dst, coeffs, stride, coef, outlo, outhi, cnt, strip
+    %define dst12q cntq
+%else
+cglobal hevc_transform_%1x%1_add_%2, 3, 6, 8, %1 * 32 + 48, dst, coeffs, stride, coef, outlo, outhi
+    %define cntd   dword [rsp + %1 * 32 + 32]
+    %define stripd dword [rsp + %1 * 32 + 36]
+%endif
+    ; the add reuses the registers of the kernel
+    %define s3q   coefq
+    %define dst4q outloq
+    %define dst8q outhiq
+    mov         stripd, 2 * %1 / mmsize
+.pass1:
+    IDCT_PAIRS_COLS %1
+%if cpuflag(sse4)
+    ptest           m5, m5
+    jz .skip
+%endif
+    mov         outloq, coeffsq
+    lea         outhiq, [coeffsq + (%1 - 1) * 2 * %1]
+    IDCT_KERNEL     %1, pd_64, 7, 2 * %1
+.skip:
+    add        coeffsq, mmsize
+    dec         stripd
+    jg .pass1
+
+    sub        coeffsq, 2 * %1
+    mov         stripd, 2 * %1 / mmsize
+%if ARCH_X86_64
+    pxor           m10, m10
+%if %2 > 8
+    mova           m11, [pw_pixel_max]
+%endif
+%endif
+.pass2:
+    IDCT_PAIRS_ROWS %1
+    lea         outloq, [rsp + %1 * mmsize]
+    lea         outhiq, [rsp + %1 * mmsize + (%1 - 1) * mmsize]
+%if %2 == 8
+    IDCT_KERNEL     %1, pd_2048, 12, mmsize
+%else
+    IDCT_KERNEL     %1, pd_512, 10, mmsize
+%endif
+    IDCT_ADD        %1, %2
+%if mmsize == 32
+    lea           dstq, [dst8q + strideq * 8]
+%else
+    lea           dstq, [dst4q + strideq * 4]
+%endif
+    add        coeffsq, mmsize * %1
+    dec         stripd
+    jg .pass2
+    RET
+%endmacro
+
+%macro TRANSFORMS 1 ; bit depth
+TRANSFORM_4x4 4x4_luma, DST_4x4, %1
+TRANSFORM_4x4 4x4,      TR_4x4,  %1
+TRANSFORM_NxN  8, %1
+TRANSFORM_NxN 16, %1
+TRANSFORM_NxN 32, %1
+%endmacro
+
+INIT_XMM sse2
+TRANSFORMS 8
+TRANSFORMS 10
+INIT_XMM sse4
+TRANSFORM_NxN 32, 8
+TRANSFORM_NxN 32, 10
+%if HAVE_AVX2_EXTERNAL && ARCH_X86_64
+INIT_YMM avx2
+TRANSFORM_NxN 32, 8
+TRANSFORM_NxN 32, 10
+%endif
@@ -0,0 +1,672 @@
+;******************************************************************************
+;* SIMD-optimized HEVC motion compensation
+;*
+;* This file is part of Libav.
+;*
+;* Libav is free software; you can redistribute it and/or
+;* modify it under the terms of the GNU Lesser General Public
+;* License as published by the Free Software Foundation; either
+;* version 2.1 of the License, or (at your option) any later version.
+;*
+;* Libav is distributed in the hope that it will be useful,
+;* but WITHOUT ANY WARRANTY; without even the implied warranty of
+;* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+;* Lesser General Public License for more details.
+;*
+;* You should have received a copy of the GNU Lesser General Public
+;* License along with Libav; if not, write to the Free Software
+;* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+;******************************************************************************
+
+%include "libavutil/x86/x86util.asm"
+
+SECTION_RODATA
+
+pw_256:       times 8 dw 256
+pw_1024:      times 8 dw 1024
+pw_2048:      times 8 dw 2048
+pw_pixel_max: times 8 dw ((1 << 10)-1)
+
+%macro QPEL_TAPS_B 8
+    times 8 db %1, %2
+    times 8 db %3, %4
+    times 8 db %5, %6
+    times 8 db %7, %8
+%endmacro
+
+%macro QPEL_TAPS_W 8
+    times 4 dw %1, %2
+    times 4 dw %3, %4
+    times 4 dw %5, %6
+    times 4 dw %7, %8
+%endmacro
+
+; luma filter taps for positions -3..4, as pairs for pmaddubsw
+qpel_taps_b:
+QPEL_TAPS_B -1, 4, -10, 58, 17,  -5, 1,  0
+QPEL_TAPS_B -1, 4, -11, 40, 40, -11, 4, -1
+QPEL_TAPS_B  0, 1,  -5, 17, 58, -10, 4, -1
+
+; the same as word pairs for pmaddwd
+qpel_taps_w:
+QPEL_TAPS_W -1, 4, -10, 58, 17,  -5, 1,  0
+QPEL_TAPS_W -1, 4, -11, 40, 40, -11, 4, -1
+QPEL_TAPS_W  0, 1,  -5, 17, 58, -10, 4, -1
+
+cextern pw_512
+cextern hevc_epel_filters
+
+SECTION .text
+
+; The taps are kept in registers, except on x86_32 where the outer two
+; pairs of the luma filter are read from memory.
+%if ARCH_X86_64
+    %define tap0 m8
+    %define tap1 m9
+    %define tap2 m10
+    %define tap3 m11
+%else
+    %define tap0 m2
+    %define tap1 m3
+%endif
+
+; x86_32 has no registers left for the block size, which is then read from
+; the arguments on the stack
+%macro DIMS_ON_STACK 2 ; argument index of the width, of the height
+    %define widthd  r%1m
+    %define heightd dword r%2m
+%endmacro
+
+; Runs %1 over a block, mmsize / 2 pixels at a time. %1 reads its input at
+; srcpq and leaves the words in m4, which are stored as words, or as bytes
+; when %8 is 1.
+; %2: source bytes per step, %3/%4: source and stride,
+; %5/%6: destination and stride in bytes, %7: row counter
+%macro MC_LOOP 7-8 2
+%%loop_y:
+    mov          srcpq, %3
+    mov          dstpq, %5
+    mov             xd, widthd
+%%loop_x:
+    %1
+    cmp             xd, mmsize / 2
+    jl %%tail
+%if %8 == 1
+    movh      [dstpq], m4
+%else
+    movu      [dstpq], m4
+%endif
+    add          srcpq, %2
+    add          dstpq, mmsize / 2 * (%8)
+    sub             xd, mmsize / 2
+    jg %%loop_x
+    jmp %%next
+%%tail:
+%if mmsize == 32
+    cmp             xd, 8
+    jl %%tail4
+    movu      [dstpq], xm4
+    je %%next
+    vextracti128   xm4, m4, 1
+    add          dstpq, 16
+    sub             xd, 8
+%%tail4:
+%endif
+    cmp             xd, 4
+    jl %%tail2
+%if %8 == 1
+    movd      [dstpq], m4
+    je %%next
+    psrlq           m4, 32
+%else
+    movq      [dstpq], xm4
+    je %%next
+    psrldq         xm4, 8
+%endif
+    add          dstpq, 4 * (%8)
+%%tail2:
+%if %8 == 1
+    movd            xd, m4
+    mov       [dstpq], xw
+%else
+    movd      [dstpq], xm4
+%endif
+%%next:
+    add             %3, %4
+    add             %5, %6
+    dec             %7
+    jg %%loop_y
+%endmacro
+
+; Multiplies two rows of taps (memory operands or zero) by the tap pair %3
+; and accumulates into m4, bytes for 8-bit input. With ymm registers the
+; low lane takes pixels 0-7 and the high one pixels 8-15.
+%macro FILTER_B 4
+%if mmsize == 32
+%ifidn %1, zero
+    pxor           xm0, xm0
+%else
+    movu           xm0, %1
+%endif
+%ifidn %2, zero
+    pxor           xm1, xm1
+%else
+    movu           xm1, %2
+%endif
+    punpckhbw      xm5, xm0, xm1
+    punpcklbw      xm0, xm1
+    vinserti128     m0, m0, xm5, 1
+%else
+%ifidn %1, zero
+    pxor            m0, m0
+%else
+    movh            m0, %1
+%endif
+%ifidn %2, zero
+    pxor            m1, m1
+%else
+    movh            m1, %2
+%endif
+    punpcklbw       m0, m1
+%endif
+%if %4
+    pmaddubsw       m0, %3
+    SWAP             0, 4
+%else
+    pmaddubsw       m0, %3
+    paddw           m4, m0
+%endif
+%endmacro
+
+; word input, accumulates dwords into m4/m5
+%macro FILTER_W 4
+%ifidn %1, zero
+    pxor            m0, m0
+%else
+    movu            m0, %1
+%endif
+%ifidn %2, zero
+    pxor            m1, m1
+%else
+    movu            m1, %2
+%endif
+    mova            m6, m0
+    punpcklwd       m0, m1
+    punpckhwd       m6, m1
+    pmaddwd         m0, %3
+    pmaddwd         m6, %3
+%if %4
+    mova            m4, m0
+    mova            m5, m6
+%else
+    paddd           m4, m0
+    paddd           m5, m6
+%endif
+%endmacro
+
+%macro FILTER_W_END 1 ; shift
+    psrad           m4, %1
+    psrad           m5, %1
+    packssdw        m4, m5
+%endmacro
+
+; row k of the vertical filter window, srcpq pointing to the first row;
+; tmp addresses the 16-bit intermediate in mcbuffer
+%macro SET_ROWS 1
+%ifidn %1, tmp
+    %define row0 [srcpq + 0 * 128]
+    %define row1 [srcpq + 1 * 128]
+    %define row2 [srcpq + 2 * 128]
+    %define row3 [srcpq + 3 * 128]
+    %define row4 [srcpq + 4 * 128]
+    %define row5 [srcpq + 5 * 128]
+    %define row6 [srcpq + 6 * 128]
+    %define row7 [srcpq + 7 * 128]
+%else
+    %define row0 [srcpq]
+    %define row1 [srcpq + srcstrideq]
+    %define row2 [srcpq + srcstrideq * 2]
+    %define row3 [srcpq + s3q]
+    %define row4 [src4q]
+    %define row5 [src4q + srcstrideq]
+    %define row6 [src4q + srcstrideq * 2]
+    %define row7 [src4q + s3q]
+%endif
+%endmacro
+
+%macro PIXELS 1 ; bit depth
+%if %1 == 8
+%if cpuflag(sse4)
+    pmovzxbw        m4, [srcpq]
+%else
+    movh            m4, [srcpq]
+    punpcklbw       m4, m7
+%endif
+    psllw           m4, 6
+%else
+    movu            m4, [srcpq]
+    psllw           m4, 14 - %1
+%endif
+%endmacro
+
+%macro QPEL_H 1 ; bit depth
+%if %1 == 8
+    FILTER_B [srcpq - 3], [srcpq - 2], tap0, 1
+    FILTER_B [srcpq - 1], [srcpq + 0], tap1, 0
+    FILTER_B [srcpq + 1], [srcpq + 2], tap2, 0
+    FILTER_B [srcpq + 3], [srcpq + 4], tap3, 0
+%else
+    FILTER_W [srcpq - 6], [srcpq - 4], tap0, 1
+    FILTER_W [srcpq - 2], [srcpq + 0], tap1, 0
+    FILTER_W [srcpq + 2], [srcpq + 4], tap2, 0
+    FILTER_W [srcpq + 6], [srcpq + 8], tap3, 0
+    FILTER_W_END %1 - 8
+%endif
+%endmacro
+
+; %1: bit depth, 0 for the intermediate of the 2D filters, %2: position;
+; the outer taps of positions 1 and 3 are zero and not loaded
+%macro QPEL_V 2
+%if %1 == 0
+    SET_ROWS tmp
+%else
+    SET_ROWS src
+    lea          src4q, [srcpq + srcstrideq * 4]
+%endif
+%if %1 == 8
+    %define FILTER FILTER_B
+%else
+    %define FILTER FILTER_W
+%endif
+%if %2 == 3
+    FILTER zero, row1, tap0, 1
+%else
+    FILTER row0, row1, tap0, 1
+%endif
+    FILTER row2, row3, tap1, 0
+    FILTER row4, row5, tap2, 0
+%if %2 == 1
+    FILTER row6, zero, tap3, 0
+%else
+    FILTER row6, row7, tap3, 0
+%endif
+%if %1 == 0
+    FILTER_W_END 6
+%elif %1 > 8
+    FILTER_W_END %1 - 8
+%endif
+%endmacro
+
+%macro EPEL_H 1
+%if %1 == 8
+    FILTER_B [srcpq - 1], [srcpq + 0], tap0, 1
+    FILTER_B [srcpq + 1], [srcpq + 2], tap1, 0
+%else
+    FILTER_W [srcpq - 2], [srcpq + 0], tap0, 1
+    FILTER_W [srcpq + 2], [srcpq + 4], tap1, 0
+    FILTER_W_END %1 - 8
+%endif
+%endmacro
+
+%macro EPEL_V 1
+%if %1 == 0
+    SET_ROWS tmp
+%else
+    SET_ROWS src
+%endif
+%if %1 == 8
+    FILTER_B row0, row1, tap0, 1
+    FILTER_B row2, row3, tap1, 0
+%else
+    FILTER_W row0, row1, tap0, 1
+    FILTER_W row2, row3, tap1, 0
+%if %1 == 0
+    FILTER_W_END 6
+%else
+    FILTER_W_END %1 - 8
+%endif
+%endif
+%endmacro
+
+; loads a 16-byte row of taps into both lanes
+%macro LOAD_TAPS 2
+%if mmsize == 32
+    vbroadcasti128  %1, %2
+%else
+    mova            %1, %2
+%endif
+%endmacro
+
+; %1: bit depth, 0 for word taps, %2: position
+%macro LOAD_QPEL_TAPS 2
+%if %1 == 8
+    %xdefine %%taps qpel_taps_b + (%2 - 1) * 64
+%else
+    %xdefine %%taps qpel_taps_w + (%2 - 1) * 64
+%endif
+    LOAD_TAPS     tap0, [%%taps]
+    LOAD_TAPS     tap1, [%%taps + 16]
+%if ARCH_X86_64
+    LOAD_TAPS     tap2, [%%taps + 32]
+    LOAD_TAPS     tap3, [%%taps + 48]
+%else
+    %xdefine tap2 [%%taps + 32]
+    %xdefine tap3 [%%taps + 48]
+%endif
+%endmacro
+
+; %1: bit depth, 0 for word taps, %2: filter index 1-7 (clobbered),
+; %3: scratch register
+%macro LOAD_EPEL_TAPS 3
+    shl            %2d, 4
+    lea             %3, [hevc_epel_filters - 16]
+%if %1 == 8
+    LOAD_TAPS     tap1, [%3 + %2q]
+    pshuflw       tap0, tap1, q0000
+    pshuflw       tap1, tap1, q1111
+    punpcklqdq    tap0, tap0
+    punpcklqdq    tap1, tap1
+%else
+%if cpuflag(sse4)
+    pmovsxbw      tap1, [%3 + %2q]
+%else
+    mova          tap1, [%3 + %2q]
+    punpcklbw     tap1, tap1
+    psraw         tap1, 8
+%endif
+    pshufd        tap0, tap1, q0000
+    pshufd        tap1, tap1, q1111
+%endif
+%endmacro
+
+; void put_hevc_qpel_*(int16_t *dst, ptrdiff_t dststride, uint8_t *src,
+;                      ptrdiff_t srcstride, int width, int height,
+;                      int16_t *mcbuffer)
+%macro HEVC_PIXELS 2 ; name, bit depth
+%if ARCH_X86_64
+cglobal hevc_put_%1_pixels_%2, 6, 9, 8, dst, dststride, src, srcstride, width, height, srcp, dstp, x
+%else
+cglobal hevc_put_%1_pixels_%2, 4, 7, 8, dst, dststride, src, srcstride, srcp, dstp, x
+    DIMS_ON_STACK    4, 5
+%endif
+    add     dststrideq, dststrideq
+%if %2 == 8 && notcpuflag(sse4)
+    pxor            m7, m7
+%endif
+    MC_LOOP {PIXELS %2}, mmsize / 2 * ((%2 + 7) / 8), srcq, srcstrideq, dstq, dststrideq, heightd
+    RET
+%endmacro
+
+%macro HEVC_QPEL_H 2 ; bit depth, position
+%if ARCH_X86_64
+cglobal hevc_put_qpel_h%2_%1, 6, 9, 12, dst, dststride, src, srcstride, width, height, srcp, dstp, x
+%else
+cglobal hevc_put_qpel_h%2_%1, 4, 7, 8, dst, dststride, src, srcstride, srcp, dstp, x
+    DIMS_ON_STACK    4, 5
+%endif
+    LOAD_QPEL_TAPS  %1, %2
+    add     dststrideq, dststrideq
+    MC_LOOP {QPEL_H %1}, mmsize / 2 * ((%1 + 7) / 8), srcq, srcstrideq, dstq, dststrideq, heightd
+    RET
+%endmacro
+
+; on x86_32 the doubled destination stride and the source pointer live in
+; their argument slots
+%macro HEVC_QPEL_V 2
+%if ARCH_X86_64
+cglobal hevc_put_qpel_v%2_%1, 6, 11, 12, dst, dststride, src, srcstride, width, height, srcp, dstp, x, src4, s3
+    LOAD_QPEL_TAPS  %1, %2
+    add     dststrideq, dststrideq
+    lea            s3q, [srcstrideq * 3]
+    sub           srcq, s3q
+    MC_LOOP {QPEL_V %1, %2}, mmsize / 2 * ((%1 + 7) / 8), srcq, srcstrideq, dstq, dststrideq, heightd
+%else
+cglobal hevc_put_qpel_v%2_%1, 4, 7, 8, dst, dststride, src, srcstride, srcp, dstp, x
+    DIMS_ON_STACK    4, 5
+    LOAD_QPEL_TAPS  %1, %2
+    add     dststrideq, dststrideq
+    mov             r1m, dststrideq
+    lea             xq, [srcstrideq * 3]
+    sub           srcq, xq
+    mov             r2m, srcq
+    DEFINE_ARGS dst, src4, s3, srcstride, srcp, dstp, x
+    lea            s3q, [srcstrideq * 3]
+    MC_LOOP {QPEL_V %1, %2}, mmsize / 2 * ((%1 + 7) / 8), r2m, srcstrideq, dstq, r1m, heightd
+%endif
+    RET
+%endmacro
+
+; the horizontal pass runs over the 3 rows above (2 for position 3) and
+; the 4 below (3 for position 1) into mcbuffer, the vertical one over that
+%macro HEVC_QPEL_HV 3 ; bit depth, horizontal position, vertical position
+%if ARCH_X86_64
+cglobal hevc_put_qpel_h%2v%3_%1, 7, 12, 12, dst, dststride, src, srcstride, width, height, mcbuf, srcp, dstp, x, tmp, rows
+    LOAD_QPEL_TAPS  %1, %2
+%if %3 == 3
+    lea           tmpq, [srcstrideq * 2]
+%else
+    lea           tmpq, [srcstrideq * 3]
+%endif
+    sub           srcq, tmpq
+%if %3 == 2
+    lea          rowsd, [heightq + 7]
+%else
+    lea          rowsd, [heightq + 6]
+%endif
+    mov           tmpq, mcbufq
+%else
+cglobal hevc_put_qpel_h%2v%3_%1, 4, 7, 8, dst, dststride, src, srcstride, srcp, dstp, x
+    DIMS_ON_STACK    4, 5
+    LOAD_QPEL_TAPS  %1, %2
+    DEFINE_ARGS tmp, rows, src, srcstride, srcp, dstp, x
+%if %3 == 3
+    lea           tmpq, [srcstrideq * 2]
+%else
+    lea           tmpq, [srcstrideq * 3]
+%endif
+    sub           srcq, tmpq
+    mov          rowsd, heightd
+%if %3 == 2
+    add          rowsd, 7
+%else
+    add          rowsd, 6
+%endif
+    mov           tmpq, r6m
+%endif
+    MC_LOOP {QPEL_H %1}, mmsize / 2 * ((%1 + 7) / 8), srcq, srcstrideq, tmpq, 128, rowsd
+
+    LOAD_QPEL_TAPS   0, %3
+%if ARCH_X86_32
+    DEFINE_ARGS dst, dststride, mcbuf, srcstride, srcp, dstp, x
+    mov           dstq, r0m
+    mov     dststrideq, r1m
+    mov         mcbufq, r6m
+%endif
+    add     dststrideq, dststrideq
+%if %3 == 3
+    sub         mcbufq, 128
+%endif
+    MC_LOOP {QPEL_V 0, %3}, mmsize, mcbufq, 128, dstq, dststrideq, heightd
+    RET
+%endmacro
+
+; void put_hevc_epel_*(int16_t *dst, ptrdiff_t dststride, uint8_t *src,
+;                      ptrdiff_t srcstride, int width, int height,
+;                      int mx, int my, int16_t *mcbuffer)
+%macro HEVC_EPEL 1 ; bit depth
+%if ARCH_X86_64
+cglobal hevc_put_epel_h_%1, 7, 10, 10, dst, dststride, src, srcstride, width, height, mx, srcp, dstp, x
+    LOAD_EPEL_TAPS  %1, mx, srcpq
+%else
+cglobal hevc_put_epel_h_%1, 4, 7, 8, dst, dststride, src, srcstride, srcp, dstp, x
+    DIMS_ON_STACK    4, 5
+    mov             xd, r6m
+    LOAD_EPEL_TAPS  %1, x, srcpq
+%endif
+    add     dststrideq, dststrideq
+    MC_LOOP {EPEL_H %1}, mmsize / 2 * ((%1 + 7) / 8), srcq, srcstrideq, dstq, dststrideq, heightd
+    RET
+
+%if ARCH_X86_64
+cglobal hevc_put_epel_v_%1, 8, 12, 10, dst, dststride, src, srcstride, width, height, mx, my, srcp, dstp, x, s3
+    LOAD_EPEL_TAPS  %1, my, srcpq
+    add     dststrideq, dststrideq
+    lea            s3q, [srcstrideq * 3]
+    sub           srcq, srcstrideq
+    MC_LOOP {EPEL_V %1}, mmsize / 2 * ((%1 + 7) / 8), srcq, srcstrideq, dstq, dststrideq, heightd
+%else
+cglobal hevc_put_epel_v_%1, 4, 7, 8, dst, dststride, src, srcstride, srcp, dstp, x
+    DIMS_ON_STACK    4, 5
+    mov             xd, r7m
+    LOAD_EPEL_TAPS  %1, x, srcpq
+    add     dststrideq, dststrideq
+    mov             r1m, dststrideq
+    sub           srcq, srcstrideq
+    DEFINE_ARGS dst, s3, src, srcstride, srcp, dstp, x
+    lea            s3q, [srcstrideq * 3]
+    MC_LOOP {EPEL_V %1}, mmsize / 2 * ((%1 + 7) / 8), srcq, srcstrideq, dstq, r1m, heightd
+%endif
+    RET
+
+%if ARCH_X86_64
+cglobal hevc_put_epel_hv_%1, 9, 14, 10, dst, dststride, src, srcstride, width, height, mx, my, mcbuf, srcp, dstp, x, tmp, rows
+    LOAD_EPEL_TAPS  %1, mx, srcpq
+    sub           srcq, srcstrideq
+    lea          rowsd, [heightq + 3]
+    mov           tmpq, mcbufq
+%else
+cglobal hevc_put_epel_hv_%1, 4, 7, 8, dst, dststride, src, srcstride, srcp, dstp, x
+    DIMS_ON_STACK    4, 5
+    mov             xd, r6m
+    LOAD_EPEL_TAPS  %1, x, srcpq
+    DEFINE_ARGS tmp, rows, src, srcstride, srcp, dstp, x
+    sub           srcq, srcstrideq
+    mov          rowsd, heightd
+    add          rowsd, 3
+    mov           tmpq, r8m
+%endif
+    MC_LOOP {EPEL_H %1}, mmsize / 2 * ((%1 + 7) / 8), srcq, srcstrideq, tmpq, 128, rowsd
+
+%if ARCH_X86_64
+    LOAD_EPEL_TAPS   0, my, srcpq
+%else
+    mov             xd, r7m
+    LOAD_EPEL_TAPS   0, x, srcpq
+    DEFINE_ARGS dst, dststride, mcbuf, srcstride, srcp, dstp, x
+    mov           dstq, r0m
+    mov     dststrideq, r1m
+    mov         mcbufq, r8m
+%endif
+    add     dststrideq, dststrideq
+    MC_LOOP {EPEL_V 0}, mmsize, mcbufq, 128, dstq, dststrideq, heightd
+    RET
+%endmacro
+
+%macro HEVC_MC 1 ; bit depth
+HEVC_PIXELS qpel, %1
+HEVC_PIXELS epel, %1
+HEVC_QPEL_H  %1, 1
+HEVC_QPEL_H  %1, 2
+HEVC_QPEL_H  %1, 3
+HEVC_QPEL_V  %1, 1
+HEVC_QPEL_V  %1, 2
+HEVC_QPEL_V  %1, 3
+HEVC_QPEL_HV %1, 1, 1
+HEVC_QPEL_HV %1, 1, 2
+HEVC_QPEL_HV %1, 1, 3
+HEVC_QPEL_HV %1, 2, 1
+HEVC_QPEL_HV %1, 2, 2
+HEVC_QPEL_HV %1, 2, 3
+HEVC_QPEL_HV %1, 3, 1
+HEVC_QPEL_HV %1, 3, 2
+HEVC_QPEL_HV %1, 3, 3
+HEVC_EPEL    %1
+%endmacro
+
+INIT_XMM ssse3
+HEVC_MC 8
+INIT_XMM sse2
+HEVC_MC 10
+INIT_XMM sse4
+HEVC_MC 8
+HEVC_MC 10
+%if HAVE_AVX2_EXTERNAL && ARCH_X86_64
+INIT_YMM avx2
+HEVC_MC 8
+HEVC_MC 10
+%endif
+
+; The rounding shifts of the prediction are done by pmulhrsw, which also
+; gives the right result where the saturating add of bi-prediction clips.
+%macro UNI_PRED 1 ; bit depth
+    movu            m4, [srcpq]
+    pmulhrsw        m4, m6
+%if %1 == 8
+    packuswb        m4, m4
+%else
+    CLIPW           m4, m7, [pw_pixel_max]
+%endif
+%endmacro
+
+%macro BI_PRED 1
+    movu            m4, [srcpq]
+    movu            m0, [srcpq + src2q]
+    paddsw          m4, m0
+    pmulhrsw        m4, m6
+%if %1 == 8
+    packuswb        m4, m4
+%else
+    CLIPW           m4, m7, [pw_pixel_max]
+%endif
+%endmacro
+
+%macro HEVC_PRED 1 ; bit depth
+; void put_unweighted_pred(uint8_t *dst, ptrdiff_t dststride, int16_t *src,
+;                          ptrdiff_t srcstride, int width, int height)
+%if ARCH_X86_64
+cglobal hevc_put_unweighted_pred_%1, 6, 9, 8, dst, dststride, src, srcstride, width, height, srcp, dstp, x
+%else
+cglobal hevc_put_unweighted_pred_%1, 4, 7, 8, dst, dststride, src, srcstride, srcp, dstp, x
+    DIMS_ON_STACK    4, 5
+%endif
+    add     srcstrideq, srcstrideq
+%if %1 == 8
+    mova            m6, [pw_512]
+%else
+    mova            m6, [pw_2048]
+    pxor            m7, m7
+%endif
+    MC_LOOP {UNI_PRED %1}, 16, srcq, srcstrideq, dstq, dststrideq, heightd, (%1 + 7) / 8
+    RET
+
+; void put_weighted_pred_avg(uint8_t *dst, ptrdiff_t dststride,
+;                            int16_t *src1, int16_t *src2,
+;                            ptrdiff_t srcstride, int width, int height)
+%if ARCH_X86_64
+cglobal hevc_put_weighted_pred_avg_%1, 7, 10, 8, dst, dststride, src, src2, srcstride, width, height, srcp, dstp, x
+    add     srcstrideq, srcstrideq
+    sub          src2q, srcq
+%else
+cglobal hevc_put_weighted_pred_avg_%1, 5, 7, 8, dst, dststride, src, src2, srcstride, srcp, dstp
+    DIMS_ON_STACK    5, 6
+    add     srcstrideq, srcstrideq
+    sub          src2q, srcq
+    DEFINE_ARGS dst, x, src, src2, srcstride, srcp, dstp
+%endif
+%if %1 == 8
+    mova            m6, [pw_256]
+%else
+    mova            m6, [pw_1024]
+    pxor            m7, m7
+%endif
+%if ARCH_X86_64
+    MC_LOOP {BI_PRED %1}, 16, srcq, srcstrideq, dstq, dststrideq, heightd, (%1 + 7) / 8
+%else
+    MC_LOOP {BI_PRED %1}, 16, srcq, srcstrideq, dstq, r1m, heightd, (%1 + 7) / 8
+%endif
+    RET
+%endmacro
+
+INIT_XMM ssse3
+HEVC_PRED 8
+HEVC_PRED 10
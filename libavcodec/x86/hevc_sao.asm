@@ -0,0 +1,227 @@
+;******************************************************************************
+;* SIMD-optimized HEVC sample adaptive offset
+;*
+;* This file is part of Libav.
+;*
+;* Libav is free software; you can redistribute it and/or
+;* modify it under the terms of the GNU Lesser General Public
+;* License as published by the Free Software Foundation; either
+;* version 2.1 of the License, or (at your option) any later version.
+;*
+;* Libav is distributed in the hope that it will be useful,
+;* but WITHOUT ANY WARRANTY; without even the implied warranty of
+;* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+;* Lesser General Public License for more details.
+;*
+;* You should have received a copy of the GNU Lesser General Public
+;* License along with Libav; if not, write to the Free Software
+;* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+;******************************************************************************
+
+%include "libavutil/x86/x86util.asm"
+
+SECTION_RODATA
+
+pb_2:         times 16 db 2
+pb_10:        times 16 db 0x10
+pb_1f:        times 16 db 0x1f
+pb_70:        times 16 db 0x70
+pw_2:         times 8 dw 2
+pw_pixel_max: times 8 dw ((1 << 10)-1)
+
+cextern pb_80
+
+SECTION .text
+
+%if ARCH_X86_64
+
+; Stores the first xd pixels of m0 at dstpq, %1 is the pixel size
+%macro STORE_PARTIAL 1
+    cmp             xd, 8 / %1
+    jl %%dword
+    movh      [dstpq], m0
+    psrldq          m0, 8
+    add          dstpq, 8
+    sub             xd, 8 / %1
+%%dword:
+    cmp             xd, 4 / %1
+    jl %%word
+    movd      [dstpq], m0
+    psrldq          m0, 4
+    add          dstpq, 4
+    sub             xd, 4 / %1
+%%word:
+%if %1 == 1
+    movd          srcpd, m0
+    cmp             xd, 2
+    jl %%byte
+    mov       [dstpq], srcpw
+    shr          srcpd, 16
+    add          dstpq, 2
+    sub             xd, 2
+%%byte:
+    test            xd, xd
+    jz %%end
+    mov       [dstpq], srcpb
+%else
+    test            xd, xd
+    jz %%end
+    movd          srcpd, m0
+    mov       [dstpq], srcpw
+%endif
+%%end:
+%endmacro
+
+; Runs %1 over a block, filtering 16 bytes of m0 in place at a time.
+; %2: pixel size
+%macro SAO_LOOP 2
+.loop_y:
+    mov          srcpq, srcq
+    mov          dstpq, dstq
+    mov             xd, widthd
+.loop_x:
+    movu            m0, [srcpq]
+    %1
+    cmp             xd, 16 / %2
+    jl .tail
+    movu      [dstpq], m0
+    add          srcpq, 16
+    add          dstpq, 16
+    sub             xd, 16 / %2
+    jg .loop_x
+    jmp .next
+.tail:
+    STORE_PARTIAL   %2
+.next:
+    add           srcq, strideq
+    add           dstq, strideq
+    dec        heightd
+    jg .loop_y
+%endmacro
+
+; adds the signed bytes in m1 to the pixels in m0 with unsigned saturation
+%macro ADD_OFFSETS_8 0
+    pxor            m0, m7
+    paddsb          m0, m1
+    pxor            m0, m7
+%endmacro
+
+; the offsets in m1 as bytes, index 0x70 + band in m2 for bands 0-15 and
+; 0x70 + band - 16 in m3 for bands 16-31, so that pshufb zeroes the rest
+%macro BAND_LOOKUP 0
+    mova            m3, m2
+    pxor            m3, [pb_10]
+    paddb           m2, [pb_70]
+    paddb           m3, [pb_70]
+    mova            m1, m5
+    pshufb          m1, m2
+    mova            m2, m6
+    pshufb          m2, m3
+    por             m1, m2
+%endmacro
+
+%macro BAND_8 0
+    mova            m2, m0
+    psrlw           m2, 3
+    pand            m2, [pb_1f]
+    BAND_LOOKUP
+    ADD_OFFSETS_8
+%endmacro
+
+%macro BAND_10 0
+    mova            m2, m0
+    psrlw           m2, 5
+    packuswb        m2, m2
+    BAND_LOOKUP
+    punpcklbw       m1, m1
+    psraw           m1, 8
+    paddw           m0, m1
+    CLIPW           m0, m4, [pw_pixel_max]
+%endmacro
+
+; void sao_band_filter(uint8_t *dst, uint8_t *src, ptrdiff_t stride,
+;                      const int8_t *offset_table, int width, int height)
+%macro SAO_BAND 1 ; bit depth
+cglobal hevc_sao_band_filter_%1, 6, 9, 8, dst, src, stride, table, width, height, srcp, dstp, x
+    movu            m5, [tableq]
+    movu            m6, [tableq + 16]
+%if %1 == 8
+    mova            m7, [pb_80]
+    SAO_LOOP   BAND_8, 1
+%else
+    pxor            m4, m4
+    SAO_LOOP  BAND_10, 2
+%endif
+    RET
+%endmacro
+
+; the edge index 2 + sign(src - a) + sign(src - b), looked up in m6
+%macro EDGE_8 0
+    movu            m1, [srcpq + aq]
+    movu            m2, [srcpq + bq]
+    pxor            m0, m7
+    pxor            m1, m7
+    pxor            m2, m7
+    mova            m3, m0
+    mova            m4, m0
+    pcmpgtb         m3, m1
+    pcmpgtb         m4, m2
+    pcmpgtb         m1, m0
+    pcmpgtb         m2, m0
+    psubb           m1, m3
+    psubb           m2, m4
+    paddb           m1, m2
+    paddb           m1, m5
+    mova            m2, m6
+    pshufb          m2, m1
+    paddsb          m0, m2
+    pxor            m0, m7
+%endmacro
+
+%macro EDGE_10 0
+    movu            m1, [srcpq + aq]
+    movu            m2, [srcpq + bq]
+    mova            m3, m0
+    mova            m4, m0
+    pcmpgtw         m3, m1
+    pcmpgtw         m4, m2
+    pcmpgtw         m1, m0
+    pcmpgtw         m2, m0
+    psubw           m1, m3
+    psubw           m2, m4
+    paddw           m1, m2
+    paddw           m1, m5
+    packsswb        m1, m1
+    mova            m2, m6
+    pshufb          m2, m1
+    punpcklbw       m2, m2
+    psraw           m2, 8
+    paddw           m0, m2
+    pxor            m4, m4
+    CLIPW           m0, m4, [pw_pixel_max]
+%endmacro
+
+; void sao_edge_filter(uint8_t *dst, uint8_t *src, ptrdiff_t stride,
+;                      const int8_t *offset_table, ptrdiff_t a, ptrdiff_t b,
+;                      int width, int height)
+%macro SAO_EDGE 1
+cglobal hevc_sao_edge_filter_%1, 8, 11, 8, dst, src, stride, table, a, b, width, height, srcp, dstp, x
+    movq            m6, [tableq]
+%if %1 == 8
+    mova            m5, [pb_2]
+    mova            m7, [pb_80]
+    SAO_LOOP   EDGE_8, 1
+%else
+    mova            m5, [pw_2]
+    SAO_LOOP  EDGE_10, 2
+%endif
+    RET
+%endmacro
+
+INIT_XMM ssse3
+SAO_BAND 8
+SAO_BAND 10
+SAO_EDGE 8
+SAO_EDGE 10
+
+%endif ; ARCH_X86_64
@@ -45,6 +45,131 @@ LFC_FUNCS(uint8_t, 10)
 LFL_FUNCS(uint8_t, 8)
 LFL_FUNCS(uint8_t, 10)
 
+#define QPEL_FUNC(NAME, DEPTH, OPT) \
+void ff_hevc_put_qpel_ ## NAME ## _ ## DEPTH ## _ ## OPT(int16_t *dst, ptrdiff_t dststride, uint8_t *src, ptrdiff_t srcstride, int width, int height, int16_t *mcbuffer);
+
+#define EPEL_FUNC(NAME, DEPTH, OPT) \
+void ff_hevc_put_epel_ ## NAME ## _ ## DEPTH ## _ ## OPT(int16_t *dst, ptrdiff_t dststride, uint8_t *src, ptrdiff_t srcstride, int width, int height, int mx, int my, int16_t *mcbuffer);
+
+#define MC_FUNCS(depth, opt)     \
+    QPEL_FUNC(pixels, depth, opt) \
+    QPEL_FUNC(h1,     depth, opt) \
+    QPEL_FUNC(h2,     depth, opt) \
+    QPEL_FUNC(h3,     depth, opt) \
+    QPEL_FUNC(v1,     depth, opt) \
+    QPEL_FUNC(v2,     depth, opt) \
+    QPEL_FUNC(v3,     depth, opt) \
+    QPEL_FUNC(h1v1,   depth, opt) \
+    QPEL_FUNC(h1v2,   depth, opt) \
+    QPEL_FUNC(h1v3,   depth, opt) \
+    QPEL_FUNC(h2v1,   depth, opt) \
+    QPEL_FUNC(h2v2,   depth, opt) \
+    QPEL_FUNC(h2v3,   depth, opt) \
+    QPEL_FUNC(h3v1,   depth, opt) \
+    QPEL_FUNC(h3v2,   depth, opt) \
+    QPEL_FUNC(h3v3,   depth, opt) \
+    EPEL_FUNC(pixels, depth, opt) \
+    EPEL_FUNC(h,      depth, opt) \
+    EPEL_FUNC(v,      depth, opt) \
+    EPEL_FUNC(hv,     depth, opt)
+
+#define PRED_FUNCS(depth, opt) \
+void ff_hevc_put_unweighted_pred_ ## depth ## _ ## opt(uint8_t *dst, ptrdiff_t dststride, int16_t *src, ptrdiff_t srcstride, int width, int height); \
+void ff_hevc_put_weighted_pred_avg_ ## depth ## _ ## opt(uint8_t *dst, ptrdiff_t dststride, int16_t *src1, int16_t *src2, ptrdiff_t srcstride, int width, int height);
+
+#define IDCT_FUNC(NAME, DEPTH, OPT) \
+void ff_hevc_transform_ ## NAME ## _add_ ## DEPTH ## _ ## OPT(uint8_t *dst, int16_t *coeffs, ptrdiff_t stride);
+
+#define IDCT_FUNCS(depth, opt)      \
+    IDCT_FUNC(4x4_luma, depth, opt) \
+    IDCT_FUNC(4x4,      depth, opt) \
+    IDCT_FUNC(8x8,      depth, opt) \
+    IDCT_FUNC(16x16,    depth, opt) \
+    IDCT_FUNC(32x32,    depth, opt)
+
+#define SAO_FUNCS(depth, opt) \
+void ff_hevc_sao_band_filter_ ## depth ## _ ## opt(uint8_t *dst, uint8_t *src, ptrdiff_t stride, const int8_t *offset_table, int width, int height); \
+void ff_hevc_sao_edge_filter_ ## depth ## _ ## opt(uint8_t *dst, uint8_t *src, ptrdiff_t stride, const int8_t *offset_table, ptrdiff_t a, ptrdiff_t b, int width, int height); \
+                                                                               \
+static void sao_band_filter_0_ ## depth ## _ ## opt(uint8_t *dst, uint8_t *src, \
+                                                    ptrdiff_t stride,          \
+                                                    SAOParams *sao,            \
+                                                    int *borders, int width,   \
+                                                    int height, int c_idx)     \
+{                                                                              \
+    ff_hevc_sao_band_filter_0(dst, src, stride, sao, borders, width, height,   \
+                              c_idx, ff_hevc_sao_band_filter_ ## depth ## _ ## opt); \
+}                                                                              \
+                                                                               \
+static void sao_edge_filter_0_ ## depth ## _ ## opt(uint8_t *dst, uint8_t *src, \
+                                                    ptrdiff_t stride,          \
+                                                    SAOParams *sao,            \
+                                                    int *borders, int width,   \
+                                                    int height, int c_idx,     \
+                                                    uint8_t vert_edge,         \
+                                                    uint8_t horiz_edge,        \
+                                                    uint8_t diag_edge)         \
+{                                                                              \
+    ff_hevc_sao_edge_filter_0(dst, src, stride, sao, borders, width, height,   \
+                              c_idx, vert_edge, horiz_edge, diag_edge,         \
+                              depth > 8,                                       \
+                              ff_hevc_sao_edge_filter_ ## depth ## _ ## opt);  \
+}
+
+MC_FUNCS(8,  ssse3)
+MC_FUNCS(10, sse2)
+MC_FUNCS(8,  sse4)
+MC_FUNCS(10, sse4)
+MC_FUNCS(8,  avx2)
+MC_FUNCS(10, avx2)
+PRED_FUNCS(8,  ssse3)
+PRED_FUNCS(10, ssse3)
+IDCT_FUNCS(8,  sse2)
+IDCT_FUNCS(10, sse2)
+IDCT_FUNC(32x32, 8,  sse4)
+IDCT_FUNC(32x32, 10, sse4)
+IDCT_FUNC(32x32, 8,  avx2)
+IDCT_FUNC(32x32, 10, avx2)
+SAO_FUNCS(8,  ssse3)
+SAO_FUNCS(10, ssse3)
+
+#define MC_INIT(depth, opt)                                                    \
+    c->put_hevc_qpel[0][0] = ff_hevc_put_qpel_pixels_ ## depth ## _ ## opt;   \
+    c->put_hevc_qpel[0][1] = ff_hevc_put_qpel_h1_     ## depth ## _ ## opt;   \
+    c->put_hevc_qpel[0][2] = ff_hevc_put_qpel_h2_     ## depth ## _ ## opt;   \
+    c->put_hevc_qpel[0][3] = ff_hevc_put_qpel_h3_     ## depth ## _ ## opt;   \
+    c->put_hevc_qpel[1][0] = ff_hevc_put_qpel_v1_     ## depth ## _ ## opt;   \
+    c->put_hevc_qpel[1][1] = ff_hevc_put_qpel_h1v1_   ## depth ## _ ## opt;   \
+    c->put_hevc_qpel[1][2] = ff_hevc_put_qpel_h2v1_   ## depth ## _ ## opt;   \
+    c->put_hevc_qpel[1][3] = ff_hevc_put_qpel_h3v1_   ## depth ## _ ## opt;   \
+    c->put_hevc_qpel[2][0] = ff_hevc_put_qpel_v2_     ## depth ## _ ## opt;   \
+    c->put_hevc_qpel[2][1] = ff_hevc_put_qpel_h1v2_   ## depth ## _ ## opt;   \
+    c->put_hevc_qpel[2][2] = ff_hevc_put_qpel_h2v2_   ## depth ## _ ## opt;   \
+    c->put_hevc_qpel[2][3] = ff_hevc_put_qpel_h3v2_   ## depth ## _ ## opt;   \
+    c->put_hevc_qpel[3][0] = ff_hevc_put_qpel_v3_     ## depth ## _ ## opt;   \
+    c->put_hevc_qpel[3][1] = ff_hevc_put_qpel_h1v3_   ## depth ## _ ## opt;   \
+    c->put_hevc_qpel[3][2] = ff_hevc_put_qpel_h2v3_   ## depth ## _ ## opt;   \
+    c->put_hevc_qpel[3][3] = ff_hevc_put_qpel_h3v3_   ## depth ## _ ## opt;   \
+    c->put_hevc_epel[0][0] = ff_hevc_put_epel_pixels_ ## depth ## _ ## opt;   \
+    c->put_hevc_epel[0][1] = ff_hevc_put_epel_h_      ## depth ## _ ## opt;   \
+    c->put_hevc_epel[1][0] = ff_hevc_put_epel_v_      ## depth ## _ ## opt;   \
+    c->put_hevc_epel[1][1] = ff_hevc_put_epel_hv_     ## depth ## _ ## opt
+
+#define PRED_INIT(depth, opt)                                                  \
+    c->put_unweighted_pred   = ff_hevc_put_unweighted_pred_   ## depth ## _ ## opt; \
+    c->put_weighted_pred_avg = ff_hevc_put_weighted_pred_avg_ ## depth ## _ ## opt
+
+#define IDCT_INIT(depth, opt)                                                  \
+    c->transform_4x4_luma_add = ff_hevc_transform_4x4_luma_add_ ## depth ## _ ## opt; \
+    c->transform_add[0]       = ff_hevc_transform_4x4_add_      ## depth ## _ ## opt; \
+    c->transform_add[1]       = ff_hevc_transform_8x8_add_      ## depth ## _ ## opt; \
+    c->transform_add[2]       = ff_hevc_transform_16x16_add_    ## depth ## _ ## opt; \
+    c->transform_add[3]       = ff_hevc_transform_32x32_add_    ## depth ## _ ## opt
+
+#define SAO_INIT(depth, opt)                                                   \
+    c->sao_band_filter[0] = sao_band_filter_0_ ## depth ## _ ## opt;          \
+    c->sao_edge_filter[0] = sao_edge_filter_0_ ## depth ## _ ## opt
+
 void ff_hevc_dsp_init_x86(HEVCDSPContext *c, const int bit_depth)
 {
     int cpu_flags = av_get_cpu_flags();
@@ -53,19 +178,47 @@ void ff_hevc_dsp_init_x86(HEVCDSPContext *c, const int bit_depth)
         if (EXTERNAL_SSE2(cpu_flags)) {
             c->hevc_v_loop_filter_chroma = ff_hevc_v_loop_filter_chroma_8_sse2;
             c->hevc_h_loop_filter_chroma = ff_hevc_h_loop_filter_chroma_8_sse2;
+            IDCT_INIT(8, sse2);
+        }
+        if (EXTERNAL_SSSE3(cpu_flags)) {
+            MC_INIT(8, ssse3);
+            PRED_INIT(8, ssse3);
         }
         if (EXTERNAL_SSSE3(cpu_flags) && ARCH_X86_64) {
             c->hevc_v_loop_filter_luma = ff_hevc_v_loop_filter_luma_8_ssse3;
             c->hevc_h_loop_filter_luma = ff_hevc_h_loop_filter_luma_8_ssse3;
+            SAO_INIT(8, ssse3);
+        }
+        if (EXTERNAL_SSE4(cpu_flags)) {
+            MC_INIT(8, sse4);
+            c->transform_add[3] = ff_hevc_transform_32x32_add_8_sse4;
+        }
+        if (EXTERNAL_AVX2(cpu_flags) && ARCH_X86_64) {
+            MC_INIT(8, avx2);
+            c->transform_add[3] = ff_hevc_transform_32x32_add_8_avx2;
         }
     } else if (bit_depth == 10) {
         if (EXTERNAL_SSE2(cpu_flags)) {
             c->hevc_v_loop_filter_chroma = ff_hevc_v_loop_filter_chroma_10_sse2;
             c->hevc_h_loop_filter_chroma = ff_hevc_h_loop_filter_chroma_10_sse2;
+            MC_INIT(10, sse2);
+            IDCT_INIT(10, sse2);
+        }
+        if (EXTERNAL_SSSE3(cpu_flags)) {
+            PRED_INIT(10, ssse3);
         }
         if (EXTERNAL_SSSE3(cpu_flags) && ARCH_X86_64) {
             c->hevc_v_loop_filter_luma = ff_hevc_v_loop_filter_luma_10_ssse3;
             c->hevc_h_loop_filter_luma = ff_hevc_h_loop_filter_luma_10_ssse3;
+            SAO_INIT(10, ssse3);
+        }
+        if (EXTERNAL_SSE4(cpu_flags)) {
+            MC_INIT(10, sse4);
+            c->transform_add[3] = ff_hevc_transform_32x32_add_10_sse4;
+        }
+        if (EXTERNAL_AVX2(cpu_flags) && ARCH_X86_64) {
+            MC_INIT(10, avx2);
+            c->transform_add[3] = ff_hevc_transform_32x32_add_10_avx2;
         }
     }
 }
@@ -0,0 +1,48 @@
+/*
+ * This file is part of Libav.
+ *
+ * Libav is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * Libav is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Libav; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "libavutil/attributes.h"
+#include "libavfilter/vf_hqdn3d.h"
+
+void ff_hqdn3d_row_8_aarch64(uint8_t *src, uint8_t *dst,
+                             uint16_t *line_ant, uint16_t *frame_ant,
+                             ptrdiff_t w, int16_t *spatial,
+                             int16_t *temporal);
+void ff_hqdn3d_row_9_aarch64(uint8_t *src, uint8_t *dst,
+                             uint16_t *line_ant, uint16_t *frame_ant,
+                             ptrdiff_t w, int16_t *spatial,
+                             int16_t *temporal);
+void ff_hqdn3d_row_10_aarch64(uint8_t *src, uint8_t *dst,
+                              uint16_t *line_ant, uint16_t *frame_ant,
+                              ptrdiff_t w, int16_t *spatial,
+                              int16_t *temporal);
+void ff_hqdn3d_row_16_aarch64(uint8_t *src, uint8_t *dst,
+                              uint16_t *line_ant, uint16_t *frame_ant,
+                              ptrdiff_t w, int16_t *spatial,
+                              int16_t *temporal);
+
+av_cold void ff_hqdn3d_init_aarch64(HQDN3DContext *hqdn3d)
+{
+    hqdn3d->denoise_row[8]  = ff_hqdn3d_row_8_aarch64;
+    hqdn3d->denoise_row[9]  = ff_hqdn3d_row_9_aarch64;
+    hqdn3d->denoise_row[10] = ff_hqdn3d_row_10_aarch64;
+    hqdn3d->denoise_row[16] = ff_hqdn3d_row_16_aarch64;
+}
@@ -217,6 +217,10 @@ static av_cold void volume_init(VolumeContext *vol)
         break;
     }
 
+    if (ARCH_AARCH64)
+        ff_volume_init_aarch64(vol);
+    if (ARCH_ARM)
+        ff_volume_init_arm(vol);
     if (ARCH_X86)
         ff_volume_init_x86(vol);
 }
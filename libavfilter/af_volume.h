@@ -60,6 +60,8 @@ typedef struct VolumeContext {
     int samples_align;
 } VolumeContext;
 
+void ff_volume_init_aarch64(VolumeContext *vol);
+void ff_volume_init_arm(VolumeContext *vol);
 void ff_volume_init_x86(VolumeContext *vol);
 
 #endif /* AVFILTER_AF_VOLUME_H */
@@ -0,0 +1,53 @@
+/*
+ * This file is part of Libav.
+ *
+ * Libav is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * Libav is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Libav; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <stdint.h>
+
+#include "libavutil/attributes.h"
+#include "libavutil/cpu.h"
+#include "libavutil/arm/cpu.h"
+#include "libavfilter/gradfun.h"
+
+void ff_gradfun_filter_line_neon(uint8_t *dst, uint8_t *src, uint16_t *dc,
+                                 int width, int thresh,
+                                 const uint16_t *dithers);
+void ff_gradfun_blur_line_neon(uint16_t *dc, uint16_t *buf, uint16_t *buf1,
+                               uint8_t *src, int src_linesize, int width);
+
+static void gradfun_filter_line_neon(uint8_t *dst, uint8_t *src, uint16_t *dc,
+                                     int width, int thresh,
+                                     const uint16_t *dithers)
+{
+    if (width & 7) {
+        int x = width & ~7;
+        ff_gradfun_filter_line_c(dst + x, src + x, dc + x / 2,
+                                 width - x, thresh, dithers);
+        width = x;
+    }
+    ff_gradfun_filter_line_neon(dst, src, dc, width, thresh, dithers);
+}
+
+av_cold void ff_gradfun_init_arm(GradFunContext *gf)
+{
+    int cpu_flags = av_get_cpu_flags();
+
+    if (have_neon(cpu_flags)) {
+        gf->filter_line = gradfun_filter_line_neon;
+        gf->blur_line   = ff_gradfun_blur_line_neon;
+    }
+}
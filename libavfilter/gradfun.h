@@ -33,12 +33,15 @@ typedef struct GradFunContext {
     int chroma_w;  ///< width of the chroma planes
     int chroma_h;  ///< weight of the chroma planes
     int chroma_r;  ///< blur radius for the chroma planes
-    uint16_t *buf; ///< holds image data for blur algorithm passed into filter.
+    uint16_t *buf; ///< holds image data for blur algorithm passed into filter, one chunk per plane
+    int buf_size;  ///< number of elements in each plane's chunk of buf
     /// DSP functions.
     void (*filter_line) (uint8_t *dst, uint8_t *src, uint16_t *dc, int width, int thresh, const uint16_t *dithers);
     void (*blur_line) (uint16_t *dc, uint16_t *buf, uint16_t *buf1, uint8_t *src, int src_linesize, int width);
 } GradFunContext;
 
+void ff_gradfun_init_aarch64(GradFunContext *gf);
+void ff_gradfun_init_arm(GradFunContext *gf);
 void ff_gradfun_init_x86(GradFunContext *gf);
 
 void ff_gradfun_filter_line_c(uint8_t *dst, uint8_t *src, uint16_t *dc, int width, int thresh, const uint16_t *dithers);
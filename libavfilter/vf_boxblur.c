@@ -72,7 +72,9 @@ typedef struct BoxBlurContext {
     int hsub, vsub;
     int radius[4];
     int power[4];
-    uint8_t *temp[2]; ///< temporary buffer used in blur_power()
+    uint8_t *temp[2]; ///< temporary buffers used in blur_power(), one line per thread
+    int temp_size;    ///< size of one thread's line in temp
+    int nb_threads;
 } BoxBlurContext;
 
 #define Y 0
@@ -139,11 +141,14 @@ static int config_input(AVFilterLink *inlink)
     char *expr;
     int ret;
 
+    s->nb_threads = FFMAX(1, ctx->graph->nb_threads);
+    s->temp_size  = FFMAX(w, h);
+
     av_freep(&s->temp[0]);
     av_freep(&s->temp[1]);
-    if (!(s->temp[0] = av_malloc(FFMAX(w, h))))
+    if (!(s->temp[0] = av_malloc_array(s->nb_threads, s->temp_size)))
        return AVERROR(ENOMEM);
-    if (!(s->temp[1] = av_malloc(FFMAX(w, h)))) {
+    if (!(s->temp[1] = av_malloc_array(s->nb_threads, s->temp_size))) {
         av_freep(&s->temp[0]);
         return AVERROR(ENOMEM);
     }
@@ -273,41 +278,89 @@ static inline void blur_power(uint8_t *dst, int dst_step, const uint8_t *src, in
 }
 
 static void hblur(uint8_t *dst, int dst_linesize, const uint8_t *src, int src_linesize,
-                  int w, int h, int radius, int power, uint8_t *temp[2])
+                  int w, int y0, int y1, int radius, int power, uint8_t *temp[2])
 {
     int y;
 
     if (radius == 0 && dst == src)
         return;
 
-    for (y = 0; y < h; y++)
+    for (y = y0; y < y1; y++)
         blur_power(dst + y*dst_linesize, 1, src + y*src_linesize, 1,
                    w, radius, power, temp);
 }
 
 static void vblur(uint8_t *dst, int dst_linesize, const uint8_t *src, int src_linesize,
-                  int w, int h, int radius, int power, uint8_t *temp[2])
+                  int x0, int x1, int h, int radius, int power, uint8_t *temp[2])
 {
     int x;
 
     if (radius == 0 && dst == src)
         return;
 
-    for (x = 0; x < w; x++)
+    for (x = x0; x < x1; x++)
         blur_power(dst + x, dst_linesize, src + x, src_linesize,
                    h, radius, power, temp);
 }
 
+typedef struct ThreadData {
+    AVFrame *in, *out;
+    int w[4], h[4];
+} ThreadData;
+
+/* horizontal pass, each job takes a band of rows */
+static int hblur_slice(AVFilterContext *ctx, void *arg, int jobnr, int nb_jobs)
+{
+    BoxBlurContext *s = ctx->priv;
+    ThreadData *td = arg;
+    uint8_t *temp[2] = { s->temp[0] + jobnr * s->temp_size,
+                         s->temp[1] + jobnr * s->temp_size };
+    int plane;
+
+    for (plane = 0; td->in->data[plane] && plane < 4; plane++) {
+        int h = td->h[plane];
+        int slice_start = (h *  jobnr)      / nb_jobs;
+        int slice_end   = (h * (jobnr + 1)) / nb_jobs;
+
+        hblur(td->out->data[plane], td->out->linesize[plane],
+              td->in ->data[plane], td->in ->linesize[plane],
+              td->w[plane], slice_start, slice_end,
+              s->radius[plane], s->power[plane], temp);
+    }
+    return 0;
+}
+
+/* vertical pass in place, each job takes a band of columns */
+static int vblur_slice(AVFilterContext *ctx, void *arg, int jobnr, int nb_jobs)
+{
+    BoxBlurContext *s = ctx->priv;
+    ThreadData *td = arg;
+    uint8_t *temp[2] = { s->temp[0] + jobnr * s->temp_size,
+                         s->temp[1] + jobnr * s->temp_size };
+    int plane;
+
+    for (plane = 0; td->in->data[plane] && plane < 4; plane++) {
+        int w = td->w[plane];
+        int slice_start = (w *  jobnr)      / nb_jobs;
+        int slice_end   = (w * (jobnr + 1)) / nb_jobs;
+
+        vblur(td->out->data[plane], td->out->linesize[plane],
+              td->out->data[plane], td->out->linesize[plane],
+              slice_start, slice_end, td->h[plane],
+              s->radius[plane], s->power[plane], temp);
+    }
+    return 0;
+}
+
 static int filter_frame(AVFilterLink *inlink, AVFrame *in)
 {
     AVFilterContext *ctx = inlink->dst;
     BoxBlurContext *s = ctx->priv;
     AVFilterLink *outlink = inlink->dst->outputs[0];
     AVFrame *out;
-    int plane;
+    ThreadData td;
     int cw = inlink->w >> s->hsub, ch = in->height >> s->vsub;
-    int w[4] = { inlink->w, cw, cw, inlink->w };
-    int h[4] = { in->height, ch, ch, in->height };
+    int nb_jobs = FFMIN(s->nb_threads, FFMIN(cw, ch));
 
     out = ff_get_video_buffer(outlink, outlink->w, outlink->h);
     if (!out) {
@@ -316,17 +369,15 @@ static int filter_frame(AVFilterLink *inlink, AVFrame *in)
     }
     av_frame_copy_props(out, in);
 
-    for (plane = 0; in->data[plane] && plane < 4; plane++)
-        hblur(out->data[plane], out->linesize[plane],
-              in ->data[plane], in ->linesize[plane],
-              w[plane], h[plane], s->radius[plane], s->power[plane],
-              s->temp);
+    td.in   = in;
+    td.out  = out;
+    td.w[0] = td.w[3] = inlink->w;
+    td.w[1] = td.w[2] = cw;
+    td.h[0] = td.h[3] = in->height;
+    td.h[1] = td.h[2] = ch;
 
-    for (plane = 0; in->data[plane] && plane < 4; plane++)
-        vblur(out->data[plane], out->linesize[plane],
-              out->data[plane], out->linesize[plane],
-              w[plane], h[plane], s->radius[plane], s->power[plane],
-              s->temp);
+    ctx->internal->execute(ctx, hblur_slice, &td, NULL, FFMAX(nb_jobs, 1));
+    ctx->internal->execute(ctx, vblur_slice, &td, NULL, FFMAX(nb_jobs, 1));
 
     av_frame_free(&in);
 
@@ -384,4 +435,5 @@ AVFilter ff_vf_boxblur = {
 
     .inputs    = avfilter_vf_boxblur_inputs,
     .outputs   = avfilter_vf_boxblur_outputs,
+    .flags     = AVFILTER_FLAG_SLICE_THREADS,
 };
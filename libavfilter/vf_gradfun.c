@@ -79,13 +79,13 @@ void ff_gradfun_blur_line_c(uint16_t *dc, uint16_t *buf, uint16_t *buf1, uint8_t
     }
 }
 
-static void filter(GradFunContext *ctx, uint8_t *dst, uint8_t *src, int width, int height, int dst_linesize, int src_linesize, int r)
+static void filter(GradFunContext *ctx, uint16_t *tmp, uint8_t *dst, uint8_t *src, int width, int height, int dst_linesize, int src_linesize, int r)
 {
     int bstride = FFALIGN(width, 16) / 2;
     int y;
     uint32_t dc_factor = (1 << 21) / (r * r);
-    uint16_t *dc = ctx->buf + 16;
-    uint16_t *buf = ctx->buf + bstride + 32;
+    uint16_t *dc = tmp + 16;
+    uint16_t *buf = tmp + bstride + 32;
     int thresh = ctx->thresh;
 
     memset(dc, 0, (bstride + 16) * sizeof(*buf));
@@ -131,6 +131,10 @@ static av_cold int init(AVFilterContext *ctx)
     s->blur_line = ff_gradfun_blur_line_c;
     s->filter_line = ff_gradfun_filter_line_c;
 
+    if (ARCH_AARCH64)
+        ff_gradfun_init_aarch64(s);
+    if (ARCH_ARM)
+        ff_gradfun_init_arm(s);
     if (ARCH_X86)
         ff_gradfun_init_x86(s);
 
@@ -168,7 +172,8 @@ static int config_input(AVFilterLink *inlink)
     int vsub = desc->log2_chroma_h;
 
     av_freep(&s->buf);
-    s->buf = av_mallocz((FFALIGN(inlink->w, 16) * (s->radius + 1) / 2 + 32) * sizeof(uint16_t));
+    s->buf_size = FFALIGN(inlink->w, 16) * (s->radius + 1) / 2 + 32;
+    s->buf = av_mallocz_array(4 * s->buf_size, sizeof(uint16_t));
     if (!s->buf)
         return AVERROR(ENOMEM);
 
@@ -179,12 +184,43 @@ static int config_input(AVFilterLink *inlink)
     return 0;
 }
 
+typedef struct ThreadData {
+    AVFrame *in, *out;
+} ThreadData;
+
+/* The blur runs down the plane with running sums, so the jobs are planes. */
+static int filter_plane(AVFilterContext *ctx, void *arg, int p, int nb_jobs)
+{
+    GradFunContext *s = ctx->priv;
+    AVFilterLink *inlink = ctx->inputs[0];
+    ThreadData *td = arg;
+    AVFrame *in = td->in, *out = td->out;
+    int w = inlink->w;
+    int h = inlink->h;
+    int r = s->radius;
+
+    if (p) {
+        w = s->chroma_w;
+        h = s->chroma_h;
+        r = s->chroma_r;
+    }
+
+    if (FFMIN(w, h) > 2 * r)
+        filter(s, s->buf + p * s->buf_size, out->data[p], in->data[p],
+               w, h, out->linesize[p], in->linesize[p], r);
+    else if (out->data[p] != in->data[p])
+        av_image_copy_plane(out->data[p], out->linesize[p], in->data[p], in->linesize[p], w, h);
+
+    return 0;
+}
+
 static int filter_frame(AVFilterLink *inlink, AVFrame *in)
 {
-    GradFunContext *s = inlink->dst->priv;
-    AVFilterLink *outlink = inlink->dst->outputs[0];
+    AVFilterContext *ctx = inlink->dst;
+    AVFilterLink *outlink = ctx->outputs[0];
     AVFrame *out;
-    int p, direct;
+    ThreadData td;
+    int nb_planes, direct;
 
     if (av_frame_is_writable(in)) {
         direct = 1;
@@ -202,21 +238,12 @@ static int filter_frame(AVFilterLink *inlink, AVFrame *in)
         out->height = outlink->h;
     }
 
-    for (p = 0; p < 4 && in->data[p]; p++) {
-        int w = inlink->w;
-        int h = inlink->h;
-        int r = s->radius;
-        if (p) {
-            w = s->chroma_w;
-            h = s->chroma_h;
-            r = s->chroma_r;
-        }
+    for (nb_planes = 0; nb_planes < 4 && in->data[nb_planes]; nb_planes++)
+        ;
 
-        if (FFMIN(w, h) > 2 * r)
-            filter(s, out->data[p], in->data[p], w, h, out->linesize[p], in->linesize[p], r);
-        else if (out->data[p] != in->data[p])
-            av_image_copy_plane(out->data[p], out->linesize[p], in->data[p], in->linesize[p], w, h);
-    }
+    td.in  = in;
+    td.out = out;
+    ctx->internal->execute(ctx, filter_plane, &td, NULL, nb_planes);
 
     if (!direct)
         av_frame_free(&in);
@@ -268,4 +295,5 @@ AVFilter ff_vf_gradfun = {
 
     .inputs    = avfilter_vf_gradfun_inputs,
     .outputs   = avfilter_vf_gradfun_outputs,
+    .flags     = AVFILTER_FLAG_SLICE_THREADS,
 };
@@ -211,7 +211,9 @@ static av_cold void uninit(AVFilterContext *ctx)
     av_freep(&s->coefs[1]);
     av_freep(&s->coefs[2]);
     av_freep(&s->coefs[3]);
-    av_freep(&s->line);
+    av_freep(&s->line[0]);
+    av_freep(&s->line[1]);
+    av_freep(&s->line[2]);
     av_freep(&s->frame_prev[0]);
     av_freep(&s->frame_prev[1]);
     av_freep(&s->frame_prev[2]);
@@ -259,9 +261,12 @@ static int config_input(AVFilterLink *inlink)
     s->vsub  = desc->log2_chroma_h;
     s->depth = desc->comp[0].depth_minus1+1;
 
-    s->line = av_malloc(inlink->w * sizeof(*s->line));
-    if (!s->line)
-        return AVERROR(ENOMEM);
+    /* one line buffer per plane, the planes are filtered concurrently */
+    for (i = 0; i < 3; i++) {
+        s->line[i] = av_malloc(inlink->w * sizeof(*s->line[i]));
+        if (!s->line[i])
+            return AVERROR(ENOMEM);
+    }
 
     for (i = 0; i < 4; i++) {
         s->coefs[i] = precalc_coefs(s->strength[i], s->depth);
@@ -269,18 +274,45 @@ static int config_input(AVFilterLink *inlink)
             return AVERROR(ENOMEM);
     }
 
+    if (ARCH_AARCH64)
+        ff_hqdn3d_init_aarch64(s);
+    if (ARCH_ARM)
+        ff_hqdn3d_init_arm(s);
     if (ARCH_X86)
         ff_hqdn3d_init_x86(s);
 
     return 0;
 }
 
+typedef struct ThreadData {
+    AVFrame *in, *out;
+} ThreadData;
+
+/* The spatial filter is recursive in both directions, so the planes are
+ * the units of work rather than slices of rows. */
+static int denoise_plane(AVFilterContext *ctx, void *arg, int c, int nb_jobs)
+{
+    HQDN3DContext *s = ctx->priv;
+    ThreadData *td = arg;
+    AVFrame *in  = td->in;
+    AVFrame *out = td->out;
+
+    denoise(s, in->data[c], out->data[c],
+            s->line[c], &s->frame_prev[c],
+            in->width  >> (!!c * s->hsub),
+            in->height >> (!!c * s->vsub),
+            in->linesize[c], out->linesize[c],
+            s->coefs[c?2:0], s->coefs[c?3:1]);
+    return 0;
+}
+
 static int filter_frame(AVFilterLink *inlink, AVFrame *in)
 {
-    HQDN3DContext *s = inlink->dst->priv;
-    AVFilterLink *outlink = inlink->dst->outputs[0];
+    AVFilterContext *ctx = inlink->dst;
+    AVFilterLink *outlink = ctx->outputs[0];
+    ThreadData td;
     AVFrame *out;
-    int direct, c;
+    int direct;
 
     if (av_frame_is_writable(in)) {
         direct = 1;
@@ -298,14 +330,9 @@ static int filter_frame(AVFilterLink *inlink, AVFrame *in)
         out->height = outlink->h;
     }
 
-    for (c = 0; c < 3; c++) {
-        denoise(s, in->data[c], out->data[c],
-                s->line, &s->frame_prev[c],
-                in->width  >> (!!c * s->hsub),
-                in->height >> (!!c * s->vsub),
-                in->linesize[c], out->linesize[c],
-                s->coefs[c?2:0], s->coefs[c?3:1]);
-    }
+    td.in  = in;
+    td.out = out;
+    ctx->internal->execute(ctx, denoise_plane, &td, NULL, 3);
 
     if (!direct)
         av_frame_free(&in);
@@ -361,4 +388,5 @@ AVFilter ff_vf_hqdn3d = {
     .inputs    = avfilter_vf_hqdn3d_inputs,
 
     .outputs   = avfilter_vf_hqdn3d_outputs,
+    .flags     = AVFILTER_FLAG_SLICE_THREADS,
 };
@@ -27,7 +27,7 @@
 typedef struct HQDN3DContext {
     const AVClass *class;
     int16_t *coefs[4];
-    uint16_t *line;
+    uint16_t *line[3];
     uint16_t *frame_prev[3];
     double strength[4];
     int hsub, vsub;
@@ -40,6 +40,8 @@ typedef struct HQDN3DContext {
 #define CHROMA_SPATIAL 2
 #define CHROMA_TMP     3
 
+void ff_hqdn3d_init_aarch64(HQDN3DContext *hqdn3d);
+void ff_hqdn3d_init_arm(HQDN3DContext *hqdn3d);
 void ff_hqdn3d_init_x86(HQDN3DContext *hqdn3d);
 
 #endif /* AVFILTER_VF_HQDN3D_H */
@@ -195,29 +195,42 @@ static int config_output(AVFilterLink *outlink)
     return 0;
 }
 
-static void blend_frame(AVFilterContext *ctx,
-                        AVFrame *dst, AVFrame *src,
-                        int x, int y)
+typedef struct ThreadData {
+    AVFrame *dst, *src;
+    int x, y;
+} ThreadData;
+
+/* Each job blends a band of the covered main rows, aligned to the chroma
+ * rows so that no chroma line is shared between jobs. */
+static int blend_slice(AVFilterContext *ctx, void *arg, int jobnr, int nb_jobs)
 {
     OverlayContext *s = ctx->priv;
+    ThreadData *td = arg;
+    AVFrame *dst = td->dst, *src = td->src;
+    int x = td->x, y = td->y;
     int i, j, k;
     int width, height;
     int overlay_end_y = y + src->height;
     int end_y, start_y;
+    int slice_h, slice_start, slice_end;
 
     width = FFMIN(dst->width - x, src->width);
     end_y = FFMIN(dst->height, overlay_end_y);
     start_y = FFMAX(y, 0);
     height = end_y - start_y;
 
+    slice_h     = FFALIGN(height / nb_jobs, 1 << s->vsub);
+    slice_start = FFMIN(jobnr * slice_h, height);
+    slice_end   = jobnr == nb_jobs - 1 ? height : FFMIN(slice_start + slice_h, height);
+
     if (dst->format == AV_PIX_FMT_BGR24 || dst->format == AV_PIX_FMT_RGB24) {
-        uint8_t *dp = dst->data[0] + x * 3 + start_y * dst->linesize[0];
-        uint8_t *sp = src->data[0];
+        uint8_t *dp = dst->data[0] + x * 3 + (start_y + slice_start) * dst->linesize[0];
+        uint8_t *sp = src->data[0] + slice_start * src->linesize[0];
         int b = dst->format == AV_PIX_FMT_BGR24 ? 2 : 0;
         int r = dst->format == AV_PIX_FMT_BGR24 ? 0 : 2;
         if (y < 0)
             sp += -y * src->linesize[0];
-        for (i = 0; i < height; i++) {
+        for (i = slice_start; i < slice_end; i++) {
             uint8_t *d = dp, *s = sp;
             for (j = 0; j < width; j++) {
                 d[r] = (d[r] * (0xff - s[3]) + s[0] * s[3] + 128) >> 8;
@@ -233,17 +246,19 @@ static void blend_frame(AVFilterContext *ctx,
         for (i = 0; i < 3; i++) {
             int hsub = i ? s->hsub : 0;
             int vsub = i ? s->vsub : 0;
-            uint8_t *dp = dst->data[i] + (x >> hsub) +
-                (start_y >> vsub) * dst->linesize[i];
-            uint8_t *sp = src->data[i];
-            uint8_t *ap = src->data[3];
             int wp = FFALIGN(width, 1<<hsub) >> hsub;
             int hp = FFALIGN(height, 1<<vsub) >> vsub;
+            int j0 = slice_start >> vsub;
+            int j1 = slice_end == height ? hp : slice_end >> vsub;
+            uint8_t *dp = dst->data[i] + (x >> hsub) +
+                ((start_y >> vsub) + j0) * dst->linesize[i];
+            uint8_t *sp = src->data[i] + j0 * src->linesize[i];
+            uint8_t *ap = src->data[3] + (j0 << vsub) * src->linesize[3];
             if (y < 0) {
                 sp += ((-y) >> vsub) * src->linesize[i];
                 ap += -y * src->linesize[3];
             }
-            for (j = 0; j < hp; j++) {
+            for (j = j0; j < j1; j++) {
                 uint8_t *d = dp, *s = sp, *a = ap;
                 for (k = 0; k < wp; k++) {
                     // average alpha for color components, improve quality
@@ -269,6 +284,21 @@ static void blend_frame(AVFilterContext *ctx,
             }
         }
     }
+    return 0;
+}
+
+static void blend_frame(AVFilterContext *ctx,
+                        AVFrame *dst, AVFrame *src,
+                        int x, int y)
+{
+    ThreadData td = { .dst = dst, .src = src, .x = x, .y = y };
+    int height = FFMIN(dst->height, y + src->height) - FFMAX(y, 0);
+
+    if (height <= 0 || FFMIN(dst->width - x, src->width) <= 0)
+        return;
+
+    ctx->internal->execute(ctx, blend_slice, &td, NULL,
+                           FFMIN(height, ctx->graph->nb_threads));
 }
 
 static int filter_frame_main(AVFilterLink *inlink, AVFrame *frame)
@@ -428,4 +458,5 @@ AVFilter ff_vf_overlay = {
 
     .inputs    = avfilter_vf_overlay_inputs,
     .outputs   = avfilter_vf_overlay_outputs,
+    .flags     = AVFILTER_FLAG_SLICE_THREADS,
 };
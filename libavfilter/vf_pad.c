@@ -340,9 +340,67 @@ static int frame_needs_copy(PadContext *s, AVFrame *frame)
     return 0;
 }
 
+typedef struct ThreadData {
+    AVFrame *in, *out;
+    int needs_copy;
+} ThreadData;
+
+static int filter_slice(AVFilterContext *ctx, void *arg, int jobnr, int nb_jobs)
+{
+    PadContext *s = ctx->priv;
+    ThreadData *td = arg;
+    AVFrame *in  = td->in;
+    AVFrame *out = td->out;
+    /* keep the slice edges on chroma rows */
+    int slice_h     = FFALIGN(s->h / nb_jobs, 1 << s->vsub);
+    int slice_start = FFMIN(jobnr * slice_h, s->h);
+    int slice_end   = (jobnr == nb_jobs - 1) ? s->h :
+                      FFMIN((jobnr + 1) * slice_h, s->h);
+    int y0, y1;
+
+    /* top bar */
+    y1 = FFMIN(s->y, slice_end);
+    if (slice_start < y1)
+        ff_draw_rectangle(out->data, out->linesize,
+                          s->line, s->line_step, s->hsub, s->vsub,
+                          0, slice_start, s->w, y1 - slice_start);
+
+    /* bottom bar */
+    y0 = FFMAX(s->y + s->in_h, slice_start);
+    if (y0 < slice_end)
+        ff_draw_rectangle(out->data, out->linesize,
+                          s->line, s->line_step, s->hsub, s->vsub,
+                          0, y0, s->w, slice_end - y0);
+
+    y0 = FFMAX(s->y, slice_start);
+    y1 = FFMIN(s->y + in->height, slice_end);
+    if (y0 >= y1)
+        return 0;
+
+    /* left border */
+    ff_draw_rectangle(out->data, out->linesize, s->line, s->line_step,
+                      s->hsub, s->vsub, 0, y0, s->x, y1 - y0);
+
+    if (td->needs_copy) {
+        ff_copy_rectangle(out->data, out->linesize, in->data, in->linesize,
+                          s->line_step, s->hsub, s->vsub,
+                          s->x, y0, y0 - s->y, in->width, y1 - y0);
+    }
+
+    /* right border */
+    ff_draw_rectangle(out->data, out->linesize,
+                      s->line, s->line_step, s->hsub, s->vsub,
+                      s->x + s->in_w, y0, s->w - s->x - s->in_w,
+                      y1 - y0);
+
+    return 0;
+}
+
 static int filter_frame(AVFilterLink *inlink, AVFrame *in)
 {
-    PadContext *s = inlink->dst->priv;
+    AVFilterContext *ctx = inlink->dst;
+    PadContext *s = ctx->priv;
+    ThreadData td;
     AVFrame *out;
     int needs_copy = frame_needs_copy(s, in);
 
@@ -369,35 +427,11 @@ static int filter_frame(AVFilterLink *inlink, AVFrame *in)
         }
     }
 
-    /* top bar */
-    if (s->y) {
-        ff_draw_rectangle(out->data, out->linesize,
-                          s->line, s->line_step, s->hsub, s->vsub,
-                          0, 0, s->w, s->y);
-    }
-
-    /* bottom bar */
-    if (s->h > s->y + s->in_h) {
-        ff_draw_rectangle(out->data, out->linesize,
-                          s->line, s->line_step, s->hsub, s->vsub,
-                          0, s->y + s->in_h, s->w, s->h - s->y - s->in_h);
-    }
-
-    /* left border */
-    ff_draw_rectangle(out->data, out->linesize, s->line, s->line_step,
-                      s->hsub, s->vsub, 0, s->y, s->x, in->height);
-
-    if (needs_copy) {
-        ff_copy_rectangle(out->data, out->linesize, in->data, in->linesize,
-                          s->line_step, s->hsub, s->vsub,
-                          s->x, s->y, 0, in->width, in->height);
-    }
-
-    /* right border */
-    ff_draw_rectangle(out->data, out->linesize,
-                      s->line, s->line_step, s->hsub, s->vsub,
-                      s->x + s->in_w, s->y, s->w - s->x - s->in_w,
-                      in->height);
+    td.in  = in;
+    td.out = out;
+    td.needs_copy = needs_copy;
+    ctx->internal->execute(ctx, filter_slice, &td, NULL,
+                           FFMIN(s->h, ctx->graph->nb_threads));
 
     out->width  = s->w;
     out->height = s->h;
@@ -460,4 +494,5 @@ AVFilter ff_vf_pad = {
     .inputs    = avfilter_vf_pad_inputs,
 
     .outputs   = avfilter_vf_pad_outputs,
+    .flags     = AVFILTER_FLAG_SLICE_THREADS,
 };
@@ -59,7 +59,8 @@ typedef struct FilterParam {
     int steps_y;                             ///< vertical step count
     int scalebits;                           ///< bits to shift pixel
     int32_t halfscale;                       ///< amount to add to pixel
-    uint32_t *sc[(MAX_SIZE * MAX_SIZE) - 1]; ///< finite state machine storage
+    uint32_t *sc;                            ///< finite state machine storage, one per slice thread
+    int sc_size;                             ///< size of the storage of a thread, in elements
 } FilterParam;
 
 typedef struct UnsharpContext {
@@ -69,34 +70,50 @@ typedef struct UnsharpContext {
     FilterParam luma;   ///< luma parameters (width, height, amount)
     FilterParam chroma; ///< chroma parameters (width, height, amount)
     int hsub, vsub;
+    int nb_threads;
 } UnsharpContext;
 
+typedef struct ThreadData {
+    AVFrame *in, *out;
+} ThreadData;
+
+/**
+ * Filter the rows from slice_start to slice_end of a plane.
+ *
+ * The filter is a finite one, so a slice only needs the steps_y rows
+ * above and below it to produce the same output as the whole plane.
+ */
 static void apply_unsharp(      uint8_t *dst, int dst_stride,
                           const uint8_t *src, int src_stride,
-                          int width, int height, FilterParam *fp)
+                          int width, int height,
+                          int slice_start, int slice_end,
+                          FilterParam *fp, uint32_t *sc_buf)
 {
-    uint32_t **sc = fp->sc;
+    uint32_t *sc[MAX_SIZE - 1];
     uint32_t sr[(MAX_SIZE * MAX_SIZE) - 1], tmp1, tmp2;
 
     int32_t res;
     int x, y, z;
     const uint8_t *src2;
 
+    if (slice_start >= slice_end)
+        return;
+
     if (!fp->amount) {
-        if (dst_stride == src_stride)
-            memcpy(dst, src, src_stride * height);
-        else
-            for (y = 0; y < height; y++, dst += dst_stride, src += src_stride)
-                memcpy(dst, src, width);
+        dst += slice_start * dst_stride;
+        src += slice_start * src_stride;
+        for (y = slice_start; y < slice_end; y++, dst += dst_stride, src += src_stride)
+            memcpy(dst, src, width);
         return;
     }
 
-    for (y = 0; y < 2 * fp->steps_y; y++)
+    for (y = 0; y < 2 * fp->steps_y; y++) {
+        sc[y] = sc_buf + y * (width + 2 * fp->steps_x);
         memset(sc[y], 0, sizeof(sc[y][0]) * (width + 2 * fp->steps_x));
+    }
 
-    for (y = -fp->steps_y; y < height + fp->steps_y; y++) {
-        if (y < height)
-            src2 = src;
+    for (y = slice_start - fp->steps_y; y < slice_end + fp->steps_y; y++) {
+        src2 = src + av_clip(y, 0, height - 1) * src_stride;
 
         memset(sr, 0, sizeof(sr[0]) * (2 * fp->steps_x - 1));
         for (x = -fp->steps_x; x < width + fp->steps_x; x++) {
@@ -109,18 +126,14 @@ static void apply_unsharp(      uint8_t *dst, int dst_stride,
                 tmp2 = sc[z + 0][x + fp->steps_x] + tmp1; sc[z + 0][x + fp->steps_x] = tmp1;
                 tmp1 = sc[z + 1][x + fp->steps_x] + tmp2; sc[z + 1][x + fp->steps_x] = tmp2;
             }
-            if (x >= fp->steps_x && y >= fp->steps_y) {
-                const uint8_t *srx = src - fp->steps_y * src_stride + x - fp->steps_x;
-                uint8_t *dsx       = dst - fp->steps_y * dst_stride + x - fp->steps_x;
+            if (x >= fp->steps_x && y >= slice_start + fp->steps_y) {
+                const uint8_t *srx = src + (y - fp->steps_y) * src_stride + x - fp->steps_x;
+                uint8_t *dsx       = dst + (y - fp->steps_y) * dst_stride + x - fp->steps_x;
 
                 res = (int32_t)*srx + ((((int32_t) * srx - (int32_t)((tmp1 + fp->halfscale) >> fp->scalebits)) * fp->amount) >> 16);
                 *dsx = av_clip_uint8(res);
             }
         }
-        if (y >= 0) {
-            dst += dst_stride;
-            src += src_stride;
-        }
     }
 }
 
@@ -159,9 +172,9 @@ static int query_formats(AVFilterContext *ctx)
     return 0;
 }
 
-static void init_filter_param(AVFilterContext *ctx, FilterParam *fp, const char *effect_type, int width)
+static int init_filter_param(AVFilterContext *ctx, FilterParam *fp, const char *effect_type, int width)
 {
-    int z;
+    UnsharpContext *unsharp = ctx->priv;
     const char *effect;
 
     effect = fp->amount == 0 ? "none" : fp->amount < 0 ? "blur" : "sharpen";
@@ -169,30 +182,38 @@ static void init_filter_param(AVFilterContext *ctx, FilterParam *fp, const char
     av_log(ctx, AV_LOG_VERBOSE, "effect:%s type:%s msize_x:%d msize_y:%d amount:%0.2f\n",
            effect, effect_type, fp->msize_x, fp->msize_y, fp->amount / 65535.0);
 
-    for (z = 0; z < 2 * fp->steps_y; z++)
-        fp->sc[z] = av_malloc(sizeof(*(fp->sc[z])) * (width + 2 * fp->steps_x));
+    av_freep(&fp->sc);
+    fp->sc_size = 2 * fp->steps_y * (width + 2 * fp->steps_x);
+    fp->sc = av_malloc_array(unsharp->nb_threads * fp->sc_size, sizeof(*fp->sc));
+    if (!fp->sc)
+        return AVERROR(ENOMEM);
+
+    return 0;
 }
 
 static int config_props(AVFilterLink *link)
 {
     UnsharpContext *unsharp = link->dst->priv;
     const AVPixFmtDescriptor *desc = av_pix_fmt_desc_get(link->format);
+    int ret;
 
     unsharp->hsub = desc->log2_chroma_w;
     unsharp->vsub = desc->log2_chroma_h;
+    unsharp->nb_threads = FFMAX(1, link->dst->graph->nb_threads);
 
-    init_filter_param(link->dst, &unsharp->luma,   "luma",   link->w);
-    init_filter_param(link->dst, &unsharp->chroma, "chroma", SHIFTUP(link->w, unsharp->hsub));
+    ret = init_filter_param(link->dst, &unsharp->luma,   "luma",   link->w);
+    if (ret < 0)
+        return ret;
+    ret = init_filter_param(link->dst, &unsharp->chroma, "chroma", SHIFTUP(link->w, unsharp->hsub));
+    if (ret < 0)
+        return ret;
 
     return 0;
 }
 
 static void free_filter_param(FilterParam *fp)
 {
-    int z;
-
-    for (z = 0; z < 2 * fp->steps_y; z++)
-        av_free(fp->sc[z]);
+    av_freep(&fp->sc);
 }
 
 static av_cold void uninit(AVFilterContext *ctx)
@@ -203,13 +224,37 @@ static av_cold void uninit(AVFilterContext *ctx)
     free_filter_param(&unsharp->chroma);
 }
 
+static int filter_slice(AVFilterContext *ctx, void *arg, int jobnr, int nb_jobs)
+{
+    UnsharpContext *unsharp = ctx->priv;
+    ThreadData *td = arg;
+    AVFrame *in  = td->in;
+    AVFrame *out = td->out;
+    int plane;
+
+    for (plane = 0; plane < 3; plane++) {
+        FilterParam *fp = plane ? &unsharp->chroma : &unsharp->luma;
+        int w = plane ? SHIFTUP(in->width,  unsharp->hsub) : in->width;
+        int h = plane ? SHIFTUP(in->height, unsharp->vsub) : in->height;
+        int slice_h     = h / nb_jobs;
+        int slice_start = jobnr * slice_h;
+        int slice_end   = (jobnr == nb_jobs - 1) ? h : (jobnr + 1) * slice_h;
+
+        apply_unsharp(out->data[plane], out->linesize[plane],
+                      in->data[plane], in->linesize[plane], w, h,
+                      slice_start, slice_end, fp, fp->sc + jobnr * fp->sc_size);
+    }
+
+    return 0;
+}
+
 static int filter_frame(AVFilterLink *link, AVFrame *in)
 {
-    UnsharpContext *unsharp = link->dst->priv;
-    AVFilterLink *outlink   = link->dst->outputs[0];
+    AVFilterContext *ctx    = link->dst;
+    UnsharpContext *unsharp = ctx->priv;
+    AVFilterLink *outlink   = ctx->outputs[0];
+    ThreadData td;
     AVFrame *out;
-    int cw = SHIFTUP(link->w, unsharp->hsub);
-    int ch = SHIFTUP(link->h, unsharp->vsub);
 
     out = ff_get_video_buffer(outlink, outlink->w, outlink->h);
     if (!out) {
@@ -218,9 +263,10 @@ static int filter_frame(AVFilterLink *link, AVFrame *in)
     }
     av_frame_copy_props(out, in);
 
-    apply_unsharp(out->data[0], out->linesize[0], in->data[0], in->linesize[0], link->w, link->h, &unsharp->luma);
-    apply_unsharp(out->data[1], out->linesize[1], in->data[1], in->linesize[1], cw,      ch,      &unsharp->chroma);
-    apply_unsharp(out->data[2], out->linesize[2], in->data[2], in->linesize[2], cw,      ch,      &unsharp->chroma);
+    td.in  = in;
+    td.out = out;
+    ctx->internal->execute(ctx, filter_slice, &td, NULL,
+                           FFMIN(link->h, unsharp->nb_threads));
 
     av_frame_free(&in);
     return ff_filter_frame(outlink, out);
@@ -277,4 +323,5 @@ AVFilter ff_vf_unsharp = {
     .inputs    = avfilter_vf_unsharp_inputs,
 
     .outputs   = avfilter_vf_unsharp_outputs,
+    .flags     = AVFILTER_FLAG_SLICE_THREADS,
 };
@@ -474,6 +474,11 @@ static int config_props(AVFilterLink *link)
             ff_yadif_init_x86(s);
     }
 
+    if (ARCH_AARCH64)
+        ff_yadif_init_aarch64(s);
+    if (ARCH_ARM)
+        ff_yadif_init_arm(s);
+
     return 0;
 }
 
@@ -65,6 +65,8 @@ typedef struct YADIFContext {
     int eof;
 } YADIFContext;
 
+void ff_yadif_init_aarch64(YADIFContext *yadif);
+void ff_yadif_init_arm(YADIFContext *yadif);
 void ff_yadif_init_x86(YADIFContext *yadif);
 
 #endif /* AVFILTER_YADIF_H */
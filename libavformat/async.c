@@ -0,0 +1,342 @@
+/*
+ * Asynchronous read-ahead protocol
+ *
+ * This file is part of Libav.
+ *
+ * Libav is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * Libav is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Libav; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file
+ * Read a nested protocol from a separate thread into a ring buffer.
+ *
+ * The thread is the only user of the nested URLContext once it is open.
+ * The ring holds the bytes from start_pos to end_pos of the input; seeks
+ * within it only move the read position, other seeks are passed on to
+ * the thread, which empties the ring and reads on from the new position.
+ */
+
+#include <pthread.h>
+
+#include "libavutil/avstring.h"
+#include "libavutil/opt.h"
+#include "libavutil/time.h"
+#include "avformat.h"
+#include "url.h"
+
+typedef struct AsyncContext {
+    const AVClass *class;
+    int buffer_size;
+    URLContext *inner;
+    AVIOInterruptCB inner_int_cb;
+    int64_t size;
+
+    uint8_t *buffer;
+    int64_t start_pos;      /* input position of the oldest buffered byte */
+    int64_t end_pos;        /* and of the byte after the newest one */
+    int64_t read_pos;
+    int eof;
+    int error;
+
+    int seek_request;
+    unsigned seek_serial;   /* number of the latest seek request */
+    unsigned seek_done;     /* number of the last request answered */
+    int64_t seek_pos;
+    int64_t seek_ret;
+
+    int abort;
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+} AsyncContext;
+
+#define OFFSET(x) offsetof(AsyncContext, x)
+#define D AV_OPT_FLAG_DECODING_PARAM
+static const AVOption options[] = {
+    { "buffer_size", "Size of the read-ahead buffer in bytes", OFFSET(buffer_size), AV_OPT_TYPE_INT, { .i64 = 4 << 20 }, 65536, INT_MAX, D },
+    { NULL }
+};
+
+static const AVClass async_class = {
+    .class_name = "async",
+    .item_name  = av_default_item_name,
+    .option     = options,
+    .version    = LIBAVUTIL_VERSION_INT,
+};
+
+static int async_interrupt_cb(void *opaque)
+{
+    URLContext *h = opaque;
+    AsyncContext *c = h->priv_data;
+
+    return c->abort || ff_check_interrupt(&h->interrupt_callback);
+}
+
+/*
+ * Return the free space of the ring, dropping what was read except for
+ * the last quarter of the buffer, which is kept for backward seeks.
+ */
+static int64_t async_space(AsyncContext *c)
+{
+    int64_t keep_from = FFMIN(c->read_pos, c->end_pos) - c->buffer_size / 4;
+
+    if (c->start_pos < keep_from)
+        c->start_pos = keep_from;
+    return c->buffer_size - (c->end_pos - c->start_pos);
+}
+
+static void *async_buffer_thread(void *arg)
+{
+    URLContext *h = arg;
+    AsyncContext *c = h->priv_data;
+    int64_t pos, end_pos;
+    unsigned serial;
+    int offset, len, ret;
+
+    pthread_mutex_lock(&c->mutex);
+    while (!c->abort) {
+        if (c->seek_request) {
+            pos     = c->seek_pos;
+            serial  = c->seek_serial;
+            end_pos = c->end_pos;
+            c->seek_request = 0;
+            pthread_mutex_unlock(&c->mutex);
+            pos = ffurl_seek(c->inner, pos, SEEK_SET);
+            pthread_mutex_lock(&c->mutex);
+            if (serial != c->seek_serial) {
+                /* The caller gave up on this seek; put the input back
+                 * where the ring ends so that the buffered data stays
+                 * valid. */
+                if (pos >= 0 && pos != end_pos &&
+                    ffurl_seek(c->inner, end_pos, SEEK_SET) < 0)
+                    c->error = AVERROR(EIO);
+                continue;
+            }
+            if (pos >= 0) {
+                c->start_pos = c->end_pos = c->read_pos = pos;
+                c->eof   = 0;
+                c->error = 0;
+            }
+            c->seek_ret  = pos;
+            c->seek_done = serial;
+            pthread_cond_signal(&c->cond);
+            continue;
+        }
+        len = FFMIN(async_space(c), INT_MAX);
+        if (c->eof || c->error || len <= 0) {
+            pthread_cond_wait(&c->cond, &c->mutex);
+            continue;
+        }
+
+        /* nothing but this thread touches the free part of the ring */
+        offset = c->end_pos % c->buffer_size;
+        len    = FFMIN(len, c->buffer_size - offset);
+        pthread_mutex_unlock(&c->mutex);
+        ret = ffurl_read(c->inner, c->buffer + offset, len);
+        pthread_mutex_lock(&c->mutex);
+
+        if (ret > 0)
+            c->end_pos += ret;
+        else if (!ret || ret == AVERROR_EOF)
+            c->eof = 1;
+        else if (!c->abort)
+            c->error = ret;
+        pthread_cond_signal(&c->cond);
+    }
+    pthread_mutex_unlock(&c->mutex);
+
+    return NULL;
+}
+
+/* Wait for the buffer thread to make progress, checking for interrupts. */
+static int async_wait(URLContext *h)
+{
+    AsyncContext *c = h->priv_data;
+    int64_t t = av_gettime() + 100000;
+    struct timespec tv = { .tv_sec  =  t / 1000000,
+                           .tv_nsec = (t % 1000000) * 1000 };
+
+    if (ff_check_interrupt(&h->interrupt_callback))
+        return AVERROR_EXIT;
+    pthread_cond_timedwait(&c->cond, &c->mutex, &tv);
+    return 0;
+}
+
+static int async_open(URLContext *h, const char *uri, int flags)
+{
+    AsyncContext *c = h->priv_data;
+    const char *nested_url;
+    int ret;
+
+    if (!av_strstart(uri, "async+", &nested_url) &&
+        !av_strstart(uri, "async:", &nested_url)) {
+        av_log(h, AV_LOG_ERROR, "Unsupported url %s\n", uri);
+        return AVERROR(EINVAL);
+    }
+    if (flags & AVIO_FLAG_WRITE) {
+        av_log(h, AV_LOG_ERROR, "Only reading is supported\n");
+        return AVERROR(ENOSYS);
+    }
+
+    c->inner_int_cb.callback = async_interrupt_cb;
+    c->inner_int_cb.opaque   = h;
+    if ((ret = ffurl_open(&c->inner, nested_url, AVIO_FLAG_READ,
+                          &c->inner_int_cb, NULL)) < 0) {
+        av_log(h, AV_LOG_ERROR, "Unable to open input\n");
+        return ret;
+    }
+    h->is_streamed = c->inner->is_streamed;
+    c->size        = ffurl_size(c->inner);
+
+    c->buffer = av_malloc(c->buffer_size);
+    if (!c->buffer) {
+        ret = AVERROR(ENOMEM);
+        goto fail;
+    }
+
+    pthread_mutex_init(&c->mutex, NULL);
+    pthread_cond_init(&c->cond, NULL);
+    if (pthread_create(&c->thread, NULL, async_buffer_thread, h)) {
+        av_log(h, AV_LOG_ERROR, "pthread_create failed\n");
+        pthread_mutex_destroy(&c->mutex);
+        pthread_cond_destroy(&c->cond);
+        ret = AVERROR(EIO);
+        goto fail;
+    }
+    return 0;
+
+fail:
+    av_freep(&c->buffer);
+    ffurl_close(c->inner);
+    c->inner = NULL;
+    return ret;
+}
+
+static int async_read(URLContext *h, uint8_t *buf, int size)
+{
+    AsyncContext *c = h->priv_data;
+    int offset, len, ret = 0;
+
+    pthread_mutex_lock(&c->mutex);
+    while (c->end_pos <= c->read_pos) {
+        if (c->error) {
+            ret = c->error;
+            break;
+        }
+        if (c->eof) {
+            ret = AVERROR_EOF;
+            break;
+        }
+        if ((ret = async_wait(h)) < 0)
+            break;
+    }
+    if (!ret) {
+        size = FFMIN(size, c->end_pos - c->read_pos);
+        while (ret < size) {
+            offset = c->read_pos % c->buffer_size;
+            len    = FFMIN(size - ret, c->buffer_size - offset);
+            memcpy(buf + ret, c->buffer + offset, len);
+            c->read_pos += len;
+            ret         += len;
+        }
+        pthread_cond_signal(&c->cond);
+    }
+    pthread_mutex_unlock(&c->mutex);
+
+    return ret;
+}
+
+static int64_t async_seek(URLContext *h, int64_t pos, int whence)
+{
+    AsyncContext *c = h->priv_data;
+    int64_t ret = 0;
+    unsigned serial;
+
+    if (whence == AVSEEK_SIZE)
+        return c->size;
+
+    pthread_mutex_lock(&c->mutex);
+    if (whence == SEEK_CUR)
+        pos += c->read_pos;
+    else if (whence == SEEK_END)
+        pos = c->size < 0 ? -1 : c->size + pos;
+    else if (whence != SEEK_SET)
+        pos = -1;
+    if (pos < 0) {
+        pthread_mutex_unlock(&c->mutex);
+        return AVERROR(EINVAL);
+    }
+
+    /* Serve the seek from the ring, or let the thread read up to the new
+     * position if that is less than a buffer ahead. */
+    if (pos >= c->start_pos &&
+        (pos <= c->end_pos ||
+         (!c->eof && !c->error && pos - c->end_pos <= c->buffer_size))) {
+        c->read_pos = pos;
+        pthread_cond_signal(&c->cond);
+        pthread_mutex_unlock(&c->mutex);
+        return pos;
+    }
+    if (h->is_streamed) {
+        pthread_mutex_unlock(&c->mutex);
+        return AVERROR(ESPIPE);
+    }
+
+    serial          = ++c->seek_serial;
+    c->seek_pos     = pos;
+    c->seek_request = 1;
+    pthread_cond_signal(&c->cond);
+    while (c->seek_done != serial && (ret = async_wait(h)) >= 0)
+        ;
+    if (ret >= 0) {
+        ret = c->seek_ret;
+    } else {
+        /* Withdraw the request; should the thread already be seeking,
+         * the changed serial makes it drop the result. */
+        c->seek_request = 0;
+        c->seek_serial++;
+    }
+    pthread_mutex_unlock(&c->mutex);
+
+    return ret;
+}
+
+static int async_close(URLContext *h)
+{
+    AsyncContext *c = h->priv_data;
+
+    pthread_mutex_lock(&c->mutex);
+    c->abort = 1;
+    pthread_cond_signal(&c->cond);
+    pthread_mutex_unlock(&c->mutex);
+    pthread_join(c->thread, NULL);
+    pthread_mutex_destroy(&c->mutex);
+    pthread_cond_destroy(&c->cond);
+
+    ffurl_close(c->inner);
+    av_freep(&c->buffer);
+    return 0;
+}
+
+URLProtocol ff_async_protocol = {
+    .name            = "async",
+    .url_open        = async_open,
+    .url_read        = async_read,
+    .url_seek        = async_seek,
+    .url_close       = async_close,
+    .priv_data_size  = sizeof(AsyncContext),
+    .priv_data_class = &async_class,
+    .flags           = URL_PROTOCOL_FLAG_NESTED_SCHEME,
+};
@@ -1041,6 +1041,13 @@ typedef struct AVFormatContext {
  * This flag is mainly intended for testing.
  */
 #define AVFMT_FLAG_BITEXACT         0x0400
+/**
+ * Make avformat_find_stream_info() return as soon as the parameters of all
+ * streams are known, taking the frame rate signalled in the bitstream for
+ * the video codecs that have one, and run the probing decodes of different
+ * streams in parallel.
+ */
+#define AVFMT_FLAG_FAST_INFO        0x0800
 
     /**
      * Maximum size of the data read from input for determining
@@ -0,0 +1,290 @@
+/*
+ * Input caching protocol
+ *
+ * This file is part of Libav.
+ *
+ * Libav is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * Libav is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Libav; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file
+ * Keep everything read from a nested protocol in a temporary file.
+ *
+ * Data is stored at its own offset in a sparse file, and a sorted list of
+ * the byte ranges written so far tells which reads can be served from
+ * it. Only the gaps between those ranges are read from the nested
+ * protocol, which is seeked lazily, when a gap has to be filled.
+ */
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "libavutil/avstring.h"
+#include "libavutil/mem.h"
+#include "libavutil/opt.h"
+#include "avformat.h"
+#include "url.h"
+
+typedef struct CacheExtent {
+    int64_t start, end;
+} CacheExtent;
+
+typedef struct CacheContext {
+    const AVClass *class;
+    char *cache_dir;
+    URLContext *inner;
+    int fd;
+    int write_error;
+    int64_t pos;            /* read position */
+    int64_t inner_pos;      /* position of the nested protocol */
+    int64_t size;
+    CacheExtent *extents;   /* sorted, neither overlapping nor adjacent */
+    int nb_extents;
+    int extents_allocated;
+    int64_t hit_bytes, miss_bytes;
+} CacheContext;
+
+#define OFFSET(x) offsetof(CacheContext, x)
+#define D AV_OPT_FLAG_DECODING_PARAM
+static const AVOption options[] = {
+    { "cache_dir", "Directory for the cache file", OFFSET(cache_dir), AV_OPT_TYPE_STRING, { .str = NULL }, 0, 0, D },
+    { NULL }
+};
+
+static const AVClass cache_class = {
+    .class_name = "cache",
+    .item_name  = av_default_item_name,
+    .option     = options,
+    .version    = LIBAVUTIL_VERSION_INT,
+};
+
+/* Return the last extent starting at or before pos, or -1. */
+static int find_extent(CacheContext *c, int64_t pos)
+{
+    int lo = 0, hi = c->nb_extents;
+
+    while (lo < hi) {
+        int mid = (lo + hi) >> 1;
+        if (c->extents[mid].start <= pos)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo - 1;
+}
+
+static int add_extent(CacheContext *c, int64_t start, int64_t end)
+{
+    int i = find_extent(c, start), j = i + 1;
+
+    if (i < 0 || c->extents[i].end < start)
+        i++;
+    while (j < c->nb_extents && c->extents[j].start <= end)
+        j++;
+
+    if (i == j) {
+        if (c->nb_extents == c->extents_allocated) {
+            int ret = av_reallocp_array(&c->extents,
+                                        2 * c->extents_allocated + 16,
+                                        sizeof(*c->extents));
+            if (ret < 0) {
+                c->nb_extents = c->extents_allocated = 0;
+                return ret;
+            }
+            c->extents_allocated = 2 * c->extents_allocated + 16;
+        }
+        memmove(c->extents + i + 1, c->extents + i,
+                (c->nb_extents - i) * sizeof(*c->extents));
+        c->extents[i].start = start;
+        c->extents[i].end   = end;
+        c->nb_extents++;
+        return 0;
+    }
+
+    /* merge with the extents from i to j - 1 */
+    c->extents[i].start = FFMIN(start, c->extents[i].start);
+    c->extents[i].end   = FFMAX(end,   c->extents[j - 1].end);
+    memmove(c->extents + i + 1, c->extents + j,
+            (c->nb_extents - j) * sizeof(*c->extents));
+    c->nb_extents -= j - i - 1;
+    return 0;
+}
+
+static void cache_store(URLContext *h, int64_t pos, const uint8_t *buf,
+                        int size)
+{
+    CacheContext *c = h->priv_data;
+    int len = size;
+
+    if (c->write_error)
+        return;
+    if (lseek(c->fd, pos, SEEK_SET) != pos)
+        len = -1;
+    while (len > 0) {
+        int ret = write(c->fd, buf + size - len, len);
+        if (ret <= 0)
+            break;
+        len -= ret;
+    }
+    if (len || add_extent(c, pos, pos + size) < 0) {
+        av_log(h, AV_LOG_WARNING, "Unable to write to the cache file, "
+               "no longer caching\n");
+        c->write_error = 1;
+    }
+}
+
+static int cache_open(URLContext *h, const char *uri, int flags)
+{
+    CacheContext *c = h->priv_data;
+    const char *nested_url, *dir;
+    char *filename;
+    int len, ret;
+
+    if (!av_strstart(uri, "cache+", &nested_url) &&
+        !av_strstart(uri, "cache:", &nested_url)) {
+        av_log(h, AV_LOG_ERROR, "Unsupported url %s\n", uri);
+        return AVERROR(EINVAL);
+    }
+    if (flags & AVIO_FLAG_WRITE) {
+        av_log(h, AV_LOG_ERROR, "Only reading is supported\n");
+        return AVERROR(ENOSYS);
+    }
+
+    if (!(dir = c->cache_dir) && !(dir = getenv("TMPDIR")))
+        dir = "/tmp";
+    len = strlen(dir) + sizeof("/lavfcacheXXXXXX");
+    if (!(filename = av_malloc(len)))
+        return AVERROR(ENOMEM);
+    snprintf(filename, len, "%s/lavfcacheXXXXXX", dir);
+    c->fd = mkstemp(filename);
+    if (c->fd < 0) {
+        ret = AVERROR(errno);
+        av_log(h, AV_LOG_ERROR, "Unable to create the cache file %s\n",
+               filename);
+        av_free(filename);
+        return ret;
+    }
+    /* nothing else needs the file, let it go away once it is closed */
+    unlink(filename);
+    av_free(filename);
+
+    if ((ret = ffurl_open(&c->inner, nested_url, AVIO_FLAG_READ,
+                          &h->interrupt_callback, NULL)) < 0) {
+        av_log(h, AV_LOG_ERROR, "Unable to open input\n");
+        close(c->fd);
+        return ret;
+    }
+    c->size = ffurl_size(c->inner);
+    return 0;
+}
+
+static int cache_read(URLContext *h, uint8_t *buf, int size)
+{
+    CacheContext *c = h->priv_data;
+    int i = find_extent(c, c->pos);
+    int64_t ret;
+
+    if (c->size >= 0 && c->pos >= c->size)
+        return AVERROR_EOF;
+
+    if (i >= 0 && c->pos < c->extents[i].end) {
+        size = FFMIN(size, c->extents[i].end - c->pos);
+        if (lseek(c->fd, c->pos, SEEK_SET) == c->pos &&
+            (ret = read(c->fd, buf, size)) > 0) {
+            c->pos       += ret;
+            c->hit_bytes += ret;
+            return ret;
+        }
+        av_log(h, AV_LOG_WARNING, "Unable to read from the cache file\n");
+    } else if (i + 1 < c->nb_extents) {
+        /* stop at the next cached range */
+        size = FFMIN(size, c->extents[i + 1].start - c->pos);
+    }
+
+    if (c->inner_pos != c->pos) {
+        ret = ffurl_seek(c->inner, c->pos, SEEK_SET);
+        if (ret >= 0) {
+            c->inner_pos = ret;
+        } else if (c->pos < c->inner_pos) {
+            return ret;
+        }
+        /* the nested protocol cannot seek, read up to the position */
+        while (c->inner_pos < c->pos) {
+            ret = ffurl_read(c->inner, buf,
+                             FFMIN(size, c->pos - c->inner_pos));
+            if (ret <= 0)
+                return ret ? ret : AVERROR_EOF;
+            cache_store(h, c->inner_pos, buf, ret);
+            c->inner_pos  += ret;
+            c->miss_bytes += ret;
+        }
+    }
+
+    ret = ffurl_read(c->inner, buf, size);
+    if (ret > 0) {
+        cache_store(h, c->pos, buf, ret);
+        c->pos        += ret;
+        c->inner_pos  += ret;
+        c->miss_bytes += ret;
+    } else if ((!ret || ret == AVERROR_EOF) && c->size < 0) {
+        c->size = c->pos;
+    }
+    return ret;
+}
+
+static int64_t cache_seek(URLContext *h, int64_t pos, int whence)
+{
+    CacheContext *c = h->priv_data;
+
+    if (whence == AVSEEK_SIZE)
+        return c->size >= 0 ? c->size : AVERROR(ENOSYS);
+    if (whence == SEEK_CUR)
+        pos += c->pos;
+    else if (whence == SEEK_END && c->size >= 0)
+        pos += c->size;
+    else if (whence != SEEK_SET)
+        return AVERROR(EINVAL);
+    if (pos < 0)
+        return AVERROR(EINVAL);
+
+    /* the nested protocol is only seeked when a read needs it */
+    c->pos = pos;
+    return pos;
+}
+
+static int cache_close(URLContext *h)
+{
+    CacheContext *c = h->priv_data;
+
+    av_log(h, AV_LOG_VERBOSE, "%"PRId64" bytes read from the cache, "
+           "%"PRId64" from the input, %d cached ranges\n",
+           c->hit_bytes, c->miss_bytes, c->nb_extents);
+    close(c->fd);
+    ffurl_close(c->inner);
+    av_freep(&c->extents);
+    return 0;
+}
+
+URLProtocol ff_cache_protocol = {
+    .name            = "cache",
+    .url_open        = cache_open,
+    .url_read        = cache_read,
+    .url_seek        = cache_seek,
+    .url_close       = cache_close,
+    .priv_data_size  = sizeof(CacheContext),
+    .priv_data_class = &cache_class,
+    .flags           = URL_PROTOCOL_FLAG_NESTED_SCHEME,
+};
@@ -32,6 +32,9 @@
 #endif
 #include <sys/stat.h>
 #include <stdlib.h>
+#if HAVE_MMAP
+#include <sys/mman.h>
+#endif
 #include "os_support.h"
 #include "url.h"
 
@@ -42,10 +45,18 @@ typedef struct FileContext {
     const AVClass *class;
     int fd;
     int trunc;
+    int use_mmap;
+    int readahead;
+    uint8_t *map;       /* the whole file when it is mapped */
+    int64_t map_size;
+    int64_t pos;        /* read position, for the mapping and readahead */
+    int64_t advised;    /* end of the range last given to the readahead */
 } FileContext;
 
 static const AVOption file_options[] = {
     { "truncate", "Truncate existing files on write", offsetof(FileContext, trunc), AV_OPT_TYPE_INT, { .i64 = 1 }, 0, 1, AV_OPT_FLAG_ENCODING_PARAM },
+    { "mmap", "Map files opened for reading into memory", offsetof(FileContext, use_mmap), AV_OPT_TYPE_INT, { .i64 = 0 }, 0, 1, AV_OPT_FLAG_DECODING_PARAM },
+    { "readahead", "Bytes to ask the system to read ahead of the read position", offsetof(FileContext, readahead), AV_OPT_TYPE_INT, { .i64 = 0 }, 0, INT_MAX, AV_OPT_FLAG_DECODING_PARAM },
     { NULL }
 };
 
@@ -56,10 +67,33 @@ static const AVClass file_class = {
     .version    = LIBAVUTIL_VERSION_INT,
 };
 
+static void file_readahead(FileContext *c)
+{
+#if HAVE_POSIX_FADVISE
+    /* renew the request once half of the last one has been read */
+    if (c->pos + c->readahead / 2 >= c->advised) {
+        posix_fadvise(c->fd, c->pos, c->readahead, POSIX_FADV_WILLNEED);
+        c->advised = c->pos + c->readahead;
+    }
+#endif
+}
+
 static int file_read(URLContext *h, unsigned char *buf, int size)
 {
     FileContext *c = h->priv_data;
-    return read(c->fd, buf, size);
+    int ret;
+
+    if (c->readahead)
+        file_readahead(c);
+    if (c->map) {
+        ret = FFMIN(size, FFMAX(c->map_size - c->pos, 0));
+        memcpy(buf, c->map + c->pos, ret);
+    } else {
+        ret = read(c->fd, buf, size);
+    }
+    if (ret > 0)
+        c->pos += ret;
+    return ret;
 }
 
 static int file_write(URLContext *h, const unsigned char *buf, int size)
@@ -89,6 +123,27 @@ static int file_check(URLContext *h, int mask)
 
 #if CONFIG_FILE_PROTOCOL
 
+#if HAVE_MMAP
+/* Map a regular file, reads fall back to read() if that is not possible. */
+static void file_map(URLContext *h)
+{
+    FileContext *c = h->priv_data;
+    struct stat st;
+    void *map;
+
+    if (fstat(c->fd, &st) < 0 || !S_ISREG(st.st_mode) || st.st_size <= 0 ||
+        st.st_size > SIZE_MAX)
+        return;
+    map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, c->fd, 0);
+    if (map == MAP_FAILED) {
+        av_log(h, AV_LOG_VERBOSE, "Unable to map the file, reading it\n");
+        return;
+    }
+    c->map      = map;
+    c->map_size = st.st_size;
+}
+#endif
+
 static int file_open(URLContext *h, const char *filename, int flags)
 {
     FileContext *c = h->priv_data;
@@ -115,6 +170,16 @@ static int file_open(URLContext *h, const char *filename, int flags)
     if (fd == -1)
         return AVERROR(errno);
     c->fd = fd;
+
+    if (access == O_RDONLY && (c->use_mmap || c->readahead)) {
+#if HAVE_POSIX_FADVISE
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+#if HAVE_MMAP
+        if (c->use_mmap)
+            file_map(h);
+#endif
+    }
     return 0;
 }
 
@@ -127,18 +192,40 @@ static int64_t file_seek(URLContext *h, int64_t pos, int whence)
     if (whence == AVSEEK_SIZE) {
         struct stat st;
 
+        if (c->map)
+            return c->map_size;
         ret = fstat(c->fd, &st);
         return ret < 0 ? AVERROR(errno) : st.st_size;
     }
 
-    ret = lseek(c->fd, pos, whence);
+    if (c->map) {
+        if (whence == SEEK_CUR)
+            pos += c->pos;
+        else if (whence == SEEK_END)
+            pos += c->map_size;
+        else if (whence != SEEK_SET)
+            return AVERROR(EINVAL);
+        if (pos < 0)
+            return AVERROR(EINVAL);
+        ret = pos;
+    } else {
+        ret = lseek(c->fd, pos, whence);
+        if (ret < 0)
+            return AVERROR(errno);
+    }
+    c->pos     = ret;
+    c->advised = 0;
 
-    return ret < 0 ? AVERROR(errno) : ret;
+    return ret;
 }
 
 static int file_close(URLContext *h)
 {
     FileContext *c = h->priv_data;
+#if HAVE_MMAP
+    if (c->map)
+        munmap(c->map, c->map_size);
+#endif
     return close(c->fd);
 }
 
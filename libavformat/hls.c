@@ -34,8 +34,13 @@
 #include "avformat.h"
 #include "internal.h"
 #include "avio_internal.h"
+#include "http.h"
 #include "url.h"
 
+#if HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
 #define INITIAL_BUFFER_SIZE 32768
 
 /*
@@ -63,6 +68,21 @@ struct segment {
     uint8_t iv[16];
 };
 
+/*
+ * A segment downloaded by the prefetch thread. Data is appended while
+ * the download is in progress and consumed by the demuxer from pos.
+ */
+struct fetched_segment {
+    int seq_no;
+    uint8_t *data;
+    unsigned int allocated;
+    int size, pos;
+    int done;   /* download finished, err holds its result */
+    int err;
+    int64_t fetch_time;
+    struct fetched_segment *next;
+};
+
 /*
  * Each variant has its own demuxer. If it currently is active,
  * it has an open AVIOContext too, and potentially an AVPacket
@@ -91,9 +111,39 @@ struct variant {
 
     char key_url[MAX_URL_SIZE];
     uint8_t key[16];
+
+    int compatible;         /* streams match the exported ones */
+    int64_t seg_bytes;      /* download size and time of the segment */
+    int64_t seg_time;       /* being read, for the bandwidth estimate */
+
+#if HAVE_PTHREADS
+    /* Segment prefetching: once started, the fetch thread owns the
+     * segment list, the playlist reloads and the key, the demuxer only
+     * consumes the fetched list. */
+    pthread_t fetch_thread;
+    pthread_mutex_t fetch_lock;
+    pthread_cond_t fetch_cond;
+    int fetch_started;
+    int fetch_abort;
+    int fetch_gen;      /* bumped to drop the downloads in flight */
+    int fetch_busy_gen; /* generation of the current download */
+    int fetch_seq_no;   /* next segment to download */
+    int fetch_err;      /* set when nothing more can be fetched */
+    int fetch_reloaded; /* the last reload brought no new segments yet */
+    int nb_fetched;
+    struct fetched_segment *fetched;
+    AVIOInterruptCB fetch_int_cb;
+    URLContext *fetch_conn; /* persistent HTTP connection */
+#endif
 };
 
 typedef struct HLSContext {
+    const AVClass *class;
+    int prefetch_segments;
+    int adaptive;
+    int cur_variant;    /* variant received in adaptive mode */
+    int switched;
+    int64_t bandwidth;  /* estimated download rate in bits/s */
     int n_variants;
     struct variant **variants;
     int cur_seq_no;
@@ -122,11 +172,45 @@ static void free_segment_list(struct variant *var)
     var->n_segments = 0;
 }
 
+#if HAVE_PTHREADS
+static void free_fetched(struct variant *v)
+{
+    while (v->fetched) {
+        struct fetched_segment *fs = v->fetched;
+        v->fetched = fs->next;
+        av_free(fs->data);
+        av_free(fs);
+    }
+    v->nb_fetched = 0;
+}
+
+static void stop_fetch(struct variant *v)
+{
+    if (!v->fetch_started)
+        return;
+    pthread_mutex_lock(&v->fetch_lock);
+    v->fetch_abort = 1;
+    pthread_cond_signal(&v->fetch_cond);
+    pthread_mutex_unlock(&v->fetch_lock);
+    pthread_join(v->fetch_thread, NULL);
+    pthread_mutex_destroy(&v->fetch_lock);
+    pthread_cond_destroy(&v->fetch_cond);
+    free_fetched(v);
+    if (v->fetch_conn)
+        ffurl_close(v->fetch_conn);
+    v->fetch_conn    = NULL;
+    v->fetch_started = 0;
+}
+#endif
+
 static void free_variant_list(HLSContext *c)
 {
     int i;
     for (i = 0; i < c->n_variants; i++) {
         struct variant *var = c->variants[i];
+#if HAVE_PTHREADS
+        stop_fetch(var);
+#endif
         free_segment_list(var);
         av_free_packet(&var->pkt);
         av_free(var->pb.buffer);
@@ -200,7 +284,8 @@ static void handle_key_args(struct key_info *info, const char *key,
 }
 
 static int parse_playlist(HLSContext *c, const char *url,
-                          struct variant *var, AVIOContext *in)
+                          struct variant *var, AVIOContext *in,
+                          const AVIOInterruptCB *int_cb)
 {
     int ret = 0, is_segment = 0, is_variant = 0, bandwidth = 0;
     int64_t duration = 0;
@@ -215,8 +300,7 @@ static int parse_playlist(HLSContext *c, const char *url,
 
     if (!in) {
         close_in = 1;
-        if ((ret = avio_open2(&in, url, AVIO_FLAG_READ,
-                              c->interrupt_callback, NULL)) < 0)
+        if ((ret = avio_open2(&in, url, AVIO_FLAG_READ, int_cb, NULL)) < 0)
             return ret;
     }
 
@@ -329,19 +413,18 @@ fail:
     return ret;
 }
 
-static int open_input(struct variant *var)
+static int open_input(struct variant *var, struct segment *seg,
+                      URLContext **in, const AVIOInterruptCB *int_cb,
+                      AVDictionary **opts)
 {
-    struct segment *seg = var->segments[var->cur_seq_no - var->start_seq_no];
     if (seg->key_type == KEY_NONE) {
-        return ffurl_open(&var->input, seg->url, AVIO_FLAG_READ,
-                          &var->parent->interrupt_callback, NULL);
+        return ffurl_open(in, seg->url, AVIO_FLAG_READ, int_cb, opts);
     } else if (seg->key_type == KEY_AES_128) {
         char iv[33], key[33], url[MAX_URL_SIZE];
         int ret;
         if (strcmp(seg->key, var->key_url)) {
             URLContext *uc;
-            if (ffurl_open(&uc, seg->key, AVIO_FLAG_READ,
-                           &var->parent->interrupt_callback, NULL) == 0) {
+            if (ffurl_open(&uc, seg->key, AVIO_FLAG_READ, int_cb, NULL) == 0) {
                 if (ffurl_read_complete(uc, var->key, sizeof(var->key))
                     != sizeof(var->key)) {
                     av_log(NULL, AV_LOG_ERROR, "Unable to read key file %s\n",
@@ -361,14 +444,13 @@ static int open_input(struct variant *var)
             snprintf(url, sizeof(url), "crypto+%s", seg->url);
         else
             snprintf(url, sizeof(url), "crypto:%s", seg->url);
-        if ((ret = ffurl_alloc(&var->input, url, AVIO_FLAG_READ,
-                               &var->parent->interrupt_callback)) < 0)
+        if ((ret = ffurl_alloc(in, url, AVIO_FLAG_READ, int_cb)) < 0)
             return ret;
-        av_opt_set(var->input->priv_data, "key", key, 0);
-        av_opt_set(var->input->priv_data, "iv", iv, 0);
-        if ((ret = ffurl_connect(var->input, NULL)) < 0) {
-            ffurl_close(var->input);
-            var->input = NULL;
+        av_opt_set((*in)->priv_data, "key", key, 0);
+        av_opt_set((*in)->priv_data, "iv", iv, 0);
+        if ((ret = ffurl_connect(*in, NULL)) < 0) {
+            ffurl_close(*in);
+            *in = NULL;
             return ret;
         }
         return 0;
@@ -376,13 +458,394 @@ static int open_input(struct variant *var)
     return AVERROR(ENOSYS);
 }
 
+#if HAVE_PTHREADS
+static int fetch_interrupt_cb(void *opaque)
+{
+    struct variant *v = opaque;
+    return v->fetch_abort || v->fetch_busy_gen != v->fetch_gen ||
+           ff_check_interrupt(&v->parent->interrupt_callback);
+}
+
+static void fetch_wait(struct variant *v, int64_t timeout)
+{
+    int64_t t = av_gettime() + timeout;
+    struct timespec tv = { .tv_sec  =  t / 1000000,
+                           .tv_nsec = (t % 1000000) * 1000 };
+    pthread_cond_timedwait(&v->fetch_cond, &v->fetch_lock, &tv);
+}
+
+/* Reload a live playlist without holding the lock during the download. */
+static int fetch_reload_playlist(HLSContext *c, struct variant *v)
+{
+    struct variant *tmp = av_mallocz(sizeof(*tmp));
+    int ret;
+
+    if (!tmp)
+        return AVERROR(ENOMEM);
+    tmp->start_seq_no    = v->start_seq_no;
+    tmp->target_duration = v->target_duration;
+
+    ret = parse_playlist(c, v->url, tmp, NULL, &v->fetch_int_cb);
+    if (ret >= 0) {
+        pthread_mutex_lock(&v->fetch_lock);
+        free_segment_list(v);
+        v->segments        = tmp->segments;
+        v->n_segments      = tmp->n_segments;
+        v->start_seq_no    = tmp->start_seq_no;
+        v->target_duration = tmp->target_duration;
+        v->finished        = tmp->finished;
+        v->last_load_time  = tmp->last_load_time;
+        pthread_mutex_unlock(&v->fetch_lock);
+    } else {
+        free_segment_list(tmp);
+    }
+    av_free(tmp);
+    return ret;
+}
+
+/*
+ * Open a segment, reusing the connection of the previous one when both
+ * are plain HTTP.
+ */
+static int fetch_open_segment(struct variant *v, struct segment *seg,
+                              URLContext **in)
+{
+    AVDictionary *opts = NULL;
+    int ret;
+
+    if (v->fetch_conn) {
+        if (seg->key_type == KEY_NONE &&
+            ff_http_do_new_request(v->fetch_conn, seg->url) >= 0) {
+            *in = v->fetch_conn;
+            return 0;
+        }
+        ffurl_close(v->fetch_conn);
+        v->fetch_conn = NULL;
+    }
+
+    av_dict_set(&opts, "multiple_requests", "1", 0);
+    ret = open_input(v, seg, in, &v->fetch_int_cb, &opts);
+    av_dict_free(&opts);
+    if (ret >= 0 && seg->key_type == KEY_NONE &&
+        (!strcmp((*in)->prot->name, "http") ||
+         !strcmp((*in)->prot->name, "https")))
+        v->fetch_conn = *in;
+    return ret;
+}
+
+static void *fetch_thread(void *arg)
+{
+    struct variant *v = arg;
+    HLSContext *c     = v->parent->priv_data;
+    uint8_t buf[INITIAL_BUFFER_SIZE];
+
+    pthread_mutex_lock(&v->fetch_lock);
+    while (!v->fetch_abort) {
+        struct fetched_segment *fs, **tail;
+        struct segment *seg;
+        URLContext *in = NULL;
+        int gen = v->fetch_gen, ret;
+        int64_t start;
+
+        if (!v->needed || v->fetch_err ||
+            v->nb_fetched > c->prefetch_segments) {
+            pthread_cond_wait(&v->fetch_cond, &v->fetch_lock);
+            continue;
+        }
+
+        if (v->fetch_seq_no < v->start_seq_no) {
+            av_log(v->parent, AV_LOG_WARNING,
+                   "skipping %d segments ahead, expired from playlists\n",
+                   v->start_seq_no - v->fetch_seq_no);
+            v->fetch_seq_no = v->start_seq_no;
+        }
+        if (v->fetch_seq_no >= v->start_seq_no + v->n_segments) {
+            /* Reload after the duration of the last segment, then every
+             * half target duration until new segments show up. */
+            int64_t reload_interval = !v->fetch_reloaded && v->n_segments ?
+                                      v->segments[v->n_segments - 1]->duration :
+                                      v->target_duration / 2;
+            int64_t wait = v->last_load_time + reload_interval - av_gettime();
+
+            if (v->finished) {
+                v->fetch_err = AVERROR_EOF;
+                pthread_cond_signal(&v->fetch_cond);
+            } else if (wait > 0) {
+                fetch_wait(v, wait);
+            } else {
+                v->fetch_busy_gen = gen;
+                pthread_mutex_unlock(&v->fetch_lock);
+                ret = fetch_reload_playlist(c, v);
+                pthread_mutex_lock(&v->fetch_lock);
+                v->fetch_reloaded = 1;
+                if (ret < 0 && !v->fetch_abort) {
+                    v->fetch_err = ret;
+                    pthread_cond_signal(&v->fetch_cond);
+                }
+            }
+            continue;
+        }
+        v->fetch_reloaded = 0;
+
+        if (!(fs = av_mallocz(sizeof(*fs)))) {
+            v->fetch_err = AVERROR(ENOMEM);
+            pthread_cond_signal(&v->fetch_cond);
+            continue;
+        }
+        fs->seq_no = v->fetch_seq_no++;
+        for (tail = &v->fetched; *tail; tail = &(*tail)->next)
+            ;
+        *tail = fs;
+        v->nb_fetched++;
+        v->fetch_busy_gen = gen;
+        seg = v->segments[fs->seq_no - v->start_seq_no];
+        pthread_mutex_unlock(&v->fetch_lock);
+
+        start = av_gettime();
+        ret   = fetch_open_segment(v, seg, &in);
+        while (ret >= 0) {
+            ret = ffurl_read(in, buf, sizeof(buf));
+            if (ret <= 0)
+                break;
+            pthread_mutex_lock(&v->fetch_lock);
+            if (gen != v->fetch_gen) {
+                pthread_mutex_unlock(&v->fetch_lock);
+                break;
+            }
+            if (fs->size + ret + 1 > fs->allocated) {
+                uint8_t *data = av_fast_realloc(fs->data, &fs->allocated,
+                                                FFMAX(2 * fs->allocated,
+                                                      fs->size + ret + 1));
+                if (!data) {
+                    ret = AVERROR(ENOMEM);
+                    pthread_mutex_unlock(&v->fetch_lock);
+                    break;
+                }
+                fs->data = data;
+            }
+            memcpy(fs->data + fs->size, buf, ret);
+            fs->size += ret;
+            pthread_cond_signal(&v->fetch_cond);
+            pthread_mutex_unlock(&v->fetch_lock);
+        }
+        if (in && in != v->fetch_conn)
+            ffurl_close(in);
+        if (ret < 0 && ret != AVERROR_EOF && v->fetch_conn) {
+            ffurl_close(v->fetch_conn);
+            v->fetch_conn = NULL;
+        }
+
+        pthread_mutex_lock(&v->fetch_lock);
+        if (gen == v->fetch_gen) {
+            /* like the unthreaded path, a failed read just ends the
+             * segment, only failing to open it is an error */
+            if (!in)
+                fs->err = ret;
+            else if (ret < 0 && ret != AVERROR_EOF && !v->fetch_abort)
+                av_log(v->parent, AV_LOG_WARNING,
+                       "Failed reading segment %d\n", fs->seq_no);
+            fs->done       = 1;
+            fs->fetch_time = av_gettime() - start;
+            pthread_cond_signal(&v->fetch_cond);
+        }
+    }
+    pthread_mutex_unlock(&v->fetch_lock);
+
+    return NULL;
+}
+
+/*
+ * Start prefetching. A segment already open for reading is finished
+ * without the thread, fetching starts with the next one.
+ */
+static void start_fetch(struct variant *v)
+{
+    v->fetch_seq_no        = v->cur_seq_no + !!v->input;
+    v->fetch_int_cb.callback = fetch_interrupt_cb;
+    v->fetch_int_cb.opaque   = v;
+    pthread_mutex_init(&v->fetch_lock, NULL);
+    pthread_cond_init(&v->fetch_cond, NULL);
+    if (pthread_create(&v->fetch_thread, NULL, fetch_thread, v)) {
+        av_log(v->parent, AV_LOG_WARNING,
+               "Unable to start the prefetch thread, "
+               "fetching segments on demand\n");
+        pthread_mutex_destroy(&v->fetch_lock);
+        pthread_cond_destroy(&v->fetch_cond);
+        return;
+    }
+    v->fetch_started = 1;
+}
+
+/* Restart fetching at cur_seq_no, dropping everything fetched so far. */
+static void reset_fetch(struct variant *v)
+{
+    if (!v->fetch_started)
+        return;
+    pthread_mutex_lock(&v->fetch_lock);
+    free_fetched(v);
+    v->fetch_seq_no   = v->cur_seq_no;
+    v->fetch_err      = 0;
+    v->fetch_reloaded = 0;
+    v->fetch_gen++;
+    pthread_cond_signal(&v->fetch_cond);
+    pthread_mutex_unlock(&v->fetch_lock);
+}
+
+/*
+ * Read from the segment at the head of the fetched list. Returns 0 at
+ * the end of the segment, with cur_seq_no set to its sequence number.
+ */
+static int read_fetched(struct variant *v, uint8_t *buf, int buf_size)
+{
+    HLSContext *c = v->parent->priv_data;
+    int ret;
+
+    pthread_mutex_lock(&v->fetch_lock);
+    for (;;) {
+        struct fetched_segment *fs = v->fetched;
+
+        if (fs && fs->pos < fs->size) {
+            ret = FFMIN(buf_size, fs->size - fs->pos);
+            memcpy(buf, fs->data + fs->pos, ret);
+            fs->pos += ret;
+            break;
+        }
+        if (fs && fs->done) {
+            ret           = fs->err;
+            v->cur_seq_no = fs->seq_no;
+            v->seg_bytes  = fs->size;
+            v->seg_time   = fs->fetch_time;
+            v->fetched    = fs->next;
+            v->nb_fetched--;
+            av_free(fs->data);
+            av_free(fs);
+            pthread_cond_signal(&v->fetch_cond);
+            break;
+        }
+        if (!fs && v->fetch_err) {
+            ret = v->fetch_err;
+            break;
+        }
+        if (ff_check_interrupt(c->interrupt_callback)) {
+            ret = AVERROR_EXIT;
+            break;
+        }
+        /* wake up periodically to check for interrupts */
+        fetch_wait(v, 100000);
+    }
+    pthread_mutex_unlock(&v->fetch_lock);
+
+    return ret;
+}
+#endif
+
+/* Fold the download rate of the segment just read into the estimate. */
+static void update_bandwidth(HLSContext *c, struct variant *v)
+{
+    if (v->seg_bytes > 0 && v->seg_time > 0) {
+        int64_t rate = v->seg_bytes * 8 * AV_TIME_BASE / v->seg_time;
+        c->bandwidth = c->bandwidth ? (3 * c->bandwidth + rate) / 4 : rate;
+    }
+    v->seg_bytes = 0;
+    v->seg_time  = 0;
+}
+
+/*
+ * Pick the variant to receive with the estimated bandwidth. Switch down
+ * once the current variant needs more than 90% of it, to the best one
+ * that needs at most 80%; switch up only to a variant needing at most 70%.
+ */
+static int select_variant(HLSContext *c)
+{
+    struct variant *cur = c->variants[c->cur_variant];
+    int down = cur->bandwidth > c->bandwidth * 9 / 10;
+    int64_t limit = c->bandwidth * (down ? 8 : 7) / 10;
+    int i, best = -1, lowest = -1;
+
+    if (!c->bandwidth)
+        return c->cur_variant;
+
+    for (i = 0; i < c->n_variants; i++) {
+        struct variant *v = c->variants[i];
+        if (!v->compatible)
+            continue;
+        if (lowest < 0 || v->bandwidth < c->variants[lowest]->bandwidth)
+            lowest = i;
+        if (v->bandwidth <= limit &&
+            (best < 0 || v->bandwidth > c->variants[best]->bandwidth))
+            best = i;
+    }
+    if (down)
+        return best >= 0 ? best : lowest;
+    return best >= 0 && c->variants[best]->bandwidth > cur->bandwidth ?
+           best : c->cur_variant;
+}
+
+/*
+ * Set whether the variant is received. The fetch thread checks the flag,
+ * so it may only change under the fetch lock once the thread runs.
+ */
+static void set_needed(struct variant *v, int needed)
+{
+#if HAVE_PTHREADS
+    if (v->fetch_started) {
+        pthread_mutex_lock(&v->fetch_lock);
+        v->needed = needed;
+        pthread_mutex_unlock(&v->fetch_lock);
+        return;
+    }
+#endif
+    v->needed = needed;
+}
+
+/* Start receiving another variant from segment seq_no on. */
+static void switch_variant(HLSContext *c, int index, int seq_no)
+{
+    struct variant *v = c->variants[index];
+
+    av_log(v->parent, AV_LOG_INFO, "Switching to variant %d (%d bps), "
+           "estimated bandwidth %"PRId64" bps\n", index, v->bandwidth,
+           c->bandwidth);
+    c->cur_variant = index;
+    c->switched    = 1;
+
+    /* drop whatever was left from the last time it was received */
+    if (v->input)
+        ffurl_close(v->input);
+    v->input = NULL;
+    av_free_packet(&v->pkt);
+    reset_packet(&v->pkt);
+    ff_read_frame_flush(v->ctx);
+    v->pb.eof_reached = 0;
+    v->pb.buf_end = v->pb.buf_ptr = v->pb.buffer;
+    v->pb.pos     = 0;
+
+    set_needed(v, 1);
+    v->cur_seq_no = seq_no;
+#if HAVE_PTHREADS
+    if (v->fetch_started)
+        reset_fetch(v);
+    else if (c->prefetch_segments)
+        start_fetch(v);
+#endif
+}
+
 static int read_data(void *opaque, uint8_t *buf, int buf_size)
 {
     struct variant *v = opaque;
     HLSContext *c = v->parent->priv_data;
+    int64_t start;
     int ret, i;
 
 restart:
+#if HAVE_PTHREADS
+    if (v->fetch_started && !v->input) {
+        ret = read_fetched(v, buf, buf_size);
+        if (ret)
+            return ret;
+        goto segment_done;
+    }
+#endif
     if (!v->input) {
         /* If this is a live stream and the reload interval has elapsed since
          * the last playlist reload, reload the variant playlists now. */
@@ -393,7 +856,7 @@ restart:
 reload:
         if (!v->finished &&
             av_gettime() - v->last_load_time >= reload_interval) {
-            if ((ret = parse_playlist(c, v->url, v, NULL)) < 0)
+            if ((ret = parse_playlist(c, v->url, v, NULL, c->interrupt_callback)) < 0)
                 return ret;
             /* If we need to reload the playlist again below (if
              * there's still no more segments), switch to a reload
@@ -418,45 +881,89 @@ reload:
             goto reload;
         }
 
-        ret = open_input(v);
+        start = av_gettime();
+        ret   = open_input(v, v->segments[v->cur_seq_no - v->start_seq_no],
+                           &v->input, &v->parent->interrupt_callback, NULL);
+        v->seg_time += av_gettime() - start;
         if (ret < 0)
             return ret;
     }
-    ret = ffurl_read(v->input, buf, buf_size);
-    if (ret > 0)
+    start = av_gettime();
+    ret   = ffurl_read(v->input, buf, buf_size);
+    v->seg_time += av_gettime() - start;
+    if (ret > 0) {
+        v->seg_bytes += ret;
         return ret;
+    }
     ffurl_close(v->input);
     v->input = NULL;
+#if HAVE_PTHREADS
+segment_done:
+#endif
     v->cur_seq_no++;
 
     c->end_of_segment = 1;
     c->cur_seq_no = v->cur_seq_no;
 
-    if (v->ctx && v->ctx->nb_streams &&
+    update_bandwidth(c, v);
+
+    if (c->adaptive) {
+        if (v->needed && c->cur_variant >= 0 &&
+            v == c->variants[c->cur_variant]) {
+            i = select_variant(c);
+            if (i != c->cur_variant) {
+                set_needed(v, 0);
+                switch_variant(c, i, v->cur_seq_no);
+            }
+        }
+    } else if (v->ctx && v->ctx->nb_streams &&
         v->parent->nb_streams >= v->stream_offset + v->ctx->nb_streams) {
-        v->needed = 0;
+        int needed = 0;
         for (i = v->stream_offset; i < v->stream_offset + v->ctx->nb_streams;
              i++) {
             if (v->parent->streams[i]->discard < AVDISCARD_ALL)
-                v->needed = 1;
+                needed = 1;
         }
+        set_needed(v, needed);
     }
     if (!v->needed) {
         av_log(v->parent, AV_LOG_INFO, "No longer receiving variant %d\n",
                v->index);
+#if HAVE_PTHREADS
+        reset_fetch(v);
+#endif
         return AVERROR_EOF;
     }
     goto restart;
 }
 
+/* check whether packets of b can be output on the streams of a */
+static int variants_compatible(struct variant *a, struct variant *b)
+{
+    int i;
+
+    if (a->ctx->nb_streams != b->ctx->nb_streams)
+        return 0;
+    for (i = 0; i < a->ctx->nb_streams; i++) {
+        AVCodecContext *ca = a->ctx->streams[i]->codec;
+        AVCodecContext *cb = b->ctx->streams[i]->codec;
+        if (ca->codec_type != cb->codec_type || ca->codec_id != cb->codec_id)
+            return 0;
+    }
+    return 1;
+}
+
 static int hls_read_header(AVFormatContext *s)
 {
     HLSContext *c = s->priv_data;
+    struct variant *ref = NULL;
     int ret = 0, i, j, stream_offset = 0;
 
     c->interrupt_callback = &s->interrupt_callback;
+    c->cur_variant        = -1;
 
-    if ((ret = parse_playlist(c, s->filename, NULL, s->pb)) < 0)
+    if ((ret = parse_playlist(c, s->filename, NULL, s->pb,
+                              c->interrupt_callback)) < 0)
         goto fail;
 
     if (c->n_variants == 0) {
@@ -469,7 +976,7 @@ static int hls_read_header(AVFormatContext *s)
     if (c->n_variants > 1 || c->variants[0]->n_segments == 0) {
         for (i = 0; i < c->n_variants; i++) {
             struct variant *v = c->variants[i];
-            if ((ret = parse_playlist(c, v->url, v, NULL)) < 0)
+            if ((ret = parse_playlist(c, v->url, v, NULL, c->interrupt_callback)) < 0)
                 goto fail;
         }
     }
@@ -493,7 +1000,7 @@ static int hls_read_header(AVFormatContext *s)
     for (i = 0; i < c->n_variants; i++) {
         struct variant *v = c->variants[i];
         AVInputFormat *in_fmt = NULL;
-        char bitrate_str[20];
+        char bitrate_str[20], url[MAX_URL_SIZE];
         AVProgram *program;
 
         if (v->n_segments == 0)
@@ -505,7 +1012,7 @@ static int hls_read_header(AVFormatContext *s)
         }
 
         v->index  = i;
-        v->needed = 1;
+        set_needed(v, 1);
         v->parent = s;
 
         /* If this is a live stream with more than 3 segments, start at the
@@ -514,11 +1021,21 @@ static int hls_read_header(AVFormatContext *s)
         if (!v->finished && v->n_segments > 3)
             v->cur_seq_no = v->start_seq_no + v->n_segments - 3;
 
+        /* the segment list belongs to the fetch thread from now on */
+        av_strlcpy(url, v->segments[0]->url, sizeof(url));
+#if HAVE_PTHREADS
+        /* In adaptive mode, only the variant received is prefetched, from
+         * the first packet on. Probing the variants one at a time keeps
+         * their downloads out of each other's bandwidth measurement. */
+        if (c->prefetch_segments && !c->adaptive)
+            start_fetch(v);
+#endif
+
         v->read_buffer = av_malloc(INITIAL_BUFFER_SIZE);
         ffio_init_context(&v->pb, v->read_buffer, INITIAL_BUFFER_SIZE, 0, v,
                           read_data, NULL, NULL);
         v->pb.seekable = 0;
-        ret = av_probe_input_buffer(&v->pb, &in_fmt, v->segments[0]->url,
+        ret = av_probe_input_buffer(&v->pb, &in_fmt, url,
                                     NULL, 0, 0);
         if (ret < 0) {
             /* Free the ctx - it isn't initialized properly at this point,
@@ -531,7 +1048,7 @@ static int hls_read_header(AVFormatContext *s)
         }
         v->ctx->pb       = &v->pb;
         v->stream_offset = stream_offset;
-        ret = avformat_open_input(&v->ctx, v->segments[0]->url, in_fmt, NULL);
+        ret = avformat_open_input(&v->ctx, url, in_fmt, NULL);
         if (ret < 0)
             goto fail;
 
@@ -539,6 +1056,20 @@ static int hls_read_header(AVFormatContext *s)
         ret = avformat_find_stream_info(v->ctx, NULL);
         if (ret < 0)
             goto fail;
+
+        /* In adaptive mode, every variant outputs its packets on the
+         * streams created for the first one. */
+        if (c->adaptive && ref) {
+            v->stream_offset = 0;
+            v->compatible    = variants_compatible(ref, v);
+            if (!v->compatible)
+                av_log(s, AV_LOG_WARNING, "Variant %d has different streams, "
+                       "not switching to it\n", i);
+            continue;
+        }
+        v->compatible = 1;
+        ref           = v;
+
         snprintf(bitrate_str, sizeof(bitrate_str), "%d", v->bandwidth);
 
         program = av_new_program(s, i);
@@ -558,7 +1089,7 @@ static int hls_read_header(AVFormatContext *s)
             st->id = i;
             avpriv_set_pts_info(st, ist->pts_wrap_bits, ist->time_base.num, ist->time_base.den);
             avcodec_copy_context(st->codec, v->ctx->streams[j]->codec);
-            if (v->bandwidth)
+            if (v->bandwidth && !c->adaptive)
                 av_dict_set(&st->metadata, "variant_bitrate", bitrate_str,
                                  0);
         }
@@ -593,16 +1124,22 @@ static int recheck_discard_flags(AVFormatContext *s, int first)
     for (i = 0; i < c->n_variants; i++) {
         struct variant *v = c->variants[i];
         if (v->cur_needed && !v->needed) {
-            v->needed = 1;
+            set_needed(v, 1);
             changed = 1;
             v->cur_seq_no = c->cur_seq_no;
             v->pb.eof_reached = 0;
+#if HAVE_PTHREADS
+            reset_fetch(v);
+#endif
             av_log(s, AV_LOG_INFO, "Now receiving variant %d\n", i);
         } else if (first && !v->cur_needed && v->needed) {
             if (v->input)
                 ffurl_close(v->input);
             v->input = NULL;
-            v->needed = 0;
+            set_needed(v, 0);
+#if HAVE_PTHREADS
+            reset_fetch(v);
+#endif
             changed = 1;
             av_log(s, AV_LOG_INFO, "No longer receiving variant %d\n", i);
         }
@@ -610,13 +1147,44 @@ static int recheck_discard_flags(AVFormatContext *s, int first)
     return changed;
 }
 
+/* Receive the first variant the bandwidth estimate allows, and only it. */
+static void select_first_variant(AVFormatContext *s)
+{
+    HLSContext *c = s->priv_data;
+    int i;
+
+    for (i = 0; !c->variants[i]->compatible; i++)
+        ;
+    c->cur_variant = i;
+    c->cur_variant = select_variant(c);
+
+    for (i = 0; i < c->n_variants; i++) {
+        struct variant *v = c->variants[i];
+        if (i == c->cur_variant || !v->needed)
+            continue;
+        if (v->input)
+            ffurl_close(v->input);
+        v->input  = NULL;
+        set_needed(v, 0);
+    }
+#if HAVE_PTHREADS
+    if (c->prefetch_segments)
+        start_fetch(c->variants[c->cur_variant]);
+#endif
+    av_log(s, AV_LOG_INFO, "Receiving variant %d (%d bps)\n",
+           c->cur_variant, c->variants[c->cur_variant]->bandwidth);
+}
+
 static int hls_read_packet(AVFormatContext *s, AVPacket *pkt)
 {
     HLSContext *c = s->priv_data;
     int ret, i, minvariant = -1;
 
     if (c->first_packet) {
-        recheck_discard_flags(s, 1);
+        if (c->adaptive)
+            select_first_variant(s);
+        else
+            recheck_discard_flags(s, 1);
         c->first_packet = 0;
     }
 
@@ -694,14 +1262,21 @@ start:
         }
     }
     if (c->end_of_segment) {
-        if (recheck_discard_flags(s, 0))
+        int changed = c->adaptive ? c->switched : recheck_discard_flags(s, 0);
+        c->switched = 0;
+        if (changed)
             goto start;
     }
     /* If we got a packet, return it */
     if (minvariant >= 0) {
-        *pkt = c->variants[minvariant]->pkt;
-        pkt->stream_index += c->variants[minvariant]->stream_offset;
-        reset_packet(&c->variants[minvariant]->pkt);
+        struct variant *var = c->variants[minvariant];
+        AVStream *ist       = var->ctx->streams[var->pkt.stream_index];
+
+        *pkt = var->pkt;
+        pkt->stream_index += var->stream_offset;
+        av_packet_rescale_ts(pkt, ist->time_base,
+                             s->streams[pkt->stream_index]->time_base);
+        reset_packet(&var->pkt);
         return 0;
     }
     return AVERROR_EOF;
@@ -767,6 +1342,9 @@ static int hls_read_seek(AVFormatContext *s, int stream_index,
             }
             pos += var->segments[j]->duration;
         }
+#if HAVE_PTHREADS
+        reset_fetch(var);
+#endif
         if (ret)
             c->seek_timestamp = AV_NOPTS_VALUE;
     }
@@ -786,10 +1364,28 @@ static int hls_probe(AVProbeData *p)
     return 0;
 }
 
+#define OFFSET(x) offsetof(HLSContext, x)
+#define FLAGS AV_OPT_FLAG_DECODING_PARAM
+static const AVOption hls_options[] = {
+    { "prefetch_segments", "Number of segments to download ahead in a background thread, 0 to fetch on demand",
+      OFFSET(prefetch_segments), AV_OPT_TYPE_INT, { .i64 = 2 }, 0, 64, FLAGS },
+    { "adaptive", "Switch between the variants according to the measured bandwidth",
+      OFFSET(adaptive), AV_OPT_TYPE_INT, { .i64 = 0 }, 0, 1, FLAGS },
+    { NULL },
+};
+
+static const AVClass hls_class = {
+    .class_name = "hls demuxer",
+    .item_name  = av_default_item_name,
+    .option     = hls_options,
+    .version    = LIBAVUTIL_VERSION_INT,
+};
+
 AVInputFormat ff_hls_demuxer = {
     .name           = "hls,applehttp",
     .long_name      = NULL_IF_CONFIG_SMALL("Apple HTTP Live Streaming"),
     .priv_data_size = sizeof(HLSContext),
+    .priv_class     = &hls_class,
     .read_probe     = hls_probe,
     .read_header    = hls_read_header,
     .read_packet    = hls_read_packet,
@@ -251,12 +251,37 @@ fail:
     return AVERROR(EIO);
 }
 
+/* check whether the connection can be kept for a request to uri */
+static int can_reuse_connection(HTTPContext *s, const char *uri)
+{
+    char proto1[10], host1[1024], proto2[10], host2[1024];
+    int port1, port2;
+
+    /* the server closes the connection, the previous reply was not read
+     * completely or may still have a chunked trailer pending */
+    if (!s->hd || s->willclose || s->chunksize >= 0 ||
+        (s->filesize >= 0 && s->off < s->filesize))
+        return 0;
+
+    av_url_split(proto1, sizeof(proto1), NULL, 0, host1, sizeof(host1),
+                 &port1, NULL, 0, s->location);
+    av_url_split(proto2, sizeof(proto2), NULL, 0, host2, sizeof(host2),
+                 &port2, NULL, 0, uri);
+    return !strcmp(proto1, proto2) && !av_strcasecmp(host1, host2) &&
+           port1 == port2;
+}
+
 int ff_http_do_new_request(URLContext *h, const char *uri)
 {
     HTTPContext *s = h->priv_data;
     AVDictionary *options = NULL;
     int ret;
 
+    if (s->hd && !can_reuse_connection(s, uri)) {
+        ffurl_close(s->hd);
+        s->hd = NULL;
+    }
+
     s->off           = 0;
     s->icy_data_read = 0;
     av_free(s->location);
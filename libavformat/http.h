@@ -38,7 +38,9 @@
 void ff_http_init_auth_state(URLContext *dest, const URLContext *src);
 
 /**
- * Send a new HTTP request, reusing the old connection.
+ * Send a new HTTP request, reusing the old connection if it is to the
+ * same server and the previous reply has been read completely. Otherwise
+ * a new connection is opened.
  *
  * @param h pointer to the ressource
  * @param uri uri used to perform the request
@@ -40,13 +40,13 @@
 #endif
 
 #include "libavutil/avstring.h"
+#include "libavutil/buffer.h"
 #include "libavutil/dict.h"
 #include "libavutil/intfloat.h"
 #include "libavutil/intreadwrite.h"
 #include "libavutil/lzo.h"
 #include "libavutil/mathematics.h"
 
-#include "libavcodec/bytestream.h"
 #include "libavcodec/flac.h"
 #include "libavcodec/mpeg4audio.h"
 
@@ -92,9 +92,10 @@ typedef struct {
 } EbmlList;
 
 typedef struct {
-    int      size;
-    uint8_t *data;
-    int64_t  pos;
+    int          size;
+    AVBufferRef *buf;
+    uint8_t     *data;
+    int64_t      pos;
 } EbmlBin;
 
 typedef struct {
@@ -746,14 +747,20 @@ static int ebml_read_ascii(AVIOContext *pb, int size, char **str)
  */
 static int ebml_read_binary(AVIOContext *pb, int length, EbmlBin *bin)
 {
-    av_free(bin->data);
-    if (!(bin->data = av_mallocz(length + FF_INPUT_BUFFER_PADDING_SIZE)))
+    av_buffer_unref(&bin->buf);
+    bin->buf = av_buffer_alloc(length + FF_INPUT_BUFFER_PADDING_SIZE);
+    if (!bin->buf) {
+        bin->data = NULL;
         return AVERROR(ENOMEM);
+    }
+    bin->data = bin->buf->data;
+    memset(bin->data + length, 0, FF_INPUT_BUFFER_PADDING_SIZE);
 
     bin->size = length;
     bin->pos  = avio_tell(pb);
     if (avio_read(pb, bin->data, length) != length) {
-        av_freep(&bin->data);
+        av_buffer_unref(&bin->buf);
+        bin->data = NULL;
         return AVERROR(EIO);
     }
 
@@ -969,7 +976,8 @@ static void ebml_free(EbmlSyntax *syntax, void *data)
             av_freep(data_off);
             break;
         case EBML_BIN:
-            av_freep(&((EbmlBin *) data_off)->data);
+            av_buffer_unref(&((EbmlBin *) data_off)->buf);
+            ((EbmlBin *) data_off)->data = NULL;
             break;
         case EBML_NEST:
             if (syntax[i].list_elem_size) {
@@ -1565,8 +1573,19 @@ static int matroska_parse_tracks(AVFormatContext *s)
                            "Failed to decode codec private data\n");
                 }
 
-                if (codec_priv != track->codec_priv.data)
-                    av_free(codec_priv);
+                if (codec_priv != track->codec_priv.data) {
+                    av_buffer_unref(&track->codec_priv.buf);
+                    if (track->codec_priv.data) {
+                        track->codec_priv.buf = av_buffer_create(track->codec_priv.data,
+                                                                 track->codec_priv.size,
+                                                                 NULL, NULL, 0);
+                        if (!track->codec_priv.buf) {
+                            av_freep(&track->codec_priv.data);
+                            track->codec_priv.size = 0;
+                            return AVERROR(ENOMEM);
+                        }
+                    }
+                }
             }
         }
 
@@ -2230,14 +2249,14 @@ fail:
 
 static int matroska_parse_frame(MatroskaDemuxContext *matroska,
                                 MatroskaTrack *track, AVStream *st,
-                                uint8_t *data, int pkt_size,
+                                AVBufferRef *buf, uint8_t *data, int pkt_size,
                                 uint64_t timecode, uint64_t duration,
                                 int64_t pos, int is_keyframe)
 {
     MatroskaTrackEncoding *encodings = track->encodings.elem;
     uint8_t *pkt_data = data;
     int offset = 0, res;
-    AVPacket *pkt;
+    AVPacket *pkt = NULL;
 
     if (encodings && encodings->scope & 1) {
         res = matroska_decode_buffer(&pkt_data, &pkt_size, track);
@@ -2262,23 +2281,45 @@ static int matroska_parse_frame(MatroskaDemuxContext *matroska,
         offset = 8;
 
     pkt = av_mallocz(sizeof(AVPacket));
-    /* XXX: prevent data copy... */
-    if (av_new_packet(pkt, pkt_size + offset) < 0) {
-        av_free(pkt);
-        return AVERROR(ENOMEM);
+    if (!pkt) {
+        res = AVERROR(ENOMEM);
+        goto fail;
     }
+    av_init_packet(pkt);
 
-    if (st->codec->codec_id == AV_CODEC_ID_PRORES) {
-        uint8_t *buf = pkt->data;
-        bytestream_put_be32(&buf, pkt_size);
-        bytestream_put_be32(&buf, MKBETAG('i', 'c', 'p', 'f'));
+    if (offset) {
+        /* the ProRes frame header has to be prepended, so copy */
+        if (av_new_packet(pkt, pkt_size + offset) < 0) {
+            res = AVERROR(ENOMEM);
+            goto fail;
+        }
+        AV_WB32(pkt->data,     pkt_size);
+        AV_WB32(pkt->data + 4, MKBETAG('i', 'c', 'p', 'f'));
+        memcpy(pkt->data + offset, pkt_data, pkt_size);
+        if (pkt_data != data)
+            av_freep(&pkt_data);
+    } else if (pkt_data != data) {
+        /* decompressed or rebuilt data, hand the new buffer over as is */
+        uint8_t *tmp = av_realloc(pkt_data,
+                                  pkt_size + FF_INPUT_BUFFER_PADDING_SIZE);
+        if (!tmp) {
+            res = AVERROR(ENOMEM);
+            goto fail;
+        }
+        pkt_data = tmp;
+        memset(pkt_data + pkt_size, 0, FF_INPUT_BUFFER_PADDING_SIZE);
+        if ((res = av_packet_from_data(pkt, pkt_data, pkt_size)) < 0)
+            goto fail;
+    } else {
+        /* reference the frame inside the block buffer */
+        if (!(pkt->buf = av_buffer_ref(buf))) {
+            res = AVERROR(ENOMEM);
+            goto fail;
+        }
+        pkt->data = data;
+        pkt->size = pkt_size;
     }
 
-    memcpy(pkt->data + offset, pkt_data, pkt_size);
-
-    if (pkt_data != data)
-        av_free(pkt_data);
-
     pkt->flags        = is_keyframe;
     pkt->stream_index = st->index;
 
@@ -2309,12 +2350,14 @@ static int matroska_parse_frame(MatroskaDemuxContext *matroska,
     return 0;
 
 fail:
+    av_free(pkt);
     if (pkt_data != data)
         av_freep(&pkt_data);
     return res;
 }
 
-static int matroska_parse_block(MatroskaDemuxContext *matroska, uint8_t *data,
+static int matroska_parse_block(MatroskaDemuxContext *matroska,
+                                AVBufferRef *buf, uint8_t *data,
                                 int size, int64_t pos, uint64_t cluster_time,
                                 uint64_t block_duration, int is_keyframe,
                                 int64_t cluster_pos)
@@ -2404,7 +2447,8 @@ static int matroska_parse_block(MatroskaDemuxContext *matroska, uint8_t *data,
             if (res)
                 goto end;
         } else {
-            res = matroska_parse_frame(matroska, track, st, data, lace_size[n],
+            res = matroska_parse_frame(matroska, track, st, buf, data,
+                                       lace_size[n],
                                        timecode, duration, pos,
                                        !n ? is_keyframe : 0);
             if (res)
@@ -2463,7 +2507,8 @@ static int matroska_parse_cluster_incremental(MatroskaDemuxContext *matroska)
             int is_keyframe = blocks[i].non_simple ? !blocks[i].reference : -1;
             if (!blocks[i].non_simple)
                 blocks[i].duration = AV_NOPTS_VALUE;
-            res = matroska_parse_block(matroska, blocks[i].bin.data,
+            res = matroska_parse_block(matroska, blocks[i].bin.buf,
+                                       blocks[i].bin.data,
                                        blocks[i].bin.size, blocks[i].bin.pos,
                                        matroska->current_cluster.timecode,
                                        blocks[i].duration, is_keyframe,
@@ -2498,7 +2543,8 @@ static int matroska_parse_cluster(MatroskaDemuxContext *matroska)
             int is_keyframe = blocks[i].non_simple ? !blocks[i].reference : -1;
             if (!blocks[i].non_simple)
                 blocks[i].duration = AV_NOPTS_VALUE;
-            res = matroska_parse_block(matroska, blocks[i].bin.data,
+            res = matroska_parse_block(matroska, blocks[i].bin.buf,
+                                       blocks[i].bin.data,
                                        blocks[i].bin.size, blocks[i].bin.pos,
                                        cluster.timecode, blocks[i].duration,
                                        is_keyframe, pos);
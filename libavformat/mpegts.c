@@ -28,6 +28,7 @@
 #include "libavutil/opt.h"
 #include "libavcodec/bytestream.h"
 #include "libavcodec/get_bits.h"
+#include "libavcodec/internal.h"
 #include "avformat.h"
 #include "mpegts.h"
 #include "internal.h"
@@ -92,6 +93,19 @@ struct MpegTSFilter {
 };
 
 #define MAX_PIDS_PER_PROGRAM 64
+typedef struct TSIndexEntry {
+    int pid;
+    int64_t pos;
+    int64_t timestamp;
+} TSIndexEntry;
+
+/* timestamps of a pid between which every keyframe is in the index */
+typedef struct TSIndexRange {
+    int pid;
+    int64_t start, end;
+    int from_start;     /* no keyframes precede start in the input */
+} TSIndexRange;
+
 struct Program {
     unsigned int id; // program id/service id
     unsigned int nb_pids;
@@ -135,6 +149,23 @@ struct MpegTSContext {
 
     int resync_size;
 
+    /** random_access_indicator of the TS packet being handled */
+    int random_access;
+
+    /** sidecar file the keyframe index is loaded from and saved to */
+    char *index_file;
+    /** keyframe index entries loaded from index_file */
+    struct TSIndexEntry *loaded_index;
+    int nb_loaded_index;
+    /** ranges of the keyframe index that have no gaps */
+    TSIndexRange *index_ranges;
+    int nb_index_ranges;
+    int index_ranges_allocated;
+    /** the input has been read without a gap from its start */
+    int index_from_start;
+    /** set when the keyframe index got new entries */
+    int index_dirty;
+
     /******************************************/
     /* private mpegts data */
     /* scan context */
@@ -142,6 +173,10 @@ struct MpegTSContext {
     unsigned int nb_prg;
     struct Program *prg;
 
+    /** discard_pid() results plus one, 0 where not known yet */
+    uint8_t discard_cache[NB_PID_MAX];
+    int discard_cache_used;
+
     /** filters for various streams specified by PMT + for the PAT and PMT */
     MpegTSFilter *pids[NB_PID_MAX];
 };
@@ -157,6 +192,8 @@ static const AVOption options[] = {
      {.dbl = 0}, 0, INT_MAX, AV_OPT_FLAG_DECODING_PARAM },
     {"apid", "PID of the audio stream that must be found before we can start.", offsetof(MpegTSContext, apid), AV_OPT_TYPE_INT,
      {.dbl = 0}, 0, INT_MAX, AV_OPT_FLAG_DECODING_PARAM },
+    {"index_file", "File the keyframe index is loaded from and saved to.", offsetof(MpegTSContext, index_file), AV_OPT_TYPE_STRING,
+     {.str = NULL}, 0, 0, AV_OPT_FLAG_DECODING_PARAM },
     { NULL },
 };
 
@@ -201,6 +238,11 @@ enum MpegTSState {
 #define PES_HEADER_SIZE 9
 #define MAX_PES_HEADER_SIZE (9 + 255)
 
+/* PES buffers are at least this big, and their size is reconsidered
+ * every PES_POOL_WINDOW packets */
+#define PES_MIN_ALLOC   4096
+#define PES_POOL_WINDOW 32
+
 typedef struct PESContext {
     int pid;
     int pcr_pid; /**< if -1 then all packets containing PCR are considered */
@@ -220,15 +262,35 @@ typedef struct PESContext {
     int64_t ts_packet_pos; /**< position of first TS packet of this PES packet */
     uint8_t header[MAX_PES_HEADER_SIZE];
     AVBufferRef *buffer;
+    AVBufferPool *pool;
+    int pool_size;  /**< size of the buffers in pool, padding included */
+    int max_recent; /**< largest payload of the current pool window */
+    int nb_recent;
+    /** first keyframe indexed since the input was last read without a gap */
+    int64_t index_run_start;
+    /** and whether that read began at the start of the input */
+    int index_from_start;
+    /** drop the packets of the stream up to its next keyframe */
+    int skip_to_keyframe;
     SLConfigDescr sl;
 } PESContext;
 
 extern AVInputFormat ff_mpegts_demuxer;
 
+/* Forget the discard_pid() results, the programs or their pids changed. */
+static void reset_discard_cache(MpegTSContext *ts)
+{
+    if (ts->discard_cache_used)
+        memset(ts->discard_cache, 0, sizeof(ts->discard_cache));
+    ts->discard_cache_used = 0;
+}
+
 static void clear_program(MpegTSContext *ts, unsigned int programid)
 {
     int i;
 
+    reset_discard_cache(ts);
+
     for (i = 0; i < ts->nb_prg; i++)
         if (ts->prg[i].id == programid)
             ts->prg[i].nb_pids = 0;
@@ -236,6 +298,7 @@ static void clear_program(MpegTSContext *ts, unsigned int programid)
 
 static void clear_programs(MpegTSContext *ts)
 {
+    reset_discard_cache(ts);
     av_freep(&ts->prg);
     ts->nb_prg = 0;
 }
@@ -243,6 +306,8 @@ static void clear_programs(MpegTSContext *ts)
 static void add_pat_entry(MpegTSContext *ts, unsigned int programid)
 {
     struct Program *p;
+
+    reset_discard_cache(ts);
     if (av_reallocp_array(&ts->prg, ts->nb_prg + 1, sizeof(*ts->prg)) < 0) {
         ts->nb_prg = 0;
         return;
@@ -270,6 +335,7 @@ static void add_pid_to_pmt(MpegTSContext *ts, unsigned int programid,
     if (p->nb_pids >= MAX_PIDS_PER_PROGRAM)
         return;
     p->pids[p->nb_pids++] = pid;
+    reset_discard_cache(ts);
 }
 
 /**
@@ -314,6 +380,16 @@ static int discard_pid(MpegTSContext *ts, unsigned int pid)
     return !used && discarded;
 }
 
+/* discard_pid(), looked up once per pid until the programs change */
+static int discard_pid_cached(MpegTSContext *ts, unsigned int pid)
+{
+    if (!ts->discard_cache[pid]) {
+        ts->discard_cache[pid] = 1 + discard_pid(ts, pid);
+        ts->discard_cache_used = 1;
+    }
+    return ts->discard_cache[pid] - 1;
+}
+
 /**
  *  Assemble PES packets out of TS packets, and then call the "section_cb"
  *  function when they are complete.
@@ -427,6 +503,7 @@ static void mpegts_close_filter(MpegTSContext *ts, MpegTSFilter *filter)
     else if (filter->type == MPEGTS_PES) {
         PESContext *pes = filter->u.pes_filter.opaque;
         av_buffer_unref(&pes->buffer);
+        av_buffer_pool_uninit(&pes->pool);
         /* referenced private data will be freed later in
          * avformat_close_input */
         if (!((PESContext *)filter->u.pes_filter.opaque)->st) {
@@ -703,6 +780,182 @@ static int mpegts_set_stream_info(AVStream *st, PESContext *pes,
     return 0;
 }
 
+/**
+ * Check whether the first coded picture in a video PES payload is a
+ * random access point.
+ */
+static int is_video_keyframe(enum AVCodecID codec_id,
+                             const uint8_t *p, const uint8_t *end)
+{
+    uint32_t state = -1;
+
+    while (p < end) {
+        p = avpriv_find_start_code(p, end, &state);
+        if ((state & 0xffffff00) != 0x100)
+            break;
+        switch (codec_id) {
+        case AV_CODEC_ID_MPEG1VIDEO:
+        case AV_CODEC_ID_MPEG2VIDEO:
+            /* picture header: temporal_reference, picture_coding_type */
+            if (state == 0x100)
+                return end - p > 1 &&
+                       ((p[1] >> 3) & 7) == AV_PICTURE_TYPE_I;
+            break;
+        case AV_CODEC_ID_H264: {
+            int type = state & 0x1f;
+            if (type >= 1 && type <= 5)
+                return type == 5;
+            break;
+        }
+        case AV_CODEC_ID_HEVC: {
+            int type = (state >> 1) & 0x3f;
+            if (type < 32)
+                return type >= 16 && type <= 23;
+            break;
+        }
+        default:
+            return 0;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Record that every keyframe of pid between start and end is indexed,
+ * merging the range with those it overlaps.
+ */
+static int add_index_range(MpegTSContext *ts, int pid, int64_t start,
+                           int64_t end, int from_start)
+{
+    int i;
+
+    for (i = 0; i < ts->nb_index_ranges; i++) {
+        TSIndexRange *r = &ts->index_ranges[i];
+
+        if (r->pid != pid || r->end < start || r->start > end)
+            continue;
+        if (r->start <= start && r->end >= end &&
+            r->from_start >= from_start)
+            return 0;
+        start       = FFMIN(start, r->start);
+        end         = FFMAX(end,   r->end);
+        from_start |= r->from_start;
+        ts->index_ranges[i--] = ts->index_ranges[--ts->nb_index_ranges];
+    }
+
+    if (ts->nb_index_ranges == ts->index_ranges_allocated) {
+        int ret = av_reallocp_array(&ts->index_ranges,
+                                    2 * ts->index_ranges_allocated + 8,
+                                    sizeof(*ts->index_ranges));
+        if (ret < 0) {
+            ts->nb_index_ranges = ts->index_ranges_allocated = 0;
+            return ret;
+        }
+        ts->index_ranges_allocated = 2 * ts->index_ranges_allocated + 8;
+    }
+    ts->index_ranges[ts->nb_index_ranges].pid   = pid;
+    ts->index_ranges[ts->nb_index_ranges].start = start;
+    ts->index_ranges[ts->nb_index_ranges].end   = end;
+    ts->index_ranges[ts->nb_index_ranges].from_start = from_start;
+    ts->nb_index_ranges++;
+    ts->index_dirty = 1;
+    return 0;
+}
+
+/* check whether the index has every keyframe of pid around timestamp */
+static int index_covers(MpegTSContext *ts, int pid, int64_t timestamp)
+{
+    int i;
+
+    for (i = 0; i < ts->nb_index_ranges; i++)
+        if (ts->index_ranges[i].pid == pid &&
+            (ts->index_ranges[i].start <= timestamp ||
+             ts->index_ranges[i].from_start) &&
+            ts->index_ranges[i].end >= timestamp)
+            return 1;
+    return 0;
+}
+
+/*
+ * Flag the packet if it starts a video keyframe and add it to the keyframe
+ * index, packets without a timestamp are flagged but not indexed.
+ */
+static void index_keyframe(PESContext *pes, AVPacket *pkt)
+{
+    MpegTSContext *ts = pes->ts;
+    AVStream *st      = pes->st;
+    int64_t timestamp = pkt->dts != AV_NOPTS_VALUE ? pkt->dts : pkt->pts;
+    int nb_entries;
+
+    if (ts->stream->iformat != &ff_mpegts_demuxer ||
+        pkt->stream_index != st->index ||
+        st->codec->codec_type != AVMEDIA_TYPE_VIDEO)
+        return;
+
+    if (!(pkt->flags & AV_PKT_FLAG_KEY)) {
+        if (!is_video_keyframe(st->codec->codec_id, pkt->data,
+                               pkt->data + pkt->size))
+            return;
+        pkt->flags |= AV_PKT_FLAG_KEY;
+    }
+
+    if (timestamp == AV_NOPTS_VALUE)
+        return;
+
+    ff_reduce_index(ts->stream, st->index);
+    nb_entries = st->nb_index_entries;
+    av_add_index_entry(st, pkt->pos, timestamp, 0, 0, AVINDEX_KEYFRAME);
+    if (st->nb_index_entries > nb_entries)
+        ts->index_dirty = 1;
+
+    /* the input has been read without a gap since index_run_start */
+    if (pes->index_run_start == AV_NOPTS_VALUE)
+        pes->index_run_start = timestamp;
+    add_index_range(ts, pes->pid, pes->index_run_start, timestamp,
+                    pes->index_from_start);
+}
+
+/* Round a PES buffer size up to the size of the pool buffers for it. */
+static int pes_pool_size(int size)
+{
+    size = FFMAX(size, PES_MIN_ALLOC);
+    size = 1 << av_log2(2 * size - 1);
+    return FFMIN(size, MAX_PES_PAYLOAD + FF_INPUT_BUFFER_PADDING_SIZE);
+}
+
+/*
+ * Make sure the PES buffer can take size bytes of payload, moving what is
+ * in it to a larger buffer if needed. The buffers come from a pool per
+ * PES stream, which is replaced by one with larger buffers when they
+ * turn out to be too small.
+ */
+static int pes_reserve(PESContext *pes, int size)
+{
+    int alloc = size + FF_INPUT_BUFFER_PADDING_SIZE;
+    AVBufferRef *buf;
+
+    if (pes->buffer && pes->buffer->size >= alloc)
+        return 0;
+    if (alloc > pes->pool_size) {
+        av_buffer_pool_uninit(&pes->pool);
+        pes->pool_size = pes_pool_size(alloc);
+    }
+    if (!pes->pool) {
+        pes->pool = av_buffer_pool_init(pes->pool_size, av_buffer_alloc);
+        if (!pes->pool)
+            return AVERROR(ENOMEM);
+    }
+    buf = av_buffer_pool_get(pes->pool);
+    if (!buf)
+        return AVERROR(ENOMEM);
+    if (pes->buffer) {
+        memcpy(buf->data, pes->buffer->data, pes->data_index);
+        av_buffer_unref(&pes->buffer);
+    }
+    pes->buffer = buf;
+    return 0;
+}
+
 static void new_pes_packet(PESContext *pes, AVPacket *pkt)
 {
     av_init_packet(pkt);
@@ -730,6 +983,21 @@ static void new_pes_packet(PESContext *pes, AVPacket *pkt)
     pkt->pos   = pes->ts_packet_pos;
     pkt->flags = pes->flags;
 
+    index_keyframe(pes, pkt);
+
+    /* use smaller buffers once the payloads have become smaller */
+    pes->max_recent = FFMAX(pes->max_recent, pkt->size);
+    if (++pes->nb_recent == PES_POOL_WINDOW) {
+        int size = pes_pool_size(pes->max_recent +
+                                 FF_INPUT_BUFFER_PADDING_SIZE);
+        if (size < pes->pool_size) {
+            av_buffer_pool_uninit(&pes->pool);
+            pes->pool_size = size;
+        }
+        pes->max_recent = 0;
+        pes->nb_recent  = 0;
+    }
+
     /* reset pts values */
     pes->pts        = AV_NOPTS_VALUE;
     pes->dts        = AV_NOPTS_VALUE;
@@ -812,7 +1080,7 @@ static int mpegts_push_data(MpegTSFilter *filter,
     PESContext *pes   = filter->u.pes_filter.opaque;
     MpegTSContext *ts = pes->ts;
     const uint8_t *p;
-    int len, code;
+    int len, code, ret;
 
     if (!ts->pkt)
         return 0;
@@ -825,6 +1093,8 @@ static int mpegts_push_data(MpegTSFilter *filter,
         pes->state         = MPEGTS_HEADER;
         pes->data_index    = 0;
         pes->ts_packet_pos = pos;
+        if (ts->random_access)
+            pes->flags |= AV_PKT_FLAG_KEY;
     }
     p = buf;
     while (buf_size > 0) {
@@ -868,11 +1138,11 @@ static int mpegts_push_data(MpegTSFilter *filter,
                     if (!pes->total_size)
                         pes->total_size = MAX_PES_PAYLOAD;
 
-                    /* allocate pes buffer */
-                    pes->buffer = av_buffer_alloc(pes->total_size +
-                                                  FF_INPUT_BUFFER_PADDING_SIZE);
-                    if (!pes->buffer)
-                        return AVERROR(ENOMEM);
+                    /* get a pes buffer, unbounded ones grow as needed */
+                    ret = pes_reserve(pes, pes->total_size < MAX_PES_PAYLOAD ?
+                                      pes->total_size : 0);
+                    if (ret < 0)
+                        return ret;
 
                     if (code != 0x1bc && code != 0x1bf && /* program_stream_map, private_stream_2 */
                         code != 0x1f0 && code != 0x1f1 && /* ECM, EMM */
@@ -976,10 +1246,6 @@ skip:
                     pes->data_index + buf_size > pes->total_size) {
                     new_pes_packet(pes, ts->pkt);
                     pes->total_size = MAX_PES_PAYLOAD;
-                    pes->buffer = av_buffer_alloc(pes->total_size +
-                                                  FF_INPUT_BUFFER_PADDING_SIZE);
-                    if (!pes->buffer)
-                        return AVERROR(ENOMEM);
                     ts->stop_parse = 1;
                 } else if (pes->data_index == 0 &&
                            buf_size > pes->total_size) {
@@ -987,6 +1253,8 @@ skip:
                     // not sure if this is legal in ts but see issue #2392
                     buf_size = pes->total_size;
                 }
+                if ((ret = pes_reserve(pes, pes->data_index + buf_size)) < 0)
+                    return ret;
                 memcpy(pes->buffer->data + pes->data_index, p, buf_size);
                 pes->data_index += buf_size;
             }
@@ -1027,6 +1295,8 @@ static PESContext *add_pes_stream(MpegTSContext *ts, int pid, int pcr_pid)
     pes->state   = MPEGTS_SKIP;
     pes->pts     = AV_NOPTS_VALUE;
     pes->dts     = AV_NOPTS_VALUE;
+    pes->index_run_start  = AV_NOPTS_VALUE;
+    pes->index_from_start = ts->index_from_start;
     tss          = mpegts_open_pes_filter(ts, pid, mpegts_push_data, pes);
     if (!tss) {
         av_free(pes);
@@ -1765,7 +2035,7 @@ static int handle_packet(MpegTSContext *ts, const uint8_t *packet)
     int64_t pos;
 
     pid = AV_RB16(packet + 1) & 0x1fff;
-    if (pid && discard_pid(ts, pid))
+    if (pid && discard_pid_cached(ts, pid))
         return 0;
     is_start = packet[1] & 0x40;
     tss = ts->pids[pid];
@@ -1819,6 +2089,8 @@ av_log(s, AV_LOG_ERROR, "GOT CODECS!\n");
     is_discontinuity = has_adaptation &&
                        packet[4] != 0 && /* with length > 0 */
                        (packet[5] & 0x80); /* and discontinuity indicated */
+    ts->random_access = has_adaptation && packet[4] != 0 &&
+                        (packet[5] & 0x40);
 
     /* continuity check (currently not used) */
     cc = (packet[3] & 0xf);
@@ -1896,9 +2168,22 @@ static int mpegts_resync(AVFormatContext *s)
 {
     MpegTSContext *ts = s->priv_data;
     AVIOContext *pb = s->pb;
-    int c, i;
-
-    for (i = 0; i < ts->resync_size; i++) {
+    const uint8_t *sync;
+    int c, i, len;
+
+    for (i = 0; i < ts->resync_size; i += len) {
+        /* search what is buffered at once, refill the buffer otherwise */
+        len = FFMIN(pb->buf_end - pb->buf_ptr, ts->resync_size - i);
+        if (len > 0) {
+            sync = memchr(pb->buf_ptr, 0x47, len);
+            if (sync) {
+                pb->buf_ptr += sync - pb->buf_ptr;
+                return 0;
+            }
+            pb->buf_ptr += len;
+            continue;
+        }
+        len = 1;
         c = avio_r8(pb);
         if (pb->eof_reached)
             return AVERROR_EOF;
@@ -1950,13 +2235,14 @@ static void finished_reading_packet(AVFormatContext *s, int raw_packet_size)
 static int handle_packets(MpegTSContext *ts, int nb_packets)
 {
     AVFormatContext *s = ts->stream;
+    AVIOContext *pb   = s->pb;
     uint8_t packet[TS_PACKET_SIZE + FF_INPUT_BUFFER_PADDING_SIZE];
     const uint8_t *data;
-    int packet_num, ret = 0;
+    int packet_num, pid, i, ret = 0;
 
     if (avio_tell(s->pb) != ts->last_pos) {
-        int i;
         av_dlog(ts->stream, "Skipping after seek\n");
+        ts->index_from_start = avio_tell(s->pb) <= s->data_offset;
         /* seek detected, flush pes buffer */
         for (i = 0; i < NB_PID_MAX; i++) {
             if (ts->pids[i]) {
@@ -1965,11 +2251,24 @@ static int handle_packets(MpegTSContext *ts, int nb_packets)
                     av_buffer_unref(&pes->buffer);
                     pes->data_index = 0;
                     pes->state = MPEGTS_SKIP; /* skip until pes header */
+                    pes->index_run_start  = AV_NOPTS_VALUE;
+                    pes->index_from_start = ts->index_from_start;
                 }
                 ts->pids[i]->last_cc = -1;
             }
         }
     }
+    /* the keyframes of discarded streams are not indexed */
+    for (i = 0; i < s->nb_streams; i++) {
+        PESContext *pes = s->streams[i]->priv_data;
+        if (pes && s->streams[i]->discard >= AVDISCARD_ALL) {
+            pes->index_run_start  = AV_NOPTS_VALUE;
+            pes->index_from_start = 0;
+        }
+    }
+
+    /* the programs may have been selected differently since the last call */
+    reset_discard_cache(ts);
 
     ts->stop_parse = 0;
     packet_num = 0;
@@ -1980,6 +2279,24 @@ static int handle_packets(MpegTSContext *ts, int nb_packets)
         packet_num++;
         if (nb_packets != 0 && packet_num >= nb_packets)
             break;
+        /* Work on the packets in the AVIOContext buffer in place, dropping
+         * those of discarded pids without any further parsing. */
+        if (pb->buf_end - pb->buf_ptr >= ts->raw_packet_size &&
+            pb->buf_ptr[0] == 0x47) {
+            data = pb->buf_ptr;
+            pid  = AV_RB16(data + 1) & 0x1fff;
+            if (pid && discard_pid_cached(ts, pid)) {
+                pb->buf_ptr += ts->raw_packet_size;
+                continue;
+            }
+            /* handle_packet() expects to be right behind the TS packet */
+            pb->buf_ptr += TS_PACKET_SIZE;
+            ret = handle_packet(ts, data);
+            pb->buf_ptr += ts->raw_packet_size - TS_PACKET_SIZE;
+            if (ret != 0)
+                break;
+            continue;
+        }
         ret = read_packet(s, packet, ts->raw_packet_size, &data);
         if (ret != 0)
             break;
@@ -2051,6 +2368,143 @@ static int parse_pcr(int64_t *ppcr_high, int *ppcr_low, const uint8_t *packet)
     return 0;
 }
 
+#define INDEX_FILE_HEADER "mpegts-index 2"
+
+/**
+ * Read the keyframe index saved by save_index(). The entries are kept
+ * aside until the streams of their PIDs exist, the ranges without gaps
+ * are only trusted if all entries are valid for the input.
+ */
+static void load_index(AVFormatContext *s)
+{
+    MpegTSContext *ts = s->priv_data;
+    int64_t size      = avio_size(s->pb);
+    AVIOContext *pb;
+    TSIndexRange *ranges = NULL;
+    int nb_ranges = 0, invalid = 0, i;
+    char line[128];
+
+    if (avio_open2(&pb, ts->index_file, AVIO_FLAG_READ,
+                   &s->interrupt_callback, NULL) < 0)
+        return;
+
+    ff_get_line(pb, line, sizeof(line));
+    if (strncmp(line, INDEX_FILE_HEADER, strlen(INDEX_FILE_HEADER))) {
+        av_log(s, AV_LOG_WARNING, "Ignoring invalid index file %s\n",
+               ts->index_file);
+        goto end;
+    }
+
+    while (!pb->eof_reached) {
+        TSIndexEntry e;
+        TSIndexRange r;
+
+        if (!ff_get_line(pb, line, sizeof(line)))
+            break;
+        if (sscanf(line, "range %d %"SCNd64" %"SCNd64" %d",
+                   &r.pid, &r.start, &r.end, &r.from_start) == 4) {
+            if (r.start > r.end ||
+                av_reallocp_array(&ranges, nb_ranges + 1,
+                                  sizeof(*ranges)) < 0) {
+                invalid   = 1;
+                nb_ranges = 0;
+                continue;
+            }
+            ranges[nb_ranges++] = r;
+            continue;
+        }
+        if (sscanf(line, "%d %"SCNd64" %"SCNd64,
+                   &e.pid, &e.pos, &e.timestamp) != 3 ||
+            e.pos < 0 || (size > 0 && e.pos >= size)) {
+            invalid = 1;
+            continue;
+        }
+        if (av_reallocp_array(&ts->loaded_index, ts->nb_loaded_index + 1,
+                              sizeof(*ts->loaded_index)) < 0) {
+            ts->nb_loaded_index = 0;
+            invalid = 1;
+            break;
+        }
+        ts->loaded_index[ts->nb_loaded_index++] = e;
+    }
+    if (invalid)
+        av_log(s, AV_LOG_WARNING, "Index file %s does not match the input, "
+               "searching the file for seeks\n", ts->index_file);
+    else
+        for (i = 0; i < nb_ranges; i++)
+            add_index_range(ts, ranges[i].pid, ranges[i].start,
+                            ranges[i].end, ranges[i].from_start);
+    av_log(s, AV_LOG_VERBOSE, "Loaded %d index entries from %s\n",
+           ts->nb_loaded_index, ts->index_file);
+    av_free(ranges);
+    ts->index_dirty = 0;
+
+end:
+    avio_close(pb);
+}
+
+/* move the loaded index entries to the streams that now exist */
+static void apply_loaded_index(AVFormatContext *s)
+{
+    MpegTSContext *ts = s->priv_data;
+    int i, j, left = 0;
+
+    for (i = 0; i < ts->nb_loaded_index; i++) {
+        TSIndexEntry *e = &ts->loaded_index[i];
+
+        for (j = 0; j < s->nb_streams; j++)
+            if (s->streams[j]->id == e->pid &&
+                s->streams[j]->codec->codec_type == AVMEDIA_TYPE_VIDEO)
+                break;
+        if (j < s->nb_streams)
+            av_add_index_entry(s->streams[j], e->pos, e->timestamp,
+                               0, 0, AVINDEX_KEYFRAME);
+        else
+            ts->loaded_index[left++] = *e;
+    }
+    ts->nb_loaded_index = left;
+    if (!left)
+        av_freep(&ts->loaded_index);
+}
+
+static void save_index(AVFormatContext *s)
+{
+    MpegTSContext *ts = s->priv_data;
+    AVIOContext *pb;
+    int i, j;
+
+    if (!ts->index_file || !ts->index_dirty)
+        return;
+
+    if (avio_open2(&pb, ts->index_file, AVIO_FLAG_WRITE,
+                   &s->interrupt_callback, NULL) < 0) {
+        av_log(s, AV_LOG_WARNING, "Could not write index file %s\n",
+               ts->index_file);
+        return;
+    }
+
+    avio_printf(pb, INDEX_FILE_HEADER "\n");
+    for (i = 0; i < s->nb_streams; i++) {
+        AVStream *st = s->streams[i];
+
+        for (j = 0; j < st->nb_index_entries; j++) {
+            AVIndexEntry *e = &st->index_entries[j];
+            if (e->flags & AVINDEX_KEYFRAME)
+                avio_printf(pb, "%d %"PRId64" %"PRId64"\n",
+                            st->id, e->pos, e->timestamp);
+        }
+    }
+    for (i = 0; i < ts->nb_loaded_index; i++)
+        avio_printf(pb, "%d %"PRId64" %"PRId64"\n",
+                    ts->loaded_index[i].pid, ts->loaded_index[i].pos,
+                    ts->loaded_index[i].timestamp);
+    for (i = 0; i < ts->nb_index_ranges; i++)
+        avio_printf(pb, "range %d %"PRId64" %"PRId64" %d\n",
+                    ts->index_ranges[i].pid, ts->index_ranges[i].start,
+                    ts->index_ranges[i].end, ts->index_ranges[i].from_start);
+    avio_close(pb);
+}
+
 static int mpegts_read_header(AVFormatContext *s)
 {
     MpegTSContext *ts = s->priv_data;
@@ -2071,6 +2525,7 @@ static int mpegts_read_header(AVFormatContext *s)
         return AVERROR_INVALIDDATA;
     ts->stream     = s;
     ts->auto_guess = 0;
+    ts->index_from_start = 1;
 
     if (s->iformat == &ff_mpegts_demuxer) {
         /* normal demux */
@@ -2091,6 +2546,11 @@ static int mpegts_read_header(AVFormatContext *s)
 
         av_dlog(ts->stream, "tuning done\n");
 
+        if (ts->index_file) {
+            load_index(s);
+            apply_loaded_index(s);
+        }
+
         s->ctx_flags |= AVFMTCTX_NOHEADER;
     } else {
         AVStream *st;
@@ -2201,23 +2661,37 @@ static int mpegts_raw_read_packet(AVFormatContext *s, AVPacket *pkt)
 static int mpegts_read_packet(AVFormatContext *s, AVPacket *pkt)
 {
     MpegTSContext *ts = s->priv_data;
+    PESContext *pes;
     int ret, i;
 
-    pkt->size = -1;
-    ts->pkt = pkt;
-    ret = handle_packets(ts, 0);
-    if (ret < 0) {
-        /* flush pes data left */
-        for (i = 0; i < NB_PID_MAX; i++)
-            if (ts->pids[i] && ts->pids[i]->type == MPEGTS_PES) {
-                PESContext *pes = ts->pids[i]->u.pes_filter.opaque;
-                if (pes->state == MPEGTS_PAYLOAD && pes->data_index > 0) {
-                    new_pes_packet(pes, pkt);
-                    pes->state = MPEGTS_SKIP;
-                    ret = 0;
-                    break;
+    for (;;) {
+        pkt->size = -1;
+        ts->pkt = pkt;
+        ret = handle_packets(ts, 0);
+        if (ret < 0) {
+            /* flush pes data left */
+            for (i = 0; i < NB_PID_MAX; i++)
+                if (ts->pids[i] && ts->pids[i]->type == MPEGTS_PES) {
+                    pes = ts->pids[i]->u.pes_filter.opaque;
+                    if (pes->state == MPEGTS_PAYLOAD && pes->data_index > 0) {
+                        new_pes_packet(pes, pkt);
+                        pes->state = MPEGTS_SKIP;
+                        ret = 0;
+                        break;
+                    }
                 }
-            }
+        }
+        if (ret || pkt->size < 0)
+            break;
+
+        /* after a seek, start the video streams at a keyframe */
+        pes = s->streams[pkt->stream_index]->priv_data;
+        if (!pes || !pes->skip_to_keyframe || (pkt->flags & AV_PKT_FLAG_KEY)) {
+            if (pes)
+                pes->skip_to_keyframe = 0;
+            break;
+        }
+        av_free_packet(pkt);
     }
 
     if (!ret && pkt->size < 0)
@@ -2234,11 +2708,17 @@ static void mpegts_free(MpegTSContext *ts)
     for (i = 0; i < NB_PID_MAX; i++)
         if (ts->pids[i])
             mpegts_close_filter(ts, ts->pids[i]);
+
+    av_freep(&ts->loaded_index);
+    ts->nb_loaded_index = 0;
+    av_freep(&ts->index_ranges);
+    ts->nb_index_ranges = ts->index_ranges_allocated = 0;
 }
 
 static int mpegts_read_close(AVFormatContext *s)
 {
     MpegTSContext *ts = s->priv_data;
+    save_index(s);
     mpegts_free(ts);
     return 0;
 }
@@ -2288,15 +2768,45 @@ static int64_t mpegts_get_pcr(AVFormatContext *s, int stream_index,
 static int read_seek(AVFormatContext *s, int stream_index, int64_t target_ts, int flags)
 {
     MpegTSContext *ts = s->priv_data;
+    AVStream *st      = s->streams[stream_index];
     uint8_t buf[TS_PACKET_SIZE];
-    int64_t pos;
-    int ret;
+    int64_t pos, pcr;
+    int ret, index, i;
+
+    /* Video streams in which keyframes were found before are started at
+     * the next one. Without keyframe detection for the codec nothing
+     * would be output. */
+    for (i = 0; i < s->nb_streams; i++) {
+        PESContext *pes = s->streams[i]->priv_data;
+        if (pes && s->streams[i]->codec->codec_type == AVMEDIA_TYPE_VIDEO)
+            pes->skip_to_keyframe = s->streams[i]->nb_index_entries > 0;
+    }
 
-    ret = ff_seek_frame_binary(s, stream_index, target_ts, flags);
-    if (ret < 0)
-        return ret;
+    /* Seek with the index where it holds every keyframe around the
+     * target. Parts of the input that were skipped or not read yet have
+     * no entries, search those. A target before the first keyframe of
+     * the input is served by that keyframe, even when seeking backward. */
+    apply_loaded_index(s);
+    if (index_covers(ts, st->id, target_ts) &&
+        ((index = av_index_search_timestamp(st, target_ts, flags)) >= 0 ||
+         (index = av_index_search_timestamp(st, target_ts,
+                                            flags & ~AVSEEK_FLAG_BACKWARD)) >= 0)) {
+        AVIndexEntry *e = &st->index_entries[index];
+
+        if ((ret = avio_seek(s->pb, e->pos, SEEK_SET)) < 0)
+            return ret;
+        ff_update_cur_dts(s, st, e->timestamp);
+        return 0;
+    }
 
-    pos = avio_tell(s->pb);
+    /* the index holds DTS while the search compares PCRs, so do not let
+     * ff_seek_frame_binary() take its bounds from the index */
+    pos = ff_gen_search(s, stream_index, target_ts, 0, 0, -1,
+                        AV_NOPTS_VALUE, AV_NOPTS_VALUE, flags, &pcr,
+                        mpegts_get_pcr);
+    if (pos < 0)
+        return -1;
+    ff_update_cur_dts(s, st, pcr);
 
     for (;;) {
         avio_seek(s->pb, pos, SEEK_SET);
@@ -30,11 +30,18 @@
 #include "avio_internal.h"
 #include "libavutil/parseutils.h"
 #include "libavutil/avstring.h"
+#include "libavutil/fifo.h"
+#include "libavutil/intreadwrite.h"
+#include "libavutil/time.h"
 #include "internal.h"
 #include "network.h"
 #include "os_support.h"
 #include "url.h"
 
+#if HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
 #ifndef IPV6_ADD_MEMBERSHIP
 #define IPV6_ADD_MEMBERSHIP IPV6_JOIN_GROUP
 #define IPV6_DROP_MEMBERSHIP IPV6_LEAVE_GROUP
@@ -50,10 +57,26 @@ typedef struct {
     struct sockaddr_storage dest_addr;
     int dest_addr_len;
     int is_connected;
+
+    /* receive thread and the datagram fifo it fills */
+    int fifo_size;
+    int overrun_nonfatal;
+    AVFifoBuffer *fifo;
+    int fifo_error;
+    int overruns;
+    int in_overrun;
+    volatile int close_req;
+#if HAVE_PTHREADS
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    int thread_started;
+#endif
 } UDPContext;
 
 #define UDP_TX_BUF_SIZE 32768
 #define UDP_MAX_PKT_SIZE 65536
+#define UDP_FIFO_UNIT 188
 
 static void log_net_error(void *ctx, int level, const char* prefix)
 {
@@ -378,6 +401,62 @@ static int udp_get_file_handle(URLContext *h)
     return s->udp_fd;
 }
 
+#if HAVE_PTHREADS
+/**
+ * Drain the socket into the fifo so that datagrams are not lost in the
+ * kernel while the reader is busy. Each datagram is stored with a 32-bit
+ * length prefix.
+ */
+static void *udp_receive_thread(void *arg)
+{
+    URLContext *h = arg;
+    UDPContext *s = h->priv_data;
+    uint8_t tmp[UDP_MAX_PKT_SIZE + 4];
+    int ret, len;
+
+    while (!s->close_req) {
+        ret = ff_network_wait_fd(s->udp_fd, 0);
+        if (ret == AVERROR(EAGAIN) || ret == AVERROR(EINTR))
+            continue;
+        if (ret >= 0) {
+            len = recv(s->udp_fd, tmp + 4, sizeof(tmp) - 4, 0);
+            if (len < 0) {
+                ret = ff_neterrno();
+                if (ret == AVERROR(EAGAIN) || ret == AVERROR(EINTR))
+                    continue;
+            }
+        }
+
+        pthread_mutex_lock(&s->mutex);
+        if (ret < 0) {
+            s->fifo_error = ret;
+        } else if (av_fifo_space(s->fifo) < len + 4) {
+            s->overruns++;
+            if (!s->overrun_nonfatal) {
+                av_log(h, AV_LOG_ERROR, "Receive fifo overrun. "
+                       "Increase fifo_size or set overrun_nonfatal=1.\n");
+                s->fifo_error = AVERROR(EIO);
+            } else if (!s->in_overrun) {
+                av_log(h, AV_LOG_WARNING, "Receive fifo overrun, "
+                       "dropping datagrams (%d so far)\n", s->overruns);
+            }
+            s->in_overrun = 1;
+        } else {
+            AV_WL32(tmp, len);
+            av_fifo_generic_write(s->fifo, tmp, len + 4, NULL);
+            s->in_overrun = 0;
+        }
+        pthread_cond_signal(&s->cond);
+        ret = s->fifo_error;
+        pthread_mutex_unlock(&s->mutex);
+        if (ret < 0)
+            break;
+    }
+
+    return NULL;
+}
+#endif
+
 static int parse_source_list(char *buf, char **sources, int *num_sources,
                              int max_sources)
 {
@@ -461,6 +540,20 @@ static int udp_open(URLContext *h, const char *uri, int flags)
                                   FF_ARRAY_ELEMS(exclude_sources)))
                 goto fail;
         }
+        if (av_find_info_tag(buf, sizeof(buf), "fifo_size", p)) {
+            s->fifo_size = strtol(buf, NULL, 10);
+            if (s->fifo_size < 0 || s->fifo_size > INT_MAX / UDP_FIFO_UNIT) {
+                av_log(h, AV_LOG_ERROR, "Invalid fifo_size %s\n", buf);
+                goto fail;
+            }
+            s->fifo_size *= UDP_FIFO_UNIT;
+        }
+        if (av_find_info_tag(buf, sizeof(buf), "overrun_nonfatal", p)) {
+            char *endptr = NULL;
+            s->overrun_nonfatal = strtol(buf, &endptr, 10);
+            if (buf == endptr)
+                s->overrun_nonfatal = 1;
+        }
     }
 
     /* fill the dest addr */
@@ -566,10 +659,34 @@ static int udp_open(URLContext *h, const char *uri, int flags)
         av_freep(&exclude_sources[i]);
 
     s->udp_fd = udp_fd;
+
+    if (!is_output && s->fifo_size) {
+#if HAVE_PTHREADS
+        /* room for at least one full datagram and its length prefix */
+        s->fifo = av_fifo_alloc(FFMAX(s->fifo_size, UDP_MAX_PKT_SIZE + 4));
+        if (!s->fifo)
+            goto fail;
+        pthread_mutex_init(&s->mutex, NULL);
+        pthread_cond_init(&s->cond, NULL);
+        if (pthread_create(&s->thread, NULL, udp_receive_thread, h)) {
+            av_log(h, AV_LOG_ERROR, "pthread_create failed\n");
+            pthread_mutex_destroy(&s->mutex);
+            pthread_cond_destroy(&s->cond);
+            goto fail;
+        }
+        s->thread_started = 1;
+#else
+        av_log(h, AV_LOG_WARNING, "fifo_size is not supported "
+               "without pthreads, ignoring it\n");
+#endif
+    }
+
     return 0;
  fail:
     if (udp_fd >= 0)
         closesocket(udp_fd);
+    av_fifo_free(s->fifo);
+    s->fifo = NULL;
     for (i = 0; i < num_include_sources; i++)
         av_freep(&include_sources[i]);
     for (i = 0; i < num_exclude_sources; i++)
@@ -582,6 +699,38 @@ static int udp_read(URLContext *h, uint8_t *buf, int size)
     UDPContext *s = h->priv_data;
     int ret;
 
+#if HAVE_PTHREADS
+    if (s->fifo) {
+        pthread_mutex_lock(&s->mutex);
+        if (!av_fifo_size(s->fifo) && !s->fifo_error &&
+            !(h->flags & AVIO_FLAG_NONBLOCK)) {
+            /* wake up periodically so that the caller can check for
+             * interrupts, like ff_network_wait_fd() does */
+            int64_t t = av_gettime() + 100000;
+            struct timespec tv = { .tv_sec  =  t / 1000000,
+                                   .tv_nsec = (t % 1000000) * 1000 };
+            pthread_cond_timedwait(&s->cond, &s->mutex, &tv);
+        }
+        if (av_fifo_size(s->fifo)) {
+            uint8_t tmp[4];
+            int len;
+
+            av_fifo_generic_read(s->fifo, tmp, 4, NULL);
+            len = AV_RL32(tmp);
+            ret = FFMIN(len, size);
+            av_fifo_generic_read(s->fifo, buf, ret, NULL);
+            av_fifo_drain(s->fifo, len - ret);
+            if (len > size)
+                av_log(h, AV_LOG_WARNING, "Datagram truncated from %d to %d "
+                       "bytes\n", len, size);
+        } else {
+            ret = s->fifo_error ? s->fifo_error : AVERROR(EAGAIN);
+        }
+        pthread_mutex_unlock(&s->mutex);
+        return ret;
+    }
+#endif
+
     if (!(h->flags & AVIO_FLAG_NONBLOCK)) {
         ret = ff_network_wait_fd(s->udp_fd, 0);
         if (ret < 0)
@@ -616,6 +765,19 @@ static int udp_close(URLContext *h)
 {
     UDPContext *s = h->priv_data;
 
+#if HAVE_PTHREADS
+    if (s->thread_started) {
+        s->close_req = 1;
+        pthread_join(s->thread, NULL);
+        pthread_mutex_destroy(&s->mutex);
+        pthread_cond_destroy(&s->cond);
+        if (s->overruns)
+            av_log(h, AV_LOG_WARNING, "%d datagrams dropped on receive fifo "
+                   "overrun\n", s->overruns);
+    }
+#endif
+    av_fifo_free(s->fifo);
+
     if (s->is_multicast && (h->flags & AVIO_FLAG_READ))
         udp_leave_multicast_group(s->udp_fd, (struct sockaddr *)&s->dest_addr);
     closesocket(s->udp_fd);
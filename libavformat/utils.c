@@ -50,6 +50,10 @@
 #include "riff.h"
 #include "url.h"
 
+#if HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
 /**
  * @file
  * various utility functions for use within Libav
@@ -1836,17 +1840,11 @@ static int has_decode_delay_been_guessed(AVStream *st)
            st->info->nb_decoded_frames >= 6;
 }
 
-/* returns 1 or 0 if or if not decoded data was returned, or a negative error */
-static int try_decode_frame(AVStream *st, AVPacket *avpkt,
-                            AVDictionary **options)
+/* Open the decoder used for probing st, unless that was already tried. */
+static int open_probe_decoder(AVStream *st, AVDictionary **options)
 {
     const AVCodec *codec;
-    int got_picture = 1, ret = 0;
-    AVFrame *frame = av_frame_alloc();
-    AVPacket pkt = *avpkt;
-
-    if (!frame)
-        return AVERROR(ENOMEM);
+    int ret;
 
     if (!avcodec_is_open(st->codec) && !st->info->found_decoder) {
         AVDictionary *thread_opt = NULL;
@@ -1856,8 +1854,7 @@ static int try_decode_frame(AVStream *st, AVPacket *avpkt,
 
         if (!codec) {
             st->info->found_decoder = -1;
-            ret                     = -1;
-            goto fail;
+            return -1;
         }
 
         /* Force thread count to 1 since the H.264 decoder will not extract
@@ -1868,16 +1865,28 @@ static int try_decode_frame(AVStream *st, AVPacket *avpkt,
             av_dict_free(&thread_opt);
         if (ret < 0) {
             st->info->found_decoder = -1;
-            goto fail;
+            return ret;
         }
         st->info->found_decoder = 1;
     } else if (!st->info->found_decoder)
         st->info->found_decoder = 1;
 
-    if (st->info->found_decoder < 0) {
-        ret = -1;
+    return st->info->found_decoder < 0 ? -1 : 0;
+}
+
+/* returns 1 or 0 if or if not decoded data was returned, or a negative error */
+static int try_decode_frame(AVStream *st, AVPacket *avpkt,
+                            AVDictionary **options)
+{
+    int got_picture = 1, ret;
+    AVFrame *frame = av_frame_alloc();
+    AVPacket pkt = *avpkt;
+
+    if (!frame)
+        return AVERROR(ENOMEM);
+
+    if ((ret = open_probe_decoder(st, options)) < 0)
         goto fail;
-    }
 
     while ((pkt.size > 0 || (!pkt.data && got_picture)) &&
            ret >= 0 &&
@@ -1910,6 +1919,266 @@ fail:
     return ret;
 }
 
+/**
+ * Return the frame rate signalled in the bitstream, as exported by the
+ * decoder or parser, for the codecs known to export it exactly.
+ */
+static AVRational codec_frame_rate(AVStream *st)
+{
+    AVCodecContext *avctx = st->codec;
+    AVRational rate = { 0, 1 };
+
+    switch (avctx->codec_id) {
+    case AV_CODEC_ID_MPEG1VIDEO:
+    case AV_CODEC_ID_MPEG2VIDEO:
+    case AV_CODEC_ID_H264:
+    case AV_CODEC_ID_HEVC:
+        if (avctx->time_base.num > 0 && avctx->ticks_per_frame > 0 &&
+            avctx->time_base.num * avctx->ticks_per_frame * 1000LL >
+            avctx->time_base.den)
+            av_reduce(&rate.num, &rate.den, avctx->time_base.den,
+                      avctx->time_base.num * (int64_t)avctx->ticks_per_frame,
+                      INT_MAX);
+        break;
+    default:
+        break;
+    }
+    return rate;
+}
+
+/* Number of packets decoded together by AVFMT_FLAG_FAST_INFO. */
+#define PROBE_BATCH_SIZE 16
+
+typedef struct ProbePacket {
+    AVPacket *pkt;
+    AVDictionary **options;
+} ProbePacket;
+
+/**
+ * Decoding thread of one stream. The packets of the stream are queued by
+ * avformat_find_stream_info() and decoded when it flushes the queues;
+ * it waits meanwhile, so that the stream is only touched by one thread.
+ */
+typedef struct ProbeWorker {
+    struct ProbeContext *probe;
+    AVStream *st;
+    ProbePacket queue[PROBE_BATCH_SIZE];
+    int nb_queued;
+    int run;            /* set to have the queue decoded */
+    int threaded;
+#if HAVE_PTHREADS
+    pthread_t thread;
+#endif
+} ProbeWorker;
+
+typedef struct ProbeContext {
+    ProbeWorker **workers;
+    int nb_workers;
+    int nb_pending;     /* packets queued in all workers */
+#if HAVE_PTHREADS
+    int nb_running;
+    int quit;
+    pthread_mutex_t lock;
+    pthread_cond_t work_cond;
+    pthread_cond_t done_cond;
+#endif
+} ProbeContext;
+
+static void decode_probe_queue(ProbeWorker *w)
+{
+    int i;
+
+    for (i = 0; i < w->nb_queued; i++) {
+        try_decode_frame(w->st, w->queue[i].pkt, w->queue[i].options);
+        w->st->codec_info_nb_frames++;
+    }
+}
+
+#if HAVE_PTHREADS
+static void *probe_worker(void *arg)
+{
+    ProbeWorker *w   = arg;
+    ProbeContext *p = w->probe;
+
+    pthread_mutex_lock(&p->lock);
+    for (;;) {
+        while (!w->run && !p->quit)
+            pthread_cond_wait(&p->work_cond, &p->lock);
+        if (p->quit)
+            break;
+        pthread_mutex_unlock(&p->lock);
+
+        decode_probe_queue(w);
+
+        pthread_mutex_lock(&p->lock);
+        w->run = 0;
+        if (!--p->nb_running)
+            pthread_cond_signal(&p->done_cond);
+    }
+    pthread_mutex_unlock(&p->lock);
+    return NULL;
+}
+#endif
+
+static void init_probe(ProbeContext *p)
+{
+    memset(p, 0, sizeof(*p));
+#if HAVE_PTHREADS
+    pthread_mutex_init(&p->lock, NULL);
+    pthread_cond_init(&p->work_cond, NULL);
+    pthread_cond_init(&p->done_cond, NULL);
+#endif
+}
+
+/* Return the number of packets of st waiting to be decoded. */
+static int probe_queued(ProbeContext *p, AVStream *st)
+{
+    int i;
+
+    for (i = 0; i < p->nb_workers; i++)
+        if (p->workers[i]->st == st)
+            return p->workers[i]->nb_queued;
+    return 0;
+}
+
+/**
+ * Queue pkt for decoding on the thread of st, starting that thread with
+ * the first packet. The decoder is opened here, avcodec_open2() is not
+ * safe to call concurrently.
+ */
+static int queue_probe_packet(ProbeContext *p, AVStream *st, AVPacket *pkt,
+                              AVDictionary **options)
+{
+    ProbeWorker *w = NULL;
+    int i, ret;
+
+    if (open_probe_decoder(st, options) < 0) {
+        st->codec_info_nb_frames++;
+        return 0;
+    }
+
+    for (i = 0; i < p->nb_workers; i++)
+        if (p->workers[i]->st == st)
+            w = p->workers[i];
+    if (!w) {
+        if (!(w = av_mallocz(sizeof(*w))))
+            return AVERROR(ENOMEM);
+        if ((ret = av_reallocp_array(&p->workers, p->nb_workers + 1,
+                                     sizeof(*p->workers))) < 0) {
+            av_free(w);
+            p->nb_workers = 0;
+            return ret;
+        }
+        w->probe = p;
+        w->st    = st;
+        p->workers[p->nb_workers++] = w;
+#if HAVE_PTHREADS
+        w->threaded = !pthread_create(&w->thread, NULL, probe_worker, w);
+#endif
+    }
+
+    w->queue[w->nb_queued].pkt     = pkt;
+    w->queue[w->nb_queued].options = options;
+    w->nb_queued++;
+    p->nb_pending++;
+    return 0;
+}
+
+/* Decode all queued packets, the streams in parallel. */
+static void flush_probe(ProbeContext *p)
+{
+    int i;
+
+    if (!p->nb_pending)
+        return;
+#if HAVE_PTHREADS
+    pthread_mutex_lock(&p->lock);
+    for (i = 0; i < p->nb_workers; i++)
+        if (p->workers[i]->threaded && p->workers[i]->nb_queued) {
+            p->workers[i]->run = 1;
+            p->nb_running++;
+        }
+    pthread_cond_broadcast(&p->work_cond);
+    pthread_mutex_unlock(&p->lock);
+#endif
+    for (i = 0; i < p->nb_workers; i++)
+        if (!p->workers[i]->threaded)
+            decode_probe_queue(p->workers[i]);
+#if HAVE_PTHREADS
+    pthread_mutex_lock(&p->lock);
+    while (p->nb_running)
+        pthread_cond_wait(&p->done_cond, &p->lock);
+    pthread_mutex_unlock(&p->lock);
+#endif
+
+    for (i = 0; i < p->nb_workers; i++)
+        p->workers[i]->nb_queued = 0;
+    p->nb_pending = 0;
+}
+
+static void uninit_probe(ProbeContext *p)
+{
+    int i;
+
+    flush_probe(p);
+#if HAVE_PTHREADS
+    pthread_mutex_lock(&p->lock);
+    p->quit = 1;
+    pthread_cond_broadcast(&p->work_cond);
+    pthread_mutex_unlock(&p->lock);
+#endif
+    for (i = 0; i < p->nb_workers; i++) {
+#if HAVE_PTHREADS
+        if (p->workers[i]->threaded)
+            pthread_join(p->workers[i]->thread, NULL);
+#endif
+        av_free(p->workers[i]);
+    }
+    av_freep(&p->workers);
+    p->nb_workers = 0;
+#if HAVE_PTHREADS
+    pthread_mutex_destroy(&p->lock);
+    pthread_cond_destroy(&p->work_cond);
+    pthread_cond_destroy(&p->done_cond);
+#endif
+}
+
+/**
+ * Check whether more packets of st have to be read, i.e. it still lacks
+ * parameters or needs more frames for estimating them.
+ */
+static int stream_needs_probing(AVFormatContext *ic, AVStream *st)
+{
+    int fps_analyze_framecount = 20;
+
+    if (!has_codec_parameters(st))
+        return 1;
+    /* If the timebase is coarse (like the usual millisecond precision
+     * of mkv), we need to analyze more frames to reliably arrive at
+     * the correct fps. */
+    if (av_q2d(st->time_base) > 0.0005)
+        fps_analyze_framecount *= 2;
+    if (ic->fps_probe_size >= 0)
+        fps_analyze_framecount = ic->fps_probe_size;
+    /* variable fps and no guess at the real fps */
+    if (!st->avg_frame_rate.num &&
+        !(ic->flags & AVFMT_FLAG_FAST_INFO && codec_frame_rate(st).num) &&
+        st->codec_info_nb_frames < fps_analyze_framecount &&
+        st->codec->codec_type == AVMEDIA_TYPE_VIDEO)
+        return 1;
+    if (st->parser && st->parser->parser->split &&
+        !st->codec->extradata)
+        return 1;
+    if (st->first_dts == AV_NOPTS_VALUE &&
+        st->codec_info_nb_frames < ic->max_ts_probe &&
+        (st->codec->codec_type == AVMEDIA_TYPE_VIDEO ||
+         st->codec->codec_type == AVMEDIA_TYPE_AUDIO)) {
+        if (!(ic->flags & AVFMT_FLAG_NOFILLIN))
+            return 1;
+    }
+    return 0;
+}
+
 unsigned int ff_codec_get_tag(const AVCodecTag *tags, enum AVCodecID id)
 {
     while (tags->id != AV_CODEC_ID_NONE) {
@@ -2031,12 +2300,14 @@ static int get_std_framerate(int i)
 
 int avformat_find_stream_info(AVFormatContext *ic, AVDictionary **options)
 {
-    int i, count, ret, read_size, j;
+    int i, count, ret, read_size, j, nb_frames;
     AVStream *st;
     AVPacket pkt1, *pkt;
     int64_t old_offset  = avio_tell(ic->pb);
     // new streams might appear, no options for those
     int orig_nb_streams = ic->nb_streams;
+    int fast_info       = ic->flags & AVFMT_FLAG_FAST_INFO;
+    ProbeContext probe;
 
     for (i = 0; i < ic->nb_streams; i++) {
         const AVCodec *codec;
@@ -2077,6 +2348,8 @@ int avformat_find_stream_info(AVFormatContext *ic, AVDictionary **options)
         ic->streams[i]->info->fps_last_dts  = AV_NOPTS_VALUE;
     }
 
+    init_probe(&probe);
+
     count     = 0;
     read_size = 0;
     for (;;) {
@@ -2086,41 +2359,36 @@ int avformat_find_stream_info(AVFormatContext *ic, AVDictionary **options)
             break;
         }
 
-        /* check if one codec still needs to be handled */
-        for (i = 0; i < ic->nb_streams; i++) {
-            int fps_analyze_framecount = 20;
-
-            st = ic->streams[i];
-            if (!has_codec_parameters(st))
-                break;
-            /* If the timebase is coarse (like the usual millisecond precision
-             * of mkv), we need to analyze more frames to reliably arrive at
-             * the correct fps. */
-            if (av_q2d(st->time_base) > 0.0005)
-                fps_analyze_framecount *= 2;
-            if (ic->fps_probe_size >= 0)
-                fps_analyze_framecount = ic->fps_probe_size;
-            /* variable fps and no guess at the real fps */
-            if (!st->avg_frame_rate.num &&
-                st->codec_info_nb_frames < fps_analyze_framecount &&
-                st->codec->codec_type == AVMEDIA_TYPE_VIDEO)
-                break;
-            if (st->parser && st->parser->parser->split &&
-                !st->codec->extradata)
-                break;
-            if (st->first_dts == AV_NOPTS_VALUE &&
-                st->codec_info_nb_frames < ic->max_ts_probe &&
-                (st->codec->codec_type == AVMEDIA_TYPE_VIDEO ||
-                 st->codec->codec_type == AVMEDIA_TYPE_AUDIO)) {
-                if (!(ic->flags & AVFMT_FLAG_NOFILLIN)) {
+        /* With fastinfo, decode the queued packets once every stream that
+         * still needs probing has one, so that the checks below see their
+         * results. */
+        if (probe.nb_pending) {
+            for (i = 0; i < ic->nb_streams; i++)
+                if (!probe_queued(&probe, ic->streams[i]) &&
+                    stream_needs_probing(ic, ic->streams[i]))
                     break;
-                }
-            }
+            if (i == ic->nb_streams || probe.nb_pending >= PROBE_BATCH_SIZE ||
+                read_size >= ic->probesize)
+                flush_probe(&probe);
         }
-        if (i == ic->nb_streams) {
+
+        /* check if one codec still needs to be handled */
+        for (i = 0; !probe.nb_pending && i < ic->nb_streams; i++)
+            if (stream_needs_probing(ic, ic->streams[i]))
+                break;
+        if (!probe.nb_pending && i == ic->nb_streams) {
             /* NOTE: If the format has no header, then we need to read some
-             * packets to get most of the streams, so we cannot stop here. */
-            if (!(ic->ctx_flags & AVFMTCTX_NOHEADER)) {
+             * packets to get most of the streams, so we cannot stop here,
+             * unless we are asked to be fast and have decoded a frame of
+             * every stream found so far. */
+            j = -1;
+            if (fast_info && ic->nb_streams &&
+                ic->ctx_flags & AVFMTCTX_NOHEADER)
+                for (j = 0; j < ic->nb_streams; j++)
+                    if (!ic->streams[j]->codec_info_nb_frames)
+                        break;
+            if (!(ic->ctx_flags & AVFMTCTX_NOHEADER) ||
+                j == ic->nb_streams) {
                 /* If we found the info for all the codecs, we can stop. */
                 ret = count;
                 av_log(ic, AV_LOG_DEBUG, "All info found\n");
@@ -2147,6 +2415,8 @@ int avformat_find_stream_info(AVFormatContext *ic, AVDictionary **options)
             int err = 0;
             av_init_packet(&empty_pkt);
 
+            flush_probe(&probe);
+
             /* We could not have all the codec parameters before EOF. */
             ret = -1;
             for (i = 0; i < ic->nb_streams; i++) {
@@ -2188,7 +2458,9 @@ int avformat_find_stream_info(AVFormatContext *ic, AVDictionary **options)
         read_size += pkt->size;
 
         st = ic->streams[pkt->stream_index];
-        if (pkt->dts != AV_NOPTS_VALUE && st->codec_info_nb_frames > 1) {
+        /* the packets still queued for decoding are not counted yet */
+        nb_frames = st->codec_info_nb_frames + probe_queued(&probe, st);
+        if (pkt->dts != AV_NOPTS_VALUE && nb_frames > 1) {
             /* check for non-increasing dts */
             if (st->info->fps_last_dts != AV_NOPTS_VALUE &&
                 st->info->fps_last_dts >= pkt->dts) {
@@ -2196,8 +2468,7 @@ int avformat_find_stream_info(AVFormatContext *ic, AVDictionary **options)
                        "Non-increasing DTS in stream %d: packet %d with DTS "
                        "%"PRId64", packet %d with DTS %"PRId64"\n",
                        st->index, st->info->fps_last_dts_idx,
-                       st->info->fps_last_dts, st->codec_info_nb_frames,
-                       pkt->dts);
+                       st->info->fps_last_dts, nb_frames, pkt->dts);
                 st->info->fps_first_dts =
                 st->info->fps_last_dts  = AV_NOPTS_VALUE;
             }
@@ -2213,8 +2484,7 @@ int avformat_find_stream_info(AVFormatContext *ic, AVDictionary **options)
                        "DTS discontinuity in stream %d: packet %d with DTS "
                        "%"PRId64", packet %d with DTS %"PRId64"\n",
                        st->index, st->info->fps_last_dts_idx,
-                       st->info->fps_last_dts, st->codec_info_nb_frames,
-                       pkt->dts);
+                       st->info->fps_last_dts, nb_frames, pkt->dts);
                 st->info->fps_first_dts =
                 st->info->fps_last_dts  = AV_NOPTS_VALUE;
             }
@@ -2222,10 +2492,10 @@ int avformat_find_stream_info(AVFormatContext *ic, AVDictionary **options)
             /* update stored dts values */
             if (st->info->fps_first_dts == AV_NOPTS_VALUE) {
                 st->info->fps_first_dts     = pkt->dts;
-                st->info->fps_first_dts_idx = st->codec_info_nb_frames;
+                st->info->fps_first_dts_idx = nb_frames;
             }
             st->info->fps_last_dts     = pkt->dts;
-            st->info->fps_last_dts_idx = st->codec_info_nb_frames;
+            st->info->fps_last_dts_idx = nb_frames;
 
             /* check max_analyze_duration */
             if (av_rescale_q(pkt->dts - st->info->fps_first_dts, st->time_base,
@@ -2241,8 +2511,10 @@ int avformat_find_stream_info(AVFormatContext *ic, AVDictionary **options)
                 st->codec->extradata_size = i;
                 st->codec->extradata = av_mallocz(st->codec->extradata_size +
                                                   FF_INPUT_BUFFER_PADDING_SIZE);
-                if (!st->codec->extradata)
-                    return AVERROR(ENOMEM);
+                if (!st->codec->extradata) {
+                    ret = AVERROR(ENOMEM);
+                    goto find_stream_info_err;
+                }
                 memcpy(st->codec->extradata, pkt->data,
                        st->codec->extradata_size);
             }
@@ -2257,12 +2529,22 @@ int avformat_find_stream_info(AVFormatContext *ic, AVDictionary **options)
          * least one frame of codec data, this makes sure the codec initializes
          * the channel configuration and does not only trust the values from
          * the container. */
-        try_decode_frame(st, pkt,
-                         (options && i < orig_nb_streams) ? &options[i] : NULL);
-
-        st->codec_info_nb_frames++;
+        if (fast_info && pkt != &pkt1) {
+            /* decode on the thread of the stream, counted when decoded */
+            ret = queue_probe_packet(&probe, st, pkt,
+                                     options && st->index < orig_nb_streams ?
+                                     &options[st->index] : NULL);
+            if (ret < 0)
+                goto find_stream_info_err;
+        } else {
+            try_decode_frame(st, pkt,
+                             (options && i < orig_nb_streams) ? &options[i]
+                                                              : NULL);
+            st->codec_info_nb_frames++;
+        }
         count++;
     }
+    flush_probe(&probe);
 
     // close codecs which were opened in try_decode_frame()
     for (i = 0; i < ic->nb_streams; i++) {
@@ -2272,6 +2554,8 @@ int avformat_find_stream_info(AVFormatContext *ic, AVDictionary **options)
     for (i = 0; i < ic->nb_streams; i++) {
         st = ic->streams[i];
         if (st->codec->codec_type == AVMEDIA_TYPE_VIDEO) {
+            if (!st->avg_frame_rate.num && fast_info)
+                st->avg_frame_rate = codec_frame_rate(st);
             /* estimate average framerate if not set by demuxer */
             if (!st->avg_frame_rate.num &&
                 st->info->fps_last_dts != st->info->fps_first_dts) {
@@ -2338,6 +2622,7 @@ int avformat_find_stream_info(AVFormatContext *ic, AVDictionary **options)
     compute_chapters_end(ic);
 
 find_stream_info_err:
+    uninit_probe(&probe);
     for (i = 0; i < ic->nb_streams; i++) {
         ic->streams[i]->codec->thread_count = 0;
         av_freep(&ic->streams[i]->info);
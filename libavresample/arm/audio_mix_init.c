@@ -0,0 +1,79 @@
+/*
+ * This file is part of Libav.
+ *
+ * Libav is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * Libav is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Libav; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "config.h"
+#include "libavutil/attributes.h"
+#include "libavutil/cpu.h"
+#include "libavutil/arm/cpu.h"
+#include "libavutil/samplefmt.h"
+#include "libavresample/audio_mix.h"
+
+void ff_mix_2_to_1_fltp_flt_neon(float **src, float **matrix, int len,
+                                 int out_ch, int in_ch);
+void ff_mix_1_to_2_fltp_flt_neon(float **src, float **matrix, int len,
+                                 int out_ch, int in_ch);
+void ff_mix_2_to_1_s16p_flt_neon(int16_t **src, float **matrix, int len,
+                                 int out_ch, int in_ch);
+void ff_mix_2_to_1_s16p_q8_neon(int16_t **src, int16_t **matrix, int len,
+                                int out_ch, int in_ch);
+
+#define DEFINE_MIX_3_8_TO_1_2(chan)                                     \
+void ff_mix_ ## chan ## _to_1_fltp_flt_neon(float **src,                \
+                                            float **matrix, int len,    \
+                                            int out_ch, int in_ch);     \
+void ff_mix_ ## chan ## _to_2_fltp_flt_neon(float **src,                \
+                                            float **matrix, int len,    \
+                                            int out_ch, int in_ch);
+
+DEFINE_MIX_3_8_TO_1_2(3)
+DEFINE_MIX_3_8_TO_1_2(4)
+DEFINE_MIX_3_8_TO_1_2(5)
+DEFINE_MIX_3_8_TO_1_2(6)
+DEFINE_MIX_3_8_TO_1_2(7)
+DEFINE_MIX_3_8_TO_1_2(8)
+
+#define SET_MIX_3_8_TO_1_2(chan)                                            \
+    ff_audio_mix_set_func(am, AV_SAMPLE_FMT_FLTP, AV_MIX_COEFF_TYPE_FLT,    \
+                          chan, 1, 16, 4, "NEON",                           \
+                          ff_mix_ ## chan ## _to_1_fltp_flt_neon);          \
+    ff_audio_mix_set_func(am, AV_SAMPLE_FMT_FLTP, AV_MIX_COEFF_TYPE_FLT,    \
+                          chan, 2, 16, 4, "NEON",                           \
+                          ff_mix_ ## chan ## _to_2_fltp_flt_neon);
+
+av_cold void ff_audio_mix_init_arm(AudioMix *am)
+{
+    int cpu_flags = av_get_cpu_flags();
+
+    if (have_neon(cpu_flags)) {
+        ff_audio_mix_set_func(am, AV_SAMPLE_FMT_FLTP, AV_MIX_COEFF_TYPE_FLT,
+                              2, 1, 16, 8, "NEON", ff_mix_2_to_1_fltp_flt_neon);
+        ff_audio_mix_set_func(am, AV_SAMPLE_FMT_FLTP, AV_MIX_COEFF_TYPE_FLT,
+                              1, 2, 16, 8, "NEON", ff_mix_1_to_2_fltp_flt_neon);
+        ff_audio_mix_set_func(am, AV_SAMPLE_FMT_S16P, AV_MIX_COEFF_TYPE_FLT,
+                              2, 1, 16, 8, "NEON", ff_mix_2_to_1_s16p_flt_neon);
+        ff_audio_mix_set_func(am, AV_SAMPLE_FMT_S16P, AV_MIX_COEFF_TYPE_Q8,
+                              2, 1, 16, 8, "NEON", ff_mix_2_to_1_s16p_q8_neon);
+
+        SET_MIX_3_8_TO_1_2(3)
+        SET_MIX_3_8_TO_1_2(4)
+        SET_MIX_3_8_TO_1_2(5)
+        SET_MIX_3_8_TO_1_2(6)
+        SET_MIX_3_8_TO_1_2(7)
+        SET_MIX_3_8_TO_1_2(8)
+    }
+}
@@ -325,6 +325,10 @@ static av_cold int mix_function_init(AudioMix *am)
     ff_audio_mix_set_func(am, AV_SAMPLE_FMT_FLTP, AV_MIX_COEFF_TYPE_FLT,
                           2, 6, 1, 1, "C", mix_2_to_6_fltp_flt_c);
 
+    if (ARCH_AARCH64)
+        ff_audio_mix_init_aarch64(am);
+    if (ARCH_ARM)
+        ff_audio_mix_init_arm(am);
     if (ARCH_X86)
         ff_audio_mix_init_x86(am);
 
@@ -0,0 +1,137 @@
+/*
+ * This file is part of Libav.
+ *
+ * Libav is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * Libav is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Libav; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "config.h"
+#include "libavutil/attributes.h"
+#include "libavutil/arm/cpu.h"
+#include "libavutil/mem.h"
+#include "libswscale/swscale.h"
+#include "libswscale/swscale_internal.h"
+
+typedef void (*yuv2rgb_line_fn)(uint8_t *dst, const uint8_t *y,
+                                const uint8_t *u, const uint8_t *v,
+                                int width, const int16_t coeffs[8]);
+
+#define YUV2RGB_FUNCS(src)                                                    \
+void ff_ ## src ## _to_rgba_neon(uint8_t *dst, const uint8_t *y,             \
+                                 const uint8_t *u, const uint8_t *v,         \
+                                 int width, const int16_t coeffs[8]);        \
+void ff_ ## src ## _to_bgra_neon(uint8_t *dst, const uint8_t *y,             \
+                                 const uint8_t *u, const uint8_t *v,         \
+                                 int width, const int16_t coeffs[8]);        \
+void ff_ ## src ## _to_argb_neon(uint8_t *dst, const uint8_t *y,             \
+                                 const uint8_t *u, const uint8_t *v,         \
+                                 int width, const int16_t coeffs[8]);        \
+void ff_ ## src ## _to_abgr_neon(uint8_t *dst, const uint8_t *y,             \
+                                 const uint8_t *u, const uint8_t *v,         \
+                                 int width, const int16_t coeffs[8]);        \
+void ff_ ## src ## _to_rgb565_neon(uint8_t *dst, const uint8_t *y,           \
+                                   const uint8_t *u, const uint8_t *v,       \
+                                   int width, const int16_t coeffs[8]);      \
+                                                                              \
+static yuv2rgb_line_fn src ## _line_func(enum AVPixelFormat fmt)              \
+{                                                                             \
+    switch (fmt) {                                                            \
+    case AV_PIX_FMT_RGBA:   return ff_ ## src ## _to_rgba_neon;               \
+    case AV_PIX_FMT_BGRA:   return ff_ ## src ## _to_bgra_neon;               \
+    case AV_PIX_FMT_ARGB:   return ff_ ## src ## _to_argb_neon;               \
+    case AV_PIX_FMT_ABGR:   return ff_ ## src ## _to_abgr_neon;               \
+    case AV_PIX_FMT_RGB565: return ff_ ## src ## _to_rgb565_neon;             \
+    default:                return NULL;                                      \
+    }                                                                         \
+}
+
+YUV2RGB_FUNCS(yuv)
+YUV2RGB_FUNCS(nv12)
+YUV2RGB_FUNCS(nv21)
+
+static yuv2rgb_line_fn get_line_func(SwsContext *c)
+{
+    switch (c->srcFormat) {
+    case AV_PIX_FMT_YUV420P:
+    case AV_PIX_FMT_YUV422P: return yuv_line_func(c->dstFormat);
+    case AV_PIX_FMT_NV12:    return nv12_line_func(c->dstFormat);
+    case AV_PIX_FMT_NV21:    return nv21_line_func(c->dstFormat);
+    default:                 return NULL;
+    }
+}
+
+/* The line functions work on multiples of 16 pixels; the remainder of
+ * each row goes through zero padded temporary buffers so that nothing
+ * is written past the end of the destination line. */
+static int yuv2rgb_neon_wrapper(SwsContext *c, const uint8_t *src[],
+                                int srcStride[], int srcSliceY, int srcSliceH,
+                                uint8_t *dst[], int dstStride[])
+{
+    yuv2rgb_line_fn line = get_line_func(c);
+    const int semiplanar = c->srcFormat == AV_PIX_FMT_NV12 ||
+                           c->srcFormat == AV_PIX_FMT_NV21;
+    const int bpp  = c->dstFormat == AV_PIX_FMT_RGB565 ? 2 : 4;
+    const int w    = c->srcW & ~15;
+    const int rest = c->srcW & 15;
+    const int cw   = w >> 1;
+    DECLARE_ALIGNED(16, int16_t, coeffs)[8] = {
+        c->yCoeff, c->vrCoeff, c->ugCoeff, c->vgCoeff, c->ubCoeff, c->yOffset
+    };
+    DECLARE_ALIGNED(16, uint8_t, ybuf)[16];
+    DECLARE_ALIGNED(16, uint8_t, ubuf)[16];
+    DECLARE_ALIGNED(16, uint8_t, vbuf)[8];
+    DECLARE_ALIGNED(16, uint8_t, obuf)[16 * 4];
+    int y;
+
+    for (y = 0; y < srcSliceH; y++) {
+        const int cy      = y >> c->chrSrcVSubSample;
+        uint8_t *out      = dst[0] + (srcSliceY + y) * dstStride[0];
+        const uint8_t *py = src[0] + y  * srcStride[0];
+        const uint8_t *pu = src[1] + cy * srcStride[1];
+        const uint8_t *pv = semiplanar ? NULL : src[2] + cy * srcStride[2];
+
+        if (w)
+            line(out, py, pu, pv, w, coeffs);
+        if (rest) {
+            const int crest = (rest + 1) >> 1;
+
+            memset(ybuf, 0, sizeof(ybuf));
+            memset(ubuf, 0, sizeof(ubuf));
+            memcpy(ybuf, py + w, rest);
+            if (semiplanar) {
+                memcpy(ubuf, pu + 2 * cw, 2 * crest);
+            } else {
+                memset(vbuf, 0, sizeof(vbuf));
+                memcpy(ubuf, pu + cw, crest);
+                memcpy(vbuf, pv + cw, crest);
+            }
+            line(obuf, ybuf, ubuf, vbuf, 16, coeffs);
+            memcpy(out + w * bpp, obuf, rest * bpp);
+        }
+    }
+
+    return srcSliceH;
+}
+
+av_cold void ff_get_unscaled_swscale_arm(SwsContext *c)
+{
+    int cpu_flags = av_get_cpu_flags();
+
+    if (have_neon(cpu_flags) && !(c->flags & SWS_ACCURATE_RND) &&
+        get_line_func(c))
+        c->swscale = yuv2rgb_neon_wrapper;
+}
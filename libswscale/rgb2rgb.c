@@ -134,6 +134,10 @@ av_cold void sws_rgb2rgb_init(void)
     rgb2rgb_init_c();
     if (ARCH_X86)
         rgb2rgb_init_x86();
+    if (ARCH_ARM)
+        rgb2rgb_init_arm();
+    if (ARCH_AARCH64)
+        rgb2rgb_init_aarch64();
 }
 
 void rgb32to24(const uint8_t *src, uint8_t *dst, int src_size)
@@ -776,6 +776,10 @@ SwsFunc ff_getSwsFunc(SwsContext *c)
         ff_sws_init_swscale_ppc(c);
     if (ARCH_X86)
         ff_sws_init_swscale_x86(c);
+    if (ARCH_ARM)
+        ff_sws_init_swscale_arm(c);
+    if (ARCH_AARCH64)
+        ff_sws_init_swscale_aarch64(c);
 
     return swscale;
 }
@@ -26,6 +26,10 @@ FATE_AC3 += fate-ac3-5.1-downmix-stereo
 fate-ac3-5.1-downmix-stereo: CMD = pcm -request_channels 2 -i $(TARGET_SAMPLES)/ac3/monsters_inc_5.1_448_small.ac3
 fate-ac3-5.1-downmix-stereo: REF = $(SAMPLES)/ac3/monsters_inc_5.1_448_small_stereo_v2.pcm
 
+FATE_AC3 += fate-ac3-s16-5.1-downmix-stereo
+fate-ac3-s16-5.1-downmix-stereo: CMD = pcm -request_channels 2 -request_sample_fmt s16 -i $(TARGET_SAMPLES)/ac3/monsters_inc_5.1_448_small.ac3
+fate-ac3-s16-5.1-downmix-stereo: REF = $(SAMPLES)/ac3/monsters_inc_5.1_448_small_stereo_v2.pcm
+
 FATE_EAC3 += fate-eac3-1
 fate-eac3-1: CMD = pcm -i $(TARGET_SAMPLES)/eac3/csi_miami_5.1_256_spx_small.eac3
 fate-eac3-1: REF = $(SAMPLES)/eac3/csi_miami_5.1_256_spx_small_v2.pcm
@@ -42,10 +46,32 @@ FATE_EAC3 += fate-eac3-4
 fate-eac3-4: CMD = pcm -i $(TARGET_SAMPLES)/eac3/serenity_english_5.1_1536_small.eac3
 fate-eac3-4: REF = $(SAMPLES)/eac3/serenity_english_5.1_1536_small_v2.pcm
 
-$(FATE_AC3) $(FATE_EAC3): CMP = oneoff
+FATE_EAC3 += fate-eac3-s16-1
+fate-eac3-s16-1: CMD = pcm -request_sample_fmt s16 -i $(TARGET_SAMPLES)/eac3/csi_miami_5.1_256_spx_small.eac3
+fate-eac3-s16-1: REF = $(SAMPLES)/eac3/csi_miami_5.1_256_spx_small_v2.pcm
+
+FATE_AC3_FIXED += fate-ac3-fixed-2.0
+fate-ac3-fixed-2.0: CMD = pcm -c ac3_fixed -i $(TARGET_SAMPLES)/ac3/monsters_inc_2.0_192_small.ac3
+fate-ac3-fixed-2.0: REF = $(SAMPLES)/ac3/monsters_inc_2.0_192_small_v2.pcm
+
+FATE_AC3_FIXED += fate-ac3-fixed-4.0-downmix-mono
+fate-ac3-fixed-4.0-downmix-mono: CMD = pcm -request_channels 1 -c ac3_fixed -i $(TARGET_SAMPLES)/ac3/millers_crossing_4.0.ac3
+fate-ac3-fixed-4.0-downmix-mono: REF = $(SAMPLES)/ac3/millers_crossing_4.0_mono_v2.pcm
+
+FATE_AC3_FIXED += fate-ac3-fixed-5.1-downmix-stereo
+fate-ac3-fixed-5.1-downmix-stereo: CMD = pcm -request_channels 2 -c ac3_fixed -i $(TARGET_SAMPLES)/ac3/monsters_inc_5.1_448_small.ac3
+fate-ac3-fixed-5.1-downmix-stereo: REF = $(SAMPLES)/ac3/monsters_inc_5.1_448_small_stereo_v2.pcm
+
+FATE_EAC3_FIXED += fate-eac3-fixed-1
+fate-eac3-fixed-1: CMD = pcm -c eac3_fixed -i $(TARGET_SAMPLES)/eac3/csi_miami_5.1_256_spx_small.eac3
+fate-eac3-fixed-1: REF = $(SAMPLES)/eac3/csi_miami_5.1_256_spx_small_v2.pcm
+
+$(FATE_AC3) $(FATE_EAC3) $(FATE_AC3_FIXED) $(FATE_EAC3_FIXED): CMP = oneoff
 
 FATE_AC3-$(call  DEMDEC, AC3,  AC3)  += $(FATE_AC3)
 FATE_EAC3-$(call DEMDEC, EAC3, EAC3) += $(FATE_EAC3)
+FATE_AC3-$(call  DEMDEC, AC3,  AC3_FIXED)  += $(FATE_AC3_FIXED)
+FATE_EAC3-$(call DEMDEC, EAC3, EAC3_FIXED) += $(FATE_EAC3_FIXED)
 
 FATE_AC3-$(call ENCDEC, AC3, AC3) += fate-ac3-encode
 fate-ac3-encode: CMD = enc_dec_pcm ac3 wav s16le $(subst $(SAMPLES),$(TARGET_SAMPLES),$(REF)) -c:a ac3 -b:a 128k
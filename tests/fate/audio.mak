@@ -24,6 +24,11 @@ fate-dts: CMD = pcm -i $(TARGET_SAMPLES)/dts/dts.ts
 fate-dts: CMP = oneoff
 fate-dts: REF = $(SAMPLES)/dts/dts.pcm
 
+FATE_SAMPLES_AVCONV-$(call DEMDEC, MPEGTS, DCA) += fate-dts-s16
+fate-dts-s16: CMD = pcm -request_sample_fmt s16 -i $(TARGET_SAMPLES)/dts/dts.ts
+fate-dts-s16: CMP = oneoff
+fate-dts-s16: REF = $(SAMPLES)/dts/dts.pcm
+
 FATE_SAMPLES_AVCONV-$(call DEMDEC, AVI, IMC) += fate-imc
 fate-imc: CMD = pcm -i $(TARGET_SAMPLES)/imc/imc.avi
 fate-imc: CMP = oneoff
@@ -38,5 +38,22 @@ $(FATE_FFT_FIXED-yes): libavcodec/fft-fixed-test$(EXESUF)
 $(FATE_FFT_FIXED-yes): CMD = run libavcodec/fft-fixed-test $(CPUFLAGS:%=-c%) $(ARGS)
 $(FATE_FFT_FIXED-yes): REF = /dev/null
 
-FATE-$(CONFIG_AVCODEC) += $(FATE_FFT-yes) $(FATE_FFT_FIXED-yes)
-fate-fft: $(FATE_FFT-yes) $(FATE_FFT_FIXED-yes)
+define DEF_FFT_FIXED32
+FATE_FFT_FIXED32-$(CONFIG_FFT)  += fate-fft-fixed32-$(1)  fate-ifft-fixed32-$(1)
+FATE_FFT_FIXED32-$(CONFIG_MDCT) += fate-mdct-fixed32-$(1) fate-imdct-fixed32-$(1)
+
+fate-fft-fixed32-$(1):   ARGS = -n$(1)
+fate-ifft-fixed32-$(1):  ARGS = -n$(1) -i
+fate-mdct-fixed32-$(1):  ARGS = -n$(1) -m
+fate-imdct-fixed32-$(1): ARGS = -n$(1) -m -i
+endef
+
+$(foreach N, 4 5 6 7 8 9 10 11 12, $(eval $(call DEF_FFT_FIXED32,$(N))))
+
+fate-fft-fixed32: $(FATE_FFT_FIXED32-yes)
+$(FATE_FFT_FIXED32-yes): libavcodec/fft-fixed32-test$(EXESUF)
+$(FATE_FFT_FIXED32-yes): CMD = run libavcodec/fft-fixed32-test $(CPUFLAGS:%=-c%) $(ARGS)
+$(FATE_FFT_FIXED32-yes): REF = /dev/null
+
+FATE-$(CONFIG_AVCODEC) += $(FATE_FFT-yes) $(FATE_FFT_FIXED-yes) $(FATE_FFT_FIXED32-yes)
+fate-fft: $(FATE_FFT-yes) $(FATE_FFT_FIXED-yes) $(FATE_FFT_FIXED32-yes)
@@ -0,0 +1,717 @@
+/*
+ * Decoder and DSP function benchmark
+ *
+ * This file is part of Libav.
+ *
+ * Libav is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * Libav is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Libav; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "config.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if HAVE_UNISTD_H
+#include <unistd.h>             /* getopt */
+#endif
+#if HAVE_SYS_RESOURCE_H
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/resource.h>
+#endif
+#if HAVE_GETPROCESSMEMORYINFO
+#include <windows.h>
+#include <psapi.h>
+#endif
+
+#include "libavutil/cpu.h"
+#include "libavutil/lfg.h"
+#include "libavutil/mem.h"
+#include "libavutil/time.h"
+#include "libavcodec/avcodec.h"
+#include "libavformat/avformat.h"
+
+#if !HAVE_GETOPT
+#include "compat/getopt.c"
+#endif
+
+/* The DSP contexts are internal to libavcodec, so timing them needs the
+ * static library. */
+#define DSP_BENCH !CONFIG_SHARED
+
+#if DSP_BENCH
+#include "libavcodec/h264dsp.h"
+#include "libavcodec/hevcdsp.h"
+#endif
+
+static int64_t getmaxrss(void)
+{
+#if HAVE_GETRUSAGE && HAVE_STRUCT_RUSAGE_RU_MAXRSS
+    struct rusage rusage;
+    getrusage(RUSAGE_SELF, &rusage);
+    return (int64_t)rusage.ru_maxrss * 1024;
+#elif HAVE_GETPROCESSMEMORYINFO
+    HANDLE proc;
+    PROCESS_MEMORY_COUNTERS memcounters;
+    proc = GetCurrentProcess();
+    memcounters.cb = sizeof(memcounters);
+    GetProcessMemoryInfo(proc, &memcounters, sizeof(memcounters));
+    return memcounters.PeakPagefileUsage;
+#else
+    return 0;
+#endif
+}
+
+static int cmp_int64(const void *a, const void *b)
+{
+    int64_t va = *(const int64_t *)a, vb = *(const int64_t *)b;
+    return (va > vb) - (va < vb);
+}
+
+/* Nearest-rank percentile of the sorted array v. */
+static int64_t percentile(const int64_t *v, int n, int p)
+{
+    int idx = (n * p + 99) / 100 - 1;
+    return v[FFMAX(idx, 0)];
+}
+
+typedef struct DecodeStats {
+    int64_t *times;         ///< decode time of each output frame, in us
+    int nb_times;
+    int times_size;
+    int64_t pending;        ///< decode time not yet attributed to a frame
+} DecodeStats;
+
+static int add_frame_time(DecodeStats *st)
+{
+    if (st->nb_times == st->times_size) {
+        int size = FFMAX(2 * st->times_size, 256);
+        int ret  = av_reallocp_array(&st->times, size, sizeof(*st->times));
+        if (ret < 0)
+            return ret;
+        st->times_size = size;
+    }
+    st->times[st->nb_times++] = st->pending;
+    st->pending = 0;
+    return 0;
+}
+
+/* Decode one packet (or flush when pkt->size is 0) and account the time
+ * spent to the frames it returns. Returns the number of frames output
+ * or a negative error code. */
+static int decode_packet(AVCodecContext *avctx, AVFrame *frame,
+                         AVPacket *pkt, DecodeStats *st)
+{
+    AVPacket tmp = *pkt;
+    int frames   = 0;
+
+    do {
+        int got_frame = 0, ret;
+        int64_t t = av_gettime();
+
+        if (avctx->codec_type == AVMEDIA_TYPE_VIDEO)
+            ret = avcodec_decode_video2(avctx, frame, &got_frame, &tmp);
+        else
+            ret = avcodec_decode_audio4(avctx, frame, &got_frame, &tmp);
+        st->pending += av_gettime() - t;
+        if (ret < 0)
+            return ret;
+
+        if (got_frame) {
+            int err = add_frame_time(st);
+            av_frame_unref(frame);
+            if (err < 0)
+                return err;
+            frames++;
+        } else if (!tmp.size) {
+            break;
+        }
+        if (tmp.size) {
+            /* video decoders always consume the whole packet */
+            if (avctx->codec_type == AVMEDIA_TYPE_VIDEO)
+                break;
+            tmp.data += ret;
+            tmp.size -= ret;
+            if (!tmp.size)
+                break;
+        }
+    } while (1);
+
+    return frames;
+}
+
+static int bench_decode(const char *filename, const char *decoder,
+                        int threads, int max_frames)
+{
+    AVFormatContext *fmt = NULL;
+    AVCodecContext *avctx;
+    AVCodec *codec = NULL;
+    AVFrame *frame = NULL;
+    AVPacket pkt;
+    DecodeStats st = { 0 };
+    int64_t start, elapsed;
+    int idx = -1, ret, frames = 0;
+
+    if ((ret = avformat_open_input(&fmt, filename, NULL, NULL)) < 0) {
+        fprintf(stderr, "cannot open %s\n", filename);
+        return ret;
+    }
+    if ((ret = avformat_find_stream_info(fmt, NULL)) < 0)
+        goto end;
+
+    idx = av_find_best_stream(fmt, AVMEDIA_TYPE_VIDEO, -1, -1, NULL, 0);
+    if (idx < 0)
+        idx = av_find_best_stream(fmt, AVMEDIA_TYPE_AUDIO, -1, -1, NULL, 0);
+    if (idx < 0) {
+        fprintf(stderr, "no audio or video stream in %s\n", filename);
+        ret = idx;
+        goto end;
+    }
+    avctx = fmt->streams[idx]->codec;
+
+    if (decoder)
+        codec = avcodec_find_decoder_by_name(decoder);
+    else
+        codec = avcodec_find_decoder(avctx->codec_id);
+    if (!codec || codec->type != avctx->codec_type) {
+        fprintf(stderr, "no usable decoder for stream %d\n", idx);
+        ret = AVERROR_DECODER_NOT_FOUND;
+        goto end;
+    }
+
+    avctx->thread_count     = threads;
+    avctx->refcounted_frames = 1;
+    if ((ret = avcodec_open2(avctx, codec, NULL)) < 0)
+        goto end;
+
+    frame = av_frame_alloc();
+    if (!frame) {
+        ret = AVERROR(ENOMEM);
+        goto end;
+    }
+
+    av_init_packet(&pkt);
+    start = av_gettime();
+    while ((!max_frames || frames < max_frames) &&
+           av_read_frame(fmt, &pkt) >= 0) {
+        if (pkt.stream_index == idx) {
+            ret = decode_packet(avctx, frame, &pkt, &st);
+            if (ret < 0)
+                fprintf(stderr, "error decoding packet %"PRId64"\n", pkt.pts);
+            else
+                frames += ret;
+        }
+        av_free_packet(&pkt);
+    }
+    pkt.data = NULL;
+    pkt.size = 0;
+    while ((!max_frames || frames < max_frames) &&
+           (ret = decode_packet(avctx, frame, &pkt, &st)) > 0)
+        frames += ret;
+    elapsed = av_gettime() - start;
+
+    printf("decoder=%s threads=%d cpuflags=0x%x\n",
+           codec->name, threads, av_get_cpu_flags());
+    printf("frames=%d time=%.3fs fps=%.2f\n", frames, elapsed / 1000000.0,
+           elapsed ? frames * 1000000.0 / elapsed : 0.0);
+    if (st.nb_times) {
+        qsort(st.times, st.nb_times, sizeof(*st.times), cmp_int64);
+        printf("frame_us: min=%"PRId64" p50=%"PRId64" p90=%"PRId64
+               " p99=%"PRId64" max=%"PRId64"\n", st.times[0],
+               percentile(st.times, st.nb_times, 50),
+               percentile(st.times, st.nb_times, 90),
+               percentile(st.times, st.nb_times, 99),
+               st.times[st.nb_times - 1]);
+    }
+    printf("maxrss=%"PRId64"kB\n", getmaxrss() / 1024);
+    ret = 0;
+
+end:
+    av_frame_free(&frame);
+    av_free(st.times);
+    if (fmt && idx >= 0 && idx < fmt->nb_streams)
+        avcodec_close(fmt->streams[idx]->codec);
+    avformat_close_input(&fmt);
+    return ret;
+}
+
+#if DSP_BENCH
+
+#define BUF_STRIDE 128
+#define BUF_SIZE   (BUF_STRIDE * (64 + 16))
+
+/* Pixel and coefficient buffers shared by all the benchmarked functions.
+ * Nothing is restored between calls; the data only has to be valid input,
+ * not meaningful. */
+typedef struct BenchBufs {
+    DECLARE_ALIGNED(32, uint8_t, pix)[BUF_SIZE];
+    DECLARE_ALIGNED(32, uint8_t, pix2)[BUF_SIZE];
+    DECLARE_ALIGNED(32, int16_t, coef)[64 * 64];
+    DECLARE_ALIGNED(32, int16_t, coef2)[64 * 64];
+    DECLARE_ALIGNED(32, int16_t, mcbuf)[(64 + 7) * 64];
+    int8_t  tc0[4];
+    int     tc[2];
+    uint8_t no_p[2], no_q[2];
+    int     block_offset[48];
+    uint8_t nnzc[15 * 8];
+    int     borders[4];
+    SAOParams sao;
+} BenchBufs;
+
+/* The middle of pix, with room above and left for filters and MC. */
+#define PIX(b)  ((b)->pix  + 8 * BUF_STRIDE + 16)
+#define PIX2(b) ((b)->pix2 + 8 * BUF_STRIDE + 16)
+
+typedef void (*DSPFn)(void);
+
+typedef struct DSPFunc {
+    const char *name;
+    size_t offset;          ///< offset of the function pointer in the context
+    void (*run)(DSPFn fn, BenchBufs *b, int arg);
+    int arg;
+} DSPFunc;
+
+#define FN(type, fn) ((type)(fn))
+
+static void run_h264_weight(DSPFn fn, BenchBufs *b, int w)
+{
+    FN(h264_weight_func, fn)(PIX(b), BUF_STRIDE, w, 5, 37, 3);
+}
+
+static void run_h264_biweight(DSPFn fn, BenchBufs *b, int w)
+{
+    FN(h264_biweight_func, fn)(PIX(b), PIX2(b), BUF_STRIDE, w, 5, 37, 29, 3);
+}
+
+typedef void (*h264_lf_func)(uint8_t *pix, int stride, int alpha, int beta,
+                             int8_t *tc0);
+typedef void (*h264_lf_intra_func)(uint8_t *pix, int stride,
+                                   int alpha, int beta);
+
+static void run_h264_lf(DSPFn fn, BenchBufs *b, int arg)
+{
+    FN(h264_lf_func, fn)(PIX(b), BUF_STRIDE, 40, 12, b->tc0);
+}
+
+static void run_h264_lf_intra(DSPFn fn, BenchBufs *b, int arg)
+{
+    FN(h264_lf_intra_func, fn)(PIX(b), BUF_STRIDE, 40, 12);
+}
+
+typedef void (*h264_idct_func)(uint8_t *dst, int16_t *block, int stride);
+typedef void (*h264_idct_multi_func)(uint8_t *dst, const int *blockoffset,
+                                     int16_t *block, int stride,
+                                     const uint8_t nnzc[15 * 8]);
+typedef void (*h264_idct_add8_func)(uint8_t **dst, const int *blockoffset,
+                                    int16_t *block, int stride,
+                                    const uint8_t nnzc[15 * 8]);
+
+static void run_h264_idct(DSPFn fn, BenchBufs *b, int arg)
+{
+    FN(h264_idct_func, fn)(PIX(b), b->coef, BUF_STRIDE);
+}
+
+static void run_h264_idct_multi(DSPFn fn, BenchBufs *b, int arg)
+{
+    FN(h264_idct_multi_func, fn)(PIX(b), b->block_offset, b->coef,
+                                 BUF_STRIDE, b->nnzc);
+}
+
+static void run_h264_idct_add8(DSPFn fn, BenchBufs *b, int arg)
+{
+    uint8_t *dst[2] = { PIX(b), PIX2(b) };
+    FN(h264_idct_add8_func, fn)(dst, b->block_offset, b->coef,
+                                BUF_STRIDE, b->nnzc);
+}
+
+static void run_h264_luma_dc(DSPFn fn, BenchBufs *b, int arg)
+{
+    FN(void (*)(int16_t *, int16_t *, int), fn)(b->coef, b->coef2, 83);
+}
+
+static void run_h264_chroma_dc(DSPFn fn, BenchBufs *b, int arg)
+{
+    FN(void (*)(int16_t *, int), fn)(b->coef, 83);
+}
+
+static void run_startcode(DSPFn fn, BenchBufs *b, int arg)
+{
+    FN(int (*)(const uint8_t *, int), fn)(b->pix, BUF_SIZE);
+}
+
+#define H264(field, run, arg) \
+    { #field, offsetof(H264DSPContext, field), run, arg }
+
+static const DSPFunc h264_funcs[] = {
+    H264(weight_h264_pixels_tab[0],           run_h264_weight,     16),
+    H264(weight_h264_pixels_tab[1],           run_h264_weight,      8),
+    H264(weight_h264_pixels_tab[2],           run_h264_weight,      4),
+    H264(weight_h264_pixels_tab[3],           run_h264_weight,      2),
+    H264(biweight_h264_pixels_tab[0],         run_h264_biweight,   16),
+    H264(biweight_h264_pixels_tab[1],         run_h264_biweight,    8),
+    H264(biweight_h264_pixels_tab[2],         run_h264_biweight,    4),
+    H264(biweight_h264_pixels_tab[3],         run_h264_biweight,    2),
+    H264(h264_v_loop_filter_luma,             run_h264_lf,          0),
+    H264(h264_h_loop_filter_luma,             run_h264_lf,          0),
+    H264(h264_h_loop_filter_luma_mbaff,       run_h264_lf,          0),
+    H264(h264_v_loop_filter_luma_intra,       run_h264_lf_intra,    0),
+    H264(h264_h_loop_filter_luma_intra,       run_h264_lf_intra,    0),
+    H264(h264_h_loop_filter_luma_mbaff_intra, run_h264_lf_intra,    0),
+    H264(h264_v_loop_filter_chroma,           run_h264_lf,          0),
+    H264(h264_h_loop_filter_chroma,           run_h264_lf,          0),
+    H264(h264_h_loop_filter_chroma_mbaff,     run_h264_lf,          0),
+    H264(h264_v_loop_filter_chroma_intra,     run_h264_lf_intra,    0),
+    H264(h264_h_loop_filter_chroma_intra,     run_h264_lf_intra,    0),
+    H264(h264_h_loop_filter_chroma_mbaff_intra, run_h264_lf_intra,  0),
+    H264(h264_idct_add,                       run_h264_idct,        0),
+    H264(h264_idct8_add,                      run_h264_idct,        0),
+    H264(h264_idct_dc_add,                    run_h264_idct,        0),
+    H264(h264_idct8_dc_add,                   run_h264_idct,        0),
+    H264(h264_idct_add16,                     run_h264_idct_multi,  0),
+    H264(h264_idct8_add4,                     run_h264_idct_multi,  0),
+    H264(h264_idct_add8,                      run_h264_idct_add8,   0),
+    H264(h264_idct_add16intra,                run_h264_idct_multi,  0),
+    H264(h264_luma_dc_dequant_idct,           run_h264_luma_dc,     0),
+    H264(h264_chroma_dc_dequant_idct,         run_h264_chroma_dc,   0),
+    H264(h264_add_pixels8_clear,              run_h264_idct,        0),
+    H264(h264_add_pixels4_clear,              run_h264_idct,        0),
+    H264(startcode_find_candidate,            run_startcode,        0),
+};
+
+#if CONFIG_HEVC_DECODER
+typedef void (*hevc_add_func)(uint8_t *dst, int16_t *coeffs,
+                              ptrdiff_t stride);
+typedef void (*hevc_qpel_func)(int16_t *dst, ptrdiff_t dststride,
+                               uint8_t *src, ptrdiff_t srcstride,
+                               int width, int height, int16_t *mcbuffer);
+typedef void (*hevc_epel_func)(int16_t *dst, ptrdiff_t dststride,
+                               uint8_t *src, ptrdiff_t srcstride,
+                               int width, int height, int mx, int my,
+                               int16_t *mcbuffer);
+typedef void (*hevc_lf_luma_func)(uint8_t *pix, ptrdiff_t stride, int beta,
+                                  int *tc, uint8_t *no_p, uint8_t *no_q);
+typedef void (*hevc_lf_chroma_func)(uint8_t *pix, ptrdiff_t stride, int *tc,
+                                    uint8_t *no_p, uint8_t *no_q);
+
+/* Prediction blocks are benchmarked at 16x16, the int16_t intermediate
+ * uses the decoder's MAX_PB_SIZE stride of 64. */
+static void run_hevc_add(DSPFn fn, BenchBufs *b, int arg)
+{
+    FN(hevc_add_func, fn)(PIX(b), b->coef, BUF_STRIDE);
+}
+
+static void run_hevc_sao_band(DSPFn fn, BenchBufs *b, int arg)
+{
+    FN(void (*)(uint8_t *, uint8_t *, ptrdiff_t, SAOParams *, int *,
+                int, int, int), fn)(PIX(b), PIX2(b), BUF_STRIDE, &b->sao,
+                                    b->borders, 64, 64, 0);
+}
+
+static void run_hevc_sao_edge(DSPFn fn, BenchBufs *b, int arg)
+{
+    FN(void (*)(uint8_t *, uint8_t *, ptrdiff_t, SAOParams *, int *,
+                int, int, int, uint8_t, uint8_t, uint8_t),
+       fn)(PIX(b), PIX2(b), BUF_STRIDE, &b->sao, b->borders, 64, 64, 0,
+           0, 0, 0);
+}
+
+static void run_hevc_qpel(DSPFn fn, BenchBufs *b, int arg)
+{
+    FN(hevc_qpel_func, fn)(b->coef, 64, PIX2(b), BUF_STRIDE, 16, 16,
+                           b->mcbuf);
+}
+
+static void run_hevc_epel(DSPFn fn, BenchBufs *b, int arg)
+{
+    FN(hevc_epel_func, fn)(b->coef, 64, PIX2(b), BUF_STRIDE, 8, 8, 3, 5,
+                           b->mcbuf);
+}
+
+static void run_hevc_unweighted(DSPFn fn, BenchBufs *b, int arg)
+{
+    FN(void (*)(uint8_t *, ptrdiff_t, int16_t *, ptrdiff_t, int, int),
+       fn)(PIX(b), BUF_STRIDE, b->coef, 64, 16, 16);
+}
+
+static void run_hevc_unweighted_avg(DSPFn fn, BenchBufs *b, int arg)
+{
+    FN(void (*)(uint8_t *, ptrdiff_t, int16_t *, int16_t *, ptrdiff_t,
+                int, int), fn)(PIX(b), BUF_STRIDE, b->coef, b->coef2, 64,
+                               16, 16);
+}
+
+static void run_hevc_weighted(DSPFn fn, BenchBufs *b, int arg)
+{
+    FN(void (*)(uint8_t, int16_t, int16_t, uint8_t *, ptrdiff_t, int16_t *,
+                ptrdiff_t, int, int), fn)(5, 37, 3, PIX(b), BUF_STRIDE,
+                                          b->coef, 64, 16, 16);
+}
+
+static void run_hevc_weighted_avg(DSPFn fn, BenchBufs *b, int arg)
+{
+    FN(void (*)(uint8_t, int16_t, int16_t, int16_t, int16_t, uint8_t *,
+                ptrdiff_t, int16_t *, int16_t *, ptrdiff_t, int, int),
+       fn)(5, 37, 29, 3, -2, PIX(b), BUF_STRIDE, b->coef, b->coef2, 64,
+           16, 16);
+}
+
+static void run_hevc_lf_luma(DSPFn fn, BenchBufs *b, int arg)
+{
+    FN(hevc_lf_luma_func, fn)(PIX(b), BUF_STRIDE, 38, b->tc, b->no_p, b->no_q);
+}
+
+static void run_hevc_lf_chroma(DSPFn fn, BenchBufs *b, int arg)
+{
+    FN(hevc_lf_chroma_func, fn)(PIX(b), BUF_STRIDE, b->tc, b->no_p, b->no_q);
+}
+
+#define HEVC(field, run, arg) \
+    { #field, offsetof(HEVCDSPContext, field), run, arg }
+
+static const DSPFunc hevc_funcs[] = {
+    HEVC(transquant_bypass[0],      run_hevc_add,            0),
+    HEVC(transquant_bypass[1],      run_hevc_add,            0),
+    HEVC(transquant_bypass[2],      run_hevc_add,            0),
+    HEVC(transquant_bypass[3],      run_hevc_add,            0),
+    HEVC(transform_skip,            run_hevc_add,            0),
+    HEVC(transform_4x4_luma_add,    run_hevc_add,            0),
+    HEVC(transform_add[0],          run_hevc_add,            0),
+    HEVC(transform_add[1],          run_hevc_add,            0),
+    HEVC(transform_add[2],          run_hevc_add,            0),
+    HEVC(transform_add[3],          run_hevc_add,            0),
+    HEVC(sao_band_filter[0],        run_hevc_sao_band,       0),
+    HEVC(sao_edge_filter[0],        run_hevc_sao_edge,       0),
+    HEVC(put_hevc_qpel[0][0],       run_hevc_qpel,           0),
+    HEVC(put_hevc_qpel[0][1],       run_hevc_qpel,           0),
+    HEVC(put_hevc_qpel[0][2],       run_hevc_qpel,           0),
+    HEVC(put_hevc_qpel[0][3],       run_hevc_qpel,           0),
+    HEVC(put_hevc_qpel[1][0],       run_hevc_qpel,           0),
+    HEVC(put_hevc_qpel[1][1],       run_hevc_qpel,           0),
+    HEVC(put_hevc_qpel[1][2],       run_hevc_qpel,           0),
+    HEVC(put_hevc_qpel[1][3],       run_hevc_qpel,           0),
+    HEVC(put_hevc_qpel[2][0],       run_hevc_qpel,           0),
+    HEVC(put_hevc_qpel[2][1],       run_hevc_qpel,           0),
+    HEVC(put_hevc_qpel[2][2],       run_hevc_qpel,           0),
+    HEVC(put_hevc_qpel[2][3],       run_hevc_qpel,           0),
+    HEVC(put_hevc_qpel[3][0],       run_hevc_qpel,           0),
+    HEVC(put_hevc_qpel[3][1],       run_hevc_qpel,           0),
+    HEVC(put_hevc_qpel[3][2],       run_hevc_qpel,           0),
+    HEVC(put_hevc_qpel[3][3],       run_hevc_qpel,           0),
+    HEVC(put_hevc_epel[0][0],       run_hevc_epel,           0),
+    HEVC(put_hevc_epel[0][1],       run_hevc_epel,           0),
+    HEVC(put_hevc_epel[1][0],       run_hevc_epel,           0),
+    HEVC(put_hevc_epel[1][1],       run_hevc_epel,           0),
+    HEVC(put_unweighted_pred,       run_hevc_unweighted,     0),
+    HEVC(put_weighted_pred_avg,     run_hevc_unweighted_avg, 0),
+    HEVC(weighted_pred,             run_hevc_weighted,       0),
+    HEVC(weighted_pred_avg,         run_hevc_weighted_avg,   0),
+    HEVC(hevc_h_loop_filter_luma,   run_hevc_lf_luma,        0),
+    HEVC(hevc_v_loop_filter_luma,   run_hevc_lf_luma,        0),
+    HEVC(hevc_h_loop_filter_chroma, run_hevc_lf_chroma,      0),
+    HEVC(hevc_v_loop_filter_chroma, run_hevc_lf_chroma,      0),
+};
+#endif /* CONFIG_HEVC_DECODER */
+
+static void fill_bufs(BenchBufs *b)
+{
+    AVLFG lfg;
+    int i;
+
+    av_lfg_init(&lfg, 0x1234);
+    for (i = 0; i < BUF_SIZE; i++) {
+        b->pix[i]  = av_lfg_get(&lfg);
+        b->pix2[i] = av_lfg_get(&lfg);
+    }
+    for (i = 0; i < FF_ARRAY_ELEMS(b->coef); i++) {
+        b->coef[i]  = (int)(av_lfg_get(&lfg) % 512) - 256;
+        b->coef2[i] = (int)(av_lfg_get(&lfg) % 512) - 256;
+    }
+    for (i = 0; i < 4; i++) {
+        b->tc0[i]     = i + 1;
+        b->borders[i] = 1;
+    }
+    b->tc[0] = b->tc[1] = 6;
+    /* 4x4 blocks in raster order, repeated for the chroma planes */
+    for (i = 0; i < FF_ARRAY_ELEMS(b->block_offset); i++)
+        b->block_offset[i] = 4 * (i & 3) + 4 * BUF_STRIDE * ((i >> 2) & 3);
+    memset(b->nnzc, 1, sizeof(b->nnzc));
+    for (i = 0; i < 5; i++)
+        b->sao.offset_val[0][i] = i - 2;
+    b->sao.band_position[0] = 12;
+    b->sao.eo_class[0]      = 1;
+}
+
+/* Time fn in batches of doubling size until a batch runs for at least
+ * 20 ms, then take the best of three batches of that size; returns
+ * nanoseconds per call. */
+static double time_func(const DSPFunc *f, DSPFn fn, BenchBufs *b)
+{
+    int64_t t = 0, best;
+    int i, j, n;
+
+    for (n = 16; n < (1 << 26); n <<= 1) {
+        t = av_gettime();
+        for (i = 0; i < n; i++)
+            f->run(fn, b, f->arg);
+        t = av_gettime() - t;
+        if (t >= 20000)
+            break;
+    }
+    best = t;
+    for (j = 0; j < 3; j++) {
+        t = av_gettime();
+        for (i = 0; i < n; i++)
+            f->run(fn, b, f->arg);
+        best = FFMIN(best, av_gettime() - t);
+    }
+    return best * 1000.0 / n;
+}
+
+static void bench_dsp_funcs(const char *prefix, const DSPFunc *funcs,
+                            int nb_funcs, const void *ref, const void *opt,
+                            BenchBufs *b)
+{
+    int i;
+
+    for (i = 0; i < nb_funcs; i++) {
+        DSPFn fref = *(const DSPFn *)((const uint8_t *)ref + funcs[i].offset);
+        DSPFn fopt = *(const DSPFn *)((const uint8_t *)opt + funcs[i].offset);
+        double tref, topt;
+
+        if (!fref && !fopt)
+            continue;
+        if (fref == fopt) {
+            printf("%s.%-40s %10s\n", prefix, funcs[i].name, "no simd");
+            continue;
+        }
+        tref = fref ? time_func(&funcs[i], fref, b) : 0;
+        topt = fopt ? time_func(&funcs[i], fopt, b) : 0;
+        printf("%s.%-40s c %9.1f ns  simd %9.1f ns  %5.2fx\n", prefix,
+               funcs[i].name, tref, topt, tref && topt ? tref / topt : 0.0);
+    }
+}
+
+static int bench_dsp(const char *which, int cpuflags)
+{
+    BenchBufs *b = av_mallocz(sizeof(*b));
+    int ret = 0;
+
+    if (!b)
+        return AVERROR(ENOMEM);
+    fill_bufs(b);
+
+    if (0) {
+#if CONFIG_H264DSP
+    } else if (!strcmp(which, "h264")) {
+        H264DSPContext ref, opt;
+        av_set_cpu_flags_mask(0);
+        ff_h264dsp_init(&ref, 8, 1);
+        av_set_cpu_flags_mask(cpuflags);
+        ff_h264dsp_init(&opt, 8, 1);
+        bench_dsp_funcs("h264dsp", h264_funcs, FF_ARRAY_ELEMS(h264_funcs),
+                        &ref, &opt, b);
+#endif
+#if CONFIG_HEVC_DECODER
+    } else if (!strcmp(which, "hevc")) {
+        HEVCDSPContext ref, opt;
+        av_set_cpu_flags_mask(0);
+        ff_hevc_dsp_init(&ref, 8);
+        av_set_cpu_flags_mask(cpuflags);
+        ff_hevc_dsp_init(&opt, 8);
+        bench_dsp_funcs("hevcdsp", hevc_funcs, FF_ARRAY_ELEMS(hevc_funcs),
+                        &ref, &opt, b);
+#endif
+    } else {
+        fprintf(stderr, "unknown DSP context '%s'\n", which);
+        ret = AVERROR(EINVAL);
+    }
+
+    av_free(b);
+    return ret;
+}
+#endif /* DSP_BENCH */
+
+static void usage(void)
+{
+    printf("Benchmark a decoder or the C and SIMD versions of DSP functions\n"
+           "usage: decbench [options] input\n"
+           "       decbench [options] -d h264|hevc\n"
+           "options:\n"
+           "  -c name   decoder to use instead of the default one\n"
+           "  -t n      number of decoding threads (default 1, 0 for auto)\n"
+           "  -f flags  cpuflags mask, e.g. \"neon\" or \"0\" for plain C\n"
+           "  -n n      stop after n decoded frames\n"
+           "  -d ctx    time the functions of a DSP context (h264, hevc)\n"
+           "            in C and with the cpuflags in effect\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *decoder = NULL, *dsp = NULL;
+    int cpuflags = -1, threads = 1, max_frames = 0;
+    int c, ret;
+
+    while ((c = getopt(argc, argv, "c:t:f:n:d:h")) != -1) {
+        switch (c) {
+        case 'c':
+            decoder = optarg;
+            break;
+        case 't':
+            threads = atoi(optarg);
+            break;
+        case 'f':
+            cpuflags = av_parse_cpu_flags(optarg);
+            if (cpuflags < 0) {
+                fprintf(stderr, "invalid cpuflags '%s'\n", optarg);
+                return 1;
+            }
+            break;
+        case 'n':
+            max_frames = atoi(optarg);
+            break;
+        case 'd':
+            dsp = optarg;
+            break;
+        case 'h':
+            usage();
+            return 0;
+        default:
+            usage();
+            return 1;
+        }
+    }
+
+    if (dsp) {
+#if DSP_BENCH
+        return bench_dsp(dsp, cpuflags) < 0;
+#else
+        fprintf(stderr, "DSP function timing needs a static build\n");
+        return 1;
+#endif
+    }
+
+    if (optind >= argc) {
+        usage();
+        return 1;
+    }
+
+    av_set_cpu_flags_mask(cpuflags);
+    av_register_all();
+
+    ret = bench_decode(argv[optind], decoder, threads, max_frames);
+    return ret < 0;
+}